@@ -36,98 +36,9 @@
 
 #include "cut_output.h"    // outputting
 #include "cut_routines.h"  // momentum cuts
-#include "plan_ffts.h"     // FFTW plan setting
+#include "mom_gauge.h"     // lie fields and their FFT
 #include "pspace_landau.h" // momentum space Coulomb condition check
 
-#ifdef HAVE_FFTW3_H
-
-static int
-mom_gauge_spatial( struct site *__restrict A ,
-		   const lie_field_def def )
-{
-  size_t i ; 
-
-  // callback for the log definition
-  void (*log)( GLU_complex Q[ NCNC ] ,
-	       const GLU_complex U[ NCNC ] ) ;
-  log = Hermitian_proj ;
-  switch( def ) {
-  case LOG_DEF : 
-    log = exact_log_slow ; 
-    break ;
-  case LINEAR_DEF :
-    break ;
-  }
-
-#pragma omp parallel for private(i) shared(A)
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    GLU_complex temp[ NCNC ] ;
-    size_t mu ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      log( temp , A[i].O[mu] ) ;
-      equiv( A[i].O[mu] , temp ) ;
-    }
-  }
-
-  // FFTW routines
-  struct fftw_small_stuff FFTW ;
-  small_create_plans_DFT( &FFTW , Latt.dims , ND-1 ) ;
-
-  //// End of the search for Wisdom /////
-  
-  //3D complex fourier transform each time-slice
-  size_t t ;
-  for( t = 0 ; t < Latt.dims[ ND - 1 ] ; t++ )  {
-    const size_t slice = LCU *t ;
-    size_t mu , i , j ; 
-    // Loop directions and elements of the matrix
-    for( mu = 0 ; mu < ND ; mu++ )
-      for( j = 0 ; j < NCNC ; j++ ) {
-	// FORWARDS
-#ifdef CUT_FORWARD
-        #pragma omp parallel for private(i)
-        for( i = 0 ; i < LCU ; i++ ) {
-	  FFTW.in[i] = A[ slice + i ].O[mu][j] ; 
-	}
-	fftw_execute( FFTW.forward ) ; 
-        #pragma omp parallel for private(i)
-        for( i = 0 ; i < LCU ; i++ ) {
-	  A[ slice + i ].O[mu][j] = FFTW.out[i] ; 
-	}
-#else
-	// backwards
-        #pragma omp parallel for private(i)
-        for( i = 0 ; i < LCU ; i++ ) {
-	  FFTW.out[i] = A[ slice + i ].O[mu][j] ; 
-	}
-	fftw_execute( FFTW.backward ) ; 
-        #pragma omp parallel for private(i)
-        for( i = 0 ; i < LCU ; i++ ) {
-	  A[ slice + i ].O[mu][j] = FFTW.in[i] ; 
-	}
-#endif
-      }
-  }
-
-  //average into one sp_site size field
-  // et voila! we have our fourier-transformed links in 0-2Pi BZ
-  small_clean_up_fftw( FFTW ) ;
-
-  return GLU_SUCCESS ;
-}
-
-#else
-
-static short int
-mom_gauge_spatial( struct site *__restrict A ,
-		   const lie_field_def def )
-{
-  fprintf( stderr , "[CUTS] WARNING! No FFT of the fields \n" ) ;
-  return GLU_FAILURE ;
-}
-
-#endif
-
 //will write our A field with cuts takes in our ( hopefully ) gauge-fixed links
 int 
 cuts_spatial ( struct site *__restrict A ,
@@ -19,13 +19,16 @@
 /**
    @file config_gluons.c
    @brief code to compute the configuration space gluonic correlation functions
+
+   The correlators are built from time-slice sums of the fields, define
+   CONFIGSPACE_DIRECT for the explicit source-sink loops to check them against
  */
 #include "Mainfile.h"
 
 #include "cut_output.h"   // output file
 #include "cut_routines.h" // momentum cutting?
 #include "geometry.h"     // general lexi site
-#include "plan_ffts.h"    // config space correlator is convolution
+#include "GLU_malloc.h"   // allocate_s_site()
 #include "SM_wrap.h"      // do we want some smearing?
 
 /**
@@ -91,99 +94,92 @@ check_landau_condition( const struct site *__restrict A )
   return ;
 }
 
-#ifdef HAVE_FFTW3_H
+#ifndef CONFIGSPACE_DIRECT
 
-// 
-static int
-spatial_correlator( struct site *__restrict A ,
-		    double *gsp ,
-		    const double gsnorm ,
-		    const size_t spacing )
+// sum of A_mu over the sources ( on the grid of "spacing" ) and over
+// the whole of each time slice
+static void
+slice_sums( struct s_site *__restrict src ,
+	    struct s_site *__restrict snk ,
+	    size_t *nsrc ,
+	    const struct site *__restrict A ,
+	    const size_t spacing )
 {
-  if( spacing > Latt.dims[ND-1] ) { return GLU_FAILURE ; }
-
-  // FFTW routines
-  struct fftw_small_stuff FFTW ;
-  small_create_plans_DFT( &FFTW , Latt.dims , ND ) ;
-
-  //forward transform
-  size_t mu , i , j ;
-  for( mu = 0 ; mu < ND ; mu++ ) {
-    for( j = 0 ; j < NCNC ; j++ ) {
-      // FORWARD ONE
-      #ifdef CUT_FORWARD
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	FFTW.in[i] = A[i].O[mu][j] ;
-      }
-      fftw_execute( FFTW.forward ) ;
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	A[i].O[mu][j] = FFTW.out[i] ;
-      }
-      #else
-      // BACKWARD TRANSFORM
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	FFTW.out[i] = A[i].O[mu][j] ;
+  size_t t ;
+#pragma omp parallel for private(t)
+  for( t = 0 ; t < LT ; t++ ) {
+    size_t i , mu , j ;
+    for( mu = 0 ; mu < ND-1 ; mu++ ) {
+      zero_mat( src[t].O[mu] ) ;
+      zero_mat( snk[t].O[mu] ) ;
+    }
+    size_t n = 0 ;
+    for( i = 0 ; i < LCU ; i++ ) {
+      const size_t x = i + LCU * t ;
+      int vec[ ND ] ;
+      get_mom_2piBZ( vec , i , ND-1 ) ;
+      GLU_bool on_grid = GLU_TRUE ;
+      for( mu = 0 ; mu < ND-1 ; mu++ ) {
+	if( vec[ mu ] % spacing != 0 ) on_grid = GLU_FALSE ;
       }
-      fftw_execute( FFTW.backward ) ;
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	A[i].O[mu][j] = FFTW.in[i] ;
+      for( mu = 0 ; mu < ND-1 ; mu++ ) {
+	for( j = 0 ; j < NCNC ; j++ ) {
+	  snk[t].O[mu][j] += A[x].O[mu][j] ;
+	}
+	if( on_grid == GLU_FALSE ) continue ;
+	for( j = 0 ; j < NCNC ; j++ ) {
+	  src[t].O[mu][j] += A[x].O[mu][j] ;
+	}
       }
-      #endif
+      if( on_grid == GLU_TRUE ) n++ ;
     }
+    if( t == 0 ) *nsrc = n ;
   }
+  return ;
+}
 
-  // compute the convolution in momentum space
-#pragma omp parallel for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    GLU_complex tr , sum = 0.0 ;
-    #ifdef CUT_FORWARD
-    FFTW.out[i] = 0 ;
-    #else
-    FFTW.in[i] = 0 ;
-    #endif
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      trace_ab_dag( &tr , A[i].O[mu] , A[i].O[mu] ) ;
-      sum += tr ; 
-    }
-    #ifdef CUT_FORWARD
-    FFTW.out[i] = sum ;
-    #else
-    FFTW.in[i] = sum ;
-    #endif
-  }
+// the sink is summed over the whole slice so the sum over sources of
+// Tr( A_\mu(x) A_\mu(y) ) only needs the slice sums of A_\mu, this is
+// O( V + LT^2 ) rather than the O( LT^2 LCU^2 ) of the direct method
+static int
+spatial_correlator( const struct site *__restrict A ,
+		    double *__restrict gs ,
+		    const size_t spacing )
+{
+  if( spacing == 0 ) { return GLU_FAILURE ; }
 
-  // fft back into config space
-#ifdef CUT_FORWARD
-  fftw_execute( FFTW.backward ) ;
-#else
-  fftw_execute( FFTW.forward ) ;
-#endif
+  struct s_site *src = NULL , *snk = NULL ;
+  int FLAG = GLU_FAILURE ;
+  if( ( src = allocate_s_site( LT , ND-1 , NCNC ) ) == NULL ||
+      ( snk = allocate_s_site( LT , ND-1 , NCNC ) ) == NULL ) {
+    fprintf( stderr , "[CUTS] slice sum allocation failure\n" ) ;
+    goto memfree ;
+  }
+  size_t nsrc = 0 , t ;
+  slice_sums( src , snk , &nsrc , A , spacing ) ;
 
-  // compute the sum
-  size_t t ;
-#pragma omp parallel for private(i)
-  for( t = 0 ; t < Latt.dims[ND-1] ; t++ ) {
-    #ifdef CUT_FORWARD
-    GLU_complex *p = FFTW.in + LCU * t ;
-    #else
-    GLU_complex *p = FFTW.out + LCU * t ;
-    #endif
-    register double sum = 0 ;
-    for( i = 0 ; i < LCU ; i++ ) {
-      sum += creal( *p ) ;
-      p++ ;
+#pragma omp parallel for private(t)
+  for( t = 0 ; t < LT ; t++ ) {
+    register double loc_tr = 0.0 ;
+    GLU_real tr ;
+    size_t tau , mu ;
+    for( tau = 0 ; tau < LT ; tau++ ) {
+      const size_t tsnk = ( tau + t ) % LT ;
+      for( mu = 0 ; mu < ND-1 ; mu++ ) {
+	trace_ab_herm( &tr , src[tau].O[mu] , snk[tsnk].O[mu] ) ;
+	loc_tr += (double)tr ;
+      }
     }
-    gsp[ t ] = sum * gsnorm ;
+    gs[t] = loc_tr * 2.0 / ( (double)nsrc * LCU * LT ) ;
   }
 
-  // free the FFTs
-  small_clean_up_fftw( FFTW ) ;
+  FLAG = GLU_SUCCESS ;
 
-  return GLU_SUCCESS ;
+ memfree :
+  free_s_site( src , LT , ND-1 , NCNC ) ;
+  free_s_site( snk , LT , ND-1 , NCNC ) ;
+
+  return FLAG ;
 }
 
 #else
@@ -252,8 +248,7 @@ recurse_sum( const struct site *__restrict A ,
 /////////// spatial-spatial point sources over the whole lattice  ////////
 static int
 spatial_pointsource( const struct site *__restrict A ,
-		     double *__restrict gs ,
-		     const double gsnorm )
+		     double *__restrict gs )
 {
   // loop time 
   size_t t ;
@@ -306,12 +301,12 @@ spatial_pointsource( const struct site *__restrict A ,
 static int
 spatial_correlator( const struct site *__restrict A ,
 		    double *__restrict gs ,
-		    const double gsnorm ,
 		    const size_t spacing )
 {
+  if( spacing == 0 ) { return GLU_FAILURE ; }
   // this one is more effective
   if( spacing == 1 ) {
-    return spatial_pointsource( A , gs , gsnorm ) ;
+    return spatial_pointsource( A , gs ) ;
   }
   // this one is more general
   size_t t ;
@@ -365,18 +360,14 @@ cuts_struct_configspace( struct site *__restrict A ,
   // compute the temporal and spatial correlators
   double *gsp = malloc( Latt.dims[ ND-1 ] * sizeof( double ) ) ;
 
-  // normalisations :: LVOLUME is the FFT norm
-  const double spat_norm = 1.0 / ( ( ND-1 ) * LCU * LVOLUME ) ;
-
   // flag whether it worked or not
   int FLAG = GLU_FAILURE ;
 
   // timeslice length
   size_t lt[ 1 ] = { LT } ;
 
-  // spatial correlator from the convolution in momentum space
-  if( spatial_correlator( A , gsp , spat_norm , 
-			  CUTINFO.max_t ) == GLU_FAILURE ) {
+  // spatial correlator summed over sources spaced by MAX_T
+  if( spatial_correlator( A , gsp , CUTINFO.max_t ) == GLU_FAILURE ) {
     goto memfree ;
   }
 
@@ -484,11 +484,11 @@ get_veclist( struct veclist *__restrict kept ,
 }
 
 // Computes the momentum list
-struct veclist*
-compute_veclist( size_t *__restrict list_size , 
-		 const struct cut_info CUTINFO ,
-		 const size_t DIMS ,
-		 const GLU_bool CONFIGSPACE )
+static struct veclist*
+build_veclist( size_t *__restrict list_size , 
+	       const struct cut_info CUTINFO ,
+	       const size_t DIMS ,
+	       const GLU_bool CONFIGSPACE )
 {
   size_t in[1] = { 1 } ;
   struct veclist *list = NULL ;
@@ -637,6 +637,115 @@ compute_veclist( size_t *__restrict list_size ,
   return list ;
 }
 
+// how many momentum lists we keep resident in batch mode
+#define NLISTS 8
+
+// lists kept between configurations, keyed like the files in Local/Moments
+static struct {
+  struct veclist *list ;
+  size_t size ;
+  size_t dims[ ND ] ;
+  size_t DIMS ;
+  GLU_bool CONFIGSPACE ;
+  momentum_cut_def type ;
+  size_t max_mom ;
+  size_t angle ;
+  double cyl_width ;
+} kept_lists[ NLISTS ] ;
+
+static size_t Nkept = 0 ;
+static GLU_bool keep_lists = GLU_FALSE ;
+
+// is this the list we want?
+static GLU_bool
+same_list( const size_t n ,
+	   const struct cut_info CUTINFO ,
+	   const size_t DIMS ,
+	   const GLU_bool CONFIGSPACE )
+{
+  if( kept_lists[n].DIMS != DIMS || 
+      kept_lists[n].CONFIGSPACE != CONFIGSPACE ||
+      kept_lists[n].type != CUTINFO.type ||
+      kept_lists[n].max_mom != CUTINFO.max_mom ||
+      kept_lists[n].angle != CUTINFO.angle ||
+      kept_lists[n].cyl_width != CUTINFO.cyl_width ) {
+    return GLU_FALSE ;
+  }
+  size_t mu ;
+  for( mu = 0 ; mu < DIMS ; mu++ ) {
+    if( kept_lists[n].dims[mu] != Latt.dims[mu] ) return GLU_FALSE ;
+  }
+  return GLU_TRUE ;
+}
+
+// hands out a copy the caller is free to free
+static struct veclist*
+copy_veclist( const struct veclist *list ,
+	      const size_t size )
+{
+  struct veclist *cp = malloc( size * sizeof( struct veclist ) ) ;
+  if( cp != NULL ) {
+    memcpy( cp , list , size * sizeof( struct veclist ) ) ;
+  }
+  return cp ;
+}
+
+// Computes the momentum list, or copies a resident one
+struct veclist*
+compute_veclist( size_t *__restrict list_size , 
+		 const struct cut_info CUTINFO ,
+		 const size_t DIMS ,
+		 const GLU_bool CONFIGSPACE )
+{
+  size_t n ;
+  for( n = 0 ; n < Nkept ; n++ ) {
+    if( same_list( n , CUTINFO , DIMS , CONFIGSPACE ) == GLU_TRUE ) {
+      *list_size = kept_lists[n].size ;
+      return copy_veclist( kept_lists[n].list , kept_lists[n].size ) ;
+    }
+  }
+  struct veclist *list = build_veclist( list_size , CUTINFO , 
+					DIMS , CONFIGSPACE ) ;
+  if( keep_lists == GLU_TRUE && list != NULL && Nkept < NLISTS ) {
+    if( ( kept_lists[ Nkept ].list = copy_veclist( list , *list_size ) ) 
+	!= NULL ) {
+      kept_lists[ Nkept ].size = *list_size ;
+      memcpy( kept_lists[ Nkept ].dims , Latt.dims , ND * sizeof( size_t ) ) ;
+      kept_lists[ Nkept ].DIMS = DIMS ;
+      kept_lists[ Nkept ].CONFIGSPACE = CONFIGSPACE ;
+      kept_lists[ Nkept ].type = CUTINFO.type ;
+      kept_lists[ Nkept ].max_mom = CUTINFO.max_mom ;
+      kept_lists[ Nkept ].angle = CUTINFO.angle ;
+      kept_lists[ Nkept ].cyl_width = CUTINFO.cyl_width ;
+      Nkept++ ;
+    }
+  }
+  return list ;
+}
+
+// keep the momentum lists between configurations
+void
+keep_veclists( void )
+{
+  keep_lists = GLU_TRUE ;
+  return ;
+}
+
+// free the resident lists
+void
+release_veclists( void )
+{
+  size_t n ;
+  for( n = 0 ; n < Nkept ; n++ ) {
+    free( kept_lists[n].list ) ;
+  }
+  Nkept = 0 ;
+  keep_lists = GLU_FALSE ;
+  return ;
+}
+
+#undef NLISTS
+
 #ifdef CYLINDER_AS
   #undef CYLINDER_AS
 #endif
@@ -27,88 +27,9 @@
 #include "glueprop.h"      // gluon propagator calculation
 #include "MOMgg.h"         // exceptional (BOUCAUD,CHETYRKIN et al)
 #include "MOMggg.h"        // non-exceptional scheme
-#include "plan_ffts.h"     // FFTW planning wrappers
+#include "mom_gauge.h"     // lie fields and their FFT
 #include "pspace_landau.h" // momentum space Landau correction
 
-#ifdef HAVE_FFTW3_H
-
-static int
-mom_gauge( struct site *__restrict A ,
-	   const lie_field_def def )
-{
-  // callback for the log definition
-  void (*log)( GLU_complex Q[ NCNC ] ,
-	       const GLU_complex U[ NCNC ] ) = Hermitian_proj ;
-  switch( def ) {
-  case LINEAR_DEF :
-    break ;
-  case LOG_DEF : 
-    log = exact_log_slow ; 
-    break ;
-  }
-
-  size_t i ;
-  #pragma omp parallel for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) { 
-    GLU_complex temp[ NCNC ] GLUalign ;
-    size_t mu ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      log( temp , A[i].O[mu] ) ;
-      equiv( A[i].O[mu] , temp ) ;
-    }
-  }
-
-  // FFTW routines
-  struct fftw_small_stuff FFTW ;
-  small_create_plans_DFT( &FFTW , Latt.dims , ND ) ;
-  
-  //forward transform
-  size_t mu , j ;
-  for( mu = 0 ; mu < ND ; mu++ ) {
-    for( j = 0 ; j < NCNC ; j++ ) {
-      // FORWARD ONE
-      #ifdef CUT_FORWARD
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	FFTW.in[i] = A[i].O[mu][j] ;
-      }
-      fftw_execute( FFTW.forward ) ;
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	A[i].O[mu][j] = FFTW.out[i] ;
-      }
-      #else
-      // BACKWARD TRANSFORM
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	FFTW.out[i] = A[i].O[mu][j] ;
-      }
-      fftw_execute( FFTW.backward ) ;
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	A[i].O[mu][j] = FFTW.in[i] ;
-      }
-      #endif
-    }
-  }
-  //et voila! we have our fourier-transformed links in 0-2Pi BZ
-  small_clean_up_fftw( FFTW ) ;
-
-  return GLU_SUCCESS ;
-}
-
-#else
-
-static int
-mom_gauge( struct site *__restrict A ,
-	   const lie_field_def def )
-{
-  fprintf( stderr , "[CUTS] WARNING! No FFT taking place\n" ) ;
-  return GLU_FAILURE ;
-}
-
-#endif
-
 //will write our A field with cuts takes in our (hopefully) gauge-fixed links
 int 
 cuts_struct( struct site *__restrict A ,
@@ -0,0 +1,202 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (mom_gauge.c) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file mom_gauge.c
+   @brief lie fields from the links and their fourier transform
+
+   Per direction the #TRUE_HERM independent entries of the hermitian
+   field are packed field-major into one buffer and transformed by a
+   single batched FFT. The lower triangle follows from
+   A_{ji}(p) = A_{ij}(-p)^* and the last diagonal from tracelessness.
+   For SU(3) the two real diagonal entries share one complex field
+   as A_{00} + i A_{11}
+ */
+#include "Mainfile.h"
+
+#include "geometry.h"  // get_mom_2piBZ()
+#include "mom_gauge.h" // alphabetising
+#include "plan_ffts.h" // many_create_plans_DFT(), many_execute_DFT()
+
+#ifdef HAVE_FFTW3_H
+
+// site at -p, reflecting only the first DIR directions
+static size_t
+mirror_site( const size_t i ,
+	     const size_t DIR )
+{
+  int x[ ND ] ;
+  size_t mu ;
+  get_mom_2piBZ( x , i , ND ) ;
+  for( mu = 0 ; mu < DIR ; mu++ ) {
+    x[ mu ] = ( Latt.dims[ mu ] - x[ mu ] ) % Latt.dims[ mu ] ;
+  }
+  return gen_site( x ) ;
+}
+
+// pack the independent entries of hermitian Q at site i
+static inline void
+pack_lie( GLU_complex *buf ,
+	  const size_t i ,
+	  const GLU_complex Q[ NCNC ] )
+{
+#if NC == 3
+  buf[ i ] = creal( Q[0] ) + I * creal( Q[4] ) ;
+  buf[ i + LVOLUME ] = Q[1] ;
+  buf[ i + 2*LVOLUME ] = Q[2] ;
+  buf[ i + 3*LVOLUME ] = Q[5] ;
+#else
+  size_t a , b , idx = 0 ;
+  for( a = 0 ; a < NC-1 ; a++ ) {
+    for( b = a ; b < NC ; b++ ) {
+      buf[ i + idx*LVOLUME ] = ( a == b ) ? creal( Q[ b + a*NC ] ) :	\
+	Q[ b + a*NC ] ;
+      idx++ ;
+    }
+  }
+#endif
+  return ;
+}
+
+// rebuild the full transformed matrix at p from the fields at p and -p
+static inline void
+rebuild_lie( GLU_complex Q[ NCNC ] ,
+	     const GLU_complex *buf ,
+	     const size_t i ,
+	     const size_t m )
+{
+#if NC == 3
+  const GLU_complex F = buf[ i ] , Fm = conj( buf[ m ] ) ;
+  Q[0] = 0.5 * ( F + Fm ) ;
+  Q[4] = -0.5 * I * ( F - Fm ) ;
+  Q[8] = -Q[0] - Q[4] ;
+  Q[1] = buf[ i + LVOLUME ] ;
+  Q[3] = conj( buf[ m + LVOLUME ] ) ;
+  Q[2] = buf[ i + 2*LVOLUME ] ;
+  Q[6] = conj( buf[ m + 2*LVOLUME ] ) ;
+  Q[5] = buf[ i + 3*LVOLUME ] ;
+  Q[7] = conj( buf[ m + 3*LVOLUME ] ) ;
+#else
+  GLU_complex tr = 0.0 ;
+  size_t a , b , idx = 0 ;
+  for( a = 0 ; a < NC-1 ; a++ ) {
+    for( b = a ; b < NC ; b++ ) {
+      Q[ b + a*NC ] = buf[ i + idx*LVOLUME ] ;
+      if( a == b ) {
+	tr += Q[ b + a*NC ] ;
+      } else {
+	Q[ a + b*NC ] = conj( buf[ m + idx*LVOLUME ] ) ;
+      }
+      idx++ ;
+    }
+  }
+  Q[ NCNC-1 ] = -tr ;
+#endif
+  return ;
+}
+
+// log and FFT of A over the first DIR dimensions, overwrites A
+static int
+lie_fft( struct site *__restrict A ,
+	 const lie_field_def def ,
+	 const size_t DIR )
+{
+  // callback for the log definition
+  void (*log)( GLU_complex Q[ NCNC ] ,
+	       const GLU_complex U[ NCNC ] ) = Hermitian_proj ;
+  switch( def ) {
+  case LINEAR_DEF :
+    break ;
+  case LOG_DEF : 
+    log = exact_log_slow ; 
+    break ;
+  }
+
+  // one transform per independent entry and per slice for DIR < ND
+  size_t VOL = 1 , mu ;
+  for( mu = 0 ; mu < DIR ; mu++ ) {
+    VOL *= Latt.dims[ mu ] ;
+  }
+  const size_t Nfields = TRUE_HERM * ( LVOLUME / VOL ) ;
+  struct fftw_small_stuff FFTW ;
+  many_create_plans_DFT( &FFTW , Latt.dims , DIR , Nfields ) ;
+  if( FFTW.in == NULL ) {
+    fprintf( stderr , "[CUTS] FFT buffer allocation failure\n" ) ;
+    return GLU_FAILURE ;
+  }
+
+  for( mu = 0 ; mu < ND ; mu++ ) {
+    size_t i ;
+    #pragma omp parallel for private(i)
+    for( i = 0 ; i < LVOLUME ; i++ ) {
+      GLU_complex temp[ NCNC ] GLUalign ;
+      log( temp , A[i].O[mu] ) ;
+      pack_lie( FFTW.in , i , temp ) ;
+    }
+    #ifdef CUT_FORWARD
+    many_execute_DFT( FFTW.forward , FFTW.in , VOL , Nfields ) ;
+    #else
+    many_execute_DFT( FFTW.backward , FFTW.in , VOL , Nfields ) ;
+    #endif
+    #pragma omp parallel for private(i)
+    for( i = 0 ; i < LVOLUME ; i++ ) {
+      rebuild_lie( A[i].O[mu] , FFTW.in , i , mirror_site( i , DIR ) ) ;
+    }
+  }
+
+  // et voila! we have our fourier-transformed links in 0-2Pi BZ
+  small_clean_up_fftw( FFTW ) ;
+
+  return GLU_SUCCESS ;
+}
+
+// 4D transform
+int
+mom_gauge( struct site *__restrict A ,
+	   const lie_field_def def )
+{
+  return lie_fft( A , def , ND ) ;
+}
+
+// transform each time-slice
+int
+mom_gauge_spatial( struct site *__restrict A ,
+		   const lie_field_def def )
+{
+  return lie_fft( A , def , ND - 1 ) ;
+}
+
+#else
+
+int
+mom_gauge( struct site *__restrict A ,
+	   const lie_field_def def )
+{
+  fprintf( stderr , "[CUTS] WARNING! No FFT taking place\n" ) ;
+  return GLU_FAILURE ;
+}
+
+int
+mom_gauge_spatial( struct site *__restrict A ,
+		   const lie_field_def def )
+{
+  fprintf( stderr , "[CUTS] WARNING! No FFT of the fields \n" ) ;
+  return GLU_FAILURE ;
+}
+
+#endif
@@ -28,8 +28,7 @@
 #include "cut_routines.h"  // momentum cuts
 #include "cut_output.h"    // output file
 #include "geometry.h"      // general geometry for the p-calcs
-#include "init.h"          // init_navig()
-#include "plan_ffts.h"     // FFTW plan wrappers
+#include "mom_gauge.h"     // lie fields and their FFT
 #include "plaqs_links.h"   // plaquettes and links calculations
 #include "pspace_landau.h" // momentum space Landau correction
 #include "SM_wrap.h"       // smearing operations wrapper
@@ -37,87 +36,6 @@
 //#define WEAK_FIELD
 //#define TADPOLE_IMPROVE
 
-#ifdef HAVE_FFTW3_H
-
-//def = 0 "lin" def = 1 "log"
-static int
-mom_gauge( struct site *__restrict A ,
-	   const lie_field_def def )
-{
-  // callback for the log definition
-  void (*log)( GLU_complex Q[ NCNC ] ,
-	       const GLU_complex U[ NCNC ] ) = Hermitian_proj ;
-  switch( def ) {
-  case LINEAR_DEF :
-    break ;
-  case LOG_DEF : 
-    log = exact_log_slow ; 
-    break ;
-  }
-
-  size_t i ;
-#pragma omp parallel for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) { 
-    GLU_complex temp[ NCNC ] GLUalign ;
-    size_t mu ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      log( temp , A[i].O[mu] ) ;
-      equiv( A[i].O[mu] , temp ) ;
-    }
-  }
-  
-  /// FFTW routines
-  struct fftw_small_stuff FFTW ;
-  small_create_plans_DFT( &FFTW , Latt.dims , ND ) ;
-
-  // do the FFTs
-  size_t mu , j ;
-  for( mu = 0 ; mu < ND ; mu++ ) {
-    for( j = 0 ; j < NCNC ; j++ ) {
-      // forwards transform
-      #ifdef CUT_FORWARD
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	FFTW.in[i] = A[i].O[mu][j] ;
-      }
-      fftw_execute( FFTW.forward ) ;
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	A[i].O[mu][j] = FFTW.out[i] ;
-      }
-      #else
-      // backwards transform
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	FFTW.out[i] = A[i].O[mu][j] ;
-      }
-      fftw_execute( FFTW.backward ) ;
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	A[i].O[mu][j] = FFTW.in[i] ;
-      }
-      #endif
-    }
-  }
-
-  //et voila! we have our fourier-transformed links in 0-2Pi BZ
-  small_clean_up_fftw( FFTW ) ;
-
-  return GLU_SUCCESS ;
-}
-
-#else
-
-static int
-mom_gauge( struct site *__restrict A ,
-	   const lie_field_def def )
-{
-  fprintf( stderr , "[CUTS] WARNING! Not performing an FFT\n" ) ;
-  return GLU_FAILURE ;
-}
-
-#endif
-
 // compute psq using the momentum lattice coordinates
 static inline double
 psq_calc( double mom[ ND ] ,
@@ -212,19 +130,18 @@ cuts_struct_smeared( struct site *__restrict A ,
   }
 
   // allocate room for the smeared gauge field
-  struct site *SM_A = malloc( LVOLUME * sizeof ( struct site ) ) ;
-  init_navig( SM_A ) ;
+  struct site *SM_A = allocate_lat( ) ;
+  if( SM_A == NULL ) {
+    fprintf( stderr , "[CUTS] smeared field allocation failure\n" ) ;
+    return GLU_FAILURE ;
+  }
 
   // dirty, create a very weak field
 #ifdef WEAK_FIELD
   create_weak_field( A ) ;
 #endif
 
-  size_t j ; 
-#pragma omp parallel for private(j)
-  for( j = 0 ; j < LVOLUME ; j++ ) {
-    memcpy( &SM_A[j] , &A[j] , sizeof( struct site ) ) ; 
-  }
+  copy_lat( SM_A , A ) ;
   SM_wrap_struct( SM_A , SMINFO ) ;
 
 #ifdef TADPOLE_IMPROVE
@@ -299,7 +216,7 @@ cuts_struct_smeared( struct site *__restrict A ,
   free( (void*)list ) ;
   free( in ) ;
   free( str ) ;
-  free( SM_A ) ;
+  free_lat( SM_A ) ;
 
   return GLU_SUCCESS ;
 }
@@ -33,6 +33,24 @@
 #include "plan_ffts.h"    // convolution
 #include "SM_wrap.h"      // for the smearing wrapper
 
+// multiply line by the "len" links along dir starting with the one at
+// "site", returns the site after the last link so that the line can be
+// extended further later on
+static size_t
+extend_line( GLU_complex line[ NCNC ] ,
+	     const struct site *lat ,
+	     size_t site ,
+	     const size_t dir ,
+	     const size_t len )
+{
+  size_t t ;
+  for( t = 0 ; t < len ; t++ ) {
+    multab_atomic_right( line , lat[site].O[dir] ) ;
+    site = site_fwd( site , dir ) ;
+  }
+  return site ;
+}
+
 // compute a short polyakov line
 static void
 small_poly( GLU_complex poly[ NCNC ] ,
@@ -42,11 +60,23 @@ small_poly( GLU_complex poly[ NCNC ] ,
 	    const size_t length )
 {
   equiv( poly , lat[site].O[dir] ) ;
-  // poly loop calculation ...
-  size_t next = site , t ; 
-  for( t = 1 ; t < length ; t++ ) {
-    next = lat[next].neighbor[dir] ; 
-    multab_atomic_right( poly , lat[next].O[dir] ) ;
+  extend_line( poly , lat , site_fwd( site , dir ) , dir , length - 1 ) ;
+  return ;
+}
+
+// temporal lines starting on slice t0 are kept a time-slice at a time,
+// extends every line of the slab from length len to len+1
+static void
+extend_slab( GLU_complex *lines ,
+	     const struct site *lat ,
+	     const size_t t0 ,
+	     const size_t len )
+{
+  const size_t front = LCU * ( ( t0 + len ) % Latt.dims[ ND-1 ] ) ;
+  size_t k ;
+  #pragma omp parallel for private(k)
+  for( k = 0 ; k < LCU ; k++ ) {
+    extend_line( lines + k * NCNC , lat , front + k , ND-1 , 1 ) ;
   }
   return ;
 }
@@ -110,198 +140,208 @@ poly_th( double *red ,
   }
 }
 
+
 // If we have FFTW we use it for the convolutions instead of our slow
 // method, which is slow but equivalent
 #ifdef HAVE_FFTW3_H
 
-// trace-trace computation is nice and easy
+// correlators are accumulated in momentum space, one per spatial momentum
+static size_t
+correlator_length( void )
+{
+  return LCU ;
+}
+
+// plan the batched forward transform of the colour components of a slab
+// and a single field for the backward, these live for the whole measurement
+static int
+init_correlator( struct fftw_small_stuff *many ,
+		 struct fftw_small_stuff *single )
+{
+  many_create_plans_DFT( many , Latt.dims , ND-1 , NCNC ) ;
+  small_create_plans_DFT( single , Latt.dims , ND-1 ) ;
+  if( many -> in == NULL || single -> in == NULL || single -> out == NULL ) {
+    fprintf( stderr , "[STATIC-POTENTIAL] FFT buffer allocation failure\n" ) ;
+    return GLU_FAILURE ;
+  }
+  return GLU_SUCCESS ;
+}
+
+// and free them
 static void
-compute_trtr( double complex *trtr ,      
-	      struct fftw_small_stuff *FFTW ,
-	      const GLU_complex **poly ,
-	      const struct veclist *list ,
-	      const size_t rsq_count ,
-	      const size_t t )
+free_correlator( struct fftw_small_stuff many ,
+		 struct fftw_small_stuff single )
+{
+  small_clean_up_fftw( single ) ;
+  small_clean_up_fftw( many ) ;
+  return ;
+}
+
+// backward transform of single.out, read off the separations in the list
+static void
+backward_list( double complex *corr ,
+	       struct fftw_small_stuff *single ,
+	       const struct veclist *list ,
+	       const size_t rsq_count ,
+	       const double NORM )
 {
   size_t i ;
-  #pragma omp parallel for private(i)
-  for( i = 0 ; i < LCU ; i++ ) {
-    FFTW -> in[ i ] = trace( poly[ i + LCU*t ] ) ;
-  }
-  // FFT
-  fftw_execute( FFTW -> forward ) ;
-  // convolve
-  #pragma omp parallel for private(i)
-  for( i = 0 ; i < LCU ; i++ ) {
-    FFTW -> out[i] *= conj( FFTW -> out[i] ) ;
-  }
-  // FFT
-  fftw_execute( FFTW -> backward ) ;
-  // and set the trace-trace
+  fftw_execute( single -> backward ) ;
   #pragma omp parallel for private(i)
   for( i = 0 ; i < rsq_count ; i++ ) {
-    trtr[ i ] += FFTW -> in[ list[i].idx ] ;
+    corr[ i ] = single -> in[ list[ i ].idx ] * NORM ;
   }
   return ;
 }
 
-// traced computation is hard, I want to do the computation in momentum space
-// but cannot overwrite poly?
+// add the traced and trace-trace products of a slab of lines into tr and
+// trtr, field j of many is colour component j of the slab
 static void
-compute_tr( double complex *tr ,      
-	    struct fftw_small_stuff *FFTW ,
-	    GLU_complex **slice_poly ,
-	    const GLU_complex **poly ,
-	    const struct veclist *list ,
-	    const size_t rsq_count ,
-	    const size_t t )
+accumulate_correlator( double complex *tr ,
+		       double complex *trtr ,
+		       struct fftw_small_stuff *many ,
+		       const GLU_complex *lines ,
+		       const struct veclist *list ,
+		       const size_t rsq_count )
 {
-  // index by index FFTs into a temporary
   size_t i ;
-#pragma omp parallel for private(i)
+  #pragma omp parallel for private(i)
   for( i = 0 ; i < LCU ; i++ ) {
-    equiv( slice_poly[ i ] , poly[ i + LCU * t ] ) ; 
-  }
-  // FFT all indices
-  size_t j ;
-  for( j = 0 ; j < NCNC ; j++ ) {
-    // set in 
-    #pragma omp parallel for private(i)
-    for( i = 0 ; i < LCU ; i++ ) {
-      FFTW -> in[ i ] = slice_poly[ i ][ j ] ;
-    }
-    fftw_execute( FFTW -> forward ) ;
-    // store the result in slice_poly again
-    #pragma omp parallel for private(i)
-    for( i = 0 ; i < LCU ; i++ ) {
-      slice_poly[ i ][ j ] = FFTW -> out[ i ] ;
+    size_t j ;
+    for( j = 0 ; j < NCNC ; j++ ) {
+      many -> in[ i + j * LCU ] = lines[ j + i * NCNC ] ;
     }
   }
-  // now we can contract
+  many_execute_DFT( many -> forward , many -> in , LCU , NCNC ) ;
+
+  // the trace is linear so its transform is the sum of the diagonal ones
   #pragma omp parallel for private(i)
   for( i = 0 ; i < LCU ; i++ ) {
-    trace_ab_dag( &FFTW -> out[ i ] , slice_poly[ i ] , slice_poly[ i ] ) ;
-  }
-  fftw_execute( FFTW -> backward ) ;
-  // and set tr
-  #pragma omp parallel for private(i)
-  for( i = 0 ; i < rsq_count ; i++ ) {
-    tr[ i ] += FFTW -> in[ list[ i ].idx ] ;
+    GLU_complex F[ NCNC ] , res ;
+    size_t j ;
+    for( j = 0 ; j < NCNC ; j++ ) {
+      F[ j ] = many -> in[ i + j * LCU ] ;
+    }
+    trace_ab_dag( &res , F , F ) ;
+    tr[ i ] += res ;
+    res = trace( F ) ;
+    trtr[ i ] += res * conj( res ) ;
   }
   return ;
 }
 
-/// correlator
-static int
-static_quark_correlator( double complex *result ,
-			 double complex *trtr ,
-			 const GLU_complex **poly ,
-			 const struct veclist *list ,
-			 const size_t rsq_count )
-
+// transform the accumulated correlators back to the separations in list
+static void
+finish_correlator( double complex *result ,
+		   double complex *trtr ,
+		   const double complex *acc_tr ,
+		   const double complex *acc_trtr ,
+		   struct fftw_small_stuff *single ,
+		   const struct veclist *list ,
+		   const size_t rsq_count )
 {
-  GLU_complex **slice_poly = NULL ;
-  if( GLU_malloc( (void**)&slice_poly , 16 , LCU * sizeof( GLU_complex* ) ) 
-      != 0 ) {
-    return GLU_FAILURE ;
-  }
+  // LCU is the norm from the FFTs
+  const double NORM = 1.0 / ( (double)LCU * Latt.dims[ ND-1 ] ) ;
   size_t i ;
   #pragma omp parallel for private(i)
   for( i = 0 ; i < LCU ; i++ ) {
-    GLU_malloc( (void**)&slice_poly[i] , 16 , NCNC * sizeof( GLU_complex ) ) ;
-  }
-
-  // FFTW routines
-  struct fftw_small_stuff FFTW ;
-  small_create_plans_DFT( &FFTW , Latt.dims , ND-1 ) ;
-
-  size_t t ;
-  for( t = 0 ; t < Latt.dims[ ND - 1 ] ; t++ ) {
-    // compute the tr tr combination
-    compute_trtr( trtr , &FFTW , poly , list , rsq_count , t ) ;
-
-    // compute the traced
-    compute_tr( result , &FFTW , slice_poly , poly , list , rsq_count , t ) ;
+    single -> out[ i ] = acc_trtr[ i ] ;
   }
-
-  // and normalise, LCU is the norm from the FFTs
-  const double NORM = 1.0 / ( (double)LCU * Latt.dims[ ND-1 ] ) ;
+  backward_list( trtr , single , list , rsq_count , NORM ) ;
 
   #pragma omp parallel for private(i)
-  for( i = 0 ; i < rsq_count ; i++ ) {
-    result[ i ] *= NORM ;
-    trtr[ i ] *= NORM ;
-  }
-
-  // free the FFTs
-  small_clean_up_fftw( FFTW ) ;
-
-  // free the temporary polyakov loops
-#pragma omp parallel for private(i)
   for( i = 0 ; i < LCU ; i++ ) {
-    free( slice_poly[ i ] ) ;
+    single -> out[ i ] = acc_tr[ i ] ;
   }
-  free( slice_poly ) ;
-
-  return GLU_SUCCESS ;
+  backward_list( result , single , list , rsq_count , NORM ) ;
+  return ;
 }
 
 // NON-fftw version is pretty slow
 #else
 
-/// correlator
+// correlators are accumulated directly at the separations in the list
+static size_t
+correlator_length( const size_t rsq_count )
+{
+  return rsq_count ;
+}
+
+// nothing to plan
 static int
-static_quark_correlator( double complex *result ,
-			 double complex *trtr ,
-			 const GLU_complex **poly ,
-			 const struct veclist *list ,
-			 const size_t rsq_count )
+init_correlator( struct fftw_small_stuff *many ,
+		 struct fftw_small_stuff *single )
+{
+  return GLU_SUCCESS ;
+}
 
+// nothing to free
+static void
+free_correlator( struct fftw_small_stuff many ,
+		 struct fftw_small_stuff single )
+{
+  return ;
+}
+
+// add the traced and trace-trace products of a slab of lines into tr and
+// trtr for each separation in the list
+static void
+accumulate_correlator( double complex *tr ,
+		       double complex *trtr ,
+		       struct fftw_small_stuff *many ,
+		       const GLU_complex *lines ,
+		       const struct veclist *list ,
+		       const size_t rsq_count )
 {
-  const double NORM = 1.0 / (double)Latt.dims[ ND - 1 ] ;
   size_t i ;
-  // now we can loop the triplet computing the correlators ...
   #pragma omp parallel for private(i)
   for( i = 0 ; i < rsq_count ; i++ ) {
-
-    // COOL, can now contract these over the volume
     GLU_complex res ;
-    register double complex tr = 0.0 ;
+    register double complex sum = 0.0 ;
     register double complex tracetrace = 0.0 ;
 
     // the (positive) lattice vector for the separation
     int separation[ ND ] ;
     get_mom_2piBZ( separation , list[i].idx , ND-1 ) ;
 
-    // loop the lattice varying source and sink with the correct separation
-    size_t k = 0 ;
+    // loop the slab varying source and sink with the correct separation
+    size_t k ;
     for( k = 0 ; k < LCU ; k++ ) {
-      
       // translate the source from k by a vector separation
       const int translate = compute_spacing( separation , k , ND - 1 ) ;
-      
-      size_t t = 0 ;
-      for( t = 0 ; t < Latt.dims[ ND-1 ] ; t++ ) {
-	
-	// compute the source and sink for this time separation
-	const size_t source = k + LCU * t ;
-	const size_t sink   = translate + LCU * t ;
-	
-	// trace of the product
-	trace_ab_dag( &res , poly[source] , poly[sink] ) ;
-	tr += res ;
-	
-	// and the trace-trace
-	const GLU_complex tr1 = trace( poly[source] ) ;
-	const GLU_complex tr2 = trace( poly[sink] ) ;
-	tracetrace += tr1 * tr2 ;
-      }
+
+      // trace of the product
+      trace_ab_dag( &res , lines + k * NCNC , lines + translate * NCNC ) ;
+      sum += res ;
+
+      // and the trace-trace
+      const GLU_complex tr1 = trace( lines + k * NCNC ) ;
+      const GLU_complex tr2 = trace( lines + translate * NCNC ) ;
+      tracetrace += tr1 * tr2 ;
     }
-    result[i] = tr * NORM ;
-    trtr[i]   = tracetrace * NORM ;
+    tr[i]   += sum ;
+    trtr[i] += tracetrace ;
   }
+  return ;
+}
 
-  return GLU_SUCCESS ;
+// normalise by the number of starting slices
+static void
+finish_correlator( double complex *result ,
+		   double complex *trtr ,
+		   const double complex *acc_tr ,
+		   const double complex *acc_trtr ,
+		   struct fftw_small_stuff *single ,
+		   const struct veclist *list ,
+		   const size_t rsq_count )
+{
+  const double NORM = 1.0 / (double)Latt.dims[ ND - 1 ] ;
+  size_t i ;
+  for( i = 0 ; i < rsq_count ; i++ ) {
+    result[i] = acc_tr[i] * NORM ;
+    trtr[i]   = acc_trtr[i] * NORM ;
+  }
+  return ;
 }
 #endif
 
@@ -326,24 +366,43 @@ Coul_staticpot( struct site *lat ,
   // compute the ratios of the dimensions in terms of the smallest
   simorb_ratios( ND ) ;
 
-  // precompute the correlator
-  // compute all of the poly loops, lattice-wide
-  GLU_complex **poly = NULL ;
-  if( GLU_malloc( (void**)&poly , 16 , LVOLUME * sizeof( GLU_complex* ) ) != 0 ) {
+  // the lines are grown from one starting time-slice at a time so only
+  // a slab of LCU of them ever exists
+  GLU_complex *lines = NULL ;
+  if( GLU_malloc( (void**)&lines , ALIGNMENT , 
+		  LCU * NCNC * sizeof( GLU_complex ) ) != 0 ) {
     return GLU_FAILURE ;
   }
 
-  size_t i ;
-  #pragma omp parallel for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) { 
-    GLU_malloc( (void**)&poly[i] , 16 , NCNC * sizeof( GLU_complex ) ) ;
-    identity( poly[i] ) ;
+  // plan the transforms once for all T
+  struct fftw_small_stuff many , single ;
+  if( init_correlator( &many , &single ) == GLU_FAILURE ) {
+    free( lines ) ;
+    return GLU_FAILURE ;
   }
 
   // compute the momentum list
   size_t size[1] = { 0 } ;
   struct veclist *list = compute_veclist( size , CUTINFO , ND-1 , GLU_TRUE ) ;
 
+  // correlators for every T summed over the starting slices
+#ifdef HAVE_FFTW3_H
+  const size_t Ncorr = correlator_length( ) ;
+#else
+  const size_t Ncorr = correlator_length( size[0] ) ;
+#endif
+  double complex *acc_tr   = calloc( ( T - 1 ) * Ncorr + 1 , 
+				     sizeof( double complex ) ) ;
+  double complex *acc_trtr = calloc( ( T - 1 ) * Ncorr + 1 , 
+				     sizeof( double complex ) ) ;
+  if( acc_tr == NULL || acc_trtr == NULL ) {
+    fprintf( stderr , "[STATIC-POTENTIAL] accumulator allocation failure\n" ) ;
+    free( acc_tr ) ; free( acc_trtr ) ; free( list ) ;
+    free_correlator( many , single ) ;
+    free( lines ) ;
+    return GLU_FAILURE ;
+  }
+
   // set up the outputs
   const char *str = output_str_struct( CUTINFO ) ;  
   FILE *Ap = fopen( str , "wb" ) ;
@@ -362,34 +421,33 @@ Coul_staticpot( struct site *lat ,
   fwrite( Tcorrs , sizeof(uint32_t) , 1 , Ap ) ;
   if( !WORDS_BIGENDIAN ) { bswap_32( 1 , Tcorrs ) ; }  
 
+  // grow the lines out of each slice a link at a time, translation
+  // invariance in time means every slice contributes to every T
+  size_t i , t0 , t ;
+  for( t0 = 0 ; t0 < Latt.dims[ ND-1 ] ; t0++ ) {
+    #pragma omp parallel for private(i)
+    for( i = 0 ; i < LCU ; i++ ) { 
+      identity( lines + i * NCNC ) ;
+    }
+    for( t = 1 ; t < T ; t++ ) {
+      extend_slab( lines , lat , t0 , t - 1 ) ;
+      accumulate_correlator( acc_tr + ( t - 1 ) * Ncorr , 
+			     acc_trtr + ( t - 1 ) * Ncorr ,
+			     &many , lines , list , size[0] ) ;
+    }
+  }
+
   // allocate the results
   double complex *result = malloc( size[0] * sizeof( double complex ) ) ; 
   double complex *trtr   = malloc( size[0] * sizeof( double complex ) ) ; 
 
-  // precompute the polyakov loop
-  size_t t ;
   for( t = 1 ; t < T ; t++ ) {
 
-    // initialise results 
-    #pragma omp parallel
-    {
-      #pragma omp for private(i)
-      for( i = 0 ; i < size[0] ; i++ ) {
-	result[i] = trtr[i] = 0.0 ;
-      }
-
-      // atomically multiply link matrix at posit (i,t)
-      // into the array of matrices poly
-      #pragma omp for private(i)
-      for( i = 0 ; i < LVOLUME ; i++ ) { 
-	multab_atomic_right( poly[i] , lat[( i + t * LCU ) % LVOLUME].O[ND-1] ) ;
-      }
-    }
-    
     // compute the two quark correlator
-    static_quark_correlator( result , trtr , 
-			     (const GLU_complex**)poly , 
-			     list , size[0] ) ;
+    finish_correlator( result , trtr , 
+		       acc_tr + ( t - 1 ) * Ncorr , 
+		       acc_trtr + ( t - 1 ) * Ncorr ,
+		       &single , list , size[0] ) ;
 
     // write out the result of all that work
     write_complex_g2g3_to_list( Ap , result , trtr , size ) ;
@@ -405,12 +463,11 @@ Coul_staticpot( struct site *lat ,
   // memory free ...
   free( result ) ;
   free( trtr ) ;
+  free( acc_tr ) ;
+  free( acc_trtr ) ;
   free( (void*)str ) ;
-#pragma omp parallel for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) { 
-    free( poly[i] ) ;
-  }
-  free( poly ) ;
+  free_correlator( many , single ) ;
+  free( lines ) ;
 
   // free the momentum list
   free( list ) ;
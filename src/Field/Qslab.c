@@ -25,7 +25,6 @@
 #include "clover.h"     // computation of the topological charge
 #include "cut_output.h" // automatic formatting of our output file
 #include "geometry.h"   // for the spacing computation
-#include "plan_ffts.h"  // config space correlator is convolution
 #include "str_stuff.h"  // append_char()
 
 // local version of the one in geometry
@@ -62,7 +61,35 @@ slab_idx( const size_t i ,
   return gen_site( x ) ;
 }
 
+// sum the charge density over each slice in the slab direction
+static void
+slice_sums( GLU_complex *qt ,
+	    const GLU_complex *qtop ,
+	    const size_t SLAB_DIR )
+{
+  // a slab of thickness one
+  size_t dims[ ND ] , subvol = 1 , mu , t ;
+  for( mu = 0 ; mu < ND ; mu++ ) {
+    dims[ mu ] = ( mu == SLAB_DIR ) ? 1 : Latt.dims[ mu ] ;
+    subvol *= dims[ mu ] ;
+  }
+  #pragma omp parallel for private(t)
+  for( t = 0 ; t < Latt.dims[ SLAB_DIR ] ; t++ ) {
+    register GLU_complex sum = 0.0 ;
+    size_t i ;
+    for( i = 0 ; i < subvol ; i++ ) {
+      sum += qtop[ slab_idx( i , dims , SLAB_DIR , t ) ] ;
+    }
+    qt[ t ] = sum ;
+  }
+  return ;
+}
+
 // compute the slab definition of the topological susceptibility
+//
+// the sum over the slab of the convolution q*q is just the square of
+// the charge in the slab, so every (T0,T1) only needs the slice sums
+// and the slab of thickness T1 is the one of T1-1 plus a slice
 static int
 compute_slabs( const GLU_complex *qtop ,
 	       const struct cut_info CUTINFO ,
@@ -72,10 +99,11 @@ compute_slabs( const GLU_complex *qtop ,
   // normalisations
   const double NORM = -0.001583143494411527678811 ; // -1.0/(64*Pi*Pi)
   const double NORMSQ = NORM * NORM ;
+  const size_t LT = Latt.dims[ SLAB_DIR ] ;
   
   // various sums and things
   register double sum = 0.0 ;
-  size_t T0 , T1 , i , mu ;
+  size_t T0 , T1 , i ;
 
   // set up the outputs
   char *str = output_str_struct( CUTINFO ) ;
@@ -85,10 +113,14 @@ compute_slabs( const GLU_complex *qtop ,
   FILE *Ap = fopen( str , "wb" ) ;
 
   // timeslice length
-  size_t lt[ 1 ] = { Latt.dims[ SLAB_DIR ] } ;
+  size_t lt[ 1 ] = { LT } ;
 
   // temporal correlator
-  double *ct = malloc( Latt.dims[ SLAB_DIR ] * sizeof( double ) ) ;
+  double *ct = malloc( LT * sizeof( double ) ) ;
+
+  // charge on each slice and on the slab starting at each T0
+  GLU_complex *qt   = malloc( LT * sizeof( GLU_complex ) ) ;
+  GLU_complex *slab = malloc( LT * sizeof( GLU_complex ) ) ;
 
   // write out the timeslice list ...
   write_tslice_list( Ap , lt ) ;
@@ -100,84 +132,25 @@ compute_slabs( const GLU_complex *qtop ,
   fprintf( stdout , "\n[QTOP] Q %zu %1.12e %1.12e \n" ,
 	   measurement , sum * NORM , sum * sum * NORMSQ ) ;
 
-  // compute the slab definition
-  for( T1 = 1 ; T1 <= Latt.dims[ SLAB_DIR ] ; T1++ ) {
-
-    // set the dimensions of the slab
-    size_t dims[ ND ] , subvol = 1 ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      if( mu == SLAB_DIR ) {
-	dims[ mu ] = T1 ;
-      } else {
-	dims[ mu ] = Latt.dims[ mu ] ;
-      }
-      subvol *= dims[ mu ] ;
-    }
-
-#ifdef HAVE_FFTW3_H
-
-    #ifdef verbose
-    printf( "DIMS :: %zu %zu %zu %zu -> %zu \n" ,
-	    dims[0] , dims[1] , dims[2] , dims[3] , subvol ) ;
-    #endif
-
-    struct fftw_small_stuff FFTW ;
-    small_create_plans_DFT( &FFTW , dims , ND ) ;
-    
-#endif
+  slice_sums( qt , qtop , SLAB_DIR ) ;
 
+  // compute the slab definition
+  for( T0 = 0 ; T0 < LT ; T0++ ) {
+    slab[ T0 ] = 0.0 ;
+  }
+  for( T1 = 1 ; T1 <= LT ; T1++ ) {
     double tsum = 0.0 ;
     // sum over all possible time cuts
-    for( T0 = 0 ; T0 < Latt.dims[ SLAB_DIR ] ; T0++ ) {
-
-      double sum_slab = 0.0 ;
-      // perform convolution using FFTW
-      #ifdef HAVE_FFTW3_H
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < subvol ; i++ ) {
-	const size_t src = slab_idx( i , dims , SLAB_DIR , T0 ) ;
-	FFTW.in[ i ] = qtop[ src ] ; 
-      }
-      fftw_execute( FFTW.forward ) ;
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < subvol ; i++ ) {
-	FFTW.out[ i ] *= conj( FFTW.out[i] ) ;
-      }
-      fftw_execute( FFTW.backward ) ;
-
-      for( i = 0 ; i < subvol ; i++ ) {
-	sum_slab += creal( FFTW.in[ i ] ) ;
-      }
-      // perform convolution the dumb way
-      #else
-      #pragma omp parallel for private(i)
-      for( i = 0 ; i < subvol ; i++ ) {
-	const size_t src = slab_idx( i , dims , SLAB_DIR , T0 ) ;
-	const double qsrc = qtop[ src ] ;
-	size_t j ;
-	for( j = 0 ; j < subvol ; j++ ) {
-	  const size_t snk = slab_idx( j , dims , SLAB_DIR , T0 ) ;
-	  sum_slab += creal ( qsrc * qtop[ snk ] ) ;
-	}
-      }
-      #endif
-      tsum += sum_slab ;
+    for( T0 = 0 ; T0 < LT ; T0++ ) {
+      slab[ T0 ] += qt[ ( T0 + T1 - 1 ) % LT ] ;
+      tsum += creal( slab[ T0 ] ) * creal( slab[ T0 ] ) + 
+	cimag( slab[ T0 ] ) * cimag( slab[ T0 ] ) ;
     }
-
-#ifdef HAVE_FFTW3_H
-    
-    // do the usual convolution norm
-    tsum /= ( subvol ) ;
-
-    // cleanup and memory deallocate
-    small_clean_up_fftw( FFTW ) ;
-#endif
-
-    ct[ T1-1 ] = tsum * NORMSQ / Latt.dims[ SLAB_DIR ] ;
+    ct[ T1-1 ] = tsum * NORMSQ / LT ;
   }
 
   // write out the list
-  for( T1 = 0 ; T1 < Latt.dims[ SLAB_DIR ] ; T1++ ) {
+  for( T1 = 0 ; T1 < LT ; T1++ ) {
     printf( "[QSUSC] SLAB_%zu %zu %1.12e \n" , SLAB_DIR , T1+1 , ct[T1] ) ;
   }
 
@@ -188,6 +161,9 @@ compute_slabs( const GLU_complex *qtop ,
   write_g2_to_list( Ap , ct , lt ) ;
 
   // free allocated memory
+  free( slab ) ;
+  free( qt ) ;
+  free( ct ) ;
   free( str ) ;
   fclose( Ap ) ;
 
@@ -24,21 +24,21 @@ link_path( GLU_complex result[ NCNC ] ,
 
   size_t mu = (size_t)abs( path[0] ) - 1 ;
   if( path[0] < 0 ) {
-    k = lat[i].back[ mu ] ;
+    k = site_bck( i , mu ) ;
     dagger( temp , lat[k].O[mu] ) ;
   } else {
     equiv( temp , lat[i].O[ path[0] - 1 ] ) ;
-    k = lat[i].neighbor[ mu ] ;
+    k = site_fwd( i , mu ) ;
   } 
   for( j = 1 ; j < Npath ; j++ ) {
     mu = (size_t)abs( path[j] ) - 1 ;
     // logic
     if( path[j] < 0 ) {
-      k = lat[k].back[ mu ] ;
+      k = site_bck( k , mu ) ;
       multab_dag_suNC( result , temp , lat[k].O[mu] ) ;
     } else {
       multab_suNC( result , temp , lat[k].O[mu] ) ;
-      k = lat[k].neighbor[ mu ] ;
+      k = site_fwd( k , mu ) ;
     }
     equiv( temp , result ) ;
     //
@@ -48,11 +48,19 @@
  */
 #include "Mainfile.h"
 
+#include "lanes.h" // clover_lanes()
+
 // can test the versions of the projection here ....
 //#define TRF_ANTIHERMITIAN
 //#define ANTIHERMITIAN
 //#define CLOVER_LOG_DEF
 
+// the standard clover is built STAPLE_LANES sites at a time
+#if (ND == 4) && !(defined CLOVER_IMPROVE) && !(defined PLAQUETTE_FMUNU) \
+  && !(defined CLOVER_LOG_DEF)
+  #define GMUNU_LANES
+#endif
+
 // improvement factors from the bilson-thompson paper ...
 #ifndef NK5
    GLU_real fClover_k1 ;
@@ -68,6 +76,20 @@
    const GLU_real fClover_k5 = 0.0 ;
 #endif
 
+// set the absolute values of the improvement factors we test against
+void
+clover_factors( void )
+{
+#ifndef NK5
+  fClover_k1 = fabs( Clover_k1 ) ;
+  fClover_k2 = fabs( Clover_k2 ) ;
+  fClover_k3 = fabs( Clover_k3 ) ;
+  fClover_k4 = fabs( Clover_k4 ) ;
+  fClover_k5 = fabs( k5 ) ;
+#endif
+  return ;
+}
+
 #if ND == 4 /// this definition is only correct for ND = 4
 // top right
 static void
@@ -80,8 +102,8 @@ compute_s1( GLU_complex *__restrict sum ,
 	    const size_t nu ,
 	    const GLU_real mul )
 {
-  const size_t s1 = lat[i].neighbor[mu] ;
-  const size_t s2 = lat[i].neighbor[nu] ;
+  const size_t s1 = site_fwd( i , mu ) ;
+  const size_t s2 = site_fwd( i , nu ) ;
   multab_suNC( u , lat[i].O[mu] , lat[s1].O[nu] ) ;
   multab_dag_suNC( v , u , lat[s2].O[mu] ) ;
   multab_dag_suNC( u , v , lat[i].O[nu] ) ;
@@ -105,8 +127,8 @@ compute_s2( GLU_complex *__restrict sum ,
 	    const size_t nu ,
 	    const GLU_real mul )
 {
-  const size_t s1 = lat[i].back[nu] ;
-  const size_t s2 = lat[s1].neighbor[mu] ;
+  const size_t s1 = site_bck( i , nu ) ;
+  const size_t s2 = site_fwd( s1 , mu ) ;
   multabdag_suNC( u , lat[s1].O[nu] , lat[s1].O[mu] ) ;
   multab_suNC( v , u , lat[s2].O[nu] ) ;
   multab_dag_suNC( u , v , lat[i].O[mu] ) ; 
@@ -129,9 +151,9 @@ compute_s3( GLU_complex *__restrict sum ,
 	    const size_t nu ,
 	    const GLU_real mul )
 {
-  const size_t s1 = lat[i].back[mu] ;
-  const size_t s2 = lat[s1].back[nu] ;
-  const size_t s3 = lat[i].back[nu] ;
+  const size_t s1 = site_bck( i , mu ) ;
+  const size_t s2 = site_bck( s1 , nu ) ;
+  const size_t s3 = site_bck( i , nu ) ;
   multab_dagdag_suNC( u , lat[s1].O[mu] , lat[s2].O[nu] ) ;
   multab_suNC( v , u , lat[s2].O[mu] ) ;
   multab_suNC( u , v , lat[s3].O[nu] ) ;
@@ -154,8 +176,8 @@ compute_s4( GLU_complex *__restrict sum ,
 	    const size_t nu ,
 	    const GLU_real mul )
 {
-  const size_t s2 = lat[i].back[mu] ;
-  const size_t s1 = lat[s2].neighbor[nu] ;
+  const size_t s2 = site_bck( i , mu ) ;
+  const size_t s1 = site_fwd( s2 , nu ) ;
   multab_dag_suNC( u , lat[i].O[nu] , lat[s1].O[mu] ) ;
   multab_dag_suNC( v , u , lat[s2].O[nu] ) ;
   multab_suNC( u , v , lat[s2].O[mu] ) ;
@@ -188,17 +210,17 @@ compute_clover_s1( GLU_complex *__restrict sum ,
   }
   // 2x2 contribution
   if( fClover_k2 > CL_TOL ) {
-    const size_t s1 = lat[i].neighbor[mu] ;
-    const size_t s2 = lat[s1].neighbor[mu] ;
-    const size_t s3 = lat[s2].neighbor[nu] ;
+    const size_t s1 = site_fwd( i , mu ) ;
+    const size_t s2 = site_fwd( s1 , mu ) ;
+    const size_t s3 = site_fwd( s2 , nu ) ;
     multab_suNC( u , lat[i].O[mu] , lat[s1].O[mu] ) ;
     multab_suNC( v , u , lat[s2].O[nu] ) ;
     multab_suNC( u , v , lat[s3].O[nu] ) ;
     // the final link posize_ts to the top right corner
     // work backwards
-    const size_t s6 = lat[i].neighbor[nu] ;
-    const size_t s5 = lat[s6].neighbor[nu] ;    
-    const size_t s4 = lat[s5].neighbor[mu] ; 
+    const size_t s6 = site_fwd( i , nu ) ;
+    const size_t s5 = site_fwd( s6 , nu ) ;    
+    const size_t s4 = site_fwd( s5 , mu ) ; 
     multab_dag_suNC( v , u , lat[s4].O[mu] ) ;
     multab_dag_suNC( u , v , lat[s5].O[mu] ) ;
     multab_dag_suNC( v , u , lat[s6].O[nu] ) ;
@@ -213,10 +235,10 @@ compute_clover_s1( GLU_complex *__restrict sum ,
   // 1x2 contribution(s)
   if( fClover_k3 > CL_TOL ) {
     // the 1x2 contrib
-    const size_t s1 = lat[i].neighbor[mu] ;
-    const size_t s2 = lat[s1].neighbor[nu] ;
-    const size_t s3 = lat[i].neighbor[nu] ;
-    const size_t s4 = lat[s3].neighbor[nu] ;
+    const size_t s1 = site_fwd( i , mu ) ;
+    const size_t s2 = site_fwd( s1 , nu ) ;
+    const size_t s3 = site_fwd( i , nu ) ;
+    const size_t s4 = site_fwd( s3 , nu ) ;
     multab_suNC( u , lat[i].O[mu] , lat[s1].O[nu] ) ;
     multab_suNC( v , u , lat[s2].O[nu] ) ;
     multab_dag_suNC( u , v , lat[s4].O[mu] ) ;
@@ -229,12 +251,12 @@ compute_clover_s1( GLU_complex *__restrict sum ,
     a_plus_Sxb( sum , u , Clover_k3 ) ;
     #endif
     // and the 2x1
-    const size_t t1 = lat[i].neighbor[mu] ;
-    const size_t t2 = lat[t1].neighbor[mu] ;
+    const size_t t1 = site_fwd( i , mu ) ;
+    const size_t t2 = site_fwd( t1 , mu ) ;
     multab_suNC( u , lat[i].O[mu] , lat[t1].O[mu] ) ;
     multab_suNC( v , u , lat[t2].O[nu] ) ;
-    const size_t t3 = lat[i].neighbor[nu] ;
-    const size_t t4 = lat[t3].neighbor[mu] ;
+    const size_t t3 = site_fwd( i , nu ) ;
+    const size_t t4 = site_fwd( t3 , mu ) ;
     multab_dag_suNC( u , v , lat[t4].O[mu] ) ;
     multab_dag_suNC( v , u , lat[t3].O[mu] ) ;
     multab_dag_suNC( u , v , lat[i].O[nu] ) ;
@@ -248,16 +270,16 @@ compute_clover_s1( GLU_complex *__restrict sum ,
   // 1x3 contribution(s)
   if( fClover_k4 > CL_TOL ) {
     // 1x3
-    const size_t s1 = lat[i].neighbor[mu] ;
-    const size_t s2 = lat[s1].neighbor[nu] ;
-    const size_t s3 = lat[s2].neighbor[nu] ;
+    const size_t s1 = site_fwd( i , mu ) ;
+    const size_t s2 = site_fwd( s1 , nu ) ;
+    const size_t s3 = site_fwd( s2 , nu ) ;
     multab_suNC( u , lat[i].O[mu] , lat[s1].O[nu] ) ;
     multab_suNC( v , u , lat[s2].O[nu] ) ;
     multab_suNC( u , v , lat[s3].O[nu] ) ;
-    const size_t s4 = lat[s3].neighbor[nu] ;
-    const size_t s5 = lat[s4].back[mu] ;
-    const size_t s6 = lat[s5].back[nu] ;
-    const size_t s7 = lat[s6].back[nu] ;
+    const size_t s4 = site_fwd( s3 , nu ) ;
+    const size_t s5 = site_bck( s4 , mu ) ;
+    const size_t s6 = site_bck( s5 , nu ) ;
+    const size_t s7 = site_bck( s6 , nu ) ;
     multab_dag_suNC( v , u , lat[s5].O[mu] ) ;
     multab_dag_suNC( u , v , lat[s6].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s7].O[nu] ) ;
@@ -269,16 +291,16 @@ compute_clover_s1( GLU_complex *__restrict sum ,
     a_plus_Sxb( sum , u , Clover_k4 ) ;
     #endif
     // 3x1
-    const size_t t1 = lat[i].neighbor[mu] ;
-    const size_t t2 = lat[t1].neighbor[mu] ;
-    const size_t t3 = lat[t2].neighbor[mu] ;
+    const size_t t1 = site_fwd( i , mu ) ;
+    const size_t t2 = site_fwd( t1 , mu ) ;
+    const size_t t3 = site_fwd( t2 , mu ) ;
     multab_suNC( u , lat[i].O[mu] , lat[t1].O[mu] ) ;
     multab_suNC( v , u , lat[t2].O[mu] ) ;
     multab_suNC( u , v , lat[t3].O[nu] ) ;
-    const size_t t4 = lat[t3].neighbor[nu] ;
-    const size_t t5 = lat[t4].back[mu] ;
-    const size_t t6 = lat[t5].back[mu] ;
-    const size_t t7 = lat[t6].back[mu] ;
+    const size_t t4 = site_fwd( t3 , nu ) ;
+    const size_t t5 = site_bck( t4 , mu ) ;
+    const size_t t6 = site_bck( t5 , mu ) ;
+    const size_t t7 = site_bck( t6 , mu ) ;
     multab_dag_suNC( v , u , lat[t5].O[mu] ) ;
     multab_dag_suNC( u , v , lat[t6].O[mu] ) ;
     multab_dag_suNC( v , u , lat[t7].O[mu] ) ;
@@ -295,22 +317,22 @@ compute_clover_s1( GLU_complex *__restrict sum ,
   if( fClover_k5 > CL_TOL ) {
     GLU_complex x[ NCNC ] , y[ NCNC ] ;
     GLU_complex s[ NCNC ] , t[ NCNC ] ;
-    const size_t s1 = lat[i].neighbor[mu] ;
-    const size_t s2 = lat[s1].neighbor[mu] ;
-    const size_t s3 = lat[s2].neighbor[mu] ;
-    const size_t s4 = lat[s3].neighbor[nu] ;
-    const size_t s5 = lat[s4].neighbor[nu] ;
+    const size_t s1 = site_fwd( i , mu ) ;
+    const size_t s2 = site_fwd( s1 , mu ) ;
+    const size_t s3 = site_fwd( s2 , mu ) ;
+    const size_t s4 = site_fwd( s3 , nu ) ;
+    const size_t s5 = site_fwd( s4 , nu ) ;
     multab_suNC( s , lat[i].O[mu] , lat[s1].O[mu] ) ;
     multab_suNC( v , lat[s2].O[mu] , lat[s3].O[nu] ) ;
     multab_suNC( x , lat[s4].O[nu] , lat[s5].O[nu] ) ;
     multab_suNC( y , s , v ) ;
     multab_suNC( s , y , x ) ;
     // go to s6
-    const size_t s7 = lat[i].neighbor[nu] ;
-    const size_t s8 = lat[s7].neighbor[nu] ;
-    const size_t s9 = lat[s8].neighbor[nu] ;
-    const size_t s10 = lat[s9].neighbor[mu] ;
-    const size_t s11 = lat[s10].neighbor[mu] ;
+    const size_t s7 = site_fwd( i , nu ) ;
+    const size_t s8 = site_fwd( s7 , nu ) ;
+    const size_t s9 = site_fwd( s8 , nu ) ;
+    const size_t s10 = site_fwd( s9 , mu ) ;
+    const size_t s11 = site_fwd( s10 , mu ) ;
     multab_suNC( t , lat[i].O[nu] , lat[s7].O[nu] ) ;
     multab_suNC( v , lat[s8].O[nu] , lat[s9].O[mu] ) ;
     multab_suNC( x , lat[s10].O[mu] , lat[s11].O[mu] ) ;
@@ -345,16 +367,16 @@ compute_clover_s2( GLU_complex *__restrict sum ,
   }
   // 2x2 contrib
   if( fClover_k2 > CL_TOL ) {
-    const size_t s1 = lat[i].back[nu] ;
-    const size_t s2 = lat[s1].back[nu] ;
-    const size_t s3 = lat[s2].neighbor[mu] ;
+    const size_t s1 = site_bck( i , nu ) ;
+    const size_t s2 = site_bck( s1 , nu ) ;
+    const size_t s3 = site_fwd( s2 , mu ) ;
     multab_dagdag_suNC( u , lat[s1].O[nu] , lat[s2].O[nu] ) ;
     multab_suNC( v , u , lat[s2].O[mu] ) ;
     multab_suNC( u , v , lat[s3].O[mu] ) ;
     // posize_ted to halfway
-    const size_t s4 = lat[s3].neighbor[mu] ;
-    const size_t s5 = lat[s4].neighbor[nu] ;
-    const size_t s6 = lat[i].neighbor[mu] ;
+    const size_t s4 = site_fwd( s3 , mu ) ;
+    const size_t s5 = site_fwd( s4 , nu ) ;
+    const size_t s6 = site_fwd( i , mu ) ;
     multab_suNC( v , u , lat[s4].O[nu] ) ;
     multab_suNC( u , v , lat[s5].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s6].O[mu] ) ;
@@ -369,12 +391,12 @@ compute_clover_s2( GLU_complex *__restrict sum ,
   // 1x2 contrib
   if( fClover_k3 > CL_TOL ) {
     // 1x2
-    const size_t s1 = lat[i].back[nu] ;
-    const size_t s2 = lat[s1].back[nu] ;
+    const size_t s1 = site_bck( i , nu ) ;
+    const size_t s2 = site_bck( s1 , nu ) ;
     multab_dagdag_suNC( u , lat[s1].O[nu] , lat[s2].O[nu] ) ;
     multab_suNC( v , u , lat[s2].O[mu] ) ;
-    const size_t s3 = lat[s2].neighbor[mu] ;
-    const size_t s4 = lat[s3].neighbor[nu] ;
+    const size_t s3 = site_fwd( s2 , mu ) ;
+    const size_t s4 = site_fwd( s3 , nu ) ;
     multab_suNC( u , v , lat[s3].O[nu] ) ; 
     multab_suNC( v , u , lat[s4].O[nu] ) ; 
     multab_dag_suNC( u , v , lat[i].O[mu] ) ; 
@@ -385,13 +407,13 @@ compute_clover_s2( GLU_complex *__restrict sum ,
     a_plus_Sxb( sum , u , Clover_k3 ) ;
 #endif
     // 2x1 
-    const size_t t1 = lat[i].back[nu] ;
-    const size_t t2 = lat[t1].neighbor[mu] ;
+    const size_t t1 = site_bck( i , nu ) ;
+    const size_t t2 = site_fwd( t1 , mu ) ;
     multabdag_suNC( u , lat[t1].O[nu] , lat[t1].O[mu] ) ;
     multab_suNC( v , u , lat[t2].O[mu] ) ;
-    const size_t t3 = lat[t2].neighbor[mu] ;
-    const size_t t4 = lat[t3].neighbor[nu] ;
-    const size_t t5 = lat[t4].back[mu] ;
+    const size_t t3 = site_fwd( t2 , mu ) ;
+    const size_t t4 = site_fwd( t3 , nu ) ;
+    const size_t t5 = site_bck( t4 , mu ) ;
     multab_suNC( u , v , lat[t3].O[nu] ) ; 
     multab_dag_suNC( v , u , lat[t5].O[mu] ) ; 
     multab_dag_suNC( u , v , lat[i].O[mu] ) ; 
@@ -405,15 +427,15 @@ compute_clover_s2( GLU_complex *__restrict sum ,
   // 1x3 contribution
   if( fClover_k4 > CL_TOL ) {
     // 1x3
-    const size_t s1 = lat[i].back[nu] ;
-    const size_t s2 = lat[s1].back[nu] ;
-    const size_t s3 = lat[s2].back[nu] ;
+    const size_t s1 = site_bck( i , nu ) ;
+    const size_t s2 = site_bck( s1 , nu ) ;
+    const size_t s3 = site_bck( s2 , nu ) ;
     multab_dagdag_suNC( u , lat[s1].O[nu] , lat[s2].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s3].O[nu] ) ;
     multab_suNC( u , v , lat[s3].O[mu] ) ;
-    const size_t s4 = lat[s3].neighbor[mu] ;
-    const size_t s5 = lat[s4].neighbor[nu] ;
-    const size_t s6 = lat[s5].neighbor[nu] ;
+    const size_t s4 = site_fwd( s3 , mu ) ;
+    const size_t s5 = site_fwd( s4 , nu ) ;
+    const size_t s6 = site_fwd( s5 , nu ) ;
     multab_suNC( v , u , lat[s4].O[nu] ) ; 
     multab_suNC( u , v , lat[s5].O[nu] ) ; 
     multab_suNC( v , u , lat[s6].O[nu] ) ; 
@@ -425,16 +447,16 @@ compute_clover_s2( GLU_complex *__restrict sum ,
     a_plus_Sxb( sum , u , Clover_k4 ) ;
 #endif
     // 3x1
-    const size_t t1 = lat[i].back[nu] ;
-    const size_t t2 = lat[t1].neighbor[mu] ;
-    const size_t t3 = lat[t2].neighbor[mu] ;
+    const size_t t1 = site_bck( i , nu ) ;
+    const size_t t2 = site_fwd( t1 , mu ) ;
+    const size_t t3 = site_fwd( t2 , mu ) ;
     multabdag_suNC( u , lat[t1].O[nu] , lat[t1].O[mu] ) ;
     multab_suNC( v , u , lat[t2].O[mu] ) ;
     multab_suNC( u , v , lat[t3].O[mu] ) ;
-    const size_t t4 = lat[t3].neighbor[mu] ;
-    const size_t t5 = lat[t4].neighbor[nu] ;
-    const size_t t6 = lat[t5].back[mu] ;
-    const size_t t7 = lat[t6].back[mu] ;
+    const size_t t4 = site_fwd( t3 , mu ) ;
+    const size_t t5 = site_fwd( t4 , nu ) ;
+    const size_t t6 = site_bck( t5 , mu ) ;
+    const size_t t7 = site_bck( t6 , mu ) ;
     multab_suNC( v , u , lat[t4].O[nu] ) ; 
     multab_dag_suNC( u , v , lat[t6].O[mu] ) ; 
     multab_dag_suNC( v , u , lat[t7].O[mu] ) ; 
@@ -451,23 +473,23 @@ compute_clover_s2( GLU_complex *__restrict sum ,
   if( fClover_k5 > CL_TOL ) {
     GLU_complex x[ NCNC ] , y[ NCNC ] ;
     GLU_complex s[ NCNC ] , t[ NCNC ] ;
-    const size_t s1 = lat[i].back[nu] ;
-    const size_t s2 = lat[s1].back[nu] ;
-    const size_t s3 = lat[s2].back[nu] ;
-    const size_t s4 = lat[s3].neighbor[mu] ;
-    const size_t s5 = lat[s4].neighbor[mu] ;
+    const size_t s1 = site_bck( i , nu ) ;
+    const size_t s2 = site_bck( s1 , nu ) ;
+    const size_t s3 = site_bck( s2 , nu ) ;
+    const size_t s4 = site_fwd( s3 , mu ) ;
+    const size_t s5 = site_fwd( s4 , mu ) ;
     multab_dagdag_suNC( s , lat[s1].O[nu] , lat[s2].O[nu] ) ;
     multabdag_suNC( v , lat[s3].O[nu] , lat[s3].O[mu] ) ;
     multab_suNC( x , lat[s4].O[mu] , lat[s5].O[mu] ) ;
     multab_suNC( y , s , v ) ;
     multab_suNC( s , y , x ) ;
     // go to s6
-    const size_t s6 = lat[i].neighbor[mu] ;
-    const size_t s7 = lat[s6].neighbor[mu] ;
-    const size_t s8 = lat[s7].neighbor[mu] ;
-    const size_t s9 = lat[s8].back[nu] ;
-    const size_t s10 = lat[s9].back[nu] ;
-    const size_t s11 = lat[s10].back[nu] ;
+    const size_t s6 = site_fwd( i , mu ) ;
+    const size_t s7 = site_fwd( s6 , mu ) ;
+    const size_t s8 = site_fwd( s7 , mu ) ;
+    const size_t s9 = site_bck( s8 , nu ) ;
+    const size_t s10 = site_bck( s9 , nu ) ;
+    const size_t s11 = site_bck( s10 , nu ) ;
     multab_suNC( t , lat[i].O[mu] , lat[s6].O[mu] ) ;
     multab_dag_suNC( v , lat[s7].O[mu] , lat[s9].O[nu] ) ;
     multab_dagdag_suNC( x , lat[s10].O[nu] , lat[s11].O[nu] ) ;
@@ -502,16 +524,16 @@ compute_clover_s3( GLU_complex *__restrict sum ,
   }
   // 2x2 contrib
   if( fClover_k2 > CL_TOL ) {
-    const size_t s1 = lat[i].back[mu] ;
-    const size_t s2 = lat[s1].back[mu] ;
-    const size_t s3 = lat[s2].back[nu] ;
-    const size_t s4 = lat[s3].back[nu] ;
+    const size_t s1 = site_bck( i , mu ) ;
+    const size_t s2 = site_bck( s1 , mu ) ;
+    const size_t s3 = site_bck( s2 , nu ) ;
+    const size_t s4 = site_bck( s3 , nu ) ;
     multab_dagdag_suNC( u , lat[s1].O[mu] , lat[s2].O[mu] ) ;
     multab_dag_suNC( v , u , lat[s3].O[nu] ) ;
     multab_dag_suNC( u , v , lat[s4].O[nu] ) ;
-    const size_t s5 = lat[s4].neighbor[mu] ;
-    const size_t s6 = lat[s5].neighbor[mu] ;
-    const size_t s7 = lat[s6].neighbor[nu] ;
+    const size_t s5 = site_fwd( s4 , mu ) ;
+    const size_t s6 = site_fwd( s5 , mu ) ;
+    const size_t s7 = site_fwd( s6 , nu ) ;
     multab_suNC( v , u , lat[s4].O[mu] ) ;
     multab_suNC( u , v , lat[s5].O[mu] ) ;
     multab_suNC( v , u , lat[s6].O[nu] ) ;
@@ -525,13 +547,13 @@ compute_clover_s3( GLU_complex *__restrict sum ,
   }
   // 1x2 contrib
   if( fClover_k3 > CL_TOL ) {
-    const size_t s1 = lat[i].back[mu] ;
-    const size_t s2 = lat[s1].back[nu] ;
-    const size_t s3 = lat[s2].back[nu] ;
+    const size_t s1 = site_bck( i , mu ) ;
+    const size_t s2 = site_bck( s1 , nu ) ;
+    const size_t s3 = site_bck( s2 , nu ) ;
     multab_dagdag_suNC( u , lat[s1].O[mu] , lat[s2].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s3].O[nu] ) ;
-    const size_t s4 = lat[s3].neighbor[mu] ;
-    const size_t s5 = lat[s4].neighbor[nu] ;
+    const size_t s4 = site_fwd( s3 , mu ) ;
+    const size_t s5 = site_fwd( s4 , nu ) ;
     multab_suNC( u , v , lat[s3].O[mu] ) ;
     multab_suNC( v , u , lat[s4].O[nu] ) ;
     multab_suNC( u , v , lat[s5].O[nu] ) ;
@@ -542,13 +564,13 @@ compute_clover_s3( GLU_complex *__restrict sum ,
     a_plus_Sxb( sum , u , Clover_k3 ) ;
 #endif
     // 2x1
-    const size_t t1 = lat[i].back[mu] ;
-    const size_t t2 = lat[t1].back[mu] ;
-    const size_t t3 = lat[t2].back[nu] ;
+    const size_t t1 = site_bck( i , mu ) ;
+    const size_t t2 = site_bck( t1 , mu ) ;
+    const size_t t3 = site_bck( t2 , nu ) ;
     multab_dagdag_suNC( u , lat[t1].O[mu] , lat[t2].O[mu] ) ;
     multab_dag_suNC( v , u , lat[t3].O[nu] ) ;
-    const size_t t4 = lat[t3].neighbor[mu] ;
-    const size_t t5 = lat[t4].neighbor[mu] ;
+    const size_t t4 = site_fwd( t3 , mu ) ;
+    const size_t t5 = site_fwd( t4 , mu ) ;
     multab_suNC( u , v , lat[t3].O[mu] ) ;
     multab_suNC( v , u , lat[t4].O[mu] ) ;
     multab_suNC( u , v , lat[t5].O[nu] ) ;
@@ -562,16 +584,16 @@ compute_clover_s3( GLU_complex *__restrict sum ,
   // 1x3 contrib
   if( fClover_k4 > CL_TOL ) {
     // 1x3
-    const size_t s1 = lat[i].back[mu] ;
-    const size_t s2 = lat[s1].back[nu] ;
-    const size_t s3 = lat[s2].back[nu] ;
-    const size_t s4 = lat[s3].back[nu] ;
+    const size_t s1 = site_bck( i , mu ) ;
+    const size_t s2 = site_bck( s1 , nu ) ;
+    const size_t s3 = site_bck( s2 , nu ) ;
+    const size_t s4 = site_bck( s3 , nu ) ;
     multab_dagdag_suNC( u , lat[s1].O[mu] , lat[s2].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s3].O[nu] ) ;
     multab_dag_suNC( u , v , lat[s4].O[nu] ) ;
-    const size_t s5 = lat[s4].neighbor[mu] ;
-    const size_t s6 = lat[s5].neighbor[nu] ;
-    const size_t s7 = lat[s6].neighbor[nu] ;
+    const size_t s5 = site_fwd( s4 , mu ) ;
+    const size_t s6 = site_fwd( s5 , nu ) ;
+    const size_t s7 = site_fwd( s6 , nu ) ;
     multab_suNC( v , u , lat[s4].O[mu] ) ;
     multab_suNC( u , v , lat[s5].O[nu] ) ;
     multab_suNC( v , u , lat[s6].O[nu] ) ;
@@ -583,16 +605,16 @@ compute_clover_s3( GLU_complex *__restrict sum ,
     a_plus_Sxb( sum , u , Clover_k4 ) ;
 #endif
     // 3x1
-    const size_t t1 = lat[i].back[mu] ;
-    const size_t t2 = lat[t1].back[mu] ;
-    const size_t t3 = lat[t2].back[mu] ;
-    const size_t t4 = lat[t3].back[nu] ;
+    const size_t t1 = site_bck( i , mu ) ;
+    const size_t t2 = site_bck( t1 , mu ) ;
+    const size_t t3 = site_bck( t2 , mu ) ;
+    const size_t t4 = site_bck( t3 , nu ) ;
     multab_dagdag_suNC( u , lat[t1].O[mu] , lat[t2].O[mu] ) ;
     multab_dag_suNC( v , u , lat[t3].O[mu] ) ;
     multab_dag_suNC( u , v , lat[t4].O[nu] ) ;
-    const size_t t5 = lat[t4].neighbor[mu] ;
-    const size_t t6 = lat[t5].neighbor[mu] ;
-    const size_t t7 = lat[t6].neighbor[mu] ;
+    const size_t t5 = site_fwd( t4 , mu ) ;
+    const size_t t6 = site_fwd( t5 , mu ) ;
+    const size_t t7 = site_fwd( t6 , mu ) ;
     multab_suNC( v , u , lat[t4].O[mu] ) ;
     multab_suNC( u , v , lat[t5].O[mu] ) ;
     multab_suNC( v , u , lat[t6].O[mu] ) ;
@@ -609,22 +631,22 @@ compute_clover_s3( GLU_complex *__restrict sum ,
   if( fClover_k5 > CL_TOL ) {
     GLU_complex x[ NCNC ] , y[ NCNC ] ;
     GLU_complex s[ NCNC ] , t[ NCNC ] ;
-    const size_t s1 = lat[i].back[mu] ;
-    const size_t s2 = lat[s1].back[mu] ;
-    const size_t s3 = lat[s2].back[mu] ;
-    const size_t s4 = lat[s3].back[nu] ;
-    const size_t s5 = lat[s4].back[nu] ;
-    const size_t s6 = lat[s5].back[nu] ;
+    const size_t s1 = site_bck( i , mu ) ;
+    const size_t s2 = site_bck( s1 , mu ) ;
+    const size_t s3 = site_bck( s2 , mu ) ;
+    const size_t s4 = site_bck( s3 , nu ) ;
+    const size_t s5 = site_bck( s4 , nu ) ;
+    const size_t s6 = site_bck( s5 , nu ) ;
     multab_dagdag_suNC( s , lat[s1].O[mu] , lat[s2].O[mu] ) ;
     multab_dagdag_suNC( v , lat[s3].O[mu] , lat[s4].O[nu] ) ;
     multab_dagdag_suNC( x , lat[s5].O[nu] , lat[s6].O[nu] ) ;
     multab_suNC( y , s , v ) ;
     multab_suNC( s , y , x ) ;
-    const size_t s7 = lat[s6].neighbor[mu] ;
-    const size_t s8 = lat[s7].neighbor[mu] ;
-    const size_t s9 = lat[s8].neighbor[mu] ;
-    const size_t s10 = lat[s9].neighbor[nu] ;
-    const size_t s11 = lat[s10].neighbor[nu] ;
+    const size_t s7 = site_fwd( s6 , mu ) ;
+    const size_t s8 = site_fwd( s7 , mu ) ;
+    const size_t s9 = site_fwd( s8 , mu ) ;
+    const size_t s10 = site_fwd( s9 , nu ) ;
+    const size_t s11 = site_fwd( s10 , nu ) ;
     multab_suNC( t , lat[s6].O[mu] , lat[s7].O[mu] ) ;
     multab_suNC( v , lat[s8].O[mu] , lat[s9].O[nu] ) ;
     multab_suNC( x , lat[s10].O[nu] , lat[s11].O[nu] ) ;
@@ -659,16 +681,16 @@ compute_clover_s4( GLU_complex *__restrict sum ,
   }
   // 2x2 contrib
   if( fClover_k2 > CL_TOL ) {
-    const size_t s1 = lat[i].neighbor[nu] ;
-    const size_t s2 = lat[s1].neighbor[nu] ;
-    const size_t s3 = lat[s2].back[mu] ;
-    const size_t s4 = lat[s3].back[mu] ;
+    const size_t s1 = site_fwd( i , nu ) ;
+    const size_t s2 = site_fwd( s1 , nu ) ;
+    const size_t s3 = site_bck( s2 , mu ) ;
+    const size_t s4 = site_bck( s3 , mu ) ;
     multab_suNC( u , lat[i].O[nu] , lat[s1].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s3].O[mu] ) ;
     multab_dag_suNC( u , v , lat[s4].O[mu] ) ;
-    const size_t s5= lat[s4].back[nu] ;
-    const size_t s6 = lat[s5].back[nu] ;
-    const size_t s7 = lat[s6].neighbor[mu] ;
+    const size_t s5= site_bck( s4 , nu ) ;
+    const size_t s6 = site_bck( s5 , nu ) ;
+    const size_t s7 = site_fwd( s6 , mu ) ;
     multab_dag_suNC( v , u , lat[s5].O[nu] ) ;
     multab_dag_suNC( u , v , lat[s6].O[nu] ) ;
     multab_suNC( v , u , lat[s6].O[mu] ) ;
@@ -682,13 +704,13 @@ compute_clover_s4( GLU_complex *__restrict sum ,
   }
   // 1x2 contrib
   if( fClover_k3 > CL_TOL ) {
-    const size_t s1 = lat[i].neighbor[nu] ;
-    const size_t s2 = lat[s1].neighbor[nu] ;
-    const size_t s3 = lat[s2].back[mu] ;
+    const size_t s1 = site_fwd( i , nu ) ;
+    const size_t s2 = site_fwd( s1 , nu ) ;
+    const size_t s3 = site_bck( s2 , mu ) ;
     multab_suNC( u , lat[i].O[nu] , lat[s1].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s3].O[mu] ) ;
-    const size_t s4 = lat[s3].back[nu] ;
-    const size_t s5 = lat[s4].back[nu] ;
+    const size_t s4 = site_bck( s3 , nu ) ;
+    const size_t s5 = site_bck( s4 , nu ) ;
     multab_dag_suNC( u , v , lat[s4].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s5].O[nu] ) ;
     multab_suNC( u , v , lat[s5].O[mu] ) ;
@@ -699,13 +721,13 @@ compute_clover_s4( GLU_complex *__restrict sum ,
     a_plus_Sxb( sum , u , Clover_k3 ) ;
 #endif
     // 2x1 contrib
-    const size_t t1 = lat[i].neighbor[nu] ;
-    const size_t t2 = lat[t1].back[mu] ;
-    const size_t t3 = lat[t2].back[mu] ;
+    const size_t t1 = site_fwd( i , nu ) ;
+    const size_t t2 = site_bck( t1 , mu ) ;
+    const size_t t3 = site_bck( t2 , mu ) ;
     multab_dag_suNC( u , lat[i].O[nu] , lat[t2].O[mu] ) ;
     multab_dag_suNC( v , u , lat[t3].O[mu] ) ;
-    const size_t t4 = lat[t3].back[nu] ;
-    const size_t t5 = lat[t4].neighbor[mu] ;
+    const size_t t4 = site_bck( t3 , nu ) ;
+    const size_t t5 = site_fwd( t4 , mu ) ;
     multab_dag_suNC( u , v , lat[t4].O[nu] ) ;
     multab_suNC( v , u , lat[t4].O[mu] ) ;
     multab_suNC( u , v , lat[t5].O[mu] ) ;
@@ -719,16 +741,16 @@ compute_clover_s4( GLU_complex *__restrict sum ,
   // 1x3 contrib
   if( fClover_k4 > CL_TOL ) {
     // 1x3
-    const size_t s1 = lat[i].neighbor[nu] ;
-    const size_t s2 = lat[s1].neighbor[nu] ;
-    const size_t s3 = lat[s2].neighbor[nu] ;
-    const size_t s4 = lat[s3].back[mu] ;
+    const size_t s1 = site_fwd( i , nu ) ;
+    const size_t s2 = site_fwd( s1 , nu ) ;
+    const size_t s3 = site_fwd( s2 , nu ) ;
+    const size_t s4 = site_bck( s3 , mu ) ;
     multab_suNC( u , lat[i].O[nu] , lat[s1].O[nu] ) ;
     multab_suNC( v , u , lat[s2].O[nu] ) ;
     multab_dag_suNC( u , v , lat[s4].O[mu] ) ;
-    const size_t s5 = lat[s4].back[nu] ;
-    const size_t s6 = lat[s5].back[nu] ;
-    const size_t s7 = lat[s6].back[nu] ;
+    const size_t s5 = site_bck( s4 , nu ) ;
+    const size_t s6 = site_bck( s5 , nu ) ;
+    const size_t s7 = site_bck( s6 , nu ) ;
     multab_dag_suNC( v , u , lat[s5].O[nu] ) ;
     multab_dag_suNC( u , v , lat[s6].O[nu] ) ;
     multab_dag_suNC( v , u , lat[s7].O[nu] ) ;
@@ -740,16 +762,16 @@ compute_clover_s4( GLU_complex *__restrict sum ,
     a_plus_Sxb( sum , u , Clover_k4 ) ;
 #endif
     // 3x1
-    const size_t t1 = lat[i].neighbor[nu] ;
-    const size_t t2 = lat[t1].back[mu] ;
-    const size_t t3 = lat[t2].back[mu] ;
-    const size_t t4 = lat[t3].back[mu] ;
+    const size_t t1 = site_fwd( i , nu ) ;
+    const size_t t2 = site_bck( t1 , mu ) ;
+    const size_t t3 = site_bck( t2 , mu ) ;
+    const size_t t4 = site_bck( t3 , mu ) ;
     multab_dag_suNC( u , lat[i].O[nu] , lat[t2].O[mu] ) ;
     multab_dag_suNC( v , u , lat[t3].O[mu] ) ;
     multab_dag_suNC( u , v , lat[t4].O[mu] ) ;
-    const size_t t5 = lat[t4].back[nu] ;
-    const size_t t6 = lat[t5].neighbor[mu] ;
-    const size_t t7 = lat[t6].neighbor[mu] ;
+    const size_t t5 = site_bck( t4 , nu ) ;
+    const size_t t6 = site_fwd( t5 , mu ) ;
+    const size_t t7 = site_fwd( t6 , mu ) ;
     multab_dag_suNC( v , u , lat[t5].O[nu] ) ;
     multab_suNC( u , v , lat[t5].O[mu] ) ;
     multab_suNC( v , u , lat[t6].O[mu] ) ;
@@ -766,22 +788,22 @@ compute_clover_s4( GLU_complex *__restrict sum ,
   if( fClover_k5 > CL_TOL ) {
     GLU_complex x[ NCNC ] , y[ NCNC ] ;
     GLU_complex s[ NCNC ] , t[ NCNC ] ;
-    const size_t s1 = lat[i].neighbor[nu] ;
-    const size_t s2 = lat[s1].neighbor[nu] ;
-    const size_t s3 = lat[s2].neighbor[nu] ;
-    const size_t s4 = lat[s3].back[mu] ;
-    const size_t s5 = lat[s4].back[mu] ;
-    const size_t s6 = lat[s5].back[mu] ;
+    const size_t s1 = site_fwd( i , nu ) ;
+    const size_t s2 = site_fwd( s1 , nu ) ;
+    const size_t s3 = site_fwd( s2 , nu ) ;
+    const size_t s4 = site_bck( s3 , mu ) ;
+    const size_t s5 = site_bck( s4 , mu ) ;
+    const size_t s6 = site_bck( s5 , mu ) ;
     multab_suNC( s , lat[i].O[nu] , lat[s1].O[nu] ) ;
     multab_dag_suNC( v , lat[s2].O[nu] , lat[s4].O[mu] ) ;
     multab_dagdag_suNC( x , lat[s5].O[mu] , lat[s6].O[mu] ) ;
     multab_suNC( y , s , v ) ;
     multab_suNC( s , y , x ) ;
-    const size_t s7 = lat[s6].back[nu] ;
-    const size_t s8 = lat[s7].back[nu] ;
-    const size_t s9 = lat[s8].back[nu] ;
-    const size_t s10 = lat[s9].neighbor[mu] ;
-    const size_t s11 = lat[s10].neighbor[mu] ;
+    const size_t s7 = site_bck( s6 , nu ) ;
+    const size_t s8 = site_bck( s7 , nu ) ;
+    const size_t s9 = site_bck( s8 , nu ) ;
+    const size_t s10 = site_fwd( s9 , mu ) ;
+    const size_t s11 = site_fwd( s10 , mu ) ;
     multab_dagdag_suNC( t , lat[s7].O[nu] , lat[s8].O[nu] ) ;
     multabdag_suNC( v , lat[s9].O[nu] , lat[s9].O[mu] ) ;
     multab_suNC( x , lat[s10].O[mu] , lat[s11].O[mu] ) ;
@@ -930,11 +952,13 @@ compute_q( GLU_complex q[ NCNC ] ,
   return ;
 }
 
+#ifndef GMUNU_LANES
 // kernel code 
 static void
 compute_Gmunu_kernel( double *__restrict plaq_t ,
 		      double *__restrict plaq_sp ,
 		      double *__restrict qtop ,
+		      double *__restrict plaq ,
 		      const struct site *__restrict lat ,
 		      const size_t i ,
 		      const size_t mu , 
@@ -949,6 +973,15 @@ compute_Gmunu_kernel( double *__restrict plaq_t ,
   // temp matrices in u and v
   GLU_complex u[ NCNC ] GLUalign , v[ NCNC ] GLUalign ;
 #if (defined CLOVER_IMPROVE && !defined PLAQUETTE_FMUNU)
+  // the improved clover overwrites u so the plaquettes are done separately
+  if( plaq != NULL ) {
+    GLU_complex w[ NCNC ] GLUalign ;
+    zero_mat( w ) ;
+    compute_s1( w , u , v , lat , i , mu , nu , 1.0 ) ;
+    plaq[0] = creal( trace( u ) ) ;
+    compute_s1( w , u , v , lat , i , rho , delta , 1.0 ) ;
+    plaq[1] = creal( trace( u ) ) ;
+  }
   // highly improved clover definition
   compute_clover_s1( sum_1 , u , v , lat , i , mu , nu ) ;
   compute_clover_s2( sum_1 , u , v , lat , i , mu , nu ) ;
@@ -961,14 +994,19 @@ compute_Gmunu_kernel( double *__restrict plaq_t ,
 #elif defined PLAQUETTE_FMUNU
   // plaquette definition
   compute_s1( sum_1 , u , v , lat , i , mu , nu , 1.0 ) ;
+  if( plaq != NULL ) plaq[0] = creal( trace( u ) ) ;
   compute_s1( sum_2 , u , v , lat , i , rho , delta , 1.0 ) ;
+  if( plaq != NULL ) plaq[1] = creal( trace( u ) ) ;
 #else
-  // standard clover plaquette definition
+  // standard clover plaquette definition, after compute_s1 u is the
+  // plaquette at i so its trace comes for free
   compute_s1( sum_1 , u , v , lat , i , mu , nu , 1.0 ) ;
+  if( plaq != NULL ) plaq[0] = creal( trace( u ) ) ;
   compute_s2( sum_1 , u , v , lat , i , mu , nu , 1.0 ) ;
   compute_s3( sum_1 , u , v , lat , i , mu , nu , 1.0 ) ;
   compute_s4( sum_1 , u , v , lat , i , mu , nu , 1.0 ) ;
   compute_s1( sum_2 , u , v , lat , i , rho , delta , 1.0 ) ;
+  if( plaq != NULL ) plaq[1] = creal( trace( u ) ) ;
   compute_s2( sum_2 , u , v , lat , i , rho , delta , 1.0 ) ;
   compute_s3( sum_2 , u , v , lat , i , rho , delta , 1.0 ) ;
   compute_s4( sum_2 , u , v , lat , i , rho , delta , 1.0 ) ;
@@ -982,6 +1020,74 @@ compute_Gmunu_kernel( double *__restrict plaq_t ,
 #endif
   return ;
 }
+#endif
+
+// the three planes and their duals we loop
+static const size_t Gmunu_planes[ 3 ][ 4 ] = { { 3 , 0 , 1 , 2 } ,
+					       { 3 , 1 , 2 , 0 } ,
+					       { 3 , 2 , 0 , 1 } } ;
+
+// GG, qtop and (if plaq is not NULL) the temporal and spatial plaquette
+// traces summed over the n <= STAPLE_LANES sites from i. The standard
+// clover builds the leaves of the batch together with clover_lanes()
+static void
+compute_Gmunu_batch( double *__restrict GG ,
+		     double *__restrict qtop ,
+		     double *__restrict plaq ,
+		     const struct site *__restrict lat ,
+		     const size_t i ,
+		     const size_t n )
+{
+  double gg = 0.0 , q = 0.0 , p[ 2 ] = { 0.0 , 0.0 } ;
+  size_t k , l ;
+#ifdef GMUNU_LANES
+  // pad a short batch with the first site
+  size_t site[ STAPLE_LANES ] ;
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    site[ l ] = l < n ? i + l : i ;
+  }
+  for( k = 0 ; k < 3 ; k++ ) {
+    const size_t *pl = Gmunu_planes[ k ] ;
+    GLU_complex sum_1[ STAPLE_LANES ][ NCNC ] GLUalign ;
+    GLU_complex sum_2[ STAPLE_LANES ][ NCNC ] GLUalign ;
+    double p1[ STAPLE_LANES ] , p2[ STAPLE_LANES ] ;
+    clover_lanes( sum_1 , p1 , lat , site , pl[0] , pl[1] ) ;
+    clover_lanes( sum_2 , p2 , lat , site , pl[2] , pl[3] ) ;
+    for( l = 0 ; l < n ; l++ ) {
+      double plt , plsp , ql ;
+      compute_GG_q( sum_1[l] , sum_2[l] , &plt , &plsp , &ql ) ;
+      gg += plt + plsp ;
+      q += ql ;
+      p[0] += p1[l] ; p[1] += p2[l] ;
+    }
+  }
+#else
+  for( l = 0 ; l < n ; l++ ) {
+    for( k = 0 ; k < 3 ; k++ ) {
+      const size_t *pl = Gmunu_planes[ k ] ;
+      double plt , plsp , ql , pk[ 2 ] = { 0.0 , 0.0 } ;
+      compute_Gmunu_kernel( &plt , &plsp , &ql , plaq != NULL ? pk : NULL ,
+			    lat , i + l , pl[0] , pl[1] , pl[2] , pl[3] ) ;
+      gg += plt + plsp ;
+      q += ql ;
+      p[0] += pk[0] ; p[1] += pk[1] ;
+    }
+  }
+#endif
+  *GG += gg ;
+  *qtop += q ;
+  if( plaq != NULL ) {
+    plaq[0] = p[0] ; plaq[1] = p[1] ;
+  }
+  return ;
+}
+
+// number of sites in the batch starting at i
+static inline size_t
+batch_size( const size_t i )
+{
+  return ( LVOLUME - i ) < STAPLE_LANES ? ( LVOLUME - i ) : STAPLE_LANES ;
+}
 
 // this is the driving code for the computation
 void
@@ -989,40 +1095,20 @@ compute_Gmunu( double *__restrict GG ,
 	       double *__restrict qtop ,
 	       const struct site *__restrict lat )
 {
-  // initialise the temporal and spatial plaq and the qtop
-  double plaq_sp = 0. , plaq_t = 0. , Q = 0. ;
+  // initialise the field strength and the qtop
+  double G = 0. , Q = 0. ;
   size_t i ;
   // control factors
-#ifndef NK5
-  fClover_k1 = fabs( Clover_k1 ) ;
-  fClover_k2 = fabs( Clover_k2 ) ;
-  fClover_k3 = fabs( Clover_k3 ) ;
-  fClover_k4 = fabs( Clover_k4 ) ;
-  fClover_k5 = fabs( k5 ) ;
-#endif
+  clover_factors( ) ;
 
-#pragma omp parallel for private(i) reduction(+:plaq_sp) reduction(+:plaq_t) reduction(+:Q)
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    double plsp , plt , q ;
-    compute_Gmunu_kernel( &plt , &plsp , &q , lat ,
-			  i , 3 , 0 , 1 , 2  ) ;
-    plaq_sp = plaq_sp + plsp ;
-    plaq_t = plaq_t + plt ;
-    Q = Q + q ;
-    //
-    compute_Gmunu_kernel( &plt , &plsp , &q , lat ,
-			  i , 3 , 1 , 2 , 0  ) ;
-    plaq_sp = plaq_sp + plsp ;
-    plaq_t = plaq_t + plt ;
-    Q = Q + q ;
-    //
-    compute_Gmunu_kernel( &plt , &plsp , &q , lat ,
-			  i , 3 , 2 , 0 , 1  ) ;
-    plaq_sp = plaq_sp + plsp ;
-    plaq_t = plaq_t + plt ;
+#pragma omp parallel for private(i) reduction(+:G) reduction(+:Q)
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
+    double gg = 0.0 , q = 0.0 ;
+    compute_Gmunu_batch( &gg , &q , NULL , lat , i , batch_size( i ) ) ;
+    G = G + gg ;
     Q = Q + q ;
   }
-  *GG = ( plaq_sp + plaq_t ) ;
+  *GG = G ;
   *qtop = Q ;
   // just to accommodate for the sum over 4 of the others
 #ifdef PLAQUETTE_FMUNU
@@ -1041,13 +1127,7 @@ compute_Gmunu_th( double *red ,
   // I put plaquette in space 0 and qtop in space 1 
   size_t i ;
   // control factors
-#ifndef NK5
-  fClover_k1 = fabs( Clover_k1 ) ;
-  fClover_k2 = fabs( Clover_k2 ) ;
-  fClover_k3 = fabs( Clover_k3 ) ;
-  fClover_k4 = fabs( Clover_k4 ) ;
-  fClover_k5 = fabs( k5 ) ;
-#endif
+  clover_factors( ) ;
 
   // set reduction array to zero
 #pragma omp for private(i)
@@ -1057,23 +1137,10 @@ compute_Gmunu_th( double *red ,
   }
   
 #pragma omp for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    double plsp , plt , q ;
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
     const size_t th = get_GLU_thread() ;
-    compute_Gmunu_kernel( &plt , &plsp , &q , lat ,
-			  i , 3 , 0 , 1 , 2  ) ;
-    red[ 0 + CLINE*th ] += plt + plsp ;
-    red[ 1 + CLINE*th ] += q ; 
-    //
-    compute_Gmunu_kernel( &plt , &plsp , &q , lat ,
-			  i , 3 , 1 , 2 , 0  ) ;
-    red[ 0 + CLINE*th ] += plt + plsp ;
-    red[ 1 + CLINE*th ] += q ; 
-    //
-    compute_Gmunu_kernel( &plt , &plsp , &q , lat ,
-			  i , 3 , 2 , 0 , 1  ) ;
-    red[ 0 + CLINE*th ] += plt + plsp ;
-    red[ 1 + CLINE*th ] += q ;
+    compute_Gmunu_batch( red + 0 + CLINE*th , red + 1 + CLINE*th , NULL ,
+			 lat , i , batch_size( i ) ) ;
   }
 
   // plaquette and clover differ by 4*4
@@ -1088,6 +1155,29 @@ compute_Gmunu_th( double *red ,
   return ;
 }
 
+// clover density and charge of the n sites from i accumulated into GG
+// and qtop, plaq gets the temporal and spatial plaquette traces
+void
+compute_Gmunu_sites( double *__restrict GG ,
+		     double *__restrict qtop ,
+		     double plaq[ 2 ] ,
+		     const struct site *__restrict lat ,
+		     const size_t i ,
+		     const size_t n )
+{
+  double gg = 0.0 , q = 0.0 ;
+  compute_Gmunu_batch( &gg , &q , plaq , lat , i , n ) ;
+  // plaquette and clover differ by 4*4
+#ifdef PLAQUETTE_FMUNU
+  *GG += 16.0 * gg ;
+  *qtop += 16.0 * q ;
+#else
+  *GG += gg ;
+  *qtop += q ;
+#endif
+  return ;
+}
+
 // this is the driving code for the computation
 void
 compute_Gmunu_array( GLU_complex *__restrict qtop , // an LVOLUME array for the qtop
@@ -1095,13 +1185,7 @@ compute_Gmunu_array( GLU_complex *__restrict qtop , // an LVOLUME array for the
 {
   size_t i ;
   // control factors
-#ifndef NK5
-  fClover_k1 = fabs( Clover_k1 ) ;
-  fClover_k2 = fabs( Clover_k2 ) ;
-  fClover_k3 = fabs( Clover_k3 ) ;
-  fClover_k4 = fabs( Clover_k4 ) ;
-  fClover_k5 = fabs( k5 ) ;
-#endif
+  clover_factors( ) ;
 
 #pragma omp parallel for private(i)
   for( i = 0 ; i < LVOLUME ; i++ ) {
@@ -1132,3 +1216,6 @@ compute_Gmunu_array( GLU_complex *__restrict qtop , // an LVOLUME array for the
 #ifdef CLOVER_LOG_DEF
   #undef CLOVER_LOG_DEF
 #endif
+#ifdef GMUNU_LANES
+  #undef GMUNU_LANES
+#endif
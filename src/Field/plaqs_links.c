@@ -22,7 +22,10 @@
  */
 #include "Mainfile.h"
 
-#include "clover.h"   // compute_Gmunu_th()
+#include <float.h>    // DBL_MAX
+
+#include "clover.h"   // compute_Gmunu_th(), compute_Gmunu_sites()
+#include "lanes.h"    // plaquettes_lanes()
 
 #if (defined HAVE_IMMINTRIN_H) && !(defined SINGLE_PREC)
 #include <immintrin.h>
@@ -200,6 +203,36 @@ complete_plaquette( const GLU_complex *__restrict a ,
 #endif
 }
 
+// Re tr of the temporal [0] and spatial [1] plaquettes summed over the
+// n <= STAPLE_LANES sites from i
+static void
+batch_plaquettes( double plaq[ 2 ] ,
+		  const struct site *__restrict lat ,
+		  const size_t i ,
+		  const size_t n )
+{
+  double p[ STAPLE_LANES ][ 2 ] ;
+  size_t site[ STAPLE_LANES ] , l ;
+  // pad a short batch with the first site
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    site[ l ] = l < n ? i + l : i ;
+  }
+  plaquettes_lanes( p , lat , site ) ;
+  plaq[0] = plaq[1] = 0.0 ;
+  for( l = 0 ; l < n ; l++ ) {
+    plaq[0] += p[l][0] ;
+    plaq[1] += p[l][1] ;
+  }
+  return ;
+}
+
+// number of sites in the batch starting at i
+static inline size_t
+batch_size( const size_t i )
+{
+  return ( LVOLUME - i ) < STAPLE_LANES ? ( LVOLUME - i ) : STAPLE_LANES ;
+}
+
 // all of the plaquettes
 double
 all_plaquettes( const struct site *__restrict lat ,
@@ -209,29 +242,11 @@ all_plaquettes( const struct site *__restrict lat ,
   double spplaq = 0. , tplaq = 0.0 ;
   size_t i ; 
 #pragma omp parallel for private(i) reduction(+:spplaq) reduction(+:tplaq) 
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    double p = 0. , face ;
-    size_t mu , nu , s , t ;
-    for( mu = 0 ; mu < ND-1 ; mu++ ) {
-      t = lat[i].neighbor[mu] ; 
-      for( nu = 0 ; nu < mu ; nu++ ) {
-        s = lat[i].neighbor[nu] ;
-	face = complete_plaquette( lat[ i ].O[mu] , lat[ t ].O[nu] , 
-				   lat[ s ].O[mu] , lat[ i ].O[nu] ) ; 
-	p = p + (double)face ;
-      }
-    }
-    spplaq = spplaq + (double)p ;
-    // reinitialise p for the temporal plaquette ...
-    p = 0.0 ;
-    t = lat[i].neighbor[mu] ; 
-    for( nu = 0 ; nu < mu ; nu++ ) {
-      s = lat[i].neighbor[nu] ;
-      face = complete_plaquette( lat[ i ].O[mu] , lat[ t ].O[nu] , 
-				 lat[ s ].O[mu] , lat[ i ].O[nu] ) ; 
-      p = p + (double)face ;
-    }
-    tplaq = tplaq + (double)p ;
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
+    double p[ 2 ] ;
+    batch_plaquettes( p , lat , i , batch_size( i ) ) ;
+    spplaq = spplaq + p[1] ;
+    tplaq = tplaq + p[0] ;
   }
   *sp_plaq = 2.0 * spplaq / (double)( ( ND - 1 ) * ( ND - 2 ) * NC * LVOLUME ) ;
   *t_plaq  = 2.0 * tplaq /  (double)( ( ND - 1 ) * ( ND - 2 ) * NC * LVOLUME ) ;
@@ -244,21 +259,10 @@ av_plaquette( const struct site *__restrict lat )
 {
   double plaq = 0. ;
   size_t i ;
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    register double p = 0. , face ;
-    size_t mu , nu , t , s ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      t = lat[i].neighbor[mu] ; 
-      for( nu = 0 ; nu < mu ; nu++ ) {
-	s = lat[i].neighbor[nu] ;
-	face = complete_plaquette( lat[ i ].O[mu] , 
-				   lat[ t ].O[nu] , 
-				   lat[ s ].O[mu] , 
-				   lat[ i ].O[nu] ) ; 
-	p = p + (double)face ;
-      }
-    }
-    plaq = plaq + (double)p ;
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
+    double p[ 2 ] ;
+    batch_plaquettes( p , lat , i , batch_size( i ) ) ;
+    plaq = plaq + p[0] + p[1] ;
   }
   return 2.0 * plaq /(double)( NC * ND * ( ND - 1 ) * LVOLUME ) ; 
 }
@@ -274,22 +278,11 @@ av_plaquette_th( double *red ,
     red[ 3 + CLINE*i ] = 0.0 ;
   }
 #pragma omp for private(i) 
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    register double p = 0. , face ;
-    size_t mu , nu , t , s ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      t = lat[i].neighbor[mu] ; 
-      for( nu = 0 ; nu < mu ; nu++ ) {
-	s = lat[i].neighbor[nu] ;
-	face = complete_plaquette( lat[ i ].O[mu] , 
-				   lat[ t ].O[nu] , 
-				   lat[ s ].O[mu] , 
-				   lat[ i ].O[nu] ) ; 
-	p = p + (double)face ;
-      }
-    }
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
+    double p[ 2 ] ;
+    batch_plaquettes( p , lat , i , batch_size( i ) ) ;
     const size_t th = get_GLU_thread() ;
-    red[ 3 + CLINE*th ] += p ;
+    red[ 3 + CLINE*th ] += p[0] + p[1] ;
   }
   return ;
 }
@@ -304,9 +297,9 @@ s_plaq( const struct site *__restrict lat )
     register double p = 0. , face ;
     size_t mu , nu , t , s ;
     for( mu = 0 ; mu < ND - 1 ; mu++ ) {
-      t = lat[i].neighbor[mu] ; 
+      t = site_fwd( i , mu ) ; 
       for( nu = 0 ; nu < mu ; nu++ ) {
-	s = lat[i].neighbor[nu] ;
+	s = site_fwd( i , nu ) ;
 	face = complete_plaquette( lat[ i ].O[mu] , 
 				   lat[ t ].O[nu] , 
 				   lat[ s ].O[mu] , 
@@ -328,9 +321,9 @@ t_plaq( const struct site *__restrict lat )
   const size_t mu = ND - 1 ;
   for( i = 0 ; i < LVOLUME ; i++ ) {
     register double p = 0. , face ;
-    size_t nu , t = lat[i].neighbor[mu] , s ; 
+    size_t nu , t = site_fwd( i , mu ) , s ; 
     for( nu = 0 ; nu < mu ; nu++ ) {
-      s = lat[i].neighbor[nu] ;
+      s = site_fwd( i , nu ) ;
       face = complete_plaquette( lat[ i ].O[mu] , 
 				 lat[ t ].O[nu] , 
 				 lat[ s ].O[mu] , 
@@ -392,6 +385,106 @@ gauge_topological_meas_th( double *red ,
   return GLU_FAILURE ;
 }
 
+//////////// FUSED MEASUREMENT SWEEP ////////////
+
+// plaquettes, link traces and (if asked) the clover in one pass over the
+// links, the clover already builds every plaquette so we take those
+void
+gauge_obs_th( struct gauge_obs *obs ,
+	      double *red ,
+	      const struct site *__restrict lat ,
+	      const GLU_bool clover )
+{
+  // per-thread slots are spatial and temporal plaquettes, spatial and
+  // temporal links, the maximum link trace, GG and the charge
+  size_t i ;
+#if ND == 4
+  if( clover == GLU_TRUE ) {
+    clover_factors( ) ;
+  }
+#endif
+#pragma omp for private(i)
+  for( i = 0 ; i < Latt.Nthreads ; i++ ) {
+    size_t k ;
+    for( k = 0 ; k < 7 ; k++ ) {
+      red[ k + CLINE*i ] = 0.0 ;
+    }
+    red[ 4 + CLINE*i ] = -DBL_MAX ;
+  }
+#pragma omp for private(i)
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
+    double *r = red + CLINE*get_GLU_thread() ;
+    double plaq[ 2 ] , splink = 0.0 , res ;
+    const size_t n = batch_size( i ) ;
+    size_t mu , l ;
+    for( l = 0 ; l < n ; l++ ) {
+      for( mu = 0 ; mu < ND-1 ; mu++ ) {
+	speed_trace_Re( &res , lat[i+l].O[mu] ) ;
+	splink += res ;
+	if( res > r[4] ) r[4] = res ;
+      }
+      speed_trace_Re( &res , lat[i+l].O[ND-1] ) ;
+      r[3] += res ;
+      if( res > r[4] ) r[4] = res ;
+    }
+    r[2] += splink ;
+#if ND == 4
+    if( clover == GLU_TRUE ) {
+      compute_Gmunu_sites( r + 5 , r + 6 , plaq , lat , i , n ) ;
+    } else {
+      batch_plaquettes( plaq , lat , i , n ) ;
+    }
+#else
+    batch_plaquettes( plaq , lat , i , n ) ;
+#endif
+    r[0] += plaq[1] ;
+    r[1] += plaq[0] ;
+  }
+  // thread-ordered sum so every thread gets the same answer
+  double sum[ 7 ] = { 0 , 0 , 0 , 0 , -DBL_MAX , 0 , 0 } ;
+  for( i = 0 ; i < Latt.Nthreads ; i++ ) {
+    const double *r = red + CLINE*i ;
+    sum[0] += r[0] ; sum[1] += r[1] ;
+    sum[2] += r[2] ; sum[3] += r[3] ;
+    if( r[4] > sum[4] ) sum[4] = r[4] ;
+    sum[5] += r[5] ; sum[6] += r[6] ;
+  }
+  const double pnorm = ( ND - 1 ) * ( ND - 2 ) * NC * (double)LVOLUME ;
+  obs -> splaq   = 2.0 * sum[0] / pnorm ;
+  obs -> tplaq   = 2.0 * sum[1] / pnorm ;
+  obs -> plaq    = 2.0 * ( sum[0] + sum[1] ) / ( NC * ND * ( ND - 1 ) * (double)LVOLUME ) ;
+  obs -> slink   = sum[2] / ( ( ND - 1 ) * NC * (double)LVOLUME ) ;
+  obs -> tlink   = sum[3] / ( NC * (double)LVOLUME ) ;
+  obs -> link    = ( sum[2] + sum[3] ) / ( ND * NC * (double)LVOLUME ) ;
+  obs -> maxlink = sum[4] / NC ;
+  obs -> GG      = sum[5] / ( 16*LVOLUME ) ;
+  obs -> qtop    = sum[6] * -0.001583143494411527678811 ;
+  // nobody can reuse red until everyone has read it
+  {
+    #pragma omp barrier
+  }
+  return ;
+}
+
+// wrapper for gauge_obs_th() outside of a parallel region
+void
+gauge_obs( struct gauge_obs *obs ,
+	   const struct site *__restrict lat ,
+	   const GLU_bool clover )
+{
+  double red[ CLINE * Latt.Nthreads ] ;
+#pragma omp parallel
+  {
+    struct gauge_obs loc ;
+    gauge_obs_th( &loc , red , lat , clover ) ;
+    #pragma omp master
+    {
+      *obs = loc ;
+    }
+  }
+  return ;
+}
+
 //////////// LINK TRACE MEASUREMENTS ////////////
 
 // all links
@@ -69,13 +69,14 @@ get_midx( const size_t i ,
   return ( even_sum%2 + odd_sum )%Ncolors ;
 }
 
-// initialise the draughtboarding
-// warning :: red and black are allocated in here!
-// idea :: checkerboard the even sites and update the odd
-int
-init_cb( struct draughtboard *db ,
-	 const size_t LENGTH ,
-	 const size_t DIR ) 
+// sites on a side of the tiles of init_blocked_cb()
+#define CB_BLOCK (4)
+
+// count the colours and allocate the lists, leaves the Nsquare at zero
+static int
+allocate_cb( struct draughtboard *db ,
+	     const size_t LENGTH ,
+	     const size_t DIR ) 
 {
   size_t i ;
 
@@ -112,12 +113,37 @@ init_cb( struct draughtboard *db ,
     }
     db -> Nsquare[i] = 0 ;
   }
+  return GLU_SUCCESS ;
+}
+
+// add site i to the end of its colour's list
+static void
+add_cb( struct draughtboard *db ,
+	const size_t i ,
+	const size_t DIR )
+{
+  const size_t midx = get_midx( i , DIR , db -> Ncolors ) ;
+  db -> square[ midx ][ db -> Nsquare[ midx ] ] = i ;
+  db -> Nsquare[ midx ]++ ;
+  return ;
+}
+
+// initialise the draughtboarding
+// warning :: red and black are allocated in here!
+// idea :: checkerboard the even sites and update the odd
+int
+init_cb( struct draughtboard *db ,
+	 const size_t LENGTH ,
+	 const size_t DIR ) 
+{
+  if( allocate_cb( db , LENGTH , DIR ) == GLU_FAILURE ) {
+    return GLU_FAILURE ;
+  }
 
   // set back to zero and redo recording the index of each
+  size_t i ;
   for( i = 0 ; i < LENGTH ; i++ ) {
-    const size_t midx = get_midx( i , DIR , db -> Ncolors ) ;
-    db -> square[ midx ][ db -> Nsquare[ midx ] ] = i ;
-    db -> Nsquare[ midx ]++ ;
+    add_cb( db , i , DIR ) ;
   }
 
   fprintf( stdout , "\n[DB] initialised\n\n" ) ;
@@ -125,6 +151,48 @@ init_cb( struct draughtboard *db ,
   return GLU_SUCCESS ;
 }
 
+// same colouring but the lists visit the lattice one tile at a time
+int
+init_blocked_cb( struct draughtboard *db ,
+		 const size_t DIR ) 
+{
+  // tiles keep the whole of the unit-stride direction so that the
+  // hardware prefetcher still sees long runs
+  size_t LENGTH = 1 , Ntiles = 1 , Nblock = 1 , side[ ND ] , ntile[ ND ] , mu ;
+  for( mu = 0 ; mu < DIR ; mu++ ) {
+    side[ mu ] = ( mu == 0 || Latt.dims[ mu ] < CB_BLOCK ) ? 
+      Latt.dims[ mu ] : CB_BLOCK ;
+    ntile[ mu ] = ( Latt.dims[ mu ] + side[ mu ] - 1 ) / side[ mu ] ;
+    LENGTH *= Latt.dims[ mu ] ;
+    Ntiles *= ntile[ mu ] ;
+    Nblock *= side[ mu ] ;
+  }
+  if( allocate_cb( db , LENGTH , DIR ) == GLU_FAILURE ) {
+    return GLU_FAILURE ;
+  }
+
+  size_t n , k ;
+  for( n = 0 ; n < Ntiles ; n++ ) {
+    for( k = 0 ; k < Nblock ; k++ ) {
+      // position in the tile plus the tile's corner, x[0] fastest
+      size_t i = 0 , stride = 1 , nn = n , kk = k ;
+      for( mu = 0 ; mu < DIR ; mu++ ) {
+	const size_t x = ( nn % ntile[ mu ] ) * side[ mu ] + kk % side[ mu ] ;
+	if( x >= Latt.dims[ mu ] ) break ;
+	i += x * stride ;
+	stride *= Latt.dims[ mu ] ;
+	nn /= ntile[ mu ] ;
+	kk /= side[ mu ] ;
+      }
+      // tiles at the boundary are clipped
+      if( mu == DIR ) {
+	add_cb( db , i , DIR ) ;
+      }
+    }
+  }
+  return GLU_SUCCESS ;
+}
+
 // very different version required for rectangle actions
 int
 init_improved_cb( struct draughtboard *db )
@@ -237,3 +305,5 @@ init_improved_cb( struct draughtboard *db )
   fprintf( stdout , "\n[DB] initialised\n\n" ) ;
   return GLU_SUCCESS ;
 }
+
+#undef CB_BLOCK
@@ -284,23 +284,22 @@ compute_spacing( const int separation[ ND ] ,
   return gen_site( n ) ;
 }
 
-// This is the new bona-fide generic shifting code
+// This is the new bona-fide generic shifting code, only the coordinate
+// in the shifted direction is needed so this is one divide and a modulo
 size_t
 gen_shift( const size_t i , 
 	   const int dir ) // dir can be negative
 {
-  int x[ ND ] ; 
-  get_mom_2piBZ( x , i , ND ) ;
+  const size_t mu = dir >= 0 ? (size_t)dir : (size_t)( -dir - 1 ) ;
+  size_t nu , stride = 1 ;
+  for( nu = 0 ; nu < mu ; nu++ ) {
+    stride *= Latt.dims[ nu ] ;
+  }
+  const size_t L = Latt.dims[ mu ] ;
+  const size_t x = ( i / stride ) % L ;
   if( dir >= 0 ) {
-    x[ dir ] = ( x[ dir ] + 1 ) % Latt.dims[ dir ] ;
-  } else {
-    register const int numu = -dir - 1 ;
-    if( x[ numu ] == 0 ) {
-      x[ numu ] = x[ numu ] - 1 + Latt.dims[ numu ] ;
-    } else {
-      x[ numu ] = ( x[ numu ] - 1 ) % Latt.dims[ numu ] ;
-    }
+    return ( x == L - 1 ) ? i - ( L - 1 ) * stride : i + stride ;
   }
-  return gen_site( x ) ; 
+  return ( x == 0 ) ? i + ( L - 1 ) * stride : i - stride ;
 }
 
@@ -22,20 +22,39 @@
  */
 #include "Mainfile.h"
 
+#include "cpu_dispatch.h" // init_cpu_dispatch()
 #include "geometry.h"   // init_navig()
 #include "SU2_rotate.h" // compute_pertinent_indices
 
-// initialises the navigation for our lattice fields
+// initialises the shared navigation table, all gauge fields use the
+// same one so this only does any work the first time it is called
 void 
-init_navig( struct site *__restrict lat )
+init_navig( void )
 {
+  if( Latt.navig != NULL || Latt.nav_mode == NAVIG_ONTHEFLY ) return ;
+  // 32 bit indices only work if the volume fits
+  if( LVOLUME >= UINT32_MAX ) {
+    fprintf( stdout , "[INIT] volume too large for a 32-bit neighbour "
+	     "table, computing neighbours on the fly\n" ) ;
+    Latt.nav_mode = NAVIG_ONTHEFLY ;
+    return ;
+  }
+  if( GLU_malloc( (void**)&Latt.navig , ALIGNMENT , 
+		  2 * ND * LVOLUME * sizeof( uint32_t ) ) != 0 ) {
+    fprintf( stderr , "[INIT] neighbour table allocation failure, "
+	     "computing neighbours on the fly\n" ) ;
+    Latt.navig = NULL ;
+    Latt.nav_mode = NAVIG_ONTHEFLY ;
+    return ;
+  }
   size_t i ; 
   #pragma omp parallel for private(i)
   for(  i = 0 ; i < LVOLUME ; i++ ) {
+    uint32_t *nav = Latt.navig + 2 * ND * i ;
     size_t mu ;
     for(  mu = 0 ; mu < ND ; mu++ ) {
-      lat[i].neighbor[mu] = gen_shift( i , mu ) ; 
-      lat[i].back[mu] = gen_shift( i , -mu - 1 ) ;
+      nav[ mu ] = (uint32_t)gen_shift( i , mu ) ; 
+      nav[ ND + mu ] = (uint32_t)gen_shift( i , -mu - 1 ) ;
     }
   }
   return ;
@@ -76,9 +95,13 @@ init_latt( void )
   Latt.Nthreads = 1 ;
 #endif
   fprintf( stdout , "[INIT] using %u thread(s) \n" , Latt.Nthreads ) ;
-  // compute su2 indices
-  fprintf( stdout , "[INIT] allocating su(2) subgroup indices\n" ) ;
-  compute_pertinent_indices() ;
+  // point the SU(3) kernels at the best this CPU can do
+  init_cpu_dispatch( ) ;
+  // compute su2 indices, only once as they do not depend on the geometry
+  if( Latt.su2_data == NULL ) {
+    fprintf( stdout , "[INIT] allocating su(2) subgroup indices\n" ) ;
+    compute_pertinent_indices() ;
+  }
   return ;
 }
 
@@ -87,4 +110,7 @@ void
 free_latt( void )
 {
   free( Latt.su2_data ) ;
+  Latt.su2_data = NULL ;
+  free( Latt.navig ) ;
+  Latt.navig = NULL ;
 }
@@ -20,21 +20,76 @@
    @file plan_ffts.c
    @brief planner for the FFTS we use everywhere
  */
+#define _POSIX_C_SOURCE 200809L
+
 #include "Mainfile.h"
 
+#include <fcntl.h>     // fcntl() locks on the wisdom files
+#include <unistd.h>    // ftruncate()
+
 #include "GLU_timer.h" // tells us how long we spent planning FFTs
 #include "str_stuff.h" // append_char()
 
 // guard the whole thing
 #ifdef HAVE_FFTW3_H
 
-// I have reason to believe that this gives better results
-// FFTW_PATIENT OVERWRITES the data in the arrray given, be warned!
-#define GLU_PLAN FFTW_ESTIMATE
+// MEASURE and PATIENT scribble over the arrays they plan with, that is
+// fine here as they are always ones we have only just allocated. In
+// CONDOR_MODE no wisdom is kept so we only measure if asked to
+#if (defined GLU_FFTW_ESTIMATE)
+  #define GLU_PLAN FFTW_ESTIMATE
+#elif (defined GLU_FFTW_MEASURE)
+  #define GLU_PLAN FFTW_MEASURE
+#elif (defined GLU_FFTW_PATIENT)
+  #define GLU_PLAN FFTW_PATIENT
+#elif (defined CONDOR_MODE)
+  #define GLU_PLAN FFTW_ESTIMATE
+#else
+  #define GLU_PLAN FFTW_MEASURE
+#endif
 
 // for ease of reading
 enum{ NOPLAN = 0 } ;
 
+// how many plans of each kind we keep resident in batch mode
+#define NRESIDENT 8
+
+// plans and arrays kept alive between configurations
+static struct {
+  struct fftw_stuff FFTW ;
+  size_t dims[ ND ] ;
+  size_t ARR_SIZE ;
+  size_t DIR ;
+  GLU_bool used ;
+} resident[ NRESIDENT ] ;
+
+static struct {
+  struct fftw_small_stuff FFTW ;
+  size_t dims[ ND ] ;
+  size_t DIR ;
+  size_t howmany ;
+  GLU_bool used ;
+} small_resident[ NRESIDENT ] ;
+
+static size_t Nresident = 0 , Nsmall_resident = 0 ;
+static GLU_bool keep_plans = GLU_FALSE ;
+
+// plans currently alive, fftw_cleanup() would invalidate them
+static size_t Nlive = 0 ;
+
+// do the first DIR dimensions match?
+static GLU_bool
+same_dims( const size_t a[ ND ] ,
+	   const size_t b[ ND ] ,
+	   const size_t DIR )
+{
+  size_t mu ;
+  for( mu = 0 ; mu < DIR ; mu++ ) {
+    if( a[ mu ] != b[ mu ] ) return GLU_FALSE ;
+  }
+  return GLU_TRUE ;
+}
+
 // see if we have wisdom already
 static char*
 obtain_wisdom( int *planflag ,
@@ -70,6 +125,9 @@ obtain_wisdom( int *planflag ,
     #ifdef verbose
     fprintf( stdout , "\n[FFTW] Successful wisdom (%s) attained\n" , str ) ;
     #endif
+    // wait for anyone writing to it to finish
+    struct flock lock = { .l_type = F_RDLCK , .l_whence = SEEK_SET } ;
+    fcntl( fileno( wizzard ) , F_SETLKW , &lock ) ;
     *planflag = fftw_import_wisdom_from_file( wizzard ) ; 
     fclose( wizzard ) ; 
   }
@@ -80,10 +138,43 @@ obtain_wisdom( int *planflag ,
   return str ;
 }
 
-// clean up the allocations by create_plans_DFT
-void
-clean_up_fftw( struct fftw_stuff FFTW ,
-	       const size_t ARR_SIZE )
+// merge our wisdom with whatever is in the file now and write it back,
+// other jobs sharing the file have to wait for the lock
+static void
+save_wisdom( char *str ,
+	     const int planflag ,
+	     const double t0 )
+{
+  fprintf( stdout , "[FFTW] planning %s elapsed :: %e s\n" ,
+	   planflag == NOPLAN ? "from scratch" : "with wisdom" ,
+	   wall_time( ) - t0 ) ;
+#ifndef CONDOR_MODE
+  const int fd = open( str , O_RDWR | O_CREAT , 0644 ) ;
+  FILE *wizzard ;
+  if( fd < 0 || ( wizzard = fdopen( fd , "r+" ) ) == NULL ) {
+    fprintf( stdout , "[FFTW] Cannot save wisdom to %s\n" , str ) ;
+    if( fd >= 0 ) close( fd ) ;
+    free( str ) ;
+    return ;
+  }
+  struct flock lock = { .l_type = F_WRLCK , .l_whence = SEEK_SET } ;
+  fcntl( fd , F_SETLKW , &lock ) ;
+  fftw_import_wisdom_from_file( wizzard ) ;
+  rewind( wizzard ) ;
+  if( ftruncate( fd , 0 ) == 0 ) {
+    fftw_export_wisdom_to_file( wizzard ) ;
+  }
+  // closing drops the lock
+  fclose( wizzard ) ;
+#endif
+  free( str ) ;
+  return ;
+}
+
+// frees everything, resident or not
+static void
+destroy_fftw( struct fftw_stuff FFTW ,
+	      const size_t ARR_SIZE )
 {
   size_t i ;
   for( i = 0 ; i < ARR_SIZE; i++ ) {
@@ -92,14 +183,88 @@ clean_up_fftw( struct fftw_stuff FFTW ,
     fftw_free( FFTW.out[i] ) ; 
     fftw_free( FFTW.in[i] ) ; 
   }
+  if( FFTW.slab_forward != NULL ) {
+    fftw_destroy_plan( FFTW.slab_forward ) ;
+    fftw_destroy_plan( FFTW.slab_backward ) ;
+    fftw_destroy_plan( FFTW.line_forward ) ;
+    fftw_destroy_plan( FFTW.line_backward ) ;
+  }
   fftw_free( FFTW.out ) ; 
   fftw_free( FFTW.in ) ; 
   free( FFTW.forward ) ; 
   free( FFTW.backward ) ; 
-  fftw_cleanup( ) ;
+  Nlive-- ;
+  return ;
+}
+
+// clean up the allocations by create_plans_DFT
+void
+clean_up_fftw( struct fftw_stuff FFTW ,
+	       const size_t ARR_SIZE )
+{
   if( FFTW.psq != NULL ) {
     free( FFTW.psq ) ; 
   }
+  // resident plans are handed back rather than destroyed
+  size_t n ;
+  for( n = 0 ; n < Nresident ; n++ ) {
+    if( resident[n].FFTW.forward == FFTW.forward ) {
+      resident[n].used = GLU_FALSE ;
+      return ;
+    }
+  }
+  destroy_fftw( FFTW , ARR_SIZE ) ;
+  if( keep_plans == GLU_FALSE && Nlive == 0 ) {
+    fftw_cleanup( ) ;
+  }
+  return ;
+}
+
+// the same transforms split into slabs of the DIR-1 fastest directions and
+// bundles of Nline lines along the slowest one, so that a team of threads
+// can share a single field
+static void
+plan_slabs( struct fftw_stuff *FFTW ,
+	    const int dimes[ ND ] ,
+	    const size_t DIR ,
+	    const size_t VOL )
+{
+  FFTW -> slab_forward = FFTW -> slab_backward = NULL ;
+  FFTW -> line_forward = FFTW -> line_backward = NULL ;
+  FFTW -> Nslab = 1 ;
+  FFTW -> slab = VOL ;
+  FFTW -> Nline = 1 ;
+  if( DIR < 2 ) return ;
+
+  // FFTW's dimes[0] is our slowest direction
+  const int n = dimes[ 0 ] ;
+  const size_t slab = VOL / (size_t)n ;
+  size_t Nline = 16 ;
+  while( slab % Nline ) Nline >>= 1 ;
+
+  // slabs and bundles start at different offsets to the arrays we plan
+  // with, if they are not all 64-byte aligned FFTW has to be told
+  const size_t align = 64 / sizeof( GLU_complex ) ;
+  const unsigned flag = GLU_PLAN |
+    ( ( slab % align || Nline % align ) ? FFTW_UNALIGNED : 0 ) ;
+
+  FFTW -> slab_forward = fftw_plan_dft( DIR - 1 , dimes + 1 ,
+					FFTW -> in[0] , FFTW -> out[0] ,
+					FFTW_FORWARD , flag ) ;
+  FFTW -> slab_backward = fftw_plan_dft( DIR - 1 , dimes + 1 ,
+					 FFTW -> out[0] , FFTW -> in[0] ,
+					 FFTW_BACKWARD , flag ) ;
+  FFTW -> line_forward = fftw_plan_many_dft( 1 , &n , (int)Nline ,
+					     FFTW -> out[0] , NULL , (int)slab , 1 ,
+					     FFTW -> out[0] , NULL , (int)slab , 1 ,
+					     FFTW_FORWARD , flag ) ;
+  FFTW -> line_backward = fftw_plan_many_dft( 1 , &n , (int)Nline ,
+					      FFTW -> out[0] , NULL , (int)slab , 1 ,
+					      FFTW -> out[0] , NULL , (int)slab , 1 ,
+					      FFTW_BACKWARD , flag ) ;
+  FFTW -> Nslab = (size_t)n ;
+  FFTW -> slab = slab ;
+  FFTW -> Nline = Nline ;
   return ;
 }
 
@@ -110,6 +275,18 @@ create_plans_DFT( struct fftw_stuff *FFTW ,
 		  const size_t ARR_SIZE ,
 		  const size_t DIR )
 {
+  // see if we have these plans lying around
+  size_t n ;
+  for( n = 0 ; n < Nresident ; n++ ) {
+    if( resident[n].used == GLU_FALSE && resident[n].DIR == DIR &&
+	resident[n].ARR_SIZE == ARR_SIZE &&
+	same_dims( resident[n].dims , dims , DIR ) == GLU_TRUE ) {
+      resident[n].used = GLU_TRUE ;
+      *FFTW = resident[n].FFTW ;
+      return ;
+    }
+  }
+
   // set up our fft
   size_t VOL = 1 , mu , i ;
   int dimes[ DIR ] , planflag ;
@@ -120,9 +297,7 @@ create_plans_DFT( struct fftw_stuff *FFTW ,
     VOL *= dims[ DIR - 1 - mu ] ;
   }
 
-  #ifdef verbose
-  start_timer( ) ;
-  #endif
+  const double t0 = wall_time( ) ;
 
   FFTW -> forward  = malloc( ARR_SIZE * sizeof( fftw_plan ) ) ; 
   FFTW -> backward = malloc( ARR_SIZE * sizeof( fftw_plan ) ) ; 
@@ -149,36 +324,155 @@ create_plans_DFT( struct fftw_stuff *FFTW ,
 					  FFTW -> out[mu] , FFTW -> in[mu] , 
 					  FFTW_BACKWARD , GLU_PLAN ) ;
   }
+  plan_slabs( FFTW , dimes , DIR , VOL ) ;
 
-  // I want to know how long FFTW is taking to plan its FFTs
-  #ifdef verbose
-  print_time( ) ;
-  fprintf( stdout , "[FFTW] plans finished\n\n" ) ;
-  #endif
+  save_wisdom( str , planflag , t0 ) ;
+  Nlive++ ;
 
-#ifndef CONDOR_MODE
-  if( planflag == NOPLAN )  {
-    fftw_export_wisdom_to_filename( str ) ; 
+  // remember them for the next configuration
+  if( keep_plans == GLU_TRUE && Nresident < NRESIDENT ) {
+    resident[ Nresident ].FFTW = *FFTW ;
+    memcpy( resident[ Nresident ].dims , dims , DIR * sizeof( size_t ) ) ;
+    resident[ Nresident ].ARR_SIZE = ARR_SIZE ;
+    resident[ Nresident ].DIR = DIR ;
+    resident[ Nresident ].used = GLU_TRUE ;
+    Nresident++ ;
   }
-#endif
-  free( str ) ;
 
   return ;
 }
 
-// clean up the arrays allocated by small_create_plans_DFT
+// convolve every field with psq, called by all the threads of a team
 void
-small_clean_up_fftw( struct fftw_small_stuff FFTW )
+accelerate_DFT( const struct fftw_stuff *FFTW ,
+		const size_t ARR_SIZE )
 {
-  fftw_free( FFTW.out ) ; 
+  const size_t Nslab = FFTW -> Nslab , slab = FFTW -> slab ;
+  size_t i ;
+
+  // no slabs to split into, one whole field per thread
+  if( FFTW -> slab_forward == NULL ) {
+    #pragma omp for private(i) schedule(dynamic)
+    for( i = 0 ; i < ARR_SIZE ; i++ ) {
+      fftw_execute( FFTW -> forward[i] ) ;
+      size_t j ;
+      for( j = 0 ; j < slab ; j++ ) {
+	FFTW -> out[i][j] *= FFTW -> psq[j] ;
+      }
+      fftw_execute( FFTW -> backward[i] ) ;
+    }
+    return ;
+  }
+
+  // forward transform the fast directions of every slab of every field
+  #pragma omp for private(i)
+  for( i = 0 ; i < ARR_SIZE * Nslab ; i++ ) {
+    const size_t mu = i / Nslab , off = ( i % Nslab ) * slab ;
+    fftw_execute_dft( FFTW -> slab_forward ,
+		      FFTW -> in[mu] + off , FFTW -> out[mu] + off ) ;
+  }
+
+  // a bundle of lines is transformed, multiplied by psq and transformed
+  // back while it is still in cache, no barrier needed in between
+  const size_t Nline = FFTW -> Nline , Nbundle = slab / Nline ;
+  #pragma omp for private(i)
+  for( i = 0 ; i < ARR_SIZE * Nbundle ; i++ ) {
+    const size_t mu = i / Nbundle , off = ( i % Nbundle ) * Nline ;
+    GLU_complex *p = FFTW -> out[mu] + off ;
+    fftw_execute_dft( FFTW -> line_forward , p , p ) ;
+    size_t t , j ;
+    for( t = 0 ; t < Nslab ; t++ ) {
+      GLU_complex *pt = p + t * slab ;
+      const GLU_real *psq = FFTW -> psq + off + t * slab ;
+      for( j = 0 ; j < Nline ; j++ ) {
+	pt[j] *= psq[j] ;
+      }
+    }
+    fftw_execute_dft( FFTW -> line_backward , p , p ) ;
+  }
+
+  // and the fast directions back into in
+  #pragma omp for private(i)
+  for( i = 0 ; i < ARR_SIZE * Nslab ; i++ ) {
+    const size_t mu = i / Nslab , off = ( i % Nslab ) * slab ;
+    fftw_execute_dft( FFTW -> slab_backward ,
+		      FFTW -> out[mu] + off , FFTW -> in[mu] + off ) ;
+  }
+  return ;
+}
+
+// hand out an unused resident small plan if we have one
+static GLU_bool
+find_small_resident( struct fftw_small_stuff *FFTW ,
+		     const size_t dims[ ND ] ,
+		     const size_t DIR ,
+		     const size_t howmany )
+{
+  size_t n ;
+  for( n = 0 ; n < Nsmall_resident ; n++ ) {
+    if( small_resident[n].used == GLU_FALSE && small_resident[n].DIR == DIR &&
+	small_resident[n].howmany == howmany &&
+	same_dims( small_resident[n].dims , dims , DIR ) == GLU_TRUE ) {
+      small_resident[n].used = GLU_TRUE ;
+      *FFTW = small_resident[n].FFTW ;
+      return GLU_TRUE ;
+    }
+  }
+  return GLU_FALSE ;
+}
+
+// remember a small plan for the next configuration
+static void
+keep_small_resident( const struct fftw_small_stuff *FFTW ,
+		     const size_t dims[ ND ] ,
+		     const size_t DIR ,
+		     const size_t howmany )
+{
+  if( keep_plans == GLU_TRUE && Nsmall_resident < NRESIDENT ) {
+    small_resident[ Nsmall_resident ].FFTW = *FFTW ;
+    memcpy( small_resident[ Nsmall_resident ].dims , dims , 
+	    DIR * sizeof( size_t ) ) ;
+    small_resident[ Nsmall_resident ].DIR = DIR ;
+    small_resident[ Nsmall_resident ].howmany = howmany ;
+    small_resident[ Nsmall_resident ].used = GLU_TRUE ;
+    Nsmall_resident++ ;
+  }
+  return ;
+}
+
+// frees everything, resident or not
+static void
+small_destroy_fftw( struct fftw_small_stuff FFTW )
+{
+  // the batched plans are in-place
+  if( FFTW.out != FFTW.in ) {
+    fftw_free( FFTW.out ) ; 
+  }
   fftw_free( FFTW.in ) ;
   fftw_destroy_plan( FFTW.forward ) ;   
   fftw_destroy_plan( FFTW.backward ) ;  
-  fftw_cleanup( ) ;    
+  Nlive-- ;
+  return ;
+}
+
+// clean up the arrays allocated by small_create_plans_DFT
+void
+small_clean_up_fftw( struct fftw_small_stuff FFTW )
+{
   if( FFTW.psq != NULL ) {
     free( FFTW.psq ) ; 
   }
-  
+  size_t n ;
+  for( n = 0 ; n < Nsmall_resident ; n++ ) {
+    if( small_resident[n].FFTW.forward == FFTW.forward ) {
+      small_resident[n].used = GLU_FALSE ;
+      return ;
+    }
+  }
+  small_destroy_fftw( FFTW ) ;
+  if( keep_plans == GLU_FALSE && Nlive == 0 ) {
+    fftw_cleanup( ) ;
+  }
   return ;
 }
 
@@ -188,6 +482,10 @@ small_create_plans_DFT( struct fftw_small_stuff *FFTW ,
 			const size_t dims[ ND ] ,
 			const size_t DIR )
 {
+  if( find_small_resident( FFTW , dims , DIR , 1 ) == GLU_TRUE ) {
+    return ;
+  }
+
   // set up our fft
   size_t VOL = 1 , mu ;
   int dimes[ DIR ] , planflag ;
@@ -202,10 +500,7 @@ small_create_plans_DFT( struct fftw_small_stuff *FFTW ,
   FFTW -> out = fftw_malloc( VOL * sizeof( GLU_complex ) ) ;
   FFTW -> psq = NULL ;
 
-  // initialise the clock
-  #ifdef verbose
-  start_timer( ) ;
-  #endif
+  const double t0 = wall_time( ) ;
 
   char *str = obtain_wisdom( &planflag , dims , DIR , "single_" ) ;
 
@@ -216,19 +511,101 @@ small_create_plans_DFT( struct fftw_small_stuff *FFTW ,
 				    FFTW -> out , FFTW -> in , 
 				    FFTW_BACKWARD , GLU_PLAN ) ; 
 
-  // I want to know how long FFTW is taking to plan its FFTs
-  #ifdef verbose
-  print_time( ) ;
-  fprintf( stdout , "[FFTW] plans finished\n\n" ) ;
-  #endif
+  save_wisdom( str , planflag , t0 ) ;
+  Nlive++ ;
 
-#ifndef CONDOR_MODE
-  if( planflag == NOPLAN ) {
-    fftw_export_wisdom_to_filename( str ) ; 
+  keep_small_resident( FFTW , dims , DIR , 1 ) ;
+
+  return ;
+}
+
+// howmany contiguous fields, each transformed in-place by the same plan
+void
+many_create_plans_DFT( struct fftw_small_stuff *FFTW ,
+		       const size_t dims[ ND ] ,
+		       const size_t DIR ,
+		       const size_t howmany )
+{
+  if( find_small_resident( FFTW , dims , DIR , howmany ) == GLU_TRUE ) {
+    return ;
   }
-#endif
-  free( str ) ;
 
+  size_t VOL = 1 , mu ;
+  int dimes[ DIR ] , planflag ;
+  for( mu = 0 ; mu < DIR ; mu++ ) {
+    dimes[ mu ] = dims[ DIR - 1 - mu ] ;
+    VOL *= dims[ DIR - 1 - mu ] ;
+  }
+
+  FFTW -> in = fftw_malloc( howmany * VOL * sizeof( GLU_complex ) ) ;
+  FFTW -> out = FFTW -> in ;
+  FFTW -> psq = NULL ;
+
+  const double t0 = wall_time( ) ;
+
+  // wisdom for each batch size lives in its own file
+  char type[ 32 ] ;
+  sprintf( type , "many%zu_" , howmany ) ;
+  char *str = obtain_wisdom( &planflag , dims , DIR , type ) ;
+
+  // the fields after the first are only 64-byte aligned if VOL lets them
+  const size_t align = 64 / sizeof( GLU_complex ) ;
+  const unsigned flag = GLU_PLAN | ( VOL % align ? FFTW_UNALIGNED : 0 ) ;
+
+  FFTW -> forward = fftw_plan_dft( DIR , dimes ,
+				   FFTW -> in , FFTW -> in ,
+				   FFTW_FORWARD , flag ) ;
+  FFTW -> backward = fftw_plan_dft( DIR , dimes ,
+				    FFTW -> in , FFTW -> in ,
+				    FFTW_BACKWARD , flag ) ;
+
+  save_wisdom( str , planflag , t0 ) ;
+  Nlive++ ;
+
+  keep_small_resident( FFTW , dims , DIR , howmany ) ;
+
+  return ;
+}
+
+// transform the howmany fields of length VOL from in, in-place with one
+// of the plans of many_create_plans_DFT(), the fields are shared out
+// over the threads
+void
+many_execute_DFT( const fftw_plan plan ,
+		  GLU_complex *in ,
+		  const size_t VOL ,
+		  const size_t howmany )
+{
+  size_t n ;
+  #pragma omp parallel for private(n) schedule(dynamic)
+  for( n = 0 ; n < howmany ; n++ ) {
+    fftw_execute_dft( plan , in + n * VOL , in + n * VOL ) ;
+  }
+  return ;
+}
+
+// keep plans and their arrays alive between configurations
+void
+keep_fftw_plans( void )
+{
+  keep_plans = GLU_TRUE ;
+  return ;
+}
+
+// destroy anything we kept alive
+void
+release_fftw_plans( void )
+{
+  size_t n ;
+  for( n = 0 ; n < Nresident ; n++ ) {
+    destroy_fftw( resident[n].FFTW , resident[n].ARR_SIZE ) ;
+  }
+  for( n = 0 ; n < Nsmall_resident ; n++ ) {
+    small_destroy_fftw( small_resident[n].FFTW ) ;
+  }
+  Nresident = Nsmall_resident = 0 ;
+  keep_plans = GLU_FALSE ;
+  fftw_cleanup( ) ;
   return ;
 }
 
@@ -236,5 +613,6 @@ small_create_plans_DFT( struct fftw_small_stuff *FFTW ,
 #ifdef GLU_PLAN
   #undef GLU_PLAN
 #endif
+#undef NRESIDENT
 
 #endif
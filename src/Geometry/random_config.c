@@ -22,7 +22,7 @@
  */
 #include "Mainfile.h"
 
-#include "par_rng.h"      // for generate_NCxNC()
+#include "par_rng.h"      // par_gaussian_array()
 #include "gramschmidt.h"  // orthogonalisation
 #include "gtrans.h"       // gauge transformations
 
@@ -71,9 +71,11 @@ random_gtrans( struct site *__restrict lat )
   }
 
   size_t i ;
+  par_rng_pass( ) ;
 #pragma omp parallel for private(i)
   for( i = 0 ; i < LVOLUME ; i++ ) {
     GLU_malloc( (void**)&gauge[i] , ALIGNMENT , NCNC * sizeof( GLU_complex ) ) ;
+    par_rng_seek( get_GLU_thread( ) , i , 0 ) ;
     Sunitary_gen( gauge[i] , get_GLU_thread( ) ) ;
   }
 
@@ -95,8 +97,10 @@ random_gtrans_slice( GLU_complex *__restrict *__restrict slice_gauge )
   initialise_par_rng( NULL ) ; 
 
   size_t i ;
+  par_rng_pass( ) ;
   #pragma omp parallel for private(i)
   for( i = 0 ; i < LCU ; i ++  ) {
+    par_rng_seek( get_GLU_thread( ) , i , 0 ) ;
     Sunitary_gen( slice_gauge[i] , get_GLU_thread( ) ) ;
   }
   
@@ -111,8 +115,10 @@ random_transform( struct site *__restrict lat ,
   initialise_par_rng( NULL ) ; 
 
   size_t i ; 
+  par_rng_pass( ) ;
   #pragma omp parallel for private(i)
   for( i = 0 ; i < LVOLUME ; i++ ) {
+    par_rng_seek( get_GLU_thread( ) , i , 0 ) ;
     Sunitary_gen( gauge[i] , get_GLU_thread( ) ) ;
   }
   gtransform( lat , (const GLU_complex **)gauge ) ; 
@@ -126,13 +132,19 @@ random_suNC( struct site *__restrict lat )
   initialise_par_rng( NULL ) ; 
 
   size_t i ;
-  // openmp does not play nice with RNG
+  // openmp does not play nice with RNG, unless it is counter-based
+  par_rng_pass( ) ;
 #pragma omp parallel for private(i)
   for( i = 0 ; i < LVOLUME ; i++ ) {
     uint32_t thread = get_GLU_thread( ) ;
+    // all of the site's gaussians in one go
+    GLU_complex Z[ ND ][ NCNC ] ;
     size_t mu ;
+    par_rng_seek( thread , i , 0 ) ;
+    par_gaussian_array( (GLU_complex*)Z , ND * NCNC , thread ) ;
     for( mu = 0 ; mu < ND ; mu++ ) {
-      Sunitary_gen( lat[i].O[mu] , thread ) ;
+      memcpy( lat[i].O[mu] , Z[mu] , NCNC * sizeof( GLU_complex ) ) ;
+      gram_reunit( lat[i].O[mu] ) ;
     }
   }
   return ;
@@ -29,6 +29,7 @@
 #include "gtrans.h"        // gauge transformations
 #include "line_search.h"   // line searches for best alpha
 #include "par_rng.h"       // Sunitary_gen()
+#include "plan_ffts.h"     // accelerate_DFT()
 #include "plaqs_links.h"   // plaquette routine might be called
 #include "random_config.h" // for the random transformed gauge slices
 
@@ -47,6 +48,9 @@ get_info( const size_t t ,
 {
 #pragma omp master
   {
+    // teams fixing whole slices print one at a time
+    #pragma omp critical (GF_slice_info)
+    {
     if( t == 0 ) {
       fprintf( stdout , "\n" ) ;
     } if( tr < accuracy ) {
@@ -61,29 +65,33 @@ get_info( const size_t t ,
 	       t , tr , iters , control ) ; 
     }
     fprintf( stdout , "\n" ) ;
+    }
   }
   return ;
 }
 
+// rng stream of this thread, unique even inside a team fixing a slice
+static uint32_t
+rng_stream( void )
+{
+#if (defined _OPENMP ) && (defined HAVE_OMP_H )
+  const int level = omp_get_level( ) ;
+  if( level > 1 ) {
+    return (uint32_t)( omp_get_ancestor_thread_num( level - 1 ) *
+		       omp_get_team_size( level ) + omp_get_thread_num( ) ) ;
+  }
+#endif
+  return get_GLU_thread( ) ;
+}
+
 
-// is the same for Landau and Coulomb just with different LENGTHS
+// is the same for Landau and Coulomb, the lengths come from the plans
 void
-FOURIER_ACCELERATE2( struct fftw_stuff *FFTW ) 
+FOURIER_ACCELERATE2( const struct fftw_stuff *FFTW ) 
 {
 #ifdef HAVE_FFTW3_H
-  const fftw_plan *forw = ( const fftw_plan* )FFTW -> forward ;
-  const fftw_plan *back = ( const fftw_plan* )FFTW -> backward ;
-  // single core FFT's
-  size_t mu ;
-#pragma omp for private(mu) schedule(dynamic)
-  for( mu = 0 ; mu < TRUE_HERM ; mu++ ) {
-    fftw_execute( forw[mu] ) ; 
-    size_t i ;
-    for( i = 0 ; i < LCU ; i++ ) {
-      FFTW -> out[ mu ][ i ] *= FFTW -> psq[i] ;
-    }
-    fftw_execute( back[mu] ) ; 
-  }
+  // every thread works on every component
+  accelerate_DFT( FFTW , TRUE_HERM ) ;
 #endif
   return ;
 }
@@ -112,9 +120,9 @@ steep_deriv_CG( GLU_complex **in ,
       A[ mu ] = B[ mu ] = sum[ mu ] = 0.0 ;
     }
     for( mu = 0 ; mu < ND-1 ; mu++ ) {
-      const size_t Ubck = lat[Uidx].back[mu] ;
-      const size_t bck  = lat[i].back[mu] ;
-      const size_t it   = lat[i].neighbor[mu] ;
+      const size_t Ubck = site_bck( Uidx , mu ) ;
+      const size_t bck  = site_bck( i , mu ) ;
+      const size_t it   = site_fwd( i , mu ) ;
 
       memcpy( C , lat[Uidx].O[mu] , NCNC*sizeof(GLU_complex) ) ;
       gtransform_local( slice_gauge[i] , C , slice_gauge[it] ) ;
@@ -513,7 +521,7 @@ steep_fix( GLU_complex **gauge ,
       size_t i ;
       #pragma omp for private(i)
       for( i = 0 ; i < LCU ; i++ ) {
-	Sunitary_gen( gauge[i] , get_GLU_thread( ) ) ;
+	Sunitary_gen( gauge[i] , rng_stream( ) ) ;
       }
       tot_iters += loc_iters ;
       control++ ;
@@ -634,3 +642,112 @@ Coulomb_FA( struct site  *__restrict lat ,
   // and return the total iterations
   return tot_its ;
 }
+
+// every slice is fixed independently by one of Nteams teams, the links
+// are transformed once all of the slices' transformations are known
+size_t
+Coulomb_FA_slices( struct site  *__restrict lat , 
+		   struct fftw_stuff *FFTW ,
+		   const size_t Nteams ,
+		   const double accuracy ,
+		   const size_t max_iter ,
+		   const GLU_bool FACG )
+{
+  initialise_par_rng( NULL ) ;
+
+  size_t (*f)( GLU_complex **gauge ,
+	       struct CGtemps CG ,
+	       struct fftw_stuff *FFTW ,
+	       double *tr ,
+	       const struct site *lat , 
+	       const size_t t ,
+	       const double accuracy , 
+	       const size_t max_iters ) ;
+  if( FACG == GLU_TRUE ) {
+    f = steep_step_FACG ;
+  } else {
+    f = steep_step_FASD ;
+  }
+
+  const size_t LT = Latt.dims[ ND - 1 ] ;
+  const int team = (int)( Latt.Nthreads / Nteams ) ;
+  size_t tot_its = 0 , n ;
+
+  // one transformation matrix per site and CG temporaries per team
+  GLU_complex *gblock = NULL , **g = NULL ;
+  struct CGtemps *CG = calloc( Nteams , sizeof( struct CGtemps ) ) ;
+  if( CG == NULL ||
+      GLU_malloc( (void**)&gblock , ALIGNMENT , LVOLUME * NCNC * sizeof( GLU_complex ) ) != 0 ||
+      GLU_malloc( (void**)&g , ALIGNMENT , LVOLUME * sizeof( GLU_complex* ) ) != 0 ) {
+    fprintf( stderr , "[CG] problem allocating the slice gauge transformations\n" ) ;
+    goto memfree ;
+  }
+  for( n = 0 ; n < Nteams ; n++ ) {
+    if( allocate_temp_cgslice( &CG[n] , FACG ) == GLU_FAILURE ) {
+      fprintf( stderr , "[CG] problem allocating temporary Coulomb arrays\n" ) ;
+      goto memfree ;
+    }
+  }
+
+  fprintf( stdout , "[GF] Fixing %zu slices at a time with teams of %d "
+	   "thread(s)\n" , Nteams , team ) ;
+
+#if (defined _OPENMP ) && (defined HAVE_OMP_H )
+  const int levels = omp_get_max_active_levels( ) ;
+  omp_set_max_active_levels( 2 ) ;
+#endif
+
+  #pragma omp parallel num_threads( Nteams ) reduction(+:tot_its)
+  {
+    const size_t n = get_GLU_thread( ) ;
+    size_t t ;
+    #pragma omp for schedule(dynamic)
+    for( t = 0 ; t < LT ; t++ ) {
+      GLU_complex **gauge = g + LCU * t ;
+      #ifdef OBC_HACK
+      const double acc = ( t == 0 || t == LT-1 ) ? 1E-7 : accuracy ;
+      #else
+      const double acc = accuracy ;
+      #endif
+      size_t slice_its = 0 ;
+      #pragma omp parallel num_threads( team )
+      {
+	size_t i ;
+        #pragma omp for private(i)
+	for( i = 0 ; i < LCU ; i++ ) {
+	  gauge[i] = gblock + NCNC * ( i + LCU * t ) ;
+	  identity( gauge[i] ) ;
+	}
+	const size_t its = steep_fix( gauge , CG[n] , &FFTW[n] , lat ,
+				      t , acc , max_iter , f ) ;
+        #pragma omp master
+	{
+	  slice_its = its ;
+	}
+      }
+      tot_its += slice_its ;
+    }
+  }
+
+#if (defined _OPENMP ) && (defined HAVE_OMP_H )
+  omp_set_max_active_levels( levels ) ;
+#endif
+
+  // the spatial links only need their own slice, the temporal ones the next
+  gtransform( lat , (const GLU_complex**)g ) ;
+
+ memfree :
+
+  free_par_rng() ;
+
+  if( CG != NULL ) {
+    for( n = 0 ; n < Nteams ; n++ ) {
+      free_temp_cgslice( CG[n] ) ;
+    }
+  }
+  free( CG ) ;
+  free( g ) ;
+  free( gblock ) ;
+
+  return tot_its ;
+}
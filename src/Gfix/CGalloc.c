@@ -128,6 +128,60 @@ allocate_temp_lg( struct CGtemps *CG ,
   }
 }
 
+// allocates the temporaries of a team fixing whole slices
+int
+allocate_temp_cgslice( struct CGtemps *CG ,
+		       const GLU_bool FACG )
+{
+  memset( CG , 0 , sizeof( struct CGtemps ) ) ;
+  size_t i ;
+  if( ( CG -> red = calloc( LINE_NSTEPS + CLINE * Latt.Nthreads , sizeof( double ) ) ) == NULL ) {
+    return GLU_FAILURE ;
+  }
+  if( init_cb( &CG -> db , LCU , ND-1 ) == GLU_FAILURE ) {
+    return GLU_FAILURE ;
+  }
+  if( FACG == GLU_FALSE ) return GLU_SUCCESS ;
+
+  if( ( CG -> sn = calloc( TRUE_HERM , sizeof( GLU_complex* ) ) ) == NULL ||
+      ( CG -> in_old = calloc( TRUE_HERM , sizeof( GLU_complex* ) ) ) == NULL ) {
+    return GLU_FAILURE ;
+  }
+  for( i = 0 ; i < TRUE_HERM ; i++ ) {
+    if( GLU_malloc( (void**)&CG -> sn[i] , ALIGNMENT , LCU * sizeof( GLU_complex ) ) != 0 ||
+	GLU_malloc( (void**)&CG -> in_old[i] , ALIGNMENT , LCU * sizeof( GLU_complex ) ) != 0 ) {
+      return GLU_FAILURE ;
+    }
+    size_t j ;
+    for( j = 0 ; j < LCU ; j++ ) {
+      CG -> sn[i][j] = CG -> in_old[i][j] = 0.0 ;
+    }
+  }
+  return GLU_SUCCESS ;
+}
+
+// free a team's slice temporaries
+void
+free_temp_cgslice( struct CGtemps CG )
+{
+  size_t i ;
+  free( CG.red ) ;
+  if( CG.sn != NULL ) {
+    for( i = 0 ; i < TRUE_HERM ; i++ ) {
+      free( CG.sn[i] ) ;
+    }
+  }
+  if( CG.in_old != NULL ) {
+    for( i = 0 ; i < TRUE_HERM ; i++ ) {
+      free( CG.in_old[i] ) ;
+    }
+  }
+  free( CG.sn ) ;
+  free( CG.in_old ) ;
+  free_cb( &CG.db ) ;
+  return ;
+}
+
 // free Coulomb temporaries
 void
 free_temp_cg( struct gauges G ,
@@ -28,79 +28,112 @@
 #include "plaqs_links.h"   // plaqutte and link measurements
 #include "random_config.h" // latt_reunitU()
 
-// Coulomb gauge fixing code
-size_t
-Coulomb( struct site *__restrict lat , 
-	 const double accuracy , 
-	 const size_t iter )
+// plans and p^2 for one team's slice FFTs
+static void
+plan_slice_ffts( struct fftw_stuff *FFTW )
 {
-  double splink , tlink ;
-  all_links( lat , &splink , &tlink ) ;
-
-  fprintf( stdout , "[GF] Initial Tlink :: %1.15f || Slink :: %1.15f \n"
-	   "[GF] Plaquette :: %1.15f \n", 
-	   tlink , splink , av_plaquette( lat ) ) ; 
-
-  struct fftw_stuff FFTW ;
   size_t i ;
-  
   // put an ifdef guard here as SD requires none of this ...
 #ifdef HAVE_FFTW3_H
 
   // create the fftw plans, or read them if they are stored
-  create_plans_DFT( &FFTW , Latt.dims , TRUE_HERM , ND - 1 ) ;
+  create_plans_DFT( FFTW , Latt.dims , TRUE_HERM , ND - 1 ) ;
   
-  FFTW.psq = malloc( LCU * sizeof( GLU_real ) ) ; 
+  FFTW -> psq = malloc( LCU * sizeof( GLU_real ) ) ; 
   
   // we calculate the lattice p-squared here and pass it to the FFT-accelerator
 #pragma omp parallel for private(i) 
   for( i = 0 ; i < LCU ; i ++ ) {
-    FFTW.psq[i] = MAX_COULOMB / ( gen_p_sq( i , ND - 1 ) ) ;
+    FFTW -> psq[i] = MAX_COULOMB / ( gen_p_sq( i , ND - 1 ) ) ;
   }
 
   /////  End of the search for Wisdom  ////
 #else
   
-  FFTW.in = malloc( ( TRUE_HERM ) * sizeof( GLU_complex* ) ) ; 
+  FFTW -> in = malloc( ( TRUE_HERM ) * sizeof( GLU_complex* ) ) ; 
   #pragma omp parallel for private(i)
   for(  i = 0 ; i < TRUE_HERM ; i++  ) {
-    FFTW.in[i] = ( GLU_complex* )malloc( LCU * sizeof( GLU_complex ) ) ; 
+    FFTW -> in[i] = ( GLU_complex* )malloc( LCU * sizeof( GLU_complex ) ) ; 
   }
   // these are dummy arrays
-  FFTW.out = NULL ;
-  FFTW.psq = NULL ;
-  FFTW.forward = NULL ;
-  FFTW.backward = NULL ;
+  FFTW -> out = NULL ;
+  FFTW -> psq = NULL ;
+  FFTW -> forward = NULL ;
+  FFTW -> backward = NULL ;
 
 #endif
-  
-  const size_t iters =
-    #ifdef GLU_GFIX_SD
-    Coulomb_FA( lat , &FFTW , accuracy , iter , GLU_FALSE ) ;
-    #else
-    Coulomb_FA( lat , &FFTW , accuracy , iter , GLU_TRUE ) ;
-    #endif
- 
+  return ;
+}
+
+// free what plan_slice_ffts() set up
+static void
+clean_slice_ffts( struct fftw_stuff FFTW )
+{
 #ifdef HAVE_FFTW3_H
-    clean_up_fftw( FFTW , TRUE_HERM ) ;
+  clean_up_fftw( FFTW , TRUE_HERM ) ;
 #else
-  
+  size_t i ;
   #pragma omp parallel for private(i) 
   for( i = 0 ; i < TRUE_HERM ; i ++  ) {
     free( FFTW.in[i] ) ;
   }
   free( FFTW.in ) ;
-
 #endif
+  return ;
+}
+
+// Coulomb gauge fixing code
+size_t
+Coulomb( struct site *__restrict lat , 
+	 const double accuracy , 
+	 const size_t iter ,
+	 const size_t Nteams )
+{
+  struct gauge_obs obs ;
+  gauge_obs( &obs , lat , GLU_FALSE ) ;
+
+  fprintf( stdout , "[GF] Initial Tlink :: %1.15f || Slink :: %1.15f \n"
+	   "[GF] Plaquette :: %1.15f \n", 
+	   obs.tlink , obs.slink , obs.plaq ) ; 
+
+  #ifdef GLU_GFIX_SD
+  const GLU_bool FACG = GLU_FALSE ;
+  #else
+  const GLU_bool FACG = GLU_TRUE ;
+  #endif
+
+  // no more teams than threads or slices
+  size_t teams = Nteams ;
+  if( teams > Latt.Nthreads ) teams = Latt.Nthreads ;
+  if( teams > Latt.dims[ ND - 1 ] ) teams = Latt.dims[ ND - 1 ] ;
+
+  size_t iters , n ;
+  if( teams > 1 ) {
+    // each team gets its own plans and arrays
+    struct fftw_stuff *FFTW = malloc( teams * sizeof( struct fftw_stuff ) ) ;
+    for( n = 0 ; n < teams ; n++ ) {
+      plan_slice_ffts( &FFTW[n] ) ;
+    }
+    iters = Coulomb_FA_slices( lat , FFTW , teams , accuracy , iter , FACG ) ;
+    for( n = 0 ; n < teams ; n++ ) {
+      clean_slice_ffts( FFTW[n] ) ;
+    }
+    free( FFTW ) ;
+  } else {
+    struct fftw_stuff FFTW ;
+    plan_slice_ffts( &FFTW ) ;
+    iters = Coulomb_FA( lat , &FFTW , accuracy , iter , FACG ) ;
+    clean_slice_ffts( FFTW ) ;
+  }
 
   // turn this off and the code works with OBC!
   latt_reunitU( lat ) ;
 
-  all_links( lat , &splink , &tlink ) ;
+  gauge_obs( &obs , lat , GLU_FALSE ) ;
   fprintf( stdout , "[GF] Tuning :: %f || Iterations :: %zu ||"
 	   "\n[GF] Final Tlink :: %1.15f "
 	   "|| Slink :: %1.15f \n[GF] Plaquette :: %1.15f \n" , 
-	   Latt.gf_alpha , iters , tlink , splink , av_plaquette( lat ) ) ; 
+	   Latt.gf_alpha , iters , obs.tlink , obs.slink , obs.plaq ) ; 
 
   return iters ; 
 }
@@ -32,6 +32,7 @@
 #include "lin_derivs.h"  // linear approximation of lie matrices
 #include "line_search.h" // evaluate alpha
 #include "log_derivs.h"  // log-def of lie matrices 
+#include "plan_ffts.h"   // accelerate_DFT()
 #include "plaqs_links.h" // plaquette routine might be called
 
 static int
@@ -72,24 +73,13 @@ FA_deriv( double *red ,
   return GLU_SUCCESS ;
 }
 
-// is the same for Landau and Coulomb just with different LENGTHS
+// is the same for Landau and Coulomb, the lengths come from the plans
 void
-FOURIER_ACCELERATE3( struct fftw_stuff *FFTW ) 
+FOURIER_ACCELERATE3( const struct fftw_stuff *FFTW ) 
 {
 #ifdef HAVE_FFTW3_H
-  const fftw_plan *forw = ( const fftw_plan* )FFTW -> forward ;
-  const fftw_plan *back = ( const fftw_plan* )FFTW -> backward ;
-  // single core FFT's
-  size_t mu ;
-  #pragma omp for private(mu) schedule(dynamic)
-  for( mu = 0 ; mu < TRUE_HERM ; mu++ ) {
-    fftw_execute( forw[mu] ) ; 
-    size_t i ;
-    for( i = 0 ; i < LVOLUME ; i++ ) {
-      FFTW -> out[ mu ][ i ] *= FFTW -> psq[i] ;
-    }
-    fftw_execute( back[mu] ) ; 
-  }
+  // every thread works on every component
+  accelerate_DFT( FFTW , TRUE_HERM ) ;
 #endif
   return ;
 }
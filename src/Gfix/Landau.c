@@ -23,7 +23,10 @@
   Landau gauge fixing code, malloc's the ffts and
   calculates psq. Then calls the FA code in gtrans.c
   If we do not reach adequate convergence #GF_GLU_FAILURES restart(s)
-  with a random gauge transform is(are) performed.
+  with a random gauge transform is(are) performed. The restarts either
+  reread the file or start from a snapshot of the links kept in memory.
+  With LUXURY_GAUGE the random copies are fixed concurrently by teams
+  of threads, each with its own plans and copy of the links
  */
 #include "Mainfile.h"
 
@@ -31,12 +34,24 @@
 #include "geometry.h"      // lattice geometry, used for psq
 #include "gftests.h"       // derivative evaluations
 #include "GLU_malloc.h"    // malllocs
+#include "GLU_memcheck.h"  // room for the snapshot?
+#include "GLU_timer.h"     // restart latency
+#include "gramschmidt.h"   // reunitarise the rebuilt links
 #include "MAG.h"           // for randomly restarting the MAG
+#include "par_rng.h"       // rng for the Gribov copies
 #include "plan_ffts.h"     // FFTW wrappers
 #include "plaqs_links.h"   // average plaquette and link trace
 #include "read_headers.h"  // understands header formats
 #include "read_config.h"   // configuration reader
 #include "random_config.h" // random config and lattice reunit
+#include "U_Nops.h"         // shorten() and rebuild()
+
+// pristine links kept for the random restarts
+struct snapshot {
+  GF_snapshot type ;
+  struct site *lat ;
+  GLU_real *small ;
+} ;
 
 // output the data, pass lat for the plaquette
 static void
@@ -49,16 +64,16 @@ output_fixing_info( struct site *lat ,
   
   ////////// Print out the Gauge Fixing information /////////////
 
+  // plaquette and link traces in a single sweep
+  struct gauge_obs obs ;
+  gauge_obs( &obs , lat , GLU_FALSE ) ;
   printf( "[GF] Plaquette :: %1.15f \n[GF] Accuracy :: %1.4e\n" , 
-	  av_plaquette( lat ) , theta ) ;
-  GLU_real tr ;
-  const double link = indivlinks( lat , &tr ) ;
+	  obs.plaq , theta ) ;
   printf( "[GF] Iters :: %zu\n[GF] Link trace :: %1.15f || Maximum :: %1.15f\n" ,
-	  iters , link , tr / NC ) ; 
+	  iters , obs.link , obs.maxlink ) ; 
   double lin , log ;
   const_time( lat , &lin , &log ) ; 
   printf( "[GF] Temporal constance || Lin %e || Log %e \n" , lin , log ) ;
-  gauge_functional( lat ) ;
   printf( "[GF] Functional :: %1.15f\n" , gauge_functional( lat ) ) ;
 
   ///////////////////////////////////////////////////////////////
@@ -85,9 +100,129 @@ print_failure_info( const size_t failure ,
   return ;
 }
 
+// plan the FFTs and the fourier acceleration factor psq
+static void
+plan_landau_ffts( struct fftw_stuff *FFTW )
+{
+  size_t i ;
+#ifdef HAVE_FFTW3_H
+
+  /////////////// Look for Wisdom //////////////
+  create_plans_DFT( FFTW , Latt.dims , TRUE_HERM , ND ) ;
+
+  FFTW -> psq = malloc( LVOLUME * sizeof( GLU_real ) ) ; 
+  #pragma omp parallel
+  {
+    #pragma omp for private(i)
+    for(  i = 0 ; i < LVOLUME ; i++  ) {
+      FFTW -> psq[i] = MAX_LANDAU / ( gen_p_sq( i , ND )  ) ; 
+    }
+  }
+  
+  ///////// End of the search for Wisdom //////
+#else 
+  FFTW -> in = malloc( ( TRUE_HERM ) * sizeof( GLU_complex* ) ) ; 
+  #pragma omp parallel for private(i)
+  for(  i = 0 ; i < TRUE_HERM ; i++  ) {
+    GLU_malloc( (void**)&FFTW -> in[i] , ALIGNMENT , LVOLUME * sizeof( GLU_complex ) ) ;
+  }
+  // these are really dummy variables that don't get used in the SD
+  FFTW -> out = NULL ; FFTW -> psq = NULL ;
+  FFTW -> forward = NULL , FFTW -> backward = NULL ;
+#endif
+  return ;
+}
+
+// free what plan_landau_ffts() set up
+static void
+clean_landau_ffts( struct fftw_stuff FFTW )
+{
+#ifdef HAVE_FFTW3_H
+  // free mallocs
+  clean_up_fftw( FFTW , TRUE_HERM ) ;
+#else
+  size_t i ;
+  #pragma omp parallel for private(i)
+  for( i = 0 ; i < TRUE_HERM ; i++ ) {
+    free( FFTW.in[i] ) ; 
+  }
+  free( FFTW.in ) ; 
+#endif
+  return ;
+}
+
 #if ( defined LUXURY_GAUGE )
 
-// fast routine used here
+// accuracy of the first look at the functional of a copy
+#define LUXURY_FIRST_LOOK (1E-2)
+
+// how many multiples of the accuracy a copy is still allowed to fall
+#define LUXURY_MARGIN (10.0)
+
+// a team of threads fixing one copy at a time
+struct luxury_team {
+  struct site *lat ;
+  struct fftw_stuff FFTW ;
+} ;
+
+// the functional only decreases as we fix, is this copy clearly losing?
+static GLU_bool
+clearly_losing( const double F ,
+		const double theta ,
+		const double best )
+{
+#ifdef BEST_COPY
+  // near the extremum what is left to fall goes like theta
+  return ( F - LUXURY_MARGIN * theta > best ) ? GLU_TRUE : GLU_FALSE ;
+#else
+  // cannot climb back above the worst copy we have
+  return ( F < best ) ? GLU_TRUE : GLU_FALSE ;
+#endif
+}
+
+// fix a copy a decade of accuracy at a time, leaving early if it is
+// clearly losing, returns 123456789 if it does not converge
+static size_t
+fix_copy( struct site *lat_copy ,
+	  struct fftw_stuff *FFTW ,
+	  double *tr ,
+	  const double *best ,
+	  GLU_bool *abandoned )
+{
+  // set the accuracy to be low
+  const double tempacc = 1E-6 ;
+  const size_t max = 1000 ;
+  size_t iters = 0 ;
+  double stage_acc = LUXURY_FIRST_LOOK ;
+  *abandoned = GLU_FALSE ;
+  for( ;; ) {
+    #ifdef GLU_GFIX_SD
+    const size_t loc_iters = FASD( lat_copy , FFTW , tr , stage_acc , max - iters ) ;
+    #else
+    const size_t loc_iters = FACG( lat_copy , FFTW , tr , stage_acc , max - iters ) ;
+    #endif
+    if( loc_iters == 123456789 ) return 123456789 ;
+    iters += loc_iters ;
+    if( stage_acc == tempacc ) return iters ;
+    if( iters >= max ) return 123456789 ;
+
+    double best_now ;
+    #pragma omp critical (luxury_best)
+    {
+      best_now = *best ;
+    }
+    if( clearly_losing( gauge_functional( lat_copy ) , *tr ,
+			best_now ) == GLU_TRUE ) {
+      *abandoned = GLU_TRUE ;
+      return iters ;
+    }
+    // next decade, finishing exactly on tempacc
+    stage_acc = ( 0.1 * stage_acc > 1.5 * tempacc ) ? 0.1 * stage_acc : tempacc ;
+  }
+  return iters ;
+}
+
+// fast routine used here, teams of threads fix copies concurrently
 static size_t
 luxury_copy_fast( struct site *lat ,
 		  struct fftw_stuff *FFTW ,
@@ -95,11 +230,18 @@ luxury_copy_fast( struct site *lat ,
 		  const double acc ,
 		  const size_t max_iters ) 
 {
-  size_t i , iters = 0 , copies ;
+  size_t i , n , iters = 0 , tot_iters = 0 , Nabandoned = 0 ;
+  const size_t max = 1000 ;
 
-  struct site *lat_copy = NULL , *lat_best = NULL ;
+  struct site *lat_best = NULL ;
+  struct luxury_team *team = NULL ;
   GLU_complex **gauge = NULL ;
 
+  // as many teams as the threads, the copies and the memory allow
+  size_t Nteams = Latt.Nthreads < LUXURY_GAUGE ? Latt.Nthreads : LUXURY_GAUGE ;
+  Nteams = have_memory_luxury( Nteams ) ;
+  const size_t threads = Latt.Nthreads / Nteams ;
+
   // allocate new gauge field
   if( GLU_malloc( (void**)&gauge , 16 , LVOLUME * sizeof( GLU_complex* ) ) != 0 ) {
     fprintf( stderr , "[GF] luxury copy fast failed to allocate "
@@ -111,84 +253,121 @@ luxury_copy_fast( struct site *lat ,
     gauge[i] = ( GLU_complex* )malloc( NCNC * sizeof( GLU_complex ) ) ; 
     identity( gauge[i] ) ;
   }
-  
-  if( ( lat_copy = allocate_lat( ) ) == NULL ||
-      ( lat_best = allocate_lat( ) ) == NULL ) {
+  if( ( team = calloc( Nteams , sizeof( struct luxury_team ) ) ) == NULL ) {
+    fprintf( stderr , "[GF] luxury copy fast failed to allocate "
+	     "the teams\n" ) ;
+    goto memfree ;
+  }
+
+  // the first team uses the plans we were given, the rest get their own
+  team[0].FFTW = *FFTW ;
+  for( n = 1 ; n < Nteams ; n++ ) {
+    plan_landau_ffts( &team[n].FFTW ) ;
+  }
+  for( n = 0 ; n < Nteams ; n++ ) {
+    if( ( team[n].lat = allocate_lat( ) ) == NULL ) {
+      fprintf( stderr , "[GF] luxury gauge temporary allocation failure\n" ) ;
+      goto memfree ;
+    }
+  }
+  if( ( lat_best = allocate_lat( ) ) == NULL ) {
     fprintf( stderr , "[GF] luxury gauge temporary allocation failure\n" ) ;
     goto memfree ;
   }
+  // if every copy fails we keep what we came in with
+  copy_lat( lat_best , lat ) ;
 
 #ifdef BEST_COPY
-  double maxlink = 1.0 , newlink ;
+  double maxlink = 1.0 ;
 #else
-  double maxlink = 0.0 , newlink ;
+  double maxlink = 0.0 ;
 #endif
+
+  fprintf( stdout , "[GF] %d Gribov copies on %zu team(s) of %zu thread(s)\n" ,
+	   LUXURY_GAUGE , Nteams , threads ) ;
+  initialise_par_rng( NULL ) ;
+  const double t_start = wall_time( ) ;
+
+#if (defined _OPENMP ) && (defined HAVE_OMP_H )
+  const int levels = omp_get_max_active_levels( ) ;
+  omp_set_max_active_levels( 2 ) ;
+#endif
+
   // loop over the number of gauge copies !
-  for( copies = 0 ; copies < LUXURY_GAUGE ; copies++ ) {
-    
-    // copy our lattice fields
-#pragma omp parallel for private(i)
-    for( i = 0 ; i < LVOLUME ; i++ ) {
-      size_t mu ;
-      for( mu = 0 ; mu < ND ; mu++ ) {
-	equiv( lat_copy[i].O[mu] , lat[i].O[mu] ) ;
+  size_t copies ;
+  #pragma omp parallel num_threads(Nteams) reduction(+:tot_iters) reduction(+:Nabandoned)
+  {
+    struct luxury_team *T = &team[ get_GLU_thread( ) ] ;
+#if (defined _OPENMP ) && (defined HAVE_OMP_H )
+    omp_set_num_threads( threads ) ;
+#endif
+    #pragma omp for schedule(dynamic)
+    for( copies = 0 ; copies < LUXURY_GAUGE ; copies++ ) {
+      
+      // copy our lattice fields
+      copy_lat( T -> lat , lat ) ;
+
+      // perform a random gauge transform, one team at a time on the rng
+      #pragma omp critical (luxury_rng)
+      {
+	random_transform( T -> lat , gauge ) ;
       }
-    }
 
-    // perform a random gauge transform
-    random_transform( lat_copy , gauge ) ;
-    // set the accuracy to be low
-    const double tempacc = 1E-6 ;
-    const double max = 1000 ;
-    #ifdef GLU_GFIX_SD
-    iters = FASD( lat_copy , FFTW , tr , tempacc , max ) ; 
-    #else
-    iters = FACG( lat_copy , FFTW , tr , tempacc , max ) ; 
-    #endif
+      double tr_copy ;
+      GLU_bool abandoned ;
+      const size_t copy_iters = fix_copy( T -> lat , &T -> FFTW , &tr_copy ,
+					  &maxlink , &abandoned ) ;
+      tot_iters += copy_iters != 123456789 ? copy_iters : max ;
     
-    // compute the link , wrap this to the functional?
-    newlink = gauge_functional( lat_copy ) ;
-    fprintf( stdout , "  [COPY] %zu [FUNCTIONAL] %1.15f [ITER] %zu " , 
-	     copies , newlink , iters ) ; 
-    #ifdef BEST_COPY 
-    // the best copy is defined as the effective minimisation of the Gauge-functional 
-    if( newlink < maxlink && iters != max && iters != 123456789 ) 
-    #else
-    if( newlink > maxlink && iters != max && iters != 123456789 ) 
-    #endif
+      // compute the link , wrap this to the functional?
+      const double newlink = gauge_functional( T -> lat ) ;
+
+      #pragma omp critical (luxury_best)
       {
-	maxlink = newlink ;
-	fprintf( stdout , " -> Copy accepted\n" ) ;
-	// copy our lattice fields
-        #pragma omp parallel for private(i)
-	for( i = 0 ; i < LVOLUME ; i++ ) {
-	  size_t mu ;
-	  for( mu = 0 ; mu < ND ; mu++ ) {
-	    equiv( lat_best[i].O[mu] , lat_copy[i].O[mu] ) ;
-	  }
+	fprintf( stdout , "  [COPY] %zu [FUNCTIONAL] %1.15f [ITER] %zu " , 
+		 copies , newlink , copy_iters ) ; 
+	if( abandoned == GLU_TRUE ) {
+	  fprintf( stdout , " -> Copy abandoned\n" ) ;
+	  Nabandoned++ ;
 	}
-      } else {
-      double diff = newlink - maxlink ;
-      fprintf( stdout , " -> Copy rejected %e\n" , diff ) ;
+        #ifdef BEST_COPY 
+	// the best copy is defined as the effective minimisation of the Gauge-functional 
+	else if( newlink < maxlink && copy_iters != 123456789 ) 
+        #else
+	else if( newlink > maxlink && copy_iters != 123456789 ) 
+        #endif
+	  {
+	    maxlink = newlink ;
+	    fprintf( stdout , " -> Copy accepted\n" ) ;
+	    // copy our lattice fields
+	    copy_lat( lat_best , T -> lat ) ;
+	  } else {
+	  double diff = newlink - maxlink ;
+	  fprintf( stdout , " -> Copy rejected %e\n" , diff ) ;
+	}
+      }
     }
   }
 
+#if (defined _OPENMP ) && (defined HAVE_OMP_H )
+  omp_set_max_active_levels( levels ) ;
+#endif
+
+  const double t_copies = wall_time( ) - t_start ;
+  fprintf( stdout , "[GF] Copies :: %d || Abandoned :: %zu || Iters :: %zu\n"
+	   "[GF] Copies per hour :: %f\n" , LUXURY_GAUGE , Nabandoned ,
+	   tot_iters , t_copies > 0.0 ? 3600.0 * LUXURY_GAUGE / t_copies : 0.0 ) ;
  
   // set our lattice to our chosen copy
-#pragma omp parallel for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    size_t mu ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      equiv( lat[i].O[mu] , lat_best[i].O[mu] ) ;
-    }
-  }
+  copy_lat( lat , lat_best ) ;
   
   // final convergence run god I hope this one doesn't fail! Pretty unlikely
   #ifdef GLU_GFIX_SD
-  iters += FASD( lat , FFTW , tr , acc , max_iters ) ; 
+  iters = FASD( lat , FFTW , tr , acc , max_iters ) ; 
   #else
-  iters += FACG( lat , FFTW , tr , acc , max_iters ) ; 
+  iters = FACG( lat , FFTW , tr , acc , max_iters ) ; 
   #endif
+  if( iters != 123456789 ) iters += tot_iters ;
   
   printf( "FINISHED\n" ) ;
 
@@ -203,8 +382,14 @@ luxury_copy_fast( struct site *lat ,
     free( gauge ) ;
   }
 
-  // free the lattice temporaries
-  free_lat( lat_copy ) ;
+  // free the teams, the first one's plans belong to our caller
+  if( team != NULL ) {
+    for( n = 0 ; n < Nteams ; n++ ) {
+      free_lat( team[n].lat ) ;
+      if( n > 0 ) clean_landau_ffts( team[n].FFTW ) ;
+    }
+    free( team ) ;
+  }
   free_lat( lat_best ) ;
   
   return iters ;
@@ -244,10 +429,15 @@ grab_file( struct site *lat ,
 {
   struct head_data HEAD_DATA ;
   FILE *config = fopen( infile , "rb" ) ;
+  if( config == NULL ) {
+    printf( "[IO] cannot reopen %s \n" , infile ) ;
+    return GLU_FAILURE ;
+  }
   // assume the chksum is correct
   if( read_header( config , &HEAD_DATA , GLU_FALSE ) == GLU_FAILURE ||
       get_config_SUNC( config , lat , HEAD_DATA ) == GLU_FAILURE ) {
     printf( "[IO] binary file read error \n" ) ;
+    fclose( config ) ;
     return GLU_FAILURE ;
   } 
   random_transform( lat , gauge ) ; 
@@ -256,48 +446,115 @@ grab_file( struct site *lat ,
   return GLU_SUCCESS ;
 }
 
+// keep a copy of the links in the requested form if we have the room
+static void
+take_snapshot( struct snapshot *snap ,
+	       const struct site *lat ,
+	       const GF_snapshot type )
+{
+  snap -> type = type ;
+  snap -> lat = NULL ;
+  snap -> small = NULL ;
+#if NC > 3
+  // shorten() only knows SU(2) and SU(3)
+  if( snap -> type == GF_SNAPSHOT_SMALL ) {
+    fprintf( stderr , "[GF] SMALL snapshot needs NC < 4, keeping the "
+	     "full links\n" ) ;
+    snap -> type = GF_SNAPSHOT_FULL ;
+  }
+#endif
+  if( snap -> type == GF_SNAPSHOT_NONE ) return ;
+  if( have_memory_snapshot( snap -> type ) == GLU_FAILURE ) {
+    snap -> type = GF_SNAPSHOT_NONE ;
+    return ;
+  }
+  const size_t Nshort = NCNC - 1 ;
+  size_t i ;
+  switch( snap -> type ) {
+  case GF_SNAPSHOT_NONE :
+    return ;
+  case GF_SNAPSHOT_FULL :
+    if( ( snap -> lat = allocate_lat( ) ) == NULL ) break ;
+    copy_lat( snap -> lat , lat ) ;
+    fprintf( stdout , "[GF] Restarts use a full snapshot of the links\n" ) ;
+    return ;
+  case GF_SNAPSHOT_SMALL :
+    if( GLU_malloc( (void**)&snap -> small , ALIGNMENT , LVOLUME * ND *
+		    Nshort * sizeof( GLU_real ) ) != 0 ) {
+      snap -> small = NULL ;
+      break ;
+    }
+    #pragma omp parallel for private(i)
+    for( i = 0 ; i < LVOLUME ; i++ ) {
+      size_t mu ;
+      for( mu = 0 ; mu < ND ; mu++ ) {
+	shorten( snap -> small + ( i * ND + mu ) * Nshort , lat[i].O[mu] ) ;
+      }
+    }
+    fprintf( stdout , "[GF] Restarts use a compressed snapshot of the "
+	     "links\n" ) ;
+    return ;
+  }
+  fprintf( stderr , "[GF] snapshot allocation failure, restarts will "
+	   "reread the file\n" ) ;
+  snap -> type = GF_SNAPSHOT_NONE ;
+  return ;
+}
+
+// put the original links back and randomly transform them
+static int
+restore_snapshot( struct site *lat ,
+		  GLU_complex **gauge ,
+		  const struct snapshot snap ,
+		  const char *infile )
+{
+  const size_t Nshort = NCNC - 1 ;
+  size_t i ;
+  switch( snap.type ) {
+  case GF_SNAPSHOT_NONE :
+    return grab_file( lat , gauge , infile ) ;
+  case GF_SNAPSHOT_FULL :
+    copy_lat( lat , snap.lat ) ;
+    break ;
+  case GF_SNAPSHOT_SMALL :
+    // same reconstruction as the NERSC_SMALL reader
+    #pragma omp parallel for private(i)
+    for( i = 0 ; i < LVOLUME ; i++ ) {
+      size_t mu ;
+      for( mu = 0 ; mu < ND ; mu++ ) {
+	rebuild( lat[i].O[mu] , snap.small + ( i * ND + mu ) * Nshort ) ;
+	gram_reunit( lat[i].O[mu] ) ;
+      }
+    }
+    break ;
+  }
+  random_transform( lat , gauge ) ;
+  return GLU_SUCCESS ;
+}
+
 // Landau gauge fixing routine uses callbacks
 size_t 
 Landau( struct site *lat ,
 	const double accuracy ,
 	const size_t max_iter ,
-	const char *infile )
+	const char *infile ,
+	const GF_snapshot snapshot )
 {
   double theta = 0. ; 
   size_t i ;
   
   struct fftw_stuff FFTW ;
   GLU_complex **gauge = NULL ;
+  struct snapshot snap ;
   
-#ifdef HAVE_FFTW3_H
-
-  /////////////// Look for Wisdom //////////////
-  create_plans_DFT( &FFTW , Latt.dims , TRUE_HERM , ND ) ;
-
-  FFTW.psq = malloc( LVOLUME * sizeof( GLU_real ) ) ; 
-  #pragma omp parallel
-  {
-    #pragma omp for private(i)
-    for(  i = 0 ; i < LVOLUME ; i++  ) {
-      FFTW.psq[i] = MAX_LANDAU / ( gen_p_sq( i , ND )  ) ; 
-    }
-  }
-  
-  ///////// End of the search for Wisdom //////
-#else 
-  FFTW.in = malloc( ( TRUE_HERM ) * sizeof( GLU_complex* ) ) ; 
-  #pragma omp parallel for private(i)
-  for(  i = 0 ; i < TRUE_HERM ; i++  ) {
-    GLU_malloc( (void**)&FFTW.in[i] , ALIGNMENT , LVOLUME * sizeof( GLU_complex ) ) ;
-  }
-  // these are really dummy variables that don't get used in the SD
-  FFTW.out = NULL ; FFTW.psq = NULL ;
-  FFTW.forward = NULL , FFTW.backward = NULL ;
-#endif
+  plan_landau_ffts( &FFTW ) ;
 
   // set up the FA method callback
   select_callback( )  ;
 
+  // the links are still pristine, copy them if asked
+  take_snapshot( &snap , lat , snapshot ) ;
+
   size_t iters = FA_callback( lat , &FFTW , &theta , accuracy , max_iter ) ;
 
   // random restart portion of the code
@@ -308,6 +565,8 @@ Landau( struct site *lat ,
     if( GLU_malloc( (void**)&gauge , 16 , LVOLUME * sizeof( GLU_complex* ) ) != 0 ) {
       fprintf( stderr , "[GF] GF_wrap_landau failed to allocate "
 	       "temporary gauge\n" ) ;
+      free_lat( snap.lat ) ;
+      free( snap.small ) ;
       return GLU_FAILURE ;
     }
 #pragma omp parallel for private(i)
@@ -320,11 +579,14 @@ Landau( struct site *lat ,
     
     size_t iters_loc = 0 ;
     for( failure = 1 ; failure < GF_GLU_FAILURES ; failure++ ) {
-      //repeat procedure have to read in the file :( 
-      if( grab_file( lat , gauge , infile ) == GLU_FAILURE ) { 
+      // start again from the snapshot or the file
+      const double t_restart = wall_time( ) ;
+      if( restore_snapshot( lat , gauge , snap , infile ) == GLU_FAILURE ) { 
 	printf( "[IO] Something funky happened when trying to read in config again!\n" ) ;
 	goto MemFree ; 
       }
+      fprintf( stdout , "[GF] Restart %zu latency :: %e s\n" ,
+	       failure , wall_time( ) - t_restart ) ;
       // and the callback
       iters_loc = FA_callback( lat , &FFTW , &theta , accuracy , max_iter ) ;
 
@@ -350,17 +612,12 @@ Landau( struct site *lat ,
     }
     free( gauge ) ;
   }
+
+  // free the snapshot
+  free_lat( snap.lat ) ;
+  free( snap.small ) ;
   
-#ifdef HAVE_FFTW3_H
-  // free mallocs
-  clean_up_fftw( FFTW , TRUE_HERM ) ;
-#else
-  #pragma omp parallel for private(i)
-  for( i = 0 ; i < TRUE_HERM ; i++ ) {
-    free( FFTW.in[i] ) ; 
-  }
-  free( FFTW.in ) ; 
-#endif
+  clean_landau_ffts( FFTW ) ;
 
   if( failure == GF_GLU_FAILURES ) {
     printf( "\n[GF] Failure to converge to a sufficient solution \n" 
@@ -41,7 +41,7 @@ gauge_set( GLU_complex **gauge ,
 	   const size_t i )
 {  
   size_t left = i ; 
-  size_t next = lat[i].neighbor[mu] ; 
+  size_t next = site_fwd( i , mu ) ; 
   // set origin to identity
   // I guess I could just equate this with lat to save on a multiply
   identity( gauge[i] ) ; 
@@ -50,7 +50,7 @@ gauge_set( GLU_complex **gauge ,
   for( j = 0 ; j < ( Latt.dims[ mu ]-1 ) ; j++ ) {
     multab_suNC( gauge[ next ] , gauge[left] , lat[left].O[mu] ) ; 
     left = next ; 
-    next = lat[ left ].neighbor[mu] ; 
+    next = site_fwd( left , mu ) ; 
   }
   return ;
 }
@@ -87,7 +87,7 @@ OR_single( struct site *__restrict lat ,
   for( mu = 0 ; mu < DIMS ; mu++ ) {
     
     // compute U(x+\mu/2) + U^{dagger}(x-\mu/2)
-    back = lat[i].back[mu] ;
+    back = site_bck( i , mu ) ;
     
     // can speed this up as we only care about s0 and s1 which only need
     // idx_a,b,c,d
@@ -120,7 +120,7 @@ OR_single( struct site *__restrict lat ,
   
   // gauge rotate all the links that touch this gauge transformation
   for( mu = 0 ; mu < ND ; mu++ ) {
-    back = lat[i].back[mu] ;
+    back = site_bck( i , mu ) ;
     shortened_su2_multiply( lat[i].O[mu] , s0 , s1 , su2_index ) ;
     shortened_su2_multiply_dag( lat[back].O[mu] , s0 , s1 , su2_index ) ;
   }
@@ -159,17 +159,17 @@ output_fixing_info( struct site *__restrict lat ,
   latt_reunitU( lat ) ;
 
   ////////// Print out the Gauge Fixing information /////////////
+  // plaquette and link traces in a single sweep
+  struct gauge_obs obs ;
+  gauge_obs( &obs , lat , GLU_FALSE ) ;
   fprintf( stdout , "[GF] Plaquette :: %1.15f \n[GF] Accuracy :: %1.4e\n" , 
-	   av_plaquette( lat ) , theta ) ;
-  GLU_real tr ;
-  const double link = indivlinks( lat , &tr ) ;
+	   obs.plaq , theta ) ;
   fprintf( stdout , "[GF] Iters :: %zu\n[GF] Link trace :: %1.15f ||"
-	   "Maximum :: %1.15f\n" , iters , link , tr / NC ) ; 
+	   "Maximum :: %1.15f\n" , iters , obs.link , obs.maxlink ) ; 
   double lin , log ;
   const_time( lat , &lin , &log ) ; 
   fprintf( stdout , "[GF] Temporal constance || Lin %e || Log %e \n" , 
 	   lin , log ) ;
-  gauge_functional( lat ) ;
   fprintf( stdout , "[GF] Functional :: %1.15f\n" , gauge_functional( lat ) ) ;
   ///////////////////////////////////////////////////////////////
   return ;
@@ -329,12 +329,12 @@ OrCoulomb( struct site *__restrict lat ,
   }
 
   // and print it out
-  double splink , tlink ;
-  all_links( lat , &splink , &tlink ) ;
+  struct gauge_obs obs ;
+  gauge_obs( &obs , lat , GLU_FALSE ) ;
   fprintf( stdout , "[GF] Tuning :: %f || Iterations :: %zu ||\n"
 	   "[GF] Final Tlink :: %1.15f || Slink :: %1.15f \n"
 	   "[GF] Plaquette :: %1.15f \n" , Latt.gf_alpha , iters , 
-	   tlink , splink , av_plaquette( lat ) ) ;
+	   obs.tlink , obs.slink , obs.plaq ) ;
 
  end :
   // memory frees
@@ -179,7 +179,7 @@ gtrans_functional( const struct site *__restrict lat ,
     GLU_complex trabc ;
     for( mu = 0 ; mu < ND - 1 ; mu ++  ){
       trace_abc_dag( &trabc , slice_gauge[i] , lat[j].O[mu] ,
-		     slice_gauge[lat[i].neighbor[mu]] ) ;
+		     slice_gauge[site_fwd( i , mu )] ) ;
       loc_tr += (double)creal( trabc ) ;
     }
     tr = tr + (double)loc_tr ;
@@ -196,7 +196,7 @@ gtrans_functional( const struct site *__restrict lat ,
     const size_t j = slice_idx + i ;
     size_t mu ;
     for( mu = 0 ; mu < ND - 1 ; mu ++  ){
-      const size_t it = lat[i].neighbor[mu] ;
+      const size_t it = site_fwd( i , mu ) ;
       // gauge transform
       multab_dag_suNC( temp2 , lat[j].O[mu] , slice_gauge[it] ) ; 
       multab_suNC( temp , slice_gauge[i] , temp2 ) ; 
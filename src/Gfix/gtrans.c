@@ -173,14 +173,14 @@ gtransform( struct site *__restrict lat ,
 #pragma omp parallel for private(i)
   for( i = 0 ; i < LVOLUME ; i++ ) {
     #if ND == 4
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[0] , (const void*)gauge[lat[i].neighbor[0]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[1] , (const void*)gauge[lat[i].neighbor[1]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[2] , (const void*)gauge[lat[i].neighbor[2]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[3] , (const void*)gauge[lat[i].neighbor[3]] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[0] , (const void*)gauge[site_fwd( i , 0 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[1] , (const void*)gauge[site_fwd( i , 1 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[2] , (const void*)gauge[site_fwd( i , 2 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[3] , (const void*)gauge[site_fwd( i , 3 )] ) ;
     #else
     size_t mu ;
     for( mu = 0 ; mu < ND ; mu++ ) {
-      inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[mu] , (const void*)gauge[lat[i].neighbor[mu]] ) ;
+      inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[mu] , (const void*)gauge[site_fwd( i , mu )] ) ;
     }
     #endif
   } 
@@ -196,14 +196,14 @@ gtransform_th( struct site *__restrict lat ,
 #pragma omp for private(i)
   for( i = 0 ; i < LVOLUME ; i++ ) {
     #if ND == 4
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[0] , (const void*)gauge[lat[i].neighbor[0]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[1] , (const void*)gauge[lat[i].neighbor[1]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[2] , (const void*)gauge[lat[i].neighbor[2]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[3] , (const void*)gauge[lat[i].neighbor[3]] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[0] , (const void*)gauge[site_fwd( i , 0 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[1] , (const void*)gauge[site_fwd( i , 1 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[2] , (const void*)gauge[site_fwd( i , 2 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[3] , (const void*)gauge[site_fwd( i , 3 )] ) ;
     #else
     size_t mu ;
     for( mu = 0 ; mu < ND ; mu++ ) {
-      inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[mu] , (const void*)gauge[lat[i].neighbor[mu]] ) ;
+      inline_gtransform_local( (const void*)gauge[i] , (void*)lat[i].O[mu] , (const void*)gauge[site_fwd( i , mu )] ) ;
     }
     #endif
   } 
@@ -223,13 +223,13 @@ gtransform_slice( const GLU_complex *__restrict *__restrict gauge ,
   for(  i = 0  ;  i < LCU  ;  i ++ ) {
     const size_t j = slice + i ;
     #if ND == 4   
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[0] , (const void*)gauge[lat[i].neighbor[0]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[1] , (const void*)gauge[lat[i].neighbor[1]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[2] , (const void*)gauge[lat[i].neighbor[2]] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[0] , (const void*)gauge[site_fwd( i , 0 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[1] , (const void*)gauge[site_fwd( i , 1 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[2] , (const void*)gauge[site_fwd( i , 2 )] ) ;
     #else
     size_t mu ;
     for( mu = 0 ; mu < ND - 1  ; mu++ ) {
-      inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[mu] , (const void*)gauge[lat[i].neighbor[mu]] ) ;
+      inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[mu] , (const void*)gauge[site_fwd( i , mu )] ) ;
     }
     #endif
     inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[ND-1] , (const void*)gauge_up[i] ) ;
@@ -250,13 +250,13 @@ gtransform_slice_th( const GLU_complex *__restrict *__restrict gauge ,
   for(  i = 0  ;  i < LCU  ;  i ++ ) {
     const size_t j = slice + i ;
     #if ND == 4   
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[0] , (const void*)gauge[lat[i].neighbor[0]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[1] , (const void*)gauge[lat[i].neighbor[1]] ) ;
-    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[2] , (const void*)gauge[lat[i].neighbor[2]] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[0] , (const void*)gauge[site_fwd( i , 0 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[1] , (const void*)gauge[site_fwd( i , 1 )] ) ;
+    inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[2] , (const void*)gauge[site_fwd( i , 2 )] ) ;
     #else
     size_t mu ;
     for( mu = 0 ; mu < ND - 1  ; mu++ ) {
-      inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[mu] , (const void*)gauge[lat[i].neighbor[mu]] ) ;
+      inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[mu] , (const void*)gauge[site_fwd( i , mu )] ) ;
     }
     #endif
     inline_gtransform_local( (const void*)gauge[i] , (void*)lat[j].O[ND-1] , (const void*)gauge_up[i] ) ;
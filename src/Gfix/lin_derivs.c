@@ -62,7 +62,7 @@ latt_deriv_AntiHermitian_proj( GLU_complex sum[ HERMSIZE ] ,
   size_t mu ; 
   for( mu = 0 ; mu < MAX_DIR ; mu++ ) {
     Hermitian_proj_short( A , lat[i].O[mu] ) ; 
-    Hermitian_proj_short( shiftA , lat[lat[i].back[mu]].O[mu] ) ; 
+    Hermitian_proj_short( shiftA , lat[site_bck( i , mu )].O[mu] ) ; 
     // and accumulate into sum
     a_plus_Sxbminc_short( sum , 1.0 , shiftA , A ) ;
   }
@@ -112,7 +112,7 @@ fast_deriv_AntiHermitian_proj( GLU_complex sum[ HERMSIZE ] ,
     Ar7 = *( qq + 14 ) ; Ai7 = *( qq + 15 ) ;
     Ai8 = *( qq + 17 ) ;
 
-    const GLU_real *shqq = (const GLU_real*)lat[ lat[i].back[mu] ].O[mu] ;
+    const GLU_real *shqq = (const GLU_real*)lat[ site_bck( i , mu ) ].O[mu] ;
     shAi0 = *( shqq + 1 )  ;
     shAr1 = *( shqq + 2 )  ; shAi1 = *( shqq + 3 )  ;
     shAr2 = *( shqq + 4 )  ; shAi2 = *( shqq + 5 )  ;
@@ -145,7 +145,7 @@ fast_deriv_AntiHermitian_proj( GLU_complex sum[ HERMSIZE ] ,
     Ar1 = *( qq + 2 ) ; Ai1 = *( qq + 3 ) ;
  
     // and the backward one
-    const GLU_real *shqq = (const GLU_real*)lat[ lat[i].back[mu] ].O[mu] ;
+    const GLU_real *shqq = (const GLU_real*)lat[ site_bck( i , mu ) ].O[mu] ;
     shAi0 = *( shqq + 1 ) ;
     shAr1 = *( shqq + 2 ) ; shAi1 = *( shqq + 3 ) ;
 
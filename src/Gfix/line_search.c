@@ -69,25 +69,25 @@ egauge_Landau( struct site *lat ,
     GLU_complex B[ NCNC ] GLUalign ;
     set_gauge_matrix( A , in , alpha , i ) ;
     #if ND==4
-    size_t it = lat[i].neighbor[0] ;
+    size_t it = site_fwd( i , 0 ) ;
     set_gauge_matrix( B , in , alpha , it ) ;
     gtransform_local( A , lat[i].O[0] , B ) ;
 
-    it = lat[i].neighbor[1] ;
+    it = site_fwd( i , 1 ) ;
     set_gauge_matrix( B , in , alpha , it ) ;
     gtransform_local( A , lat[i].O[1] , B ) ;
     
-    it = lat[i].neighbor[2] ;
+    it = site_fwd( i , 2 ) ;
     set_gauge_matrix( B , in , alpha , it ) ;
     gtransform_local( A , lat[i].O[2] , B ) ;
 
-    it = lat[i].neighbor[3] ;
+    it = site_fwd( i , 3 ) ;
     set_gauge_matrix( B , in , alpha , it ) ;
     gtransform_local( A , lat[i].O[3] , B ) ;
     #else
     size_t mu ;
     for( mu = 0 ; mu < ND ; mu++ ) {
-      size_t it = lat[i].neighbor[mu] ;
+      size_t it = site_fwd( i , mu ) ;
       set_gauge_matrix( B , in , alpha , it ) ;
       gtransform_local( A , lat[i].O[mu] , B ) ;
     }
@@ -162,7 +162,7 @@ line_search_CoulombOdd( double *red ,
     set_gauge_matrix( A1 , in , PC1 , i ) ;
     set_gauge_matrix( A2 , in , PC2 , i ) ;
     for( mu = 0 ; mu < ND-1 ; mu++ ) {
-      const size_t fwd = lat[i].neighbor[mu] ;
+      const size_t fwd = site_fwd( i , mu ) ;
       memcpy( C , lat[i+LCU*t].O[mu] , NCNC*sizeof( GLU_complex ) ) ;
       gtransform_local( gauge[i] , C , gauge[fwd] ) ;
 
@@ -230,8 +230,8 @@ line_search_Coulomb( double *red ,
     set_gauge_matrix( A2 , in , PC2 , idx ) ;
     
     for( mu = 0 ; mu < ND-1 ; mu++ ) {
-      fwd = lat[idx].neighbor[mu] ;
-      bck = lat[idx].back[mu] ;
+      fwd = site_fwd( idx , mu ) ;
+      bck = site_bck( idx , mu ) ;
 
       memcpy( C , lat[idx+LCU*t].O[mu] , NCNC*sizeof( GLU_complex ) ) ;
       gtransform_local( gauge[idx] , C , gauge[fwd] ) ;
@@ -307,10 +307,10 @@ line_search_Landau( double *red ,
       loc_v[0] += creal( trace( lat[i].O[mu] ) ) ;
       #endif
 
-      set_gauge_matrix( B , in , PL1 , lat[i].neighbor[mu] ) ;
+      set_gauge_matrix( B , in , PL1 , site_fwd( i , mu ) ) ;
       loc_v[1] += Re_trace_abc_dag_suNC( A1 , lat[i].O[mu] , B ) ;
 
-      set_gauge_matrix( B , in , PL2 , lat[i].neighbor[mu] ) ;
+      set_gauge_matrix( B , in , PL2 , site_fwd( i , mu ) ) ;
       loc_v[2] += Re_trace_abc_dag_suNC( A2 , lat[i].O[mu] , B ) ;
     }
     
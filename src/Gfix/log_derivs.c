@@ -39,7 +39,7 @@ log_deriv( GLU_complex sum[ HERMSIZE ] ,
   size_t mu ; 
   for( mu = 0 ; mu < MAX_DIR ; mu++ ) {
     exact_log_slow_short( A , lat[i].O[mu] ) ; 
-    exact_log_slow_short( shiftA , lat[lat[i].back[mu]].O[mu] ) ; 
+    exact_log_slow_short( shiftA , lat[site_bck( i , mu )].O[mu] ) ; 
     a_plus_Sxbminc_short( sum , 1.0 , shiftA , A ) ;
 
     // compute the functional in-step to remove a log
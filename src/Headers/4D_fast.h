@@ -18,24 +18,26 @@
 */
 /**
    @file 4D_fast.h
-   @brief protoype functions for the most memory-expensive and usually fastest Hypercubic-blocking code.
+   @brief protoype functions for the fastest Hypercubic-blocking code.
  */
 #ifndef GLU_FOURD_FAST_H
 #define GLU_FOURD_FAST_H
 
 /**
-   @fn void HYPSLsmear4D_expensive( struct site *__restrict lat , const size_t smiters , const int type ) ;
-   @brief  This is the most memory-expensive Hypercubic-blocking code that we have.
+   @fn void HYPSLsmear4D( struct site *__restrict lat , const size_t smiters , const int type ) ;
+   @brief  Fastest Hypercubic-blocking code that we have.
    @param lat :: The lattice field.
    @param smiters :: The number of smearing iterations to perform.
    @param type :: Can either be SM_LOG, SM_APE or SM_STOUT
 
-   @warning could not run if we dont have memory
+   Sweeps through the time-slices keeping the decorated links of nine
+   slices, on top of the gauge field that is about 27/L_t of a gauge field
+
    @return #GLU_SUCCESS or #GLU_FAILURE
  */
 int
-HYPSLsmear4D_expensive( struct site *__restrict lat , 
-			const size_t smiters , 
-			const int type ) ;
+HYPSLsmear4D( struct site *__restrict lat , 
+	      const size_t smiters , 
+	      const int type ) ;
 
 #endif
@@ -40,4 +40,26 @@ Coulomb_FA( struct site  *__restrict lat ,
 	    const size_t max_iter ,
 	    const GLU_bool FACG ) ;
 
+/**
+   @fn size_t Coulomb_FA_slices( struct site  *__restrict lat , struct fftw_stuff *FFTW , const size_t Nteams , const double accuracy , const size_t max_iter , const GLU_bool FACG )
+   @brief Coulomb gauge fixing with whole time-slices handed to teams of threads
+   @param lat :: lattice links
+   @param FFTW :: one set of fftw temporaries and plans per team
+   @param Nteams :: number of slices fixed concurrently, each team has Latt.Nthreads/Nteams threads
+   @param accuracy :: the accuracy we wish to attain
+   @param max_iter :: the maximum number of (per slice) iterations we wish to have before random transform
+   @param FACG :: are we using the CG routines?
+   @return the sum of each slice's iterations or 0 if something went wrong
+
+   The slices only share the temporal links, which are transformed
+   along with everything else once every slice has been fixed
+ */
+size_t
+Coulomb_FA_slices( struct site  *__restrict lat , 
+		   struct fftw_stuff *FFTW ,
+		   const size_t Nteams ,
+		   const double accuracy ,
+		   const size_t max_iter ,
+		   const GLU_bool FACG ) ;
+
 #endif
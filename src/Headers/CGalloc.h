@@ -48,6 +48,27 @@ free_temp_cg( struct gauges G ,
 	      struct CGtemps CG ,
 	      const GLU_bool FACG ) ;
 
+/**
+   @fn int allocate_temp_cgslice( struct CGtemps *CG , const GLU_bool FACG )
+   @brief allocate the temporaries of one team fixing whole time-slices
+   @param CG :: CG temporaries
+   @param FACG :: are we using the FACG algorithm?
+   @return #GLU_SUCCESS or #GLU_FAILURE
+
+   On failure whatever was allocated is still freed by free_temp_cgslice()
+ */
+int
+allocate_temp_cgslice( struct CGtemps *CG ,
+		       const GLU_bool FACG ) ;
+
+/**
+   @fn void free_temp_cgslice( struct CGtemps CG )
+   @brief free the temporaries allocated by allocate_temp_cgslice()
+   @param CG :: CG temporaries
+ */
+void
+free_temp_cgslice( struct CGtemps CG ) ;
+
 /**
    @fn int allocate_temp_lg( struct CGtemps *CG , const GLU_bool FACG )
    @brief allocate the temporaries for Landau gauge fixing
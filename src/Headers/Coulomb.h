@@ -27,18 +27,20 @@
 #define GLU_COULOMB_H
 
 /**
-   @fn size_t Coulomb( struct site *__restrict lat , const double accuracy , const size_t iter ) 
+   @fn size_t Coulomb( struct site *__restrict lat , const double accuracy , const size_t iter , const size_t Nteams ) 
    @brief Coulomb gauge fixing
    
    @param lat :: Lattice fields
    @param accuracy :: Gauge fixing accuracy we are iterating to
    @param iter :: Maximum number of iterations before restarting
+   @param Nteams :: number of slices fixed concurrently, 0 or 1 fixes them in turn with every thread
 
    @return the number of iterations
  */
 size_t 
 Coulomb( struct site *__restrict lat , 
 	 const double accuracy , 
-	 const size_t iter ) ;
+	 const size_t iter ,
+	 const size_t Nteams ) ;
 
 #endif
@@ -54,4 +54,28 @@ void
 bswap_64( const size_t n , 
 	  void *u ) ;
 
+/**
+   @fn void bswap_32_serial( const size_t n , void *u ) 
+   @brief swaps the bytes of a 32 bit array without threading
+   @param n :: length of the array
+   @param u :: pointer to memory
+
+   for short arrays swapped from inside a parallel region
+ */
+void
+bswap_32_serial( const size_t n , 
+		 void *u ) ;
+
+/**
+   @fn void bswap_64_serial( const size_t n , void *u ) 
+   @brief swaps the bytes of a 64 bit array without threading
+   @param n :: length of the array
+   @param u :: pointer to memory
+
+   for short arrays swapped from inside a parallel region
+ */
+void
+bswap_64_serial( const size_t n , 
+		 void *u ) ;
+
 #endif
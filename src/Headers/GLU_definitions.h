@@ -82,11 +82,14 @@
    #define fftw_malloc fftwf_malloc
    #define fftw_plan fftwf_plan
    #define fftw_execute fftwf_execute
+   #define fftw_execute_dft fftwf_execute_dft
    #define fftw_init_threads fftwf_init_threads
    #define fftw_cleanup_threads fftwf_cleanup_threads
    #define fftw_import_wisdom_from_file fftwf_import_wisdom_from_file
    #define fftw_export_wisdom_to_file fftwf_export_wisdom_to_file
+   #define fftw_export_wisdom_to_filename fftwf_export_wisdom_to_filename
    #define fftw_plan_dft fftwf_plan_dft
+   #define fftw_plan_many_dft fftwf_plan_many_dft
    #define fftw_plan_r2r fftwf_plan_r2r
    #define fftw_r2r_kind fftwf_r2r_kind
    #define creal crealf
@@ -204,6 +207,13 @@
  */
 #define NCNC (NC * NC)
 
+// SU(3) kernels reached through function pointers chosen at run time
+// from CPUID, see cpu_dispatch.h
+#if (defined HAVE_CPU_DISPATCH) && (defined HAVE_IMMINTRIN_H) && \
+  !(defined SINGLE_PREC) && !(defined GLU_BGQ) && ( NC == 3 )
+  #define GLU_DISPATCH
+#endif
+
 /**
    @def ND
    @brief dimensions of our theory, if not specified default to 4
@@ -699,11 +709,21 @@ Defines for the gauge fixing routines ( Landau/{}.c )
   #define RNG_TABLE 16
 #elif defined WELL_512_RNG
   #define RNG_TABLE 16
+#elif defined THREEFRY_RNG
+  #define RNG_TABLE 4
 #else
   #define MWC_4096_RNG
   #define RNG_TABLE 4096
 #endif
 
+/**
+   @def PAR_RNG_BLOCK
+   @brief number of gaussians par_gaussian_array() makes per pass, the uniforms for a block live on the stack
+ */
+#ifndef PAR_RNG_BLOCK
+  #define PAR_RNG_BLOCK (64)
+#endif
+
 /**
    @def U1_DFT
    @brief U(1) fourier transform code, defaults to the slower dft because I haven't satisfactorily proved the DHT is equivalent. I believe it is and it is about twice as fast
@@ -727,4 +747,26 @@ Defines for the gauge fixing routines ( Landau/{}.c )
   #define NSTOCH NSU2SUBGROUPS
 #endif
 
+/**
+   @def HB_LANES
+   @brief number of same-colour links the heatbath updates together, one per double of the widest vector unit we are compiled for. One lane is the original link-at-a-time code
+ **/
+#ifndef HB_LANES
+  #if (defined __AVX512F__)
+    #define HB_LANES (8)
+  #elif (defined __AVX2__)
+    #define HB_LANES (4)
+  #else
+    #define HB_LANES (1)
+  #endif
+#endif
+
+/**
+   @def STAPLE_LANES
+   @brief number of sites the staple, plaquette and clover kernels of lanes.h work on together. Eight doubles fill an AVX-512 register and are two AVX2 or four SSE2 ones, so this does not depend on what we are compiled for
+ **/
+#ifndef STAPLE_LANES
+  #define STAPLE_LANES (8)
+#endif
+
 #endif
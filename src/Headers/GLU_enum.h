@@ -33,6 +33,26 @@ typedef enum{
   READ = 4 , 
   WRITE = 6 } cline_arg ;
 
+/**
+   @enum field_layout
+   @brief ordering of the links within the contiguous gauge field slab
+   SITE_MAJOR is [site][mu][NCNC] and LINK_MAJOR is [mu][site][NCNC],
+   CHECKERBOARD is [mu][colour][tile][NCNC] in the order of init_blocked_cb()
+ */
+typedef enum
+  { LAYOUT_SITE_MAJOR ,
+    LAYOUT_LINK_MAJOR ,
+    LAYOUT_CHECKERBOARD } field_layout ;
+
+/**
+   @enum navig_mode
+   @brief how the nearest-neighbour indices of a site are obtained
+   NAVIG_TABLE uses one shared 32-bit table, NAVIG_ONTHEFLY calls gen_shift()
+ */
+typedef enum
+  { NAVIG_TABLE ,
+    NAVIG_ONTHEFLY } navig_mode ;
+
 /**
    @enum file_prec
    @brief defs for the readers
@@ -115,6 +135,17 @@ typedef enum
     GLU_LANDAU_FIX ,
     GLU_MAG_FIX } GLU_fixing ;
 
+/**
+   @enum GF_snapshot
+   @brief where the Landau random restarts get the original links from
+   NONE rereads the file, FULL keeps a copy of the links and SMALL keeps
+   them in the compressed #OUTPUT_SMALL representation
+*/
+typedef enum
+  { GF_SNAPSHOT_NONE ,
+    GF_SNAPSHOT_FULL ,
+    GF_SNAPSHOT_SMALL } GF_snapshot ;
+
 /**
    @enum GF_improvements
    @brief gauge fixing improvements
@@ -153,7 +184,9 @@ typedef enum
     SM_WFLOW_STOUT ,
     SM_WFLOW_LOG ,
     SM_ADAPTWFLOW_STOUT , 
-    SM_ADAPTWFLOW_LOG } smearing_types ;
+    SM_ADAPTWFLOW_LOG ,
+    SM_EMBEDWFLOW_STOUT ,
+    SM_EMBEDWFLOW_LOG } smearing_types ;
 
 /**
    @enum cut_mode
@@ -236,6 +269,16 @@ typedef enum
     U1_RECTANGLE ,
     U1_TOPOLOGICAL } U1_meas ;
 
+/**
+   @enum GLU_simd
+   @brief instruction sets the SU(3) kernels can be dispatched to
+   #SIMD_GENERIC is whatever the compiler flags gave us (SSE2 or plain C)
+ */
+typedef enum
+  { SIMD_GENERIC ,
+    SIMD_AVX2 ,
+    SIMD_AVX512 } GLU_simd ;
+
 /**
    @enum MOMTYPE
    @brief momentum definition being used
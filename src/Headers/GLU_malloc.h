@@ -38,11 +38,35 @@ GLU_malloc( void **memptr ,
 /**
    @fn struct site * allocate_lat( void )
    @brief allocate the lattice gauge fields
+   
+   The links live in a single aligned slab of LVOLUME*ND*NCNC complex
+   numbers ordered by Latt.layout, lat[i].O[mu] points into it
+
    @return the lattice gauge fields
  */
 struct site *
 allocate_lat( void ) ;
 
+/**
+   @fn void copy_lat( struct site *dest , const struct site *src )
+   @brief copy the links of src into dest
+   @param dest :: gauge field from allocate_lat()
+   @param src :: gauge field from allocate_lat()
+   @warning both fields must share the same Latt.layout
+ */
+void
+copy_lat( struct site *dest ,
+	  const struct site *src ) ;
+
+/**
+   @fn GLU_complex * lat_slab( const struct site *lat )
+   @brief the contiguous link storage behind the gauge field
+   @param lat :: gauge field from allocate_lat()
+   @return pointer to the first element of the link slab
+ */
+GLU_complex *
+lat_slab( const struct site *lat ) ;
+
 /**
    @fn struct s_site * allocate_spt_site( const size_t LENGTH1 , const size_t LENGTH2 , const size_t LENGTH3 )
    @brief allocate an spt_site struct lat[LENGTH1].O[LENGTH2][LENGTH3]
@@ -79,14 +79,22 @@ short int
 have_memory_Lgf( void ) ;
 
 /**
-   @fn short int have_memory_readers_writers( const GLU_output config_type ) ;
-   @param config_type :: which configuration we are reading or writing.
-   @brief Checks to see whether we can use the slightly faster Landau gauge
-   fixing code.  
+   @fn short int have_memory_snapshot( const GF_snapshot snapshot )
+   @brief Checks there is room for the in-memory copy of the links used
+   by the Landau random restarts on top of the fixing itself
+   @param snapshot :: representation the links are kept in
+   @return #GLU_FAILURE or #GLU_SUCCESS
+ **/
+short int
+have_memory_snapshot( const GF_snapshot snapshot ) ;
 
-   @return fast or slow #GLU_speed
+/**
+   @fn size_t have_memory_luxury( const size_t max_teams )
+   @brief how many teams can each fix their own Gribov copy at once
+   @param max_teams :: the most teams we would like
+   @return between 1 and max_teams
  **/
-short int 
-have_memory_readers_writers( const GLU_output config_type ) ;
+size_t
+have_memory_luxury( const size_t max_teams ) ;
 
 #endif
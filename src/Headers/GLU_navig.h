@@ -0,0 +1,62 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (GLU_navig.h) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file GLU_navig.h
+   @brief nearest-neighbour lookups shared by every gauge field
+
+   The table is built once by init_navig() and is read-only afterwards,
+   if it does not exist (huge volumes or NAVIGATION = ON_THE_FLY) the
+   shift is computed with gen_shift()
+ */
+#ifndef GLU_NAVIG_H
+#define GLU_NAVIG_H
+
+#include "geometry.h" // gen_shift()
+
+/**
+   @fn static inline size_t site_fwd( const size_t i , const size_t mu )
+   @brief the site one step forward of i in direction mu
+   @param i :: lattice index
+   @param mu :: direction
+ */
+static inline size_t
+site_fwd( const size_t i , const size_t mu )
+{
+  if( Latt.navig != NULL ) {
+    return (size_t)Latt.navig[ 2*ND*i + mu ] ;
+  }
+  return gen_shift( i , (int)mu ) ;
+}
+
+/**
+   @fn static inline size_t site_bck( const size_t i , const size_t mu )
+   @brief the site one step backward of i in direction mu
+   @param i :: lattice index
+   @param mu :: direction
+ */
+static inline size_t
+site_bck( const size_t i , const size_t mu )
+{
+  if( Latt.navig != NULL ) {
+    return (size_t)Latt.navig[ 2*ND*i + ND + mu ] ;
+  }
+  return gen_shift( i , -(int)mu - 1 ) ;
+}
+
+#endif
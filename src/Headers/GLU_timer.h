@@ -49,4 +49,13 @@ print_time( void ) ;
 void 
 start_timer( void ) ;
 
+/**
+   @fn double wall_time( void )
+   @brief wall-clock time in seconds
+   for timing pieces of a routine without resetting start_timer()
+   @return seconds since the epoch, or zero without sys/time.h
+ **/
+double
+wall_time( void ) ;
+
 #endif
@@ -122,6 +122,13 @@ struct fftw_small_stuff {
 /**
    @struct fftw_stuff
    @brief FFT storage
+   @param slab_forward :: DIR-1 dimensional transform of one slab of in into out
+   @param slab_backward :: its inverse, out into in
+   @param line_forward :: Nline in-place 1D transforms along the slowest direction of out
+   @param line_backward :: its inverse
+   @param Nslab :: number of slabs, the length of the slowest direction
+   @param slab :: volume of a slab
+   @param Nline :: number of neighbouring lines transformed by one line plan
  */
 struct fftw_stuff {
   GLU_complex **out ;
@@ -129,6 +136,13 @@ struct fftw_stuff {
 #ifdef HAVE_FFTW3_H
   fftw_plan *forward ;
   fftw_plan *backward ;
+  fftw_plan slab_forward ;
+  fftw_plan slab_backward ;
+  fftw_plan line_forward ;
+  fftw_plan line_backward ;
+  size_t Nslab ;
+  size_t slab ;
+  size_t Nline ;
 #else
   int *forward ;
   int *backward ;
@@ -155,11 +169,15 @@ struct gauges {
    @param max_iters :: maximum iterations before we restart
    @param accuracy :: gauge fixing accuracy we try to meet 1E-20 is good
    @param type :: enumerated (LANDAU,COULOMB)
+   @param Nteams :: number of Coulomb slices fixed concurrently
+   @param snapshot :: in-memory copy of the links used by Landau restarts
  */
 struct gf_info {
   size_t max_iters ; // maximum iterations of the gauge fixing routine
   double accuracy ; // average accuracy to be used 
   GLU_fixing type ; // type of gauge fixing used, coulomb or landau?
+  size_t Nteams ; // slices fixed at once by teams of threads
+  GF_snapshot snapshot ; // Landau restarts from memory rather than the file
 } ;
 
 /**
@@ -172,6 +190,7 @@ struct hb_info {
   size_t Nmeasure ;
   size_t Nor ;
   size_t Nsave ;
+  size_t Nstage ;
   size_t therm ;
   GLU_bool continuation ;
 } ;
@@ -225,6 +244,9 @@ struct infile_data {
    @param sm_alpha :: the smearing parameters from the input file
    @param head :: what header type we use
    @param Seed :: the seed we use for our RNG 
+   @param layout :: ordering of the links in the gauge field slab
+   @param navig :: shared neighbour table, NULL if computed on the fly
+   @param nav_mode :: whether neighbours are tabulated or computed
  */
 struct latt_info {
   size_t dims[ ND ] ; // dimensions in x,y,z,t order opposite to FFTW
@@ -240,6 +262,9 @@ struct latt_info {
   uint32_t Nthreads ; // number of threads
   struct su2_subgroups *su2_data ; // su2 subgroups
   cline_arg argc ; // command line arguments
+  field_layout layout ; // link ordering of the gauge field slab
+  uint32_t *navig ; // [site][fwd mu ... bck mu] neighbour table
+  navig_mode nav_mode ; // tabulated or on-the-fly neighbours
 } ;
 
 /**
@@ -265,11 +290,11 @@ struct Qmoments {
 /**
    @struct site
    @brief the gauge field format
+   O[mu] is a view into the single contiguous slab allocated by allocate_lat(),
+   neighbours are looked up with site_fwd() and site_bck()
  */
 struct site {
   GLU_complex **O ;
-  size_t neighbor[ ND ] ;
-  size_t back[ ND ] ;
 } ;
 
 /**
@@ -300,6 +325,31 @@ struct veclist {
   int MOM[ ND ] ;
 } ;
 
+/**
+   @struct gauge_obs
+   @brief gauge observables from the single measurement sweep
+   @param plaq :: average plaquette
+   @param splaq :: spatial plaquette
+   @param tplaq :: temporal plaquette
+   @param link :: average link trace
+   @param slink :: spatial link trace
+   @param tlink :: temporal link trace
+   @param maxlink :: largest link trace
+   @param GG :: \f$ \langle G_{\mu\nu} G_{\mu\nu}\rangle \f$ (clover)
+   @param qtop :: gauge field topological charge
+ */
+struct gauge_obs {
+  double plaq ;
+  double splaq ;
+  double tplaq ;
+  double link ;
+  double slink ;
+  double tlink ;
+  double maxlink ;
+  double GG ;
+  double qtop ;
+} ;
+
 /**
    @struct wfmeas
    @brief linked list for wilson flow measurements
@@ -324,6 +374,7 @@ struct wfmeas {
    @param lat3 :: time-slice wide temporary
    @param lat3 :: time-slice wide temporary
    @param Z :: generating functional
+   @param Zfirst :: generating functional after the first RK stage, for the embedded error
    @param lat_two :: copy of the gauge links
    @param red :: reduction array
  */
@@ -332,6 +383,7 @@ struct wflow_temps {
   struct s_site *lat3 ;
   struct s_site *lat4 ;
   struct s_site *Z ;
+  struct s_site *Zfirst ;
   struct site *lat_two ;
   double *red ;
 } ;
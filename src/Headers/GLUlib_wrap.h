@@ -159,6 +159,23 @@ read_and_U1( const char *infile ,
 	     const GLU_output storage , 
 	     const char *output_details ) ;
 
+/**
+   @fn int batch_wrap( const char *configs , const char *out_pattern , const struct infile_data INFILE )
+   @brief run the same input over many configurations
+   @param configs :: a glob of configurations or a file listing them one per line
+   @param out_pattern :: output name, "%s" is replaced by each configuration's file name. NULL writes nothing
+   @param INFILE :: parsed input file
+   @return #GLU_SUCCESS or #GLU_FAILURE if any configuration failed
+
+   The gauge field, neighbour table, FFTW plans and momentum lists
+   stay allocated between configurations, the next configuration is
+   prefetched into the page cache while the current one is worked on
+ */
+int
+batch_wrap( const char *configs ,
+	    const char *out_pattern ,
+	    const struct infile_data INFILE ) ;
+
 /**
    @fn void unstick_GLU( void )
    @brief cleans up and frees some allocated precomputations
@@ -38,12 +38,13 @@ grab_file( struct site *lat ,
 	   const char *infile ) ;
 
 /**
-   @fn size_t Landau( struct site *lat , const double accuracy , const size_t iter , FILE *infile )
+   @fn size_t Landau( struct site *lat , const double accuracy , const size_t iter , const char *infile , const GF_snapshot snapshot )
    @brief fast landau gauge fixing
    @param lat :: gauge field
    @param accuracy :: accuracy we wish to converge our algorithm to
    @param iter :: maximum number of iterations before we restart
    @param infile :: need the configuration file in case we have to start over
+   @param snapshot :: keep the links in memory for the restarts rather than rereading infile
    our fastest smearing routine, memory expensive
    @return the number of iterations the routine took
  **/
@@ -51,6 +52,7 @@ size_t
 Landau( struct site *lat ,
 	const double accuracy ,
 	const size_t iter ,
-	const char *infile ) ;
+	const char *infile ,
+	const GF_snapshot snapshot ) ;
 
 #endif
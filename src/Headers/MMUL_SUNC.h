@@ -33,11 +33,19 @@
    computes \f$ a = b \times c \f$  tuned for suNC by computing the signed minors for the bottom row
 
    @warning only use-able for \f$ a,b,c \in SU(NC) \f$
+   @note with #GLU_DISPATCH this is a pointer to the kernel for this CPU
  **/
+#ifdef GLU_DISPATCH
+extern void 
+(*multab_suNC)( GLU_complex a[ NCNC ] , 
+	       const GLU_complex b[ NCNC ] , 
+	       const GLU_complex c[ NCNC ] ) ;
+#else
 void 
 multab_suNC( GLU_complex a[ NCNC ] , 
 	     const GLU_complex b[ NCNC ] , 
 	     const GLU_complex c[ NCNC ] ) ;
+#endif
   #else
     #define multab_suNC multab
   #endif
@@ -38,6 +38,8 @@ multabdag( GLU_complex a[ NCNC ] ,
 
 #if NC < 4
 
+// with GLU_DISPATCH this is a pointer, declared in MMULdag_SUNC.h
+#ifndef GLU_DISPATCH
 /**
    @fn void multabdag_suNC( GLU_complex a[ NCNC ] , const GLU_complex b[ NCNC ] , const GLU_complex c[ NCNC ] )
    @brief Computes general Nc x Nc matrix multiplication with \f$ a = b^{\dagger}\times c \f$
@@ -50,6 +52,7 @@ void
 multabdag_suNC( GLU_complex a[ NCNC ] , 
 		const GLU_complex b[ NCNC ] , 
 		const GLU_complex c[ NCNC ] ) ;
+#endif
 
 #else
   #define multabdag_suNC multabdag
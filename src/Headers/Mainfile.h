@@ -73,6 +73,9 @@
  */
 extern struct latt_info Latt ;
 
+// shared nearest-neighbour lookups, needs Latt
+#include "GLU_navig.h"
+
 // my own necessary libs ...
 #include "U_Nops.h"                // many matrix operations
 #include "trace_abc.h"             // trace of the product of 3 matrices
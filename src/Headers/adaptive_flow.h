@@ -39,4 +39,20 @@ flow_adaptive_RK3( struct site *__restrict lat ,
 		   const int SIGN ,
 		   const smearing_types SM_TYPE ) ;
 
+/**
+   @fn int flow_adaptive_embedded( struct site *__restrict lat , const size_t smiters , const int SIGN , const smearing_types SM_TYPE )
+   @brief adaptive RK3 integration of the flow equation with an embedded error estimate
+   @param lat :: lattice gauge field
+   @param smiters :: number of smearing iterations
+   @param SIGN :: of type #GLU_direction
+   @param SM_TYPE :: will accept SM_STOUT or SM_LOG from #smearing_types
+   <br>
+   the error is the largest link distance between the RK3 step and a second order solution made from its first two stages, so each attempt costs one step rather than the three of flow_adaptive_RK3(). Needs the same copy of the links (to restart rejected steps) and a lattice-wide copy of the first stage's Z.
+ **/
+int
+flow_adaptive_embedded( struct site *__restrict lat , 
+			const size_t smiters ,
+			const int SIGN ,
+			const smearing_types SM_TYPE ) ;
+
 #endif
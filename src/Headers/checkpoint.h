@@ -0,0 +1,65 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (checkpoint.h) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file checkpoint.h
+   @brief configuration and rng checkpoints, optionally written by a background thread
+ */
+#ifndef GLU_CHECKPOINT_H
+#define GLU_CHECKPOINT_H
+
+/**
+   @fn int init_checkpoints( const size_t Nslots , const GLU_output storage , const char *details )
+   @brief set up the staging buffers and start the background writer
+   @param Nslots :: number of staging copies of the gauge field, 0 writes synchronously
+   @param storage :: output type of the configurations
+   @param details :: string of information for the header
+   @return #GLU_SUCCESS or #GLU_FAILURE
+
+   If the staging fields or the writer cannot be set up we warn and
+   write synchronously instead
+ */
+int
+init_checkpoints( const size_t Nslots ,
+		  const GLU_output storage ,
+		  const char *details ) ;
+
+/**
+   @fn void checkpoint_configuration( const struct site *lat , const size_t seq , const char *config_file , const char *rng_file )
+   @brief write lat and the rng state to disk, or queue them for the writer
+   @param lat :: lattice gauge field
+   @param seq :: sequence number written in the header
+   @param config_file :: configuration file name
+   @param rng_file :: rng state file name
+
+   @warning must be called by every thread of a parallel region
+ */
+void
+checkpoint_configuration( const struct site *lat ,
+			  const size_t seq ,
+			  const char *config_file ,
+			  const char *rng_file ) ;
+
+/**
+   @fn void flush_checkpoints( void )
+   @brief wait for every queued checkpoint to hit the disk, stop the writer and free the staging buffers
+ */
+void
+flush_checkpoints( void ) ;
+
+#endif
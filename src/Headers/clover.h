@@ -23,6 +23,35 @@
 #ifndef GLU_CLOVER_H
 #define GLU_CLOVER_H
 
+/**
+   @fn void clover_factors( void )
+   @brief sets the absolute values of the clover improvement factors
+   @warning must be called before compute_Gmunu_sites()
+ */
+void
+clover_factors( void ) ;
+
+/**
+   @fn void compute_Gmunu_sites( double *__restrict GG , double *__restrict qtop , double plaq[ 2 ] , const struct site *__restrict lat , const size_t i , const size_t n )
+   @brief clover \f$ G_{\mu\nu} G_{\mu\nu} \f$ and charge density of the sites i to i+n-1
+   @param GG :: sum of the squared field strength, accumulated into
+   @param qtop :: unnormalised topological charge density, accumulated into
+   @param plaq :: Re tr of the temporal [0] and spatial [1] plaquettes summed over the sites
+   @param lat :: lattice gauge links
+   @param i :: first site index
+   @param n :: number of sites, at most #STAPLE_LANES
+
+   Works through the sites as compute_Gmunu_th() does, the plaquettes
+   are the ones the clover builds anyway
+ */
+void
+compute_Gmunu_sites( double *__restrict GG ,
+		     double *__restrict qtop ,
+		     double plaq[ 2 ] ,
+		     const struct site *__restrict lat ,
+		     const size_t i ,
+		     const size_t n ) ;
+
 /**
    @fn void compute_Gmunu_th( double *red , const struct site *lat )
    @brief Gmunu calculation to be called within a parallel environment
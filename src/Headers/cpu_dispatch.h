@@ -0,0 +1,129 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (cpu_dispatch.h) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file cpu_dispatch.h
+   @brief run-time selection of the SU(3) matrix kernels
+
+   With #GLU_DISPATCH the SU(3) multiplies, the trace_abc family,
+   gram_reunit(), exponentiate() and the site-batched kernels of lanes.h
+   are function pointers that we point at the AVX-512, AVX2/FMA or
+   generic (SSE2) versions depending on what CPUID says the node can
+   do. Setting GLU_SIMD=generic, avx2 or avx512 in the environment
+   overrides the choice, the FMA kernels round differently so this is
+   how to get bitwise identical output from a mixture of nodes. Without
+   #GLU_DISPATCH only #SIMD_GENERIC exists.
+ */
+#ifndef GLU_CPU_DISPATCH_H
+#define GLU_CPU_DISPATCH_H
+
+/**
+   @fn GLU_bool simd_available( const GLU_simd backend )
+   @brief is this backend compiled in and supported by the CPU?
+ */
+GLU_bool
+simd_available( const GLU_simd backend ) ;
+
+/**
+   @fn GLU_simd simd_backend( void )
+   @brief backend the kernels currently point to
+ */
+GLU_simd
+simd_backend( void ) ;
+
+/**
+   @fn const char *simd_name( const GLU_simd backend )
+   @brief printable name of a backend
+ */
+const char *
+simd_name( const GLU_simd backend ) ;
+
+/**
+   @fn int set_simd_backend( const GLU_simd backend )
+   @brief point the kernels at "backend"
+   @return #GLU_FAILURE if it is not available on this node
+   @warning not thread safe, call outside of parallel regions
+ */
+int
+set_simd_backend( const GLU_simd backend ) ;
+
+/**
+   @fn void init_cpu_dispatch( void )
+   @brief pick the widest available backend or the one in GLU_SIMD
+ */
+void
+init_cpu_dispatch( void ) ;
+
+#ifdef GLU_DISPATCH
+
+/**
+   @def GLU_KERNEL_PROTOTYPES
+   @brief one backend's entries of the kernel table
+   they have the signatures of the dispatched kernels of the same name
+ */
+#define GLU_KERNEL_PROTOTYPES( ISA )					\
+  void multab_suNC_##ISA( GLU_complex a[ NCNC ] ,			\
+			  const GLU_complex b[ NCNC ] ,			\
+			  const GLU_complex c[ NCNC ] ) ;		\
+  void multab_dag_suNC_##ISA( GLU_complex a[ NCNC ] ,			\
+			      const GLU_complex b[ NCNC ] ,		\
+			      const GLU_complex c[ NCNC ] ) ;		\
+  void multabdag_suNC_##ISA( GLU_complex a[ NCNC ] ,			\
+			     const GLU_complex b[ NCNC ] ,		\
+			     const GLU_complex c[ NCNC ] ) ;		\
+  double Re_trace_abc_dag_suNC_##ISA( const GLU_complex a[ NCNC ] ,	\
+				      const GLU_complex b[ NCNC ] ,	\
+				      const GLU_complex c[ NCNC ] ) ;	\
+  void trace_abc_##ISA( GLU_complex *__restrict tr ,			\
+			const GLU_complex a[ NCNC ] ,			\
+			const GLU_complex b[ NCNC ] ,			\
+			const GLU_complex c[ NCNC ] ) ;			\
+  void trace_abc_dag_##ISA( GLU_complex *__restrict tr ,		\
+			    const GLU_complex a[ NCNC ] ,		\
+			    const GLU_complex b[ NCNC ] ,		\
+			    const GLU_complex c[ NCNC ] ) ;		\
+  void trace_abc_dag_Re_##ISA( GLU_real *__restrict tr ,		\
+			       const GLU_complex a[ NCNC ] ,		\
+			       const GLU_complex b[ NCNC ] ,		\
+			       const GLU_complex c[ NCNC ] ) ;		\
+  void gram_reunit_##ISA( GLU_complex *__restrict U ) ;		\
+  void exponentiate_##ISA( GLU_complex U[ NCNC ] ,			\
+			   const GLU_complex Q[ NCNC ] ) ;		\
+  void staples_lanes_##ISA( GLU_complex stap[ STAPLE_LANES ][ NCNC ] ,	\
+			    const struct site *__restrict lat ,		\
+			    const size_t site[ STAPLE_LANES ] ,		\
+			    const size_t n ,				\
+			    const size_t mu ,				\
+			    const size_t dir ) ;			\
+  void plaquettes_lanes_##ISA( double plaq[ STAPLE_LANES ][ 2 ] ,	\
+			       const struct site *__restrict lat ,	\
+			       const size_t site[ STAPLE_LANES ] ) ;	\
+  void clover_lanes_##ISA( GLU_complex sum[ STAPLE_LANES ][ NCNC ] ,	\
+			   double plaq[ STAPLE_LANES ] ,		\
+			   const struct site *__restrict lat ,		\
+			   const size_t site[ STAPLE_LANES ] ,		\
+			   const size_t mu ,				\
+			   const size_t nu ) ;
+
+GLU_KERNEL_PROTOTYPES( generic )
+GLU_KERNEL_PROTOTYPES( AVX2 )
+GLU_KERNEL_PROTOTYPES( AVX512 )
+
+#endif
+
+#endif
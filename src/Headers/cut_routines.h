@@ -49,6 +49,7 @@ simorb_ratios( const size_t DIMS ) ;
    @param CUTINFO :: momentum cut information
    @param DIMS :: dimensions of the problem
    @param CONFIGSPACE :: Qsusc and Statpot have different momenta look-up
+   @return a list the caller frees
  */
 struct veclist*
 compute_veclist( size_t *__restrict list_size , 
@@ -56,4 +57,18 @@ compute_veclist( size_t *__restrict list_size ,
 		 const size_t DIMS ,
 		 const GLU_bool CONFIGSPACE ) ;
 
+/**
+   @fn void keep_veclists( void )
+   @brief keep computed momentum lists resident, later compute_veclist() calls copy them
+ */
+void
+keep_veclists( void ) ;
+
+/**
+   @fn void release_veclists( void )
+   @brief free the lists kept by keep_veclists()
+ */
+void
+release_veclists( void ) ;
+
 #endif
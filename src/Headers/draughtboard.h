@@ -44,6 +44,20 @@ init_cb( struct draughtboard *db ,
 	 const size_t LENGTH ,
 	 const size_t DIR ) ;
 
+/**
+   @fn int init_blocked_cb( struct draughtboard *db , const size_t DIR )
+   @brief initialise the draughtboard of the first DIR dimensions with each colour's list ordered tile by tile
+   @param db :: draughtboard structure
+   @param DIR :: number of directions in the geometry we are using
+   @return #GLU_SUCCESS or #GLU_FAILURE
+
+   Same colouring as init_cb(), consecutive entries lie in the same small
+   hypercube so they share most of their staple neighbours
+ */
+int
+init_blocked_cb( struct draughtboard *db ,
+		 const size_t DIR ) ;
+
 /**
    @fn void init_improved_cb( struct draughtboard *db )
    @brief initialise the improved draughtboard
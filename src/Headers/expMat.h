@@ -39,6 +39,19 @@ void
 free_factorial( void ) ;
 #endif
 
+#if NC == 3
+/**
+   @fn GLU_bool SU3_exp_effs( double complex f[ 3 ] , const GLU_complex Q[ NCNC ] )
+   @brief Cayley-Hamilton coefficients of \f$ e^{iQ} = f_0 + f_1 Q + f_2 Q^2 \f$
+   @param f :: f0, f1 and f2
+   @param Q :: Lie matrix
+   @return #GLU_FALSE if Q is numerically zero, f is then not set
+ */
+GLU_bool
+SU3_exp_effs( double complex f[ 3 ] ,
+	      const GLU_complex Q[ NCNC ] ) ;
+#endif
+
 /**
    @fn void exponentiate( GLU_complex U[ NCNC ] , const GLU_complex Q[ NCNC ] )
    @brief Our old exact exponentiation routine of Q into U. e.g. \f$ U_\mu(x) = e^{Q_\mu(x)}\f$
@@ -46,9 +59,15 @@ free_factorial( void ) ;
    @param Q :: Lie matrix
    MP exponentiation using the full (redundant) Q uses inlined eigenvalue and f calculations instead of those in solver.h and effs.h
  **/
+#ifdef GLU_DISPATCH
+extern void 
+(*exponentiate)( GLU_complex U[ NCNC ] , 
+		 const GLU_complex Q[ NCNC ] ) ;
+#else
 void 
 exponentiate( GLU_complex U[ NCNC ] , 
 	      const GLU_complex Q[ NCNC ] ) ;
+#endif
 
 /**
    @fn void exponentiate_short( GLU_complex U[ NCNC ] , const GLU_complex Q[ HERMSIZE ] )
@@ -29,8 +29,13 @@
    @brief reunitarises U into itself
    @param U :: overwritten with a reunitarised version of itself
  */
+#ifdef GLU_DISPATCH
+extern void 
+(*gram_reunit)( GLU_complex *__restrict U ) ;
+#else
 void 
 gram_reunit( GLU_complex *__restrict U ) ;
+#endif
 
 /**
    @fn void reunit_latt( GLU_complex *__restrict *__restrict U )
@@ -39,16 +39,16 @@ void
 init_latt( void ) ;
 
 /**
-   @fn void init_navig( struct site *__restrict lat )
+   @fn void init_navig( void )
    @brief Function for generically initialising the lattice navigation
    
-   @param lat :: Gauge field
-
-   packs the struct lat's "neighbor" and
-   "back" members which will be used for numerical
-   derivatives and alike.
+   packs the shared, read-only neighbour table Latt.navig used by
+   site_fwd() and site_bck() for numerical derivatives and alike.
+   Only the first call does any work, if the volume does not fit in
+   32 bits (or NAVIGATION = ON_THE_FLY) no table is built and
+   neighbours are computed with gen_shift()
  **/
 void 
-init_navig( struct site *__restrict lat ) ;
+init_navig( void ) ;
 
 #endif
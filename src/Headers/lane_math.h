@@ -0,0 +1,110 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (lane_math.h) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file lane_math.h
+   @brief branch-free log and sincos for loops we want the compiler to vectorise
+
+   libm calls stop "#pragma omp simd" loops from vectorising unless the
+   vector math library is linked, these are plain arithmetic and bit
+   operations on doubles so they vectorise everywhere. Both are good to
+   a couple of ulp over the ranges we use them for
+ */
+#ifndef GLU_LANE_MATH_H
+#define GLU_LANE_MATH_H
+
+/**
+   @fn static inline double lane_log( const double x )
+   @brief natural logarithm of a positive, normal, double
+   @param x :: argument
+
+   Splits x into 2^k f with f in [ 1/sqrt(2) , sqrt(2) ) and sums the
+   series of 2 atanh( (f-1)/(f+1) ), zero and subnormals come out as a
+   large negative number rather than -inf
+ */
+static inline double
+lane_log( const double x )
+{
+  uint64_t bits ;
+  double e , f ;
+  memcpy( &bits , &x , sizeof( double ) ) ;
+  // big is 1 if the mantissa is at least sqrt(2), an integer carry rather
+  // than a compare so that it vectorises without 64-bit compares
+  const uint64_t frac = bits & 0x000FFFFFFFFFFFFFULL ;
+  const uint64_t big = ( frac + 0x00095F619980C433ULL ) >> 52 ;
+  // exponent via the 2^52 trick, avoids a 64-bit int -> double conversion
+  const uint64_t ebits = ( ( bits >> 52 ) + big ) | 0x4330000000000000ULL ;
+  const uint64_t fbits = frac | ( ( 0x3FFULL - big ) << 52 ) ;
+  memcpy( &e , &ebits , sizeof( double ) ) ;
+  memcpy( &f , &fbits , sizeof( double ) ) ;
+  const double k = ( e - 4503599627370496.0 ) - 1023.0 ;
+  const double s = ( f - 1.0 ) / ( f + 1.0 ) , z = s * s ;
+  const double p = 2.0/3.0 + z * ( 2.0/5.0 + z * ( 2.0/7.0 + z * ( 2.0/9.0 +
+		   z * ( 2.0/11.0 + z * ( 2.0/13.0 + z * ( 2.0/15.0 +
+		   z * ( 2.0/17.0 + z * ( 2.0/19.0 + z * ( 2.0/21.0 ) ) ) ) ) ) ) ) ) ;
+  // ln(2) split so that k * ln2_hi is exact
+  return k * 6.93147180369123816490e-01 +
+    ( 2.0 * s + ( s * z * p + k * 1.90821492927058770002e-10 ) ) ;
+}
+
+/**
+   @fn static inline void lane_sincos2pi( const double u , double *s , double *c )
+   @brief sine and cosine of 2 pi u
+   @param u :: argument in turns, we use it for u in [0,1]
+   @param s :: sin( 2 pi u )
+   @param c :: cos( 2 pi u )
+
+   Reduces u to the nearest quarter turn so the polynomials only see
+   |2 pi r| <= pi/4 and then rotates by the quadrant
+ */
+static inline void
+lane_sincos2pi( const double u ,
+		double *s ,
+		double *c )
+{
+  // round-to-nearest through the 1.5*2^52 trick, low bits are the quadrant
+  const double q = 4.0 * u + 6755399441055744.0 ;
+  const double n = q - 6755399441055744.0 ;
+  uint64_t quad ;
+  memcpy( &quad , &q , sizeof( double ) ) ;
+  quad &= 3 ;
+  const double t = TWOPI * ( u - 0.25 * n ) , t2 = t * t ;
+  const double S = t * ( 1.0 + t2 * ( -1.0/6.0 + t2 * ( 1.0/120.0 +
+		   t2 * ( -1.0/5040.0 + t2 * ( 1.0/362880.0 +
+		   t2 * ( -1.0/39916800.0 + t2 * ( 1.0/6227020800.0 +
+		   t2 * ( -1.0/1307674368000.0 +
+		   t2 * ( 1.0/355687428096000.0 ) ) ) ) ) ) ) ) ) ;
+  const double C = 1.0 + t2 * ( -1.0/2.0 + t2 * ( 1.0/24.0 +
+		   t2 * ( -1.0/720.0 + t2 * ( 1.0/40320.0 +
+		   t2 * ( -1.0/3628800.0 + t2 * ( 1.0/479001600.0 +
+		   t2 * ( -1.0/87178291200.0 +
+		   t2 * ( 1.0/20922789888000.0 ) ) ) ) ) ) ) ) ;
+  // quadrant 1 is ( C , -S ), 2 is ( -S , -C ) and 3 is ( -C , S ),
+  // swaps and sign flips on the bits as SSE2 has no 64-bit compare
+  uint64_t sb , cb ;
+  memcpy( &sb , &S , sizeof( double ) ) ;
+  memcpy( &cb , &C , sizeof( double ) ) ;
+  const uint64_t swap = ( sb ^ cb ) & ( 0 - ( quad & 1 ) ) ;
+  sb ^= swap ^ ( ( quad & 2 ) << 62 ) ;
+  cb ^= swap ^ ( ( ( quad + 1 ) & 2 ) << 62 ) ;
+  memcpy( s , &sb , sizeof( double ) ) ;
+  memcpy( c , &cb , sizeof( double ) ) ;
+  return ;
+}
+
+#endif
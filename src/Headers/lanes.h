@@ -0,0 +1,108 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (lanes.h) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file lanes.h
+   @brief staple, plaquette and clover kernels over #STAPLE_LANES sites
+
+   The links of #STAPLE_LANES sites are gathered through the neighbour
+   table into tiles with the site index innermost, so every complex
+   multiply-add is a vector operation over the sites. Every entry of
+   "site" must be a valid lattice index, pad a short batch by repeating
+   one. With #GLU_DISPATCH these are pointers to the generic, AVX2 or
+   AVX-512 build of lanes_body.h, see cpu_dispatch.h
+ */
+#ifndef GLU_LANES_H
+#define GLU_LANES_H
+
+/**
+   @fn void staples_lanes( GLU_complex stap[ STAPLE_LANES ][ NCNC ] , const struct site *__restrict lat , const size_t site[ STAPLE_LANES ] , const size_t n , const size_t mu , const size_t dir )
+   @brief adds the unimproved staples of link mu of each site to stap, as all_staples() does for non-log smearing
+   @param stap :: staple sums, only the first n are touched
+   @param lat :: lattice gauge field
+   @param site :: lattice indices
+   @param n :: number of sites we want
+   @param mu :: direction of the link
+   @param dir :: number of directions we smear in
+ */
+#ifdef GLU_DISPATCH
+extern void
+(*staples_lanes)( GLU_complex stap[ STAPLE_LANES ][ NCNC ] ,
+		  const struct site *__restrict lat ,
+		  const size_t site[ STAPLE_LANES ] ,
+		  const size_t n ,
+		  const size_t mu ,
+		  const size_t dir ) ;
+#else
+void
+staples_lanes( GLU_complex stap[ STAPLE_LANES ][ NCNC ] ,
+	       const struct site *__restrict lat ,
+	       const size_t site[ STAPLE_LANES ] ,
+	       const size_t n ,
+	       const size_t mu ,
+	       const size_t dir ) ;
+#endif
+
+/**
+   @fn void plaquettes_lanes( double plaq[ STAPLE_LANES ][ 2 ] , const struct site *__restrict lat , const size_t site[ STAPLE_LANES ] )
+   @brief Re tr of the temporal [0] and spatial [1] plaquettes at each site
+   @param plaq :: the sums of the plaquettes
+   @param lat :: lattice gauge field
+   @param site :: lattice indices
+ */
+#ifdef GLU_DISPATCH
+extern void
+(*plaquettes_lanes)( double plaq[ STAPLE_LANES ][ 2 ] ,
+		     const struct site *__restrict lat ,
+		     const size_t site[ STAPLE_LANES ] ) ;
+#else
+void
+plaquettes_lanes( double plaq[ STAPLE_LANES ][ 2 ] ,
+		  const struct site *__restrict lat ,
+		  const size_t site[ STAPLE_LANES ] ) ;
+#endif
+
+/**
+   @fn void clover_lanes( GLU_complex sum[ STAPLE_LANES ][ NCNC ] , double plaq[ STAPLE_LANES ] , const struct site *__restrict lat , const size_t site[ STAPLE_LANES ] , const size_t mu , const size_t nu )
+   @brief sum of the four mu-nu plaquettes of the standard clover at each site
+   @param sum :: clover sums
+   @param plaq :: Re tr of the plaquette in the forward mu-nu corner
+   @param lat :: lattice gauge field
+   @param site :: lattice indices
+   @param mu :: first direction of the plane
+   @param nu :: second direction of the plane
+ */
+#ifdef GLU_DISPATCH
+extern void
+(*clover_lanes)( GLU_complex sum[ STAPLE_LANES ][ NCNC ] ,
+		 double plaq[ STAPLE_LANES ] ,
+		 const struct site *__restrict lat ,
+		 const size_t site[ STAPLE_LANES ] ,
+		 const size_t mu ,
+		 const size_t nu ) ;
+#else
+void
+clover_lanes( GLU_complex sum[ STAPLE_LANES ][ NCNC ] ,
+	      double plaq[ STAPLE_LANES ] ,
+	      const struct site *__restrict lat ,
+	      const size_t site[ STAPLE_LANES ] ,
+	      const size_t mu ,
+	      const size_t nu ) ;
+#endif
+
+#endif
@@ -0,0 +1,465 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (lanes_body.h) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file lanes_body.h
+   @brief the kernels of lanes.h, included once per instruction set
+
+   The includer defines LANES_FN( name ) to name the functions and sets
+   the target. Everything is plain C with the loop over the sites
+   innermost so the compiler vectorises it for whatever that target is,
+   the products are full NC x NC ones so this works for any NC
+ */
+#ifndef LANES_FN
+  #error "define LANES_FN before including lanes_body.h"
+#endif
+
+// STAPLE_LANES matrices with the site index innermost
+struct lane_mat {
+  GLU_real re[ NCNC ][ STAPLE_LANES ] ;
+  GLU_real im[ NCNC ][ STAPLE_LANES ] ;
+} ;
+
+// where element e of a link goes in the tile, transposed for the dagger
+static inline size_t
+lane_dest( const size_t e , const GLU_bool dag )
+{
+  return ( dag == GLU_TRUE ) ? e/NC + ( e%NC )*NC : e ;
+}
+
+// the links the pointers p point to, or their daggers, into the tile.
+// Each target transposes with shuffles as a load and a store per
+// double is what we would have otherwise
+#if (defined __AVX512F__) && !(defined SINGLE_PREC) && ( NC == 3 ) && ( STAPLE_LANES == 8 )
+
+#include <immintrin.h>
+
+// negates if dag, avx512f has no xor_pd
+static inline __m512d
+lane_neg512( const __m512d a , const GLU_bool dag )
+{
+  return ( dag == GLU_TRUE ) ?
+    _mm512_castsi512_pd( _mm512_xor_epi64( _mm512_castpd_si512( a ) ,
+					   _mm512_set1_epi64( 1LL << 63 ) ) ) : a ;
+}
+
+// r[l] holding 8 doubles of lane l to r[k] holding double k of each lane
+static inline void
+lane_transpose8( __m512d r[ 8 ] )
+{
+  const __m512d t0 = _mm512_unpacklo_pd( r[0] , r[1] ) ;
+  const __m512d t1 = _mm512_unpackhi_pd( r[0] , r[1] ) ;
+  const __m512d t2 = _mm512_unpacklo_pd( r[2] , r[3] ) ;
+  const __m512d t3 = _mm512_unpackhi_pd( r[2] , r[3] ) ;
+  const __m512d t4 = _mm512_unpacklo_pd( r[4] , r[5] ) ;
+  const __m512d t5 = _mm512_unpackhi_pd( r[4] , r[5] ) ;
+  const __m512d t6 = _mm512_unpacklo_pd( r[6] , r[7] ) ;
+  const __m512d t7 = _mm512_unpackhi_pd( r[6] , r[7] ) ;
+  // u0 has doubles 0 and 4 of lanes 0-3, u4 those of lanes 4-7 ...
+  const __m512d u0 = _mm512_shuffle_f64x2( t0 , t2 , 0x88 ) ;
+  const __m512d u1 = _mm512_shuffle_f64x2( t0 , t2 , 0xdd ) ;
+  const __m512d u2 = _mm512_shuffle_f64x2( t1 , t3 , 0x88 ) ;
+  const __m512d u3 = _mm512_shuffle_f64x2( t1 , t3 , 0xdd ) ;
+  const __m512d u4 = _mm512_shuffle_f64x2( t4 , t6 , 0x88 ) ;
+  const __m512d u5 = _mm512_shuffle_f64x2( t4 , t6 , 0xdd ) ;
+  const __m512d u6 = _mm512_shuffle_f64x2( t5 , t7 , 0x88 ) ;
+  const __m512d u7 = _mm512_shuffle_f64x2( t5 , t7 , 0xdd ) ;
+  r[0] = _mm512_shuffle_f64x2( u0 , u4 , 0x88 ) ;
+  r[1] = _mm512_shuffle_f64x2( u2 , u6 , 0x88 ) ;
+  r[2] = _mm512_shuffle_f64x2( u1 , u5 , 0x88 ) ;
+  r[3] = _mm512_shuffle_f64x2( u3 , u7 , 0x88 ) ;
+  r[4] = _mm512_shuffle_f64x2( u0 , u4 , 0xdd ) ;
+  r[5] = _mm512_shuffle_f64x2( u2 , u6 , 0xdd ) ;
+  r[6] = _mm512_shuffle_f64x2( u1 , u5 , 0xdd ) ;
+  r[7] = _mm512_shuffle_f64x2( u3 , u7 , 0xdd ) ;
+  return ;
+}
+
+static inline void
+lane_load( struct lane_mat *__restrict M ,
+	   const double *p[ STAPLE_LANES ] ,
+	   const GLU_bool dag )
+{
+  size_t h ;
+  // doubles 0-7 and 8-15 of each lane, elements 4h to 4h+3
+  for( h = 0 ; h < 2 ; h++ ) {
+    __m512d r[ 8 ] = { _mm512_loadu_pd( p[0] + 8*h ) ,
+		       _mm512_loadu_pd( p[1] + 8*h ) ,
+		       _mm512_loadu_pd( p[2] + 8*h ) ,
+		       _mm512_loadu_pd( p[3] + 8*h ) ,
+		       _mm512_loadu_pd( p[4] + 8*h ) ,
+		       _mm512_loadu_pd( p[5] + 8*h ) ,
+		       _mm512_loadu_pd( p[6] + 8*h ) ,
+		       _mm512_loadu_pd( p[7] + 8*h ) } ;
+    lane_transpose8( r ) ;
+    _mm512_storeu_pd( M -> re[ lane_dest( 4*h , dag ) ] , r[0] ) ;
+    _mm512_storeu_pd( M -> im[ lane_dest( 4*h , dag ) ] , lane_neg512( r[1] , dag ) ) ;
+    _mm512_storeu_pd( M -> re[ lane_dest( 4*h+1 , dag ) ] , r[2] ) ;
+    _mm512_storeu_pd( M -> im[ lane_dest( 4*h+1 , dag ) ] , lane_neg512( r[3] , dag ) ) ;
+    _mm512_storeu_pd( M -> re[ lane_dest( 4*h+2 , dag ) ] , r[4] ) ;
+    _mm512_storeu_pd( M -> im[ lane_dest( 4*h+2 , dag ) ] , lane_neg512( r[5] , dag ) ) ;
+    _mm512_storeu_pd( M -> re[ lane_dest( 4*h+3 , dag ) ] , r[6] ) ;
+    _mm512_storeu_pd( M -> im[ lane_dest( 4*h+3 , dag ) ] , lane_neg512( r[7] , dag ) ) ;
+  }
+  // and the last element, on the diagonal so not moved by the dagger
+  const __m512d lo = _mm512_insertf64x4( _mm512_castpd256_pd512(
+    _mm256_set_m128d( _mm_loadu_pd( p[1] + 16 ) , _mm_loadu_pd( p[0] + 16 ) ) ) ,
+    _mm256_set_m128d( _mm_loadu_pd( p[3] + 16 ) , _mm_loadu_pd( p[2] + 16 ) ) , 1 ) ;
+  const __m512d hi = _mm512_insertf64x4( _mm512_castpd256_pd512(
+    _mm256_set_m128d( _mm_loadu_pd( p[5] + 16 ) , _mm_loadu_pd( p[4] + 16 ) ) ) ,
+    _mm256_set_m128d( _mm_loadu_pd( p[7] + 16 ) , _mm_loadu_pd( p[6] + 16 ) ) , 1 ) ;
+  _mm512_storeu_pd( M -> re[8] , _mm512_permutex2var_pd( lo , _mm512_setr_epi64( 0 , 2 , 4 , 6 , 8 , 10 , 12 , 14 ) , hi ) ) ;
+  _mm512_storeu_pd( M -> im[8] , lane_neg512( _mm512_permutex2var_pd( lo , _mm512_setr_epi64( 1 , 3 , 5 , 7 , 9 , 11 , 13 , 15 ) , hi ) , dag ) ) ;
+  return ;
+}
+
+#elif (defined __AVX__) && !(defined SINGLE_PREC) && ( NC == 3 ) && ( STAPLE_LANES%4 == 0 )
+
+#include <immintrin.h>
+
+static inline __m256d
+lane_neg256( const __m256d a , const GLU_bool dag )
+{
+  return ( dag == GLU_TRUE ) ? _mm256_xor_pd( a , _mm256_set1_pd( -0.0 ) ) : a ;
+}
+
+static inline void
+lane_load( struct lane_mat *__restrict M ,
+	   const double *p[ STAPLE_LANES ] ,
+	   const GLU_bool dag )
+{
+  size_t b , c ;
+  // 4x4 transposes of the doubles 4c-4c+3 of lanes b-b+3
+  for( b = 0 ; b < STAPLE_LANES ; b += 4 ) {
+    const double **q = p + b ;
+    for( c = 0 ; c < 4 ; c++ ) {
+      const __m256d r[ 4 ] = { _mm256_loadu_pd( q[0] + 4*c ) ,
+			       _mm256_loadu_pd( q[1] + 4*c ) ,
+			       _mm256_loadu_pd( q[2] + 4*c ) ,
+			       _mm256_loadu_pd( q[3] + 4*c ) } ;
+      const __m256d t0 = _mm256_unpacklo_pd( r[0] , r[1] ) ;
+      const __m256d t1 = _mm256_unpackhi_pd( r[0] , r[1] ) ;
+      const __m256d t2 = _mm256_unpacklo_pd( r[2] , r[3] ) ;
+      const __m256d t3 = _mm256_unpackhi_pd( r[2] , r[3] ) ;
+      const size_t e0 = lane_dest( 2*c , dag ) , e1 = lane_dest( 2*c+1 , dag ) ;
+      _mm256_storeu_pd( M -> re[ e0 ] + b , _mm256_permute2f128_pd( t0 , t2 , 0x20 ) ) ;
+      _mm256_storeu_pd( M -> im[ e0 ] + b , lane_neg256( _mm256_permute2f128_pd( t1 , t3 , 0x20 ) , dag ) ) ;
+      _mm256_storeu_pd( M -> re[ e1 ] + b , _mm256_permute2f128_pd( t0 , t2 , 0x31 ) ) ;
+      _mm256_storeu_pd( M -> im[ e1 ] + b , lane_neg256( _mm256_permute2f128_pd( t1 , t3 , 0x31 ) , dag ) ) ;
+    }
+    // the last element is on the diagonal
+    const __m256d a = _mm256_set_m128d( _mm_loadu_pd( q[2] + 16 ) , _mm_loadu_pd( q[0] + 16 ) ) ;
+    const __m256d d = _mm256_set_m128d( _mm_loadu_pd( q[3] + 16 ) , _mm_loadu_pd( q[1] + 16 ) ) ;
+    _mm256_storeu_pd( M -> re[8] + b , _mm256_unpacklo_pd( a , d ) ) ;
+    _mm256_storeu_pd( M -> im[8] + b , lane_neg256( _mm256_unpackhi_pd( a , d ) , dag ) ) ;
+  }
+  return ;
+}
+
+#elif (defined HAVE_IMMINTRIN_H) && !(defined SINGLE_PREC) && ( STAPLE_LANES%2 == 0 )
+
+#include <immintrin.h>
+
+static inline void
+lane_load( struct lane_mat *__restrict M ,
+	   const double *p[ STAPLE_LANES ] ,
+	   const GLU_bool dag )
+{
+  const __m128d sgn = _mm_set1_pd( ( dag == GLU_TRUE ) ? -0.0 : 0.0 ) ;
+  size_t e , l ;
+  // (re,im) of two lanes to (re,re) and (im,im)
+  for( l = 0 ; l < STAPLE_LANES ; l += 2 ) {
+    for( e = 0 ; e < NCNC ; e++ ) {
+      const __m128d a = _mm_loadu_pd( p[l] + 2*e ) ;
+      const __m128d b = _mm_loadu_pd( p[l+1] + 2*e ) ;
+      const size_t d = lane_dest( e , dag ) ;
+      _mm_storeu_pd( M -> re[d] + l , _mm_unpacklo_pd( a , b ) ) ;
+      _mm_storeu_pd( M -> im[d] + l , _mm_xor_pd( _mm_unpackhi_pd( a , b ) , sgn ) ) ;
+    }
+  }
+  return ;
+}
+
+#else
+
+static inline void
+lane_load( struct lane_mat *__restrict M ,
+	   const GLU_real *p[ STAPLE_LANES ] ,
+	   const GLU_bool dag )
+{
+  size_t e , l ;
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    for( e = 0 ; e < NCNC ; e++ ) {
+      const size_t d = lane_dest( e , dag ) ;
+      M -> re[d][l] = p[l][ 2*e ] ;
+      M -> im[d][l] = ( dag == GLU_TRUE ) ? -p[l][ 2*e+1 ] : p[l][ 2*e+1 ] ;
+    }
+  }
+  return ;
+}
+
+#endif
+
+// link mu of each site into the tile
+static inline void
+lane_gather( struct lane_mat *__restrict M ,
+	     const struct site *__restrict lat ,
+	     const size_t site[ STAPLE_LANES ] ,
+	     const size_t mu )
+{
+  const GLU_real *p[ STAPLE_LANES ] ;
+  size_t l ;
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    p[l] = (const GLU_real*)lat[ site[l] ].O[mu] ;
+  }
+  lane_load( M , p , GLU_FALSE ) ;
+  return ;
+}
+
+// and its dagger, so the products never need to transpose
+static inline void
+lane_gather_dag( struct lane_mat *__restrict M ,
+		 const struct site *__restrict lat ,
+		 const size_t site[ STAPLE_LANES ] ,
+		 const size_t mu )
+{
+  const GLU_real *p[ STAPLE_LANES ] ;
+  size_t l ;
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    p[l] = (const GLU_real*)lat[ site[l] ].O[mu] ;
+  }
+  lane_load( M , p , GLU_TRUE ) ;
+  return ;
+}
+
+// C = A.B or C += A.B, accumulating each element of each lane in a
+// register rather than through C
+static inline void
+lane_mul( struct lane_mat *__restrict C ,
+	  const struct lane_mat *__restrict A ,
+	  const struct lane_mat *__restrict B ,
+	  const GLU_bool add )
+{
+  size_t i , j , l ;
+  for( i = 0 ; i < NC ; i++ ) {
+    for( j = 0 ; j < NC ; j++ ) {
+      GLU_real *cr = C -> re[ j + i*NC ] , *ci = C -> im[ j + i*NC ] ;
+      #pragma omp simd
+      for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	GLU_real re = ( add == GLU_TRUE ) ? cr[l] : 0.0 ;
+	GLU_real im = ( add == GLU_TRUE ) ? ci[l] : 0.0 ;
+#if NC == 3
+	// spelt out as -O2 does not unroll it
+	const GLU_real *ar = A -> re[ i*NC ] , *ai = A -> im[ i*NC ] ;
+	re += ( ar[l] * B -> re[j][l] - ai[l] * B -> im[j][l] )
+	  + ( ar[ STAPLE_LANES + l ] * B -> re[ j+3 ][l]
+	      - ai[ STAPLE_LANES + l ] * B -> im[ j+3 ][l] )
+	  + ( ar[ 2*STAPLE_LANES + l ] * B -> re[ j+6 ][l]
+	      - ai[ 2*STAPLE_LANES + l ] * B -> im[ j+6 ][l] ) ;
+	im += ( ar[l] * B -> im[j][l] + ai[l] * B -> re[j][l] )
+	  + ( ar[ STAPLE_LANES + l ] * B -> im[ j+3 ][l]
+	      + ai[ STAPLE_LANES + l ] * B -> re[ j+3 ][l] )
+	  + ( ar[ 2*STAPLE_LANES + l ] * B -> im[ j+6 ][l]
+	      + ai[ 2*STAPLE_LANES + l ] * B -> re[ j+6 ][l] ) ;
+#else
+	size_t k ;
+	for( k = 0 ; k < NC ; k++ ) {
+	  re += A -> re[ k + i*NC ][l] * B -> re[ j + k*NC ][l]
+	    - A -> im[ k + i*NC ][l] * B -> im[ j + k*NC ][l] ;
+	  im += A -> re[ k + i*NC ][l] * B -> im[ j + k*NC ][l]
+	    + A -> im[ k + i*NC ][l] * B -> re[ j + k*NC ][l] ;
+	}
+#endif
+	cr[l] = re ;
+	ci[l] = im ;
+      }
+    }
+  }
+  return ;
+}
+
+// the staple sum of link mu over the other dir-1 directions
+void
+LANES_FN( staples_lanes )( GLU_complex stap[ STAPLE_LANES ][ NCNC ] ,
+			   const struct site *__restrict lat ,
+			   const size_t site[ STAPLE_LANES ] ,
+			   const size_t n ,
+			   const size_t mu ,
+			   const size_t dir )
+{
+  struct lane_mat S , a , b , c ;
+  size_t x[ STAPLE_LANES ] , y[ STAPLE_LANES ] ;
+  size_t j , l ;
+  for( j = 0 ; j < NCNC ; j++ ) {
+    for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+      S.re[j][l] = S.im[j][l] = 0.0 ;
+    }
+  }
+  for( j = 0 ; j < dir-1 ; j++ ) {
+    const size_t nu = j < mu ? j : j + 1 ;
+    // top staple U_nu( x ) U_mu( x + nu ) U_nu( x + mu )^dagger
+    for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+      x[l] = site_fwd( site[l] , nu ) ;
+      y[l] = site_fwd( site[l] , mu ) ;
+    }
+    lane_gather( &a , lat , site , nu ) ;
+    lane_gather( &b , lat , x , mu ) ;
+    lane_mul( &c , &a , &b , GLU_FALSE ) ;
+    lane_gather_dag( &a , lat , y , nu ) ;
+    lane_mul( &S , &c , &a , GLU_TRUE ) ;
+    // bottom staple U_nu( x - nu )^dagger U_mu( x - nu ) U_nu( x - nu + mu )
+    for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+      x[l] = site_bck( site[l] , nu ) ;
+      y[l] = site_fwd( x[l] , mu ) ;
+    }
+    lane_gather_dag( &a , lat , x , nu ) ;
+    lane_gather( &b , lat , x , mu ) ;
+    lane_mul( &c , &a , &b , GLU_FALSE ) ;
+    lane_gather( &a , lat , y , nu ) ;
+    lane_mul( &S , &c , &a , GLU_TRUE ) ;
+  }
+  for( l = 0 ; l < n ; l++ ) {
+    for( j = 0 ; j < NCNC ; j++ ) {
+      stap[l][j] += S.re[j][l] + I * S.im[j][l] ;
+    }
+  }
+  return ;
+}
+
+// Re tr( U_mu( x ) U_nu( x + mu ) [ U_nu( x ) U_mu( x + nu ) ]^dagger )
+// summed into the temporal or spatial slot
+void
+LANES_FN( plaquettes_lanes )( double plaq[ STAPLE_LANES ][ 2 ] ,
+			      const struct site *__restrict lat ,
+			      const size_t site[ STAPLE_LANES ] )
+{
+  struct lane_mat U[ ND ] , a , X , Y ;
+  size_t x[ STAPLE_LANES ] ;
+  double p[ 2 ][ STAPLE_LANES ] ;
+  size_t mu , nu , j , l ;
+  for( mu = 0 ; mu < ND ; mu++ ) {
+    lane_gather( &U[mu] , lat , site , mu ) ;
+  }
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    p[0][l] = p[1][l] = 0.0 ;
+  }
+  for( mu = 0 ; mu < ND ; mu++ ) {
+    const size_t sp = mu < ND-1 ;
+    for( nu = 0 ; nu < mu ; nu++ ) {
+      for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	x[l] = site_fwd( site[l] , mu ) ;
+      }
+      lane_gather( &a , lat , x , nu ) ;
+      lane_mul( &X , &U[mu] , &a , GLU_FALSE ) ;
+      for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	x[l] = site_fwd( site[l] , nu ) ;
+      }
+      lane_gather( &a , lat , x , mu ) ;
+      lane_mul( &Y , &U[nu] , &a , GLU_FALSE ) ;
+      for( j = 0 ; j < NCNC ; j++ ) {
+        #pragma omp simd
+	for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	  p[sp][l] += X.re[j][l] * Y.re[j][l] + X.im[j][l] * Y.im[j][l] ;
+	}
+      }
+    }
+  }
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    plaq[l][0] = p[0][l] ;
+    plaq[l][1] = p[1][l] ;
+  }
+  return ;
+}
+
+// the four plaquettes of the mu-nu clover leaf, in the order and with
+// the products of compute_s1() ... compute_s4() in clover.c
+void
+LANES_FN( clover_lanes )( GLU_complex sum[ STAPLE_LANES ][ NCNC ] ,
+			  double plaq[ STAPLE_LANES ] ,
+			  const struct site *__restrict lat ,
+			  const size_t site[ STAPLE_LANES ] ,
+			  const size_t mu ,
+			  const size_t nu )
+{
+  struct lane_mat S , a , b , c , d ;
+  size_t x[ STAPLE_LANES ] , y[ STAPLE_LANES ] ;
+  size_t j , l ;
+  // top right, U_mu( x ) U_nu( x + mu ) U_mu( x + nu )^dag U_nu( x )^dag
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    x[l] = site_fwd( site[l] , mu ) ;
+    y[l] = site_fwd( site[l] , nu ) ;
+  }
+  lane_gather( &a , lat , site , mu ) ;
+  lane_gather( &b , lat , x , nu ) ;
+  lane_mul( &c , &a , &b , GLU_FALSE ) ;
+  lane_gather_dag( &a , lat , y , mu ) ;
+  lane_mul( &d , &c , &a , GLU_FALSE ) ;
+  lane_gather_dag( &a , lat , site , nu ) ;
+  lane_mul( &S , &d , &a , GLU_FALSE ) ;
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    double tr = 0.0 ;
+    for( j = 0 ; j < NC ; j++ ) {
+      tr += S.re[ j*( NC+1 ) ][l] ;
+    }
+    plaq[l] = tr ;
+  }
+  // bottom right, U_nu( x - nu )^dag U_mu( x - nu ) U_nu( x - nu + mu ) U_mu( x )^dag
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    x[l] = site_bck( site[l] , nu ) ;
+    y[l] = site_fwd( x[l] , mu ) ;
+  }
+  lane_gather_dag( &a , lat , x , nu ) ;
+  lane_gather( &b , lat , x , mu ) ;
+  lane_mul( &c , &a , &b , GLU_FALSE ) ;
+  lane_gather( &a , lat , y , nu ) ;
+  lane_mul( &d , &c , &a , GLU_FALSE ) ;
+  lane_gather_dag( &a , lat , site , mu ) ;
+  lane_mul( &S , &d , &a , GLU_TRUE ) ;
+  // bottom left, U_mu( x - mu )^dag U_nu( x - mu - nu )^dag U_mu( x - mu - nu ) U_nu( x - nu )
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    x[l] = site_bck( site[l] , mu ) ;
+    y[l] = site_bck( x[l] , nu ) ;
+  }
+  lane_gather_dag( &a , lat , x , mu ) ;
+  lane_gather_dag( &b , lat , y , nu ) ;
+  lane_mul( &c , &a , &b , GLU_FALSE ) ;
+  lane_gather( &a , lat , y , mu ) ;
+  lane_mul( &d , &c , &a , GLU_FALSE ) ;
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    y[l] = site_bck( site[l] , nu ) ;
+  }
+  lane_gather( &a , lat , y , nu ) ;
+  lane_mul( &S , &d , &a , GLU_TRUE ) ;
+  // top left, U_nu( x ) U_mu( x - mu + nu )^dag U_nu( x - mu )^dag U_mu( x - mu )
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    y[l] = site_fwd( x[l] , nu ) ;
+  }
+  lane_gather( &a , lat , site , nu ) ;
+  lane_gather_dag( &b , lat , y , mu ) ;
+  lane_mul( &c , &a , &b , GLU_FALSE ) ;
+  lane_gather_dag( &a , lat , x , nu ) ;
+  lane_mul( &d , &c , &a , GLU_FALSE ) ;
+  lane_gather( &a , lat , x , mu ) ;
+  lane_mul( &S , &d , &a , GLU_TRUE ) ;
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    for( j = 0 ; j < NCNC ; j++ ) {
+      sum[l][j] = S.re[j][l] + I * S.im[j][l] ;
+    }
+  }
+  return ;
+}
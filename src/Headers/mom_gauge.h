@@ -0,0 +1,49 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (mom_gauge.h) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file mom_gauge.h
+   @brief lie fields of the links and their fourier transform
+   @ingroup Cuts
+ */
+#ifndef GLU_MOM_GAUGE_H
+#define GLU_MOM_GAUGE_H
+
+/**
+   @fn int mom_gauge( struct site *__restrict A , const lie_field_def def )
+   @brief overwrite the links with the ND-dimensional FFT of their lie fields
+   @param A :: gauge field, overwritten
+   @param def :: logarithmic or linear definition of the fields
+   @return #GLU_SUCCESS or #GLU_FAILURE
+ */
+int
+mom_gauge( struct site *__restrict A ,
+	   const lie_field_def def ) ;
+
+/**
+   @fn int mom_gauge_spatial( struct site *__restrict A , const lie_field_def def )
+   @brief overwrite the links with the spatial FFT of their lie fields on each time-slice
+   @param A :: gauge field, overwritten
+   @param def :: logarithmic or linear definition of the fields
+   @return #GLU_SUCCESS or #GLU_FAILURE
+ */
+int
+mom_gauge_spatial( struct site *__restrict A ,
+		   const lie_field_def def ) ;
+
+#endif
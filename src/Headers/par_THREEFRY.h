@@ -0,0 +1,86 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (par_THREEFRY.h) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file par_THREEFRY.h
+   @brief prototype functions for the counter-based Threefry rng
+ */
+#ifndef GLU_PAR_THREEFRY_H
+#define GLU_PAR_THREEFRY_H
+
+/**
+   @fn void free_par_THREEFRY( void )
+   @brief free the per-thread streams
+ */
+void
+free_par_THREEFRY( void ) ;
+
+/**
+   @fn void GLU_set_par_THREEFRY_table( const uint32_t seed[ Latt.Nthreads ] )
+   @brief set the key from the seed and reset the counters
+   @param seed :: seeds for the RNG, only the first is used
+ */
+void
+GLU_set_par_THREEFRY_table( const uint32_t seed[ Latt.Nthreads ] ) ;
+
+/**
+   @fn double par_THREEFRY_dbl( const uint32_t thread )
+   @brief create a double precision random number
+   @param thread :: parallel thread index
+ */
+double
+par_THREEFRY_dbl( const uint32_t thread ) ;
+
+/**
+   @fn void par_THREEFRY_pass( void )
+   @brief move every counter on to a new pass over the lattice
+   @warning the increment is atomic but one thread must call it once per pass
+ */
+void
+par_THREEFRY_pass( void ) ;
+
+/**
+   @fn void par_THREEFRY_seek( const uint32_t thread , const size_t site , const size_t mu )
+   @brief point thread's stream at the first draw for ( site , mu ) in this pass
+   @param thread :: parallel thread index
+   @param site :: lattice site
+   @param mu :: direction
+ */
+void
+par_THREEFRY_seek( const uint32_t thread ,
+		   const size_t site ,
+		   const size_t mu ) ;
+
+/**
+   @fn int read_par_THREEFRY_table( FILE *rng_file )
+   @brief read the key and pass from rng_file
+   @param rng_file :: file to read the state from
+   @return #GLU_SUCCESS or #GLU_FAILURE
+ */
+int
+read_par_THREEFRY_table( FILE *rng_file ) ;
+
+/**
+   @fn void write_par_THREEFRY_table( FILE *rng_file )
+   @brief write the key and pass to rng_file
+   @param rng_file :: file to write out the state
+ */
+void
+write_par_THREEFRY_table( FILE *rng_file ) ;
+
+#endif
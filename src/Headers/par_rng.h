@@ -49,6 +49,21 @@ void
 par_generate_NCxNC( GLU_complex U[ NCNC ] , 
 		    const uint32_t thread ) ;
 
+/**
+   @fn void par_gaussian_array( GLU_complex *z , const size_t n , const uint32_t thread )
+   @brief fill an array with gaussian random numbers
+   @param z :: array of n complex gaussians, same distribution as par_polar_box()
+   @param n :: length of z
+   @param thread :: parallel thread index
+
+   Box-muller on blocks of #PAR_RNG_BLOCK uniforms so that the
+   transform vectorises, no rejection step
+ */
+void
+par_gaussian_array( GLU_complex *z ,
+		    const size_t n ,
+		    const uint32_t thread ) ;
+
 /**
    @fn GLU_real par_polar( const uint32_t thread )
    @brief gaussian random numbers from the box-mueller algorithm
@@ -76,6 +91,41 @@ par_polar_box( const uint32_t thread ) ;
 double
 par_rng_dbl( const uint32_t thread ) ;
 
+/**
+   @fn void par_rng_dbl_array( double *r , const size_t n , const uint32_t thread )
+   @brief fill an array with uniform doubles between 0 and 1
+   @param r :: array of n random doubles
+   @param n :: length of r
+   @param thread :: parallel thread index
+ */
+void
+par_rng_dbl_array( double *r ,
+		   const size_t n ,
+		   const uint32_t thread ) ;
+
+/**
+   @fn void par_rng_pass( void )
+   @brief start a new pass over the lattice, the counter-based rng gives new numbers for every ( site , mu ) from here on
+   @warning must be called by a single thread, outside of a parallel region or inside an omp single (or critical) that the threads seeking afterwards synchronise with. Does nothing for the table-based rngs
+ */
+void
+par_rng_pass( void ) ;
+
+/**
+   @fn void par_rng_seek( const uint32_t thread , const size_t site , const size_t mu )
+   @brief point thread's draws at the ones belonging to ( site , mu ) in this pass
+   @param thread :: parallel thread index
+   @param site :: lattice site being updated
+   @param mu :: direction of the link being updated
+
+   With the counter-based rng the numbers then do not depend on which
+   thread does the update, the table-based rngs ignore it
+ */
+void
+par_rng_seek( const uint32_t thread ,
+	      const size_t site ,
+	      const size_t mu ) ;
+
 /**
    @fn uint32_t par_rng_int( const uint32_t thread )
    @brief a random uint32_t between 0 and UINT_MAX
@@ -94,6 +144,14 @@ par_rng_int( const uint32_t thread ) ;
 int
 read_par_rng_state( const char *infile ) ;
 
+/**
+   @fn void write_par_rng_stream( FILE *out )
+   @brief write the rng header and table to an open stream
+   @param out :: stream being written
+*/
+void
+write_par_rng_stream( FILE *out ) ;
+
 /**
    @fn int read_par_rng_state( const char *outfile )
    @brief read the rng table to outfile
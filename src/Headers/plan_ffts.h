@@ -49,6 +49,19 @@ create_plans_DFT( struct fftw_stuff *FFTW ,
 		  const size_t ARR_SIZE ,
 		  const size_t DIR ) ;
 
+/**
+   @fn void accelerate_DFT( const struct fftw_stuff *FFTW , const size_t ARR_SIZE )
+   @brief forward transform, multiply by FFTW.psq and transform back each FFTW.in
+   @param FFTW :: plans and arrays from create_plans_DFT()
+   @param ARR_SIZE :: number of fields to accelerate
+
+   Must be called by every thread of the team, the fields are split into
+   slabs and lines so all of them get work however few fields there are
+ */
+void
+accelerate_DFT( const struct fftw_stuff *FFTW ,
+		const size_t ARR_SIZE ) ;
+
 /**
    @fn void small_clean_up_fftw( struct fftw_small_stuff FFTW ) 
    @brief deallocate memory and free plans created by small_create_plans_DFT()
@@ -69,5 +82,54 @@ small_create_plans_DFT( struct fftw_small_stuff *FFTW ,
 			const size_t dims[ ND ] ,
 			const size_t DIR ) ;
 
+/**
+   @fn void many_create_plans_DFT( struct fftw_small_stuff *FFTW , const size_t dims[ ND ] , const size_t DIR , const size_t howmany )
+   @brief plan the transform of each of howmany contiguous fields
+   @param FFTW :: temporary fft arrays, FFTW.out aliases FFTW.in
+   @param dims :: dimensions of the FFT in GLU order
+   @param DIR :: dimensionality of the FFT, need not be #ND
+   @param howmany :: number of fields, each of the product of the first DIR dims
+
+   The plans are in-place on a single field, field n starts at
+   FFTW.in + n * VOL and they are all done by many_execute_DFT().
+   Clean up with small_clean_up_fftw()
+ */
+void
+many_create_plans_DFT( struct fftw_small_stuff *FFTW ,
+		       const size_t dims[ ND ] ,
+		       const size_t DIR ,
+		       const size_t howmany ) ;
+
+/**
+   @fn void many_execute_DFT( const fftw_plan plan , GLU_complex *in , const size_t VOL , const size_t howmany )
+   @brief in-place transform of howmany contiguous fields, threaded over the fields
+   @param plan :: forward or backward plan from many_create_plans_DFT()
+   @param in :: the first field
+   @param VOL :: length of each field
+   @param howmany :: number of fields
+
+   Opens its own parallel region, so it must not be called from one
+ */
+void
+many_execute_DFT( const fftw_plan plan ,
+		  GLU_complex *in ,
+		  const size_t VOL ,
+		  const size_t howmany ) ;
+
+/**
+   @fn void keep_fftw_plans( void )
+   @brief keep plans and their arrays alive after the clean up calls
+   so that later calls with the same dimensions reuse them
+ */
+void
+keep_fftw_plans( void ) ;
+
+/**
+   @fn void release_fftw_plans( void )
+   @brief destroy every plan kept alive by keep_fftw_plans()
+ */
+void
+release_fftw_plans( void ) ;
+
 #endif // HAVE_FFTW_H
 #endif
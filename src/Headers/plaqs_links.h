@@ -119,6 +119,33 @@ gauge_topological_meas_th( double *red ,
 			   double *qtop_old ,
 			   const size_t iter ) ;
 
+/**
+   @fn void gauge_obs_th( struct gauge_obs *obs , double *red , const struct site *__restrict lat , const GLU_bool clover )
+   @brief plaquettes, link traces and the clover action density and charge in a single sweep
+   @param obs :: measured observables, every thread gets a copy
+   @param red :: reduction array, uses the first 7 elements of each #CLINE
+   @param lat :: gauge field
+   @param clover :: also compute \f$ G_{\mu\nu} G_{\mu\nu} \f$ and \f$ Q \f$, ND == 4 only
+   @warning expected to be called in a parallel environment
+ */
+void
+gauge_obs_th( struct gauge_obs *obs ,
+	      double *red ,
+	      const struct site *__restrict lat ,
+	      const GLU_bool clover ) ;
+
+/**
+   @fn void gauge_obs( struct gauge_obs *obs , const struct site *__restrict lat , const GLU_bool clover )
+   @brief serial-region wrapper for gauge_obs_th()
+   @param obs :: measured observables
+   @param lat :: gauge field
+   @param clover :: also compute \f$ G_{\mu\nu} G_{\mu\nu} \f$ and \f$ Q \f$, ND == 4 only
+ */
+void
+gauge_obs( struct gauge_obs *obs ,
+	   const struct site *__restrict lat ,
+	   const GLU_bool clover ) ;
+
 /**
    @fn double all_links( const struct site *__restrict lat , double *__restrict sp_link , double *__restrict t_link ) 
    @brief computes the lattice average trace of all directions of links
@@ -24,31 +24,38 @@
 #define GLU_READERS_H
 
 /**
-   @fn uint32_t lattice_reader_suNC( struct site *__restrict lat , FILE *__restrict in , const struct head_data HEAD_DATA )
-   @brief reads in a NERSC configuration ...
+   @fn uint32_t lattice_reader_suNC_mmap( struct site *__restrict lat , FILE *__restrict in , const struct head_data HEAD_DATA )
+   @brief reads a configuration straight out of a memory mapping of the file
    @param lat :: lattice gauge field
-   @param in :: NERSC configuration being read
+   @param in :: configuration being read, positioned at the binary data
    @param HEAD_DATA :: the header data
 
-   @returns #GLU_SUCCESS or #GLU_FAILURE
+   Checksums, byteswaps and rebuilds each site in one parallel pass
+   without a configuration-sized buffer. Falls back to
+   lattice_reader_suNC_stream() if the file cannot be mapped
+
+   @returns the checksum for this header type or #GLU_FAILURE
  **/
 uint32_t
-lattice_reader_suNC( struct site *__restrict lat , 
-		     FILE *__restrict in , 
-		     const struct head_data HEAD_DATA ) ;
+lattice_reader_suNC_mmap( struct site *__restrict lat , 
+			  FILE *__restrict in , 
+			  const struct head_data HEAD_DATA ) ;
 
 /**
-   @fn uint32_t lattice_reader_suNC_cheaper( struct site *__restrict lat , FILE *__restrict in , const struct head_data HEAD_DATA )
-   @brief reads in a NERSC configuration, cheaper and a little slower than the other needed for the Q.
+   @fn uint32_t lattice_reader_suNC_stream( struct site *__restrict lat , FILE *__restrict in , const struct head_data HEAD_DATA )
+   @brief pipelined slice-by-slice configuration reader
    @param lat :: lattice gauge field
-   @param in :: NERSC configuration being read
+   @param in :: configuration being read, positioned at the binary data
    @param HEAD_DATA :: the header data
 
-   @returns #GLU_SUCCESS or #GLU_FAILURE
+   Holds two #LCU slices of file data, one thread reads the next
+   slice while the others checksum, byteswap and rebuild the current one
+
+   @returns the checksum for this header type or #GLU_FAILURE
  **/
 uint32_t
-lattice_reader_suNC_cheaper( struct site *__restrict lat , 
-			     FILE *__restrict in , 
-			     const struct head_data HEAD_DATA ) ;
+lattice_reader_suNC_stream( struct site *__restrict lat , 
+			    FILE *__restrict in , 
+			    const struct head_data HEAD_DATA ) ;
 
 #endif
@@ -41,6 +41,29 @@ all_staples( GLU_complex stap[ NCNC ] ,
 	     const size_t dir , 
 	     const smearing_types type ) ;
 
+/**
+   @fn void all_staples_lanes( GLU_complex stap[ STAPLE_LANES ][ NCNC ] , const struct site *__restrict lat , const size_t site[ STAPLE_LANES ] , const size_t n , const size_t mu , const size_t dir , const smearing_types type )
+   @brief all_staples() or all_staples_improve() for up to #STAPLE_LANES sites at once
+   @param stap :: sums of the contributing mu-nu staples, one per site
+   @param lat :: lattice gauge field
+   @param site :: site indices, only the first n are used
+   @param n :: number of sites
+   @param mu :: direction of the link we are improving
+   @param dir :: number of directions we smear in
+   @param type :: smearing projection type
+
+   the unimproved non-log staples use the vectorised staples_lanes() of
+   lanes.h, everything else loops the per-site routines
+ **/
+void
+all_staples_lanes( GLU_complex stap[ STAPLE_LANES ][ NCNC ] ,
+		   const struct site *__restrict lat ,
+		   const size_t site[ STAPLE_LANES ] ,
+		   const size_t n ,
+		   const size_t mu ,
+		   const size_t dir ,
+		   const smearing_types type ) ;
+
 /**
    @fn void all_staples_improve( GLU_complex stap[ NCNC ] , const struct site *__restrict lat , const size_t i , const size_t mu , const size_t dir , const size_t type )
    @brief he computation of the (over)improved staple(s)
@@ -27,39 +27,70 @@
    @fn double Re_trace_abc_dag_suNC( const GLU_complex a[ NCNC ] , const GLU_complex b[ NCNC ] , const GLU_complex c[ NCNC ] ) 
    @brief real part of the trace of the product of 3 SU(N) matrices
  */
+#ifdef GLU_DISPATCH
+extern double
+(*Re_trace_abc_dag_suNC)( const GLU_complex a[ NCNC ] , 
+			  const GLU_complex b[ NCNC ] , 
+			  const GLU_complex c[ NCNC ] ) ;
+#else
 double
 Re_trace_abc_dag_suNC( const GLU_complex a[ NCNC ] , 
 		       const GLU_complex b[ NCNC ] , 
 		       const GLU_complex c[ NCNC ] ) ;
+#endif
 
 /**
    @fn void trace_abc( GLU_complex *__restrict tr , const GLU_complex a[ NCNC ] , const GLU_complex b[ NCNC ] , const GLU_complex c[ NCNC ] )
    @brief trace of the product of 3 #NCNC matrices
  */
+#ifdef GLU_DISPATCH
+extern void
+(*trace_abc)( GLU_complex *__restrict tr , 
+	      const GLU_complex a[ NCNC ] , 
+	      const GLU_complex b[ NCNC ] , 
+	      const GLU_complex c[ NCNC ] ) ;
+#else
 void
 trace_abc( GLU_complex *__restrict tr , 
 	   const GLU_complex a[ NCNC ] , 
 	   const GLU_complex b[ NCNC ] , 
 	   const GLU_complex c[ NCNC ] ) ;
+#endif
 
 /**
    @fn void trace_abc_dag( GLU_complex *__restrict tr , const GLU_complex a[ NCNC ] , const GLU_complex b[ NCNC ] , const GLU_complex c[ NCNC ] )
    @brief trace of abc where c is daggered
  */
+#ifdef GLU_DISPATCH
+extern void
+(*trace_abc_dag)( GLU_complex *__restrict tr , 
+		  const GLU_complex a[ NCNC ] , 
+		  const GLU_complex b[ NCNC ] , 
+		  const GLU_complex c[ NCNC ] ) ;
+#else
 void
 trace_abc_dag( GLU_complex *__restrict tr , 
 	       const GLU_complex a[ NCNC ] , 
 	       const GLU_complex b[ NCNC ] , 
 	       const GLU_complex c[ NCNC ] ) ;
+#endif
 
 /**
    @fn void trace_abc_dag_Re( GLU_real *__restrict tr , const GLU_complex a[ NCNC ] , const GLU_complex b[ NCNC ] , const GLU_complex c[ NCNC ] )
    @brief real part of the trace of abc where c is daggered
  */
+#ifdef GLU_DISPATCH
+extern void
+(*trace_abc_dag_Re)( GLU_real *__restrict tr , 
+		     const GLU_complex a[ NCNC ] , 
+		     const GLU_complex b[ NCNC ] , 
+		     const GLU_complex c[ NCNC ] ) ;
+#else
 void
 trace_abc_dag_Re( GLU_real *__restrict tr , 
 		  const GLU_complex a[ NCNC ] , 
 		  const GLU_complex b[ NCNC ] , 
 		  const GLU_complex c[ NCNC ] ) ;
+#endif
 
 #endif
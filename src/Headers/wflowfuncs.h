@@ -183,12 +183,33 @@ step_distance_memcheap( struct site *__restrict lat ,
 					 const double smear_alpha ) ) ;
 
 /**
-   @fn void update_meas_list( struct wfmeas *head , struct wfmeas *curr , double *red , const double new_plaq , const double t , const double delta_t , const double errmax , const struct site *lat )
+   @fn double step_distance_embedded( struct site *__restrict lat , struct wflow_temps WF , const double delta_t , const smearing_types SM_TYPE , void (*project)( GLU_complex log[ NCNC ] , GLU_complex *__restrict staple , const GLU_complex link[ NCNC ] , const double smear_alpha ) )
+   @brief perform one rk3 wilson flow integration step and estimate its error
+   @param lat :: lattice gauge field
+   @param WF :: flow temporaries, Zfirst must be allocated lattice-wide
+   @param delta_t :: flow time step
+   @param SM_TYPE :: the smearing projection used 
+   @param project :: stout or log projection
+   @return the largest link distance between the third order solution and
+   the embedded second order one exp( dt( 2Z_1 - 5/4 Z_0 ) ) W_1 built from the same stages
+   @warning must be called by every thread of a parallel region
+ */
+double
+step_distance_embedded( struct site *__restrict lat ,
+			struct wflow_temps WF ,
+			const double delta_t ,
+			const smearing_types SM_TYPE ,
+			void (*project)( GLU_complex log[ NCNC ] , 
+					 GLU_complex *__restrict staple , 
+					 const GLU_complex link[ NCNC ] , 
+					 const double smear_alpha ) ) ;
+
+/**
+   @fn void update_meas_list( struct wfmeas *head , struct wfmeas *curr , double *red , const double t , const double delta_t , const double errmax , const struct site *lat )
    @brief updates the measurement linked list with various gradient flow measurements
    @param head :: the head of the list
    @param curr :: the current node of the list that we will write into
    @param red :: reduction array
-   @param new_plaq :: new value of the plaquette
    @param t :: flow time
    @param delta_t :: flow increment
    @param errmax :: maximum error for this step
@@ -198,7 +219,6 @@ void
 update_meas_list( struct wfmeas *head ,
 		  struct wfmeas *curr ,
 		  double *red ,
-		  const double new_plaq ,
 		  const double t ,
 		  const double delta_t ,
 		  const double errmax ,
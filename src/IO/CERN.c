@@ -71,7 +71,7 @@ read_CLS_field( struct site *__restrict lat ,
 	    }
       
 	    size_t mu , j , a = 0 ;
-	    size_t shift = lat[idx].back[ND-1] ;
+	    size_t shift = site_bck( idx , ND-1 ) ;
 	    // t first
 	    for( j = 0 ; j < NCNC ; j++ ) {
 	      lat[idx].O[ND-1][j] = (GLU_real)uind[a] + I * (GLU_real)uind[a + 1] ;
@@ -87,7 +87,7 @@ read_CLS_field( struct site *__restrict lat ,
 		lat[idx].O[mu][j] = (GLU_real)uind[a] + I * (GLU_real)uind[a + 1] ;
 		a += 2 ;
 	      }
-	      size_t shift = lat[idx].back[mu] ;
+	      size_t shift = site_bck( idx , mu ) ;
 	      for( j = 0 ; j < NCNC ; j++ ) {
 		lat[shift].O[mu][j] = (GLU_real)uind[a] + I * (GLU_real)uind[a + 1] ;
 		a += 2 ;
@@ -157,7 +157,7 @@ write_CLS_field( const struct site *__restrict lat ,
 	    
 	    // config idx
 	    size_t idx = gen_site( xloc ) ;
-	    size_t shift = lat[idx].back[ ND-1 ] ;
+	    size_t shift = site_bck( idx , ND-1 ) ;
 	    
 	    size_t j , a = 0 ;
 	    // t first
@@ -180,7 +180,7 @@ write_CLS_field( const struct site *__restrict lat ,
 		uoutd[ a + 1 ] = ( double )cimag( lat[idx].O[mu][j] ) ; 
 		a += 2 ;
 	      }
-	      shift = lat[idx].back[mu] ;
+	      shift = site_bck( idx , mu ) ;
 	      for( j = 0 ; j < NCNC ; j++ ) {
 		uoutd[ a + 0 ] = ( double )creal( lat[shift].O[mu][j] ) ; 
 		uoutd[ a + 1 ] = ( double )cimag( lat[shift].O[mu][j] ) ; 
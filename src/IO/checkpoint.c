@@ -0,0 +1,297 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (checkpoint.c) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file checkpoint.c
+   @brief configuration and rng checkpoints for the heatbath
+
+   Synchronously the team idles while one thread writes. With staging
+   slots the links are copied in parallel into a free slot along with
+   the rng state and a pthread writes them out while the updates carry
+   on, the queue is bounded by the number of slots
+ */
+#include "Mainfile.h"
+
+#include "checkpoint.h"  // alphabetising
+#include "GLU_malloc.h"  // allocate_lat()
+#include "GLUlib_wrap.h" // write_configuration()
+#include "par_rng.h"     // write_par_rng_state()
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+#endif
+
+// copies a string into a freshly allocated one
+static char *
+copy_str( const char *str )
+{
+  char *cp = malloc( strlen( str ) + 1 ) ;
+  if( cp != NULL ) strcpy( cp , str ) ;
+  return cp ;
+}
+
+#ifdef HAVE_PTHREAD_H
+// a checkpoint sitting in a staging slot
+struct staged {
+  struct site *lat ;
+  char *rng ;
+  size_t rng_len ;
+  size_t seq ;
+  char *config_file ;
+  char *rng_file ;
+} ;
+
+#endif
+
+// output details and the queue shared between the team and the writer
+static struct {
+  GLU_output storage ;
+  char *details ;
+  size_t Nslots ;
+#ifdef HAVE_PTHREAD_H
+  struct staged *slots ;
+  size_t head ;
+  size_t Nqueued ;
+  GLU_bool stop ;
+  struct staged *stage ;
+  pthread_t writer ;
+  pthread_mutex_t lock ;
+  pthread_cond_t queued ;
+  pthread_cond_t freed ;
+#endif
+} CK ;
+
+// write the configuration and if that went ok the rng state
+static void
+write_checkpoint( struct site *lat ,
+		  const size_t seq ,
+		  const char *config_file ,
+		  const char *rng_file ,
+		  const GLU_output storage ,
+		  const char *details ,
+		  const char *rng ,
+		  const size_t rng_len )
+{
+  Latt.flow = seq ;
+  if( write_configuration( lat , config_file , storage , details )
+      == GLU_FAILURE ) {
+    return ;
+  }
+  // synchronously we can write the live rng state
+  if( rng == NULL ) {
+    write_par_rng_state( rng_file ) ;
+    return ;
+  }
+  FILE *out = fopen( rng_file , "wb" ) ;
+  if( out == NULL ) {
+    fprintf( stderr , "[CHECKPOINT] cannot open %s\n" , rng_file ) ;
+    return ;
+  }
+  fwrite( rng , sizeof( char ) , rng_len , out ) ;
+  fclose( out ) ;
+  return ;
+}
+
+#ifdef HAVE_PTHREAD_H
+
+// empty the queue until we are told to stop
+static void *
+writer_thread( void *arg )
+{
+#if (defined _OPENMP ) && (defined HAVE_OMP_H )
+  // the team is busy updating, the writer gets one core
+  omp_set_num_threads( 1 ) ;
+#endif
+  pthread_mutex_lock( &CK.lock ) ;
+  for( ;; ) {
+    while( CK.Nqueued == 0 && CK.stop == GLU_FALSE ) {
+      pthread_cond_wait( &CK.queued , &CK.lock ) ;
+    }
+    if( CK.Nqueued == 0 ) break ;
+    struct staged *s = &CK.slots[ CK.head ] ;
+    pthread_mutex_unlock( &CK.lock ) ;
+
+    write_checkpoint( s -> lat , s -> seq , s -> config_file ,
+		      s -> rng_file , CK.storage , CK.details ,
+		      s -> rng , s -> rng_len ) ;
+    free( s -> rng ) ;
+    free( s -> config_file ) ;
+    free( s -> rng_file ) ;
+
+    pthread_mutex_lock( &CK.lock ) ;
+    CK.head = ( CK.head + 1 ) % CK.Nslots ;
+    CK.Nqueued-- ;
+    pthread_cond_signal( &CK.freed ) ;
+  }
+  pthread_mutex_unlock( &CK.lock ) ;
+  return NULL ;
+}
+
+// free whatever staging fields we have
+static void
+free_slots( void )
+{
+  size_t n ;
+  for( n = 0 ; n < CK.Nslots ; n++ ) {
+    free_lat( CK.slots[n].lat ) ;
+  }
+  free( CK.slots ) ;
+  CK.slots = NULL ;
+  CK.Nslots = 0 ;
+}
+
+#endif
+
+// set up the staging slots and the writer
+int
+init_checkpoints( const size_t Nslots ,
+		  const GLU_output storage ,
+		  const char *details )
+{
+  CK.storage = storage ;
+  CK.Nslots = 0 ;
+  if( ( CK.details = copy_str( details ) ) == NULL ) {
+    fprintf( stderr , "[CHECKPOINT] details allocation failure\n" ) ;
+    return GLU_FAILURE ;
+  }
+  if( Nslots == 0 ) return GLU_SUCCESS ;
+#ifdef HAVE_PTHREAD_H
+  CK.head = CK.Nqueued = 0 ;
+  CK.stop = GLU_FALSE ;
+  if( ( CK.slots = calloc( Nslots , sizeof( struct staged ) ) ) == NULL ) {
+    fprintf( stderr , "[CHECKPOINT] staging allocation failure, "
+	     "writing synchronously\n" ) ;
+    return GLU_SUCCESS ;
+  }
+  for( CK.Nslots = 0 ; CK.Nslots < Nslots ; CK.Nslots++ ) {
+    if( ( CK.slots[ CK.Nslots ].lat = allocate_lat( ) ) == NULL ) {
+      free_slots( ) ;
+      fprintf( stderr , "[CHECKPOINT] staging allocation failure, "
+	       "writing synchronously\n" ) ;
+      return GLU_SUCCESS ;
+    }
+  }
+  pthread_mutex_init( &CK.lock , NULL ) ;
+  pthread_cond_init( &CK.queued , NULL ) ;
+  pthread_cond_init( &CK.freed , NULL ) ;
+  if( pthread_create( &CK.writer , NULL , writer_thread , NULL ) != 0 ) {
+    pthread_mutex_destroy( &CK.lock ) ;
+    pthread_cond_destroy( &CK.queued ) ;
+    pthread_cond_destroy( &CK.freed ) ;
+    free_slots( ) ;
+    fprintf( stderr , "[CHECKPOINT] cannot start the writer, "
+	     "writing synchronously\n" ) ;
+    return GLU_SUCCESS ;
+  }
+  fprintf( stdout , "[CHECKPOINT] Asynchronous saves through %zu "
+	   "staging field(s)\n" , CK.Nslots ) ;
+#else
+  fprintf( stdout , "[CHECKPOINT] No pthreads, writing synchronously\n" ) ;
+#endif
+  return GLU_SUCCESS ;
+}
+
+// called by the whole team, returns once the checkpoint is written or queued
+void
+checkpoint_configuration( const struct site *lat ,
+			  const size_t seq ,
+			  const char *config_file ,
+			  const char *rng_file )
+{
+#ifdef HAVE_PTHREAD_H
+  if( CK.Nslots > 0 ) {
+    // wait for a free slot, this is where a slow disk pushes back
+    #pragma omp single
+    {
+      pthread_mutex_lock( &CK.lock ) ;
+      while( CK.Nqueued == CK.Nslots ) {
+	pthread_cond_wait( &CK.freed , &CK.lock ) ;
+      }
+      CK.stage = &CK.slots[ ( CK.head + CK.Nqueued ) % CK.Nslots ] ;
+      pthread_mutex_unlock( &CK.lock ) ;
+    }
+    // everyone copies their share of the links
+    const size_t Nlinks = LVOLUME * ND ;
+    GLU_complex *pd = lat_slab( CK.stage -> lat ) ;
+    const GLU_complex *ps = lat_slab( lat ) ;
+    size_t i ;
+    #pragma omp for private(i)
+    for( i = 0 ; i < Nlinks ; i++ ) {
+      memcpy( pd + i * NCNC , ps + i * NCNC , NCNC * sizeof( GLU_complex ) ) ;
+    }
+    // snapshot the rng and hand the slot over
+    #pragma omp single
+    {
+      struct staged *s = CK.stage ;
+      FILE *mem = open_memstream( &( s -> rng ) , &( s -> rng_len ) ) ;
+      if( mem != NULL ) {
+	write_par_rng_stream( mem ) ;
+	fclose( mem ) ;
+      } else {
+	s -> rng = NULL ;
+      }
+      s -> seq = seq ;
+      s -> config_file = copy_str( config_file ) ;
+      s -> rng_file = copy_str( rng_file ) ;
+      if( s -> rng == NULL || s -> config_file == NULL ||
+	  s -> rng_file == NULL ) {
+	fprintf( stderr , "[CHECKPOINT] staging failure, %s not saved\n" ,
+		 config_file ) ;
+	free( s -> rng ) ;
+	free( s -> config_file ) ;
+	free( s -> rng_file ) ;
+      } else {
+	pthread_mutex_lock( &CK.lock ) ;
+	CK.Nqueued++ ;
+	pthread_cond_signal( &CK.queued ) ;
+	pthread_mutex_unlock( &CK.lock ) ;
+      }
+    }
+    return ;
+  }
+#endif
+  #pragma omp single
+  {
+    write_checkpoint( (struct site*)lat , seq , config_file , rng_file ,
+		      CK.storage , CK.details , NULL , 0 ) ;
+  }
+  return ;
+}
+
+// drain the queue and stop the writer
+void
+flush_checkpoints( void )
+{
+#ifdef HAVE_PTHREAD_H
+  if( CK.Nslots > 0 ) {
+    pthread_mutex_lock( &CK.lock ) ;
+    CK.stop = GLU_TRUE ;
+    pthread_cond_signal( &CK.queued ) ;
+    pthread_mutex_unlock( &CK.lock ) ;
+    pthread_join( CK.writer , NULL ) ;
+    pthread_mutex_destroy( &CK.lock ) ;
+    pthread_cond_destroy( &CK.queued ) ;
+    pthread_cond_destroy( &CK.freed ) ;
+    free_slots( ) ;
+    fprintf( stdout , "[CHECKPOINT] All checkpoints written\n" ) ;
+  }
+#endif
+  free( CK.details ) ;
+  CK.details = NULL ;
+  return ;
+}
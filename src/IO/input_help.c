@@ -223,6 +223,11 @@ help_usage( void )
   fprintf( stdout , "SMEARTYPE, DIRECTION, SMITERS, ALPHA,\n" ) ;
   fprintf( stdout , "U1_MEAS, U1_ALPHA, U1_CHARGE,\n" ) ;
   fprintf( stdout , "CONFIG_INFO, STORAGE,\n" ) ;
+  fprintf( stdout , "FIELD_LAYOUT (optional),\n" ) ;
+  fprintf( stdout , "NAVIGATION (optional),\n" ) ;
+  fprintf( stdout , "ASYNC_SAVE (optional),\n" ) ;
+  fprintf( stdout , "COULOMB_TEAMS (optional),\n" ) ;
+  fprintf( stdout , "GF_SNAPSHOT (optional),\n" ) ;
   fprintf( stdout , "*caution* in the {input_file} each one of these have "
 	   "to be specified\n"
 	  "          ONCE AND ONLY ONCE!\n" ) ;
@@ -299,6 +304,10 @@ smeartype_types( void )
 	   "of the flow equation using LOG links\n" ) ;
   fprintf( stdout , "          = ADAPTWFLOW_STOUT - Adaptive RK3 integration "
 	   "of the flow equation using STOUT links\n" ) ;
+  fprintf( stdout , "          = EMBEDWFLOW_LOG   - Adaptive RK3 integration "
+	   "of the flow equation using LOG links, embedded error estimate\n" ) ;
+  fprintf( stdout , "          = EMBEDWFLOW_STOUT - Adaptive RK3 integration "
+	   "of the flow equation using STOUT links, embedded error estimate\n" ) ;
   fprintf( stdout , "          = APE              - APE smearing U' = ( 1 - "
 	   "\\alpha ) U + \\sum staples \n" ) ;
   fprintf( stdout , "          = HEX              - Hypercubically blocked, "
@@ -415,6 +424,18 @@ GLU_helps_those_who_help_themselves( const char *help_str )
 	     "of the\n"
 	     "                 fields and after %d restarts it complains about "
 	     "changing the tuning\n" , GF_GLU_FAILURES ) ;
+  } else if( are_equal( help_str , "--help=COULOMB_TEAMS" ) ) {
+    fprintf( stdout , "COULOMB_TEAMS = %%d - the number of time-slices "
+	     "Coulomb gauge fixed at once, each by a team of "
+	     "threads/COULOMB_TEAMS threads. 0 or unspecified fixes one "
+	     "slice at a time with every thread\n" ) ;
+  } else if( are_equal( help_str , "--help=GF_SNAPSHOT" ) ) {
+    fprintf( stdout , "GF_SNAPSHOT = NONE  - Landau random restarts reread "
+	     "the configuration file\n" ) ;
+    fprintf( stdout , "GF_SNAPSHOT = FULL  - keep a copy of the links in "
+	     "memory for the restarts\n" ) ;
+    fprintf( stdout , "GF_SNAPSHOT = SMALL - keep the copy in the compressed "
+	     "NERSC_SMALL form, NC < 4 only\n" ) ;
   } else if( are_equal( help_str , "--help=CUTTYPE" ) ) {
     cuttype_types( ) ;
   } else if( are_equal( help_str , "--help=FIELD_DEFINTION" ) ) {
@@ -482,6 +503,22 @@ GLU_helps_those_who_help_themselves( const char *help_str )
 	     "for when we write out the configuration file\n" ) ;
   } else if( are_equal( help_str , "--help=STORAGE" ) ) {
     storage_types( ) ;
+  } else if( are_equal( help_str , "--help=FIELD_LAYOUT" ) ) {
+    fprintf( stdout , "FIELD_LAYOUT = LINK_MAJOR - links stored as "
+	     "[mu][site][NCNC] in one contiguous slab\n"
+	     "             = CHECKERBOARD - links stored as "
+	     "[mu][colour][tile][NCNC], the heatbath's update order\n"
+	     "             = {ALL ELSE} - links stored as "
+	     "[site][mu][NCNC] (the default if not specified)\n" ) ;
+  } else if( are_equal( help_str , "--help=NAVIGATION" ) ) {
+    fprintf( stdout , "NAVIGATION = ON_THE_FLY - lattice neighbours are "
+	     "computed when needed, saves memory on huge volumes\n"
+	     "           = {ALL ELSE} - one shared 32-bit neighbour table "
+	     "(the default if not specified)\n" ) ;
+  } else if( are_equal( help_str , "--help=ASYNC_SAVE" ) ) {
+    fprintf( stdout , "ASYNC_SAVE = %%d - the number of staging copies of "
+	     "the gauge field used to write HB-OR configurations in the "
+	     "background, 0 or unspecified writes them synchronously\n" ) ;
   } else if( are_equal( help_str , "--help=BETA" ) ) {
     fprintf( stdout , "BETA = %%f - the parameter 2N/g_0^2 with which "
 	     "we weight the ensembles in the heatbath\n" ) ;
@@ -533,6 +570,10 @@ GLUsage( void )
   fprintf( stdout , "\nTo run the code use (the last command is optional):\n\n"
 	   "./GLU -i {input_file} -c {config_file} "
 	   "-o {output_config_name} \n" ) ;
+  fprintf( stdout , "\nOr over many configurations, "
+	   "\"%%s\" in the output is each configuration's name:\n\n"
+	   "./GLU -i {input_file} -b {config_list_file or \"glob*\"} "
+	   "-o {output_pattern_%%s} \n" ) ;
   fprintf( stdout , "\nFor help on various {input_file} options use:\n\n"
 	   "./GLU --help={input_file option}\n\n" ) ;
   fprintf( stdout , "To automatically generate a standard input file use:\n\n"
@@ -347,6 +347,13 @@ read_hb_struct( struct hb_info *HBINFO )
   if( setint( &( HBINFO -> Nmeasure ) , "MEASURE" ) == GLU_FAILURE ) {
     return GLU_FAILURE ;
   }
+  // staging fields for asynchronous saves, optional
+  HBINFO -> Nstage = 0 ;
+  if( tag_search( "ASYNC_SAVE" ) != GLU_FAILURE ) {
+    if( setint( &( HBINFO -> Nstage ) , "ASYNC_SAVE" ) == GLU_FAILURE ) {
+      return GLU_FAILURE ;
+    }
+  }
   return GLU_SUCCESS ;
 }
 
@@ -477,6 +484,28 @@ read_gf_struct ( struct gf_info *GFINFO )
     printf( "Failure \n" ) ;
     return GLU_FAILURE ;
   }
+  // teams of threads fixing whole Coulomb slices, optional
+  GFINFO -> Nteams = 0 ;
+  if( tag_search( "COULOMB_TEAMS" ) != GLU_FAILURE ) {
+    if( setint( &( GFINFO -> Nteams ) , "COULOMB_TEAMS" ) == GLU_FAILURE ) {
+      return GLU_FAILURE ;
+    }
+  }
+  // keep the links in memory for Landau restarts, optional
+  GFINFO -> snapshot = GF_SNAPSHOT_NONE ;
+  {
+    const int snap_idx = tag_search( "GF_SNAPSHOT" ) ;
+    if( snap_idx != GLU_FAILURE ) {
+      if( are_equal( INPUT[snap_idx].VALUE , "FULL" ) ) {
+	GFINFO -> snapshot = GF_SNAPSHOT_FULL ;
+      } else if( are_equal( INPUT[snap_idx].VALUE , "SMALL" ) ) {
+	GFINFO -> snapshot = GF_SNAPSHOT_SMALL ;
+      } else if( !are_equal( INPUT[snap_idx].VALUE , "NONE" ) ) {
+	fprintf( stderr , "[IO] unknown GF_SNAPSHOT [%s] : Defaulting to "
+		 "rereading the file on restarts\n" , INPUT[snap_idx].VALUE ) ;
+      }
+    }
+  }
   return GLU_SUCCESS ;
 }
 
@@ -516,6 +545,38 @@ rtrans( void )
   return GLU_FALSE ;
 }
 
+// ordering of the gauge field slab, optional and defaults to site-major
+static void
+field_layout_type( void )
+{
+  Latt.layout = LAYOUT_SITE_MAJOR ;
+  const int layout_idx = tag_search( "FIELD_LAYOUT" ) ;
+  if( layout_idx == GLU_FAILURE ) return ;
+  if( are_equal( INPUT[layout_idx].VALUE , "LINK_MAJOR" ) ) {
+    Latt.layout = LAYOUT_LINK_MAJOR ;
+    fprintf( stdout , "[IO] Link-major [mu][site] gauge field layout\n" ) ;
+  } else if( are_equal( INPUT[layout_idx].VALUE , "CHECKERBOARD" ) ) {
+    Latt.layout = LAYOUT_CHECKERBOARD ;
+    fprintf( stdout , "[IO] Checkerboard [mu][colour][tile] gauge "
+	     "field layout\n" ) ;
+  }
+  return ;
+}
+
+// shared neighbour table or on-the-fly neighbours, optional
+static void
+navigation_type( void )
+{
+  Latt.nav_mode = NAVIG_TABLE ;
+  const int nav_idx = tag_search( "NAVIGATION" ) ;
+  if( nav_idx == GLU_FAILURE ) return ;
+  if( are_equal( INPUT[nav_idx].VALUE , "ON_THE_FLY" ) ) {
+    Latt.nav_mode = NAVIG_ONTHEFLY ;
+    fprintf( stdout , "[IO] Computing lattice neighbours on the fly\n" ) ;
+  }
+  return ;
+}
+
 // pack the sm_info struct
 static int
 smearing_info( struct sm_info *SMINFO )
@@ -544,6 +605,10 @@ smearing_info( struct sm_info *SMINFO )
       SMINFO -> type = SM_ADAPTWFLOW_LOG ;
     } else if( are_equal( INPUT[type_idx].VALUE , "ADAPTWFLOW_STOUT" ) ) {
       SMINFO -> type = SM_ADAPTWFLOW_STOUT ;
+    } else if( are_equal( INPUT[type_idx].VALUE , "EMBEDWFLOW_LOG" ) ) {
+      SMINFO -> type = SM_EMBEDWFLOW_LOG ;
+    } else if( are_equal( INPUT[type_idx].VALUE , "EMBEDWFLOW_STOUT" ) ) {
+      SMINFO -> type = SM_EMBEDWFLOW_STOUT ;
     } else {
       fprintf( stderr , "[IO] Unrecognised Type [%s] "
 	       "Defaulting to No Smearing \n" , INPUT[type_idx].VALUE ) ;
@@ -613,6 +678,12 @@ get_input_data( struct infile_data *INFILE ,
   // are we performing a random transform
   INFILE -> rtrans = rtrans( ) ;
 
+  // how the links are ordered in memory
+  field_layout_type( ) ;
+
+  // tabulated or computed neighbours
+  navigation_type( ) ;
+
   // get the header type
   if( header_type( &( INFILE -> head ) ) == GLU_FAILURE ) { 
     INPUT_FAILS++ ;
@@ -24,7 +24,6 @@
 
 #include "CERN.h"          // openQCD config reader/writer
 #include "BPST_config.h"   // generate a BPST config
-#include "GLU_memcheck.h"  // do we have enough memory for the fast reader?
 #include "HIREP.h"         // read a HIREP file
 #include "plaqs_links.h"   // average plaquette, link traces
 #include "random_config.h" // random SU(NC) configuration
@@ -150,12 +149,13 @@ get_config_SUNC( FILE *__restrict CONFIG ,
     if( HEAD_DATA.config_type == OUTPUT_SMALL ||
 	HEAD_DATA.config_type == OUTPUT_GAUGE ||
 	HEAD_DATA.config_type == OUTPUT_NCxNC ) {
-      const int SAFETY = have_memory_readers_writers( HEAD_DATA.config_type ) ;
-      if( SAFETY != FAST ) {
-	return lattice_reader_suNC_cheaper( lat , CONFIG , HEAD_DATA ) ;
-      } else {
-	return lattice_reader_suNC( lat , CONFIG , HEAD_DATA ) ;
-      }
+#ifdef HAVE_SYS_MMAN_H
+      // the mapping needs no buffer so is always safe
+      return lattice_reader_suNC_mmap( lat , CONFIG , HEAD_DATA ) ;
+#else
+      // only ever holds two slices
+      return lattice_reader_suNC_stream( lat , CONFIG , HEAD_DATA ) ;
+#endif
     } break ;
   case HIREP_HEADER : // HIREP uses a weird geometry compared to everyone else
     read_gauge_field( lat , CONFIG , &chksum ) ;
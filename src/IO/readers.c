@@ -27,6 +27,14 @@
 #include "GLU_bswap.h"     // bswap_*()
 #include "gramschmidt.h"   // reunit2()
 #include "random_config.h" // latt_reunitU()
+#include "readers.h"       // lattice_reader_suNC_stream()
+
+// defined in the autoconf procedure
+#ifdef HAVE_SYS_MMAN_H
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
 
 // read a full matrix, should we just read in all 
 // of the complex values?
@@ -153,11 +161,115 @@ rebuild_lat( GLU_complex *__restrict link ,
   return ;
 }
 
-//////////// MEMSPENSIVE VERSION ///////////////
+// checksum, byteswap and rebuild the links of site i from its raw
+// file data, the sums are accumulated into the caller's variables
+static void
+decode_site( struct site *lat , 
+	     const size_t i ,
+	     const char *raw ,
+	     const struct head_data HEAD_DATA ,
+	     const size_t LOOP_VAR ,
+	     uint32_t *k , 
+	     uint32_t *sum29 , 
+	     uint32_t *sum31 ,
+	     uint32_t *CRCsum29 , 
+	     uint32_t *CRCsum31 )
+{
+  const size_t site_bytes = ND * LOOP_VAR * 
+    ( HEAD_DATA.precision == DOUBLE_PREC ? sizeof( double ) : sizeof( float ) ) ;
+
+  // scidac checksum is on the RAW binary data, not the byteswapped
+  if( Latt.head == SCIDAC_HEADER || Latt.head == ILDG_SCIDAC_HEADER ) {
+    DML_checksum_accum( CRCsum29 , CRCsum31 , i , (char*)raw , site_bytes ) ;
+  }
+
+  // local copy of this site so that the input is left untouched
+  double p[ ND * LOOP_VAR ] ;
+  float q[ ND * LOOP_VAR ] ;
+  if( HEAD_DATA.precision == DOUBLE_PREC ) {
+    memcpy( p , raw , site_bytes ) ;
+    if( HEAD_DATA.endianess != WORDS_BIGENDIAN ) {
+      bswap_64_serial( ND * LOOP_VAR , p ) ;
+    }
+  } else {
+    memcpy( q , raw , site_bytes ) ;
+    if( HEAD_DATA.endianess != WORDS_BIGENDIAN ) {
+      bswap_32_serial( ND * LOOP_VAR , q ) ;
+    }
+  }
+
+  size_t rank29 = ( ND * LOOP_VAR * i ) % 29 ;
+  size_t rank31 = ( ND * LOOP_VAR * i ) % 31 ;
+  register uint32_t k_loc = 0 , sum29_loc = 0 , sum31_loc = 0 ;
+
+  // general variables ...
+  GLU_real utemp[ LOOP_VAR ] ;
+  uint32_t res = 0 ;
+  size_t mu , j , t = 0 ;
+  for( mu = 0 ; mu < ND ; mu++ ) {
+    for( j = 0 ; j < LOOP_VAR ; j++ ) {
+      if( HEAD_DATA.precision == DOUBLE_PREC ) {
+	// compute the checksum ...
+	uint32_t *buf = ( uint32_t* )( p + t ) ; 
+	res = *buf + *( buf + 1 ) ; 
+	// put value into temporary
+	*( utemp + j ) = ( GLU_real )*( p + t ) ;
+      } else {
+	// nersc checksum ...
+	res = *( uint32_t *)( q + t ) ;
+	// and put the value in the temporary
+	*( utemp + j ) = ( GLU_real )*( q + t ) ; 
+      }
+      // milc checksums ...
+      sum29_loc ^= (uint32_t)( res << rank29 | res >> ( 32 - rank29 ) ) ;
+      sum31_loc ^= (uint32_t)( res << rank31 | res >> ( 32 - rank31 ) ) ;
+
+      /// and perform the mods
+      rank29 = ( rank29 < 28 ) ? rank29 + 1 : 0 ;
+      rank31 = ( rank31 < 30 ) ? rank31 + 1 : 0 ;
+
+      // local sum
+      k_loc += res ; 
+
+      t++ ;
+    }
+    // smash all the read values into lat
+    rebuild_lat( lat[i].O[mu] , utemp , HEAD_DATA.config_type ) ;
+  }
+  // nersc
+  *k = *k + k_loc ;
+  // milc
+  *sum29 = *sum29 ^ sum29_loc ;
+  *sum31 = *sum31 ^ sum31_loc ;
+  return ;
+}
+
+// the checksum that this header type is compared against
+static uint32_t
+header_checksum( const uint32_t k , 
+		 const uint32_t sum29 , 
+		 const uint32_t CRCsum29 ,
+		 const uint32_t CRC_BQCD )
+{
+  // if we are reading a MILC file we output the sum29 checksum
+  switch( Latt.head ) {
+  case NERSC_HEADER : return k ;
+  case MILC_HEADER : return sum29 ;
+  case ILDG_SCIDAC_HEADER :
+  case SCIDAC_HEADER : return CRCsum29 ;
+  case ILDG_BQCD_HEADER : return CRC_BQCD ;
+  case LIME_HEADER : return GLU_SUCCESS ;
+  case JLQCD_HEADER : return GLU_SUCCESS ;
+  default : return GLU_FAILURE ; // should print an error here
+  }
+}
+
+#ifdef HAVE_SYS_MMAN_H
+//////////// MEMORY-MAPPED VERSION ///////////////
 uint32_t
-lattice_reader_suNC( struct site *lat , 
-		     FILE *__restrict in , 
-		     const struct head_data HEAD_DATA )
+lattice_reader_suNC_mmap( struct site *lat , 
+			  FILE *__restrict in , 
+			  const struct head_data HEAD_DATA )
 {
   // this is checked previously, nice to be certain though
   if( in == NULL ) {
@@ -173,184 +285,100 @@ lattice_reader_suNC( struct site *lat ,
     return GLU_FAILURE ;
   }
 
-  static double *uind , *p ; 
-  static float *uin , *q ; 
-  uint32_t CRCsum29 = 0 , CRCsum31 = 0 , CRC_BQCD = 0 ;
+  const size_t prec = ( HEAD_DATA.precision == DOUBLE_PREC ) ? 
+    sizeof( double ) : sizeof( float ) ;
+  const size_t site_bytes = ND * LOOP_VAR * prec ;
+  const size_t data_bytes = LATT_LOOP * prec ;
+
+  // the binary data starts wherever the header reading left us
+  struct stat st ;
+  const off_t start = ftello( in ) ;
+  if( start < 0 || fstat( fileno( in ) , &st ) != 0 ) {
+    fprintf( stdout , "[IO] Cannot map the configuration, "
+	     "using the streaming reader\n" ) ;
+    return lattice_reader_suNC_stream( lat , in , HEAD_DATA ) ;
+  }
+  if( st.st_size < start || (size_t)( st.st_size - start ) < data_bytes ) {
+    fprintf( stderr , "[IO] Configuration File reading failure "
+	     ".. Leaving \n" ) ;
+    return GLU_FAILURE ;
+  }
 
-  if( HEAD_DATA.precision == DOUBLE_PREC ) {
-    uind = ( double* )malloc( LATT_LOOP * sizeof( double ) ) ; 
-    if( fread( uind , sizeof( double ) , LATT_LOOP , in ) != LATT_LOOP ) {
-      fprintf( stderr , "[IO] Configuration File reading failure "
-	       ".. Leaving \n" ) ;
-      free( uind ) ;
-      return GLU_FAILURE ;
-    }
-    // scidac checksum is on the RAW binary data, not the byteswapped
-    if( Latt.head == SCIDAC_HEADER ||
-	Latt.head == ILDG_SCIDAC_HEADER ) {
-      size_t i ;
-      #pragma omp parallel for private(i) reduction(^:CRCsum29) reduction(^:CRCsum31)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	const uint32_t rank29 = i % 29 ;
-	const uint32_t rank31 = i % 31 ;
-	const uint32_t work =
-	  (uint32_t)crc32(0, (unsigned char*)( uind + i*ND*LOOP_VAR ) ,
-			  sizeof(double) * ND * LOOP_VAR );
-	CRCsum29 = CRCsum29 ^ ( work<<rank29 | work>>(32-rank29));
-	CRCsum31 = CRCsum31 ^ ( work<<rank31 | work>>(32-rank31) );
-	// TDOD -> an unthreaded bswap here ?
-      }
-    }
-    // BQCD checksum is just the crc of the whole thing and is not thread safe
-    // for the moment possibly for ever
+  // mmap offsets have to be page aligned
+  const off_t page = (off_t)sysconf( _SC_PAGESIZE ) ;
+  const off_t map_start = start - ( start % page ) ;
+  const size_t map_bytes = (size_t)( start - map_start ) + data_bytes ;
+  void *map = mmap( NULL , map_bytes , PROT_READ , MAP_PRIVATE , 
+		    fileno( in ) , map_start ) ;
+  if( map == MAP_FAILED ) {
+    fprintf( stdout , "[IO] Cannot map the configuration, "
+	     "using the streaming reader\n" ) ;
+    return lattice_reader_suNC_stream( lat , in , HEAD_DATA ) ;
+  }
+  // ask the kernel to start reading everything in now
+  madvise( map , map_bytes , MADV_WILLNEED ) ;
+  const char *data = (const char*)map + ( start - map_start ) ;
+
+  // checksum, byteswap and poke into gauge links in one pass, a
+  // timeslice at a time so that finished pages can be given back
+  uint32_t k = 0 , sum29 = 0 , sum31 = 0 ;
+  uint32_t CRCsum29 = 0 , CRCsum31 = 0 ;
+  size_t slice , released = 0 ;
+  for( slice = 0 ; slice < Latt.dims[ ND - 1 ] ; slice++ ) {
+    const size_t lo = slice * LCU , hi = lo + LCU ;
+    size_t i ;
+    // BQCD checksum is the crc of the whole thing and is serial
     if( Latt.head == ILDG_BQCD_HEADER ) {
-      size_t i ;
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	// BQCD's
-	CKSUM_ADD( ( uin + ( i * ND * LOOP_VAR ) ) , 
-		   sizeof(float) * ND * LOOP_VAR ) ;
-      }
-      uint32_t nbytes ;
-      CKSUM_GET( &CRC_BQCD , &nbytes ) ;
-    }
-    // and then we do the byte swap
-    if( HEAD_DATA.endianess != WORDS_BIGENDIAN ) {
-      bswap_64( LATT_LOOP , uind ) ;  
-    }
-    p = uind ; 
-  } else {
-    uin = ( float* )malloc( LATT_LOOP * sizeof( float ) ) ; 
-    if( fread( uin , sizeof( float ) , LATT_LOOP  , in ) != LATT_LOOP ) {
-      fprintf( stderr , "[IO] Configuration File reading failure "
-	       ".. Leaving \n" ) ;
-      free( uin ) ;
-      return GLU_FAILURE ;
-    }
-    // ILDG checksum is on the raw data
-    if( Latt.head == SCIDAC_HEADER ||
-	Latt.head == ILDG_SCIDAC_HEADER ) {
-      size_t i ;
-      #pragma omp parallel for private(i) reduction(^:CRCsum29) reduction(^:CRCsum31)
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	const uint32_t rank29 = i % 29 ;
-	const uint32_t rank31 = i % 31 ;
-	const uint32_t work =
-	  (uint32_t)crc32(0, (unsigned char*)( uin + i*ND*LOOP_VAR ) ,
-			  sizeof(float) * ND * LOOP_VAR );
-	CRCsum29 = CRCsum29 ^ ( work<<rank29 | work>>(32-rank29));
-	CRCsum31 = CRCsum31 ^ ( work<<rank31 | work>>(32-rank31) );
-	// TDOD -> an unthreaded bswap here ?
+      for( i = lo ; i < hi ; i++ ) {
+	CKSUM_ADD( (void*)( data + i * site_bytes ) , site_bytes ) ;
       }
     }
-    // BQCD checksum is just the crc of the whole thing and is kinda expensive
-    if( Latt.head == ILDG_BQCD_HEADER ) {
-      size_t i ;
-      for( i = 0 ; i < LVOLUME ; i++ ) {
-	// BQCD's
-	CKSUM_ADD( ( uin + ( i * ND * LOOP_VAR ) ) , 
-		   sizeof(float) * ND * LOOP_VAR ) ;
-      }
-      uint32_t nbytes ;
-      CKSUM_GET( &CRC_BQCD , &nbytes ) ;
+    #pragma omp parallel for private(i) reduction(+:k) reduction(^:sum29) reduction(^:sum31) reduction(^:CRCsum29) reduction(^:CRCsum31)
+    for( i = lo ; i < hi ; i++ ) {
+      decode_site( lat , i , data + i * site_bytes , HEAD_DATA , LOOP_VAR ,
+		   &k , &sum29 , &sum31 , &CRCsum29 , &CRCsum31 ) ;
     }
-    // and byteswap if necessary
-    if( HEAD_DATA.endianess != WORDS_BIGENDIAN ) {
-      bswap_32( LATT_LOOP , uin ) ;
+    // drop the pages we have finished with from our resident set
+    const size_t done = (size_t)( start - map_start ) + hi * site_bytes ;
+    const size_t upto = done - ( done % (size_t)page ) ;
+    if( upto > released ) {
+      madvise( (char*)map + released , upto - released , MADV_DONTNEED ) ;
+      released = upto ;
     }
-    q = uin ;
   }
 
-  // compute the crcs and poke into gauge links
-  uint32_t k = 0 , sum29 = 0 , sum31 = 0 ;
-  size_t i ;
-  #pragma omp parallel for private(i) reduction(+:k) reduction(^:sum29) reduction(^:sum31)
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    // t is the AntiHermitian_projised idx
-    size_t t = ND * LOOP_VAR * i ;
-    size_t rank29 = t % 29 ;
-    size_t rank31 = t % 31 ;
-    register uint32_t k_loc = 0 ;
-    register uint32_t sum29_loc = 0 , sum31_loc = 0 ;
-
-    // general variables ...
-    GLU_real utemp[ LOOP_VAR ] ;
-    uint32_t res = 0 ;
-    size_t mu , j , count = 0 ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      for( j = 0 ; j < LOOP_VAR ; j++ ) {
-	// should I shuffle this around ?
-	if( HEAD_DATA.precision == DOUBLE_PREC ) {
-	  // compute the checksum ...
-	  uint32_t *buf = ( uint32_t* )( p + t ) ; 
-	  res = *buf + *( buf + 1 ) ; 
-	  // put value into temporary
-	  *( utemp + j ) = ( GLU_real )*( p + t ) ;
-	} else {
-	  // nersc checksum ...
-	  res = *( uint32_t *)( q + t ) ;
-	  // and put the value in the temporary
-	  *( utemp + j ) = ( GLU_real )*( q + t ) ; 
-	}
-	count++ ;
-
-	// milc checksums ...
-	sum29_loc ^= (uint32_t)( res << rank29 | res >> ( 32 - rank29 ) ) ;
-	sum31_loc ^= (uint32_t)( res << rank31 | res >> ( 32 - rank31 ) ) ;
-
-	/// and perform the mods
-	rank29 = ( rank29 < 28 ) ? rank29 + 1 : 0 ;
-	rank31 = ( rank31 < 30 ) ? rank31 + 1 : 0 ;
+  uint32_t CRC_BQCD = 0 ;
+  if( Latt.head == ILDG_BQCD_HEADER ) {
+    uint32_t nbytes ;
+    CKSUM_GET( &CRC_BQCD , &nbytes ) ;
+  }
 
-	// local sum
-	k_loc += res ; 
+  munmap( map , map_bytes ) ;
 
-	t++ ;
-      }
-      // smash all the read values into lat
-      rebuild_lat( lat[i].O[mu] , utemp , HEAD_DATA.config_type ) ;
-    }
-    // reductions go here ...
-    // nersc
-    k = k + (uint32_t)k_loc ;
+  // leave the file where fread would have
+  fseeko( in , start + (off_t)data_bytes , SEEK_SET ) ;
 
-    // milc
-    sum29 = sum29 ^ (uint32_t)sum29_loc ;
-    sum31 = sum31 ^ (uint32_t)sum31_loc ;
-  }
-
-  if( HEAD_DATA.precision == DOUBLE_PREC ) {
-    free( uind ) ; 
-  } else {
-    // reunitarise up to working precision
+  // reunitarise up to working precision
+  if( HEAD_DATA.precision != DOUBLE_PREC ) {
     #ifndef SINGLE_PREC
     latt_reunitU( lat ) ;
     #endif
-    free( uin ) ;
   }
 
-  // if we are reading a MILC file we output the sum29 checksum
-  switch( Latt.head ) {
-  case NERSC_HEADER : return k ;
-  case MILC_HEADER : return sum29 ;
-  case ILDG_SCIDAC_HEADER :
-  case SCIDAC_HEADER : return CRCsum29 ;
-  case ILDG_BQCD_HEADER : return CRC_BQCD ;
-  case LIME_HEADER : return GLU_SUCCESS ;
-  case JLQCD_HEADER : return GLU_SUCCESS ;
-  default : return GLU_FAILURE ; // should print an error here
-  }
+  return header_checksum( k , sum29 , CRCsum29 , CRC_BQCD ) ;
 }
+#endif
 
-// MEMCHEAP READER
+//////////// PIPELINED SLICE-STREAMING VERSION ///////////////
 uint32_t
-lattice_reader_suNC_cheaper( struct site *lat , 
-			     FILE *__restrict in , 
-			     const struct head_data HEAD_DATA )
+lattice_reader_suNC_stream( struct site *lat , 
+			    FILE *__restrict in , 
+			    const struct head_data HEAD_DATA )
 {
   // this is checked previously, nice to be certain though
   if( in == NULL ) {
     fprintf( stderr , "[IO] Error opening config file!!..."
-	     "Returning with error \n" ) ; 
+	     "Returning with error\n" ) ; 
     return GLU_FAILURE ; 
   }
 
@@ -361,127 +389,83 @@ lattice_reader_suNC_cheaper( struct site *lat ,
     return GLU_FAILURE ;
   }
 
-  static double *uind , *p ; 
-  static float *uin , *q ; 
+  const size_t site_bytes = ND * LOOP_VAR * 
+    ( HEAD_DATA.precision == DOUBLE_PREC ? sizeof( double ) : sizeof( float ) ) ;
+  const size_t slice_bytes = LCU * site_bytes ;
 
-  if( HEAD_DATA.precision == DOUBLE_PREC ) {
-    uind = ( double* )malloc( ND*LOOP_VAR * sizeof( double ) ) ; 
-  } else {
-    uin = ( float* )malloc( ND*LOOP_VAR * sizeof( float ) ) ; 
+  // double buffer, one slice being read while the other is decoded
+  char *buf[ 2 ] ;
+  if( GLU_malloc( (void**)&buf[0] , ALIGNMENT , 2 * slice_bytes ) != 0 ) {
+    fprintf( stderr , "[IO] Slice buffer allocation failure\n" ) ;
+    return GLU_FAILURE ;
+  }
+  buf[1] = buf[0] + slice_bytes ;
+
+  // prime the pipeline
+  if( fread( buf[0] , 1 , slice_bytes , in ) != slice_bytes ) {
+    fprintf( stderr , "[IO] Configuration File reading failure "
+	     ".. Leaving \n" ) ;
+    free( buf[0] ) ;
+    return GLU_FAILURE ;
   }
 
-  uint32_t k = 0 , sum29 = 0 , sum31 = 0 ; // NERSC & MILC checksums ...
+  uint32_t k = 0 , sum29 = 0 , sum31 = 0 ;
   uint32_t CRCsum29 = 0 , CRCsum31 = 0 ;
-  size_t i ;
-  // do this in serial reads in site by site
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-
-    // read in a site, could we not use fseek to allow this to be done in parallel?
-    if( HEAD_DATA.precision == DOUBLE_PREC ) {
-      if( fread( uind , sizeof( double ) , ND*LOOP_VAR , in ) != ND*LOOP_VAR ) {
-	printf("[IO] Configuration File reading failure .. Leaving \n" ) ;
-	free( uind ) ;
-	return GLU_FAILURE ;
-      }
-      DML_checksum_accum( &CRCsum29 , &CRCsum31 , 
-			  i , (char*)( uind ) ,
-			  sizeof(double) * ND * LOOP_VAR ) ;
-      // BQCD's
-      CKSUM_ADD( uind , sizeof(double) * ND * LOOP_VAR ) ;
-      if( HEAD_DATA.endianess != WORDS_BIGENDIAN ) {
-	bswap_64( ND*LOOP_VAR , uind ) ;  
-      }
-      p = uind ;
-    } else { 
-      if( fread( uin , sizeof( float ) , ND*LOOP_VAR , in ) != ND*LOOP_VAR ) {
-	printf("[IO] Configuration File reading failure .. Leaving \n" ) ;
-	free( uin ) ;
-	return GLU_FAILURE ;
-      }
-      DML_checksum_accum( &CRCsum29 , &CRCsum31 , 
-			  i , (char*)( uin ) ,
-			  sizeof(float) * ND * LOOP_VAR ) ;
-      // BQCD's
-      CKSUM_ADD( uin , sizeof(float) * ND * LOOP_VAR ) ;
-      if( HEAD_DATA.endianess != WORDS_BIGENDIAN ) {
-	bswap_32( ND*LOOP_VAR , uin ) ;
+  GLU_bool read_fail = GLU_FALSE ;
+  #pragma omp parallel reduction(+:k) reduction(^:sum29) reduction(^:sum31) reduction(^:CRCsum29) reduction(^:CRCsum31)
+  {
+    size_t t ;
+    for( t = 0 ; t < Latt.dims[ ND - 1 ] ; t++ ) {
+      const char *curr = buf[ t & 1 ] ;
+      // one thread pulls the next slice off the disk (and does the
+      // serial BQCD crc) while the others decode this one
+      #pragma omp single nowait
+      {
+	if( Latt.head == ILDG_BQCD_HEADER ) {
+	  size_t i ;
+	  for( i = 0 ; i < LCU ; i++ ) {
+	    CKSUM_ADD( (void*)( curr + i * site_bytes ) , site_bytes ) ;
+	  }
+	}
+	if( t + 1 < Latt.dims[ ND - 1 ] &&
+	    fread( buf[ ( t + 1 ) & 1 ] , 1 , slice_bytes , in ) 
+	    != slice_bytes ) {
+	  read_fail = GLU_TRUE ;
+	}
       }
-      q = uin ;
-    }
-    size_t t = 0 ;
-
-    register uint32_t k_loc = 0 , sum29_loc = 0 , sum31_loc = 0 ;
-    size_t rank29 = ( ND * LOOP_VAR * i ) % 29 ;
-    size_t rank31 = ( ND * LOOP_VAR * i ) % 31 ;
-
-    // general variables ...
-    GLU_real utemp[ LOOP_VAR ] ;
-    uint32_t res = 0 ;
-    size_t mu , j ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      for( j = 0 ; j < LOOP_VAR ; j++ ) {
-	// should I shuffle this around ?
-	if( HEAD_DATA.precision == DOUBLE_PREC ) {
-	  // compute the checksum ...
-	  uint32_t *buf = ( uint32_t* )( p + t ) ; 
-	  res = *buf + *( buf + 1 ) ; 
-	  // put value into temporary
-	  *( utemp + j ) = ( GLU_real )*( p + t ) ;
-	} else {
-	  // nersc checksum ...
-	  res = *( uint32_t *)( q + t ) ;
-	  // and put the value in the temporary
-	  *( utemp + j ) = ( GLU_real )*( q + t ) ; 
-	} 
-	// local computations
-	sum29_loc ^= (uint32_t)( res << rank29 | res >> ( 32 - rank29 ) ) ;
-	sum31_loc ^= (uint32_t)( res << rank31 | res >> ( 32 - rank31 ) ) ;
-
-	/// and perform the mods
-	rank29 = ( rank29 < 28 ) ? rank29 + 1 : 0 ;
-	rank31 = ( rank31 < 30 ) ? rank31 + 1 : 0 ;
-
-	// local sum
-	k_loc += res ; 
-
-	t++ ;
+      size_t i ;
+      #pragma omp for schedule(dynamic,64) nowait
+      for( i = 0 ; i < LCU ; i++ ) {
+	decode_site( lat , LCU * t + i , curr + i * site_bytes , 
+		     HEAD_DATA , LOOP_VAR ,
+		     &k , &sum29 , &sum31 , &CRCsum29 , &CRCsum31 ) ;
       }
-      // smash all the read values into lat
-      rebuild_lat( lat[i].O[mu] , utemp , HEAD_DATA.config_type ) ;
+      #pragma omp barrier
+      if( read_fail == GLU_TRUE ) break ;
     }
-    // nersc
-    k = k + (uint32_t)k_loc ;
+  }
+  free( buf[0] ) ;
 
-    // milc
-    sum29 = sum29 ^ (uint32_t)sum29_loc ;
-    sum31 = sum31 ^ (uint32_t)sum31_loc ;
+  if( read_fail == GLU_TRUE ) {
+    fprintf( stderr , "[IO] Configuration File reading failure "
+	     ".. Leaving \n" ) ;
+    return GLU_FAILURE ;
   }
 
-  // BQCD checksum is just the crc of the whol thing
-  uint32_t CRC_BQCD , nbytes ;
-  CKSUM_GET( &CRC_BQCD , &nbytes ) ;
+  uint32_t CRC_BQCD = 0 ;
+  if( Latt.head == ILDG_BQCD_HEADER ) {
+    uint32_t nbytes ;
+    CKSUM_GET( &CRC_BQCD , &nbytes ) ;
+  }
 
-  if( HEAD_DATA.precision == DOUBLE_PREC ) {
-    free( uind ) ; 
-  } else {
-    // reunitarise up to working precision
+  // reunitarise up to working precision
+  if( HEAD_DATA.precision != DOUBLE_PREC ) {
     #ifndef SINGLE_PREC
     latt_reunitU( lat ) ;
     #endif
-    free( uin ) ;
   }
 
-  // if we are reading a MILC file we output the sum29 checksum
-  switch( Latt.head ) {
-  case NERSC_HEADER : return k ;
-  case MILC_HEADER : return sum29 ;
-  case ILDG_SCIDAC_HEADER :
-  case SCIDAC_HEADER : return CRCsum29 ;
-  case ILDG_BQCD_HEADER : return CRC_BQCD ;
-  case LIME_HEADER : return GLU_SUCCESS ;
-  case JLQCD_HEADER : return GLU_SUCCESS ;
-  default : return GLU_FAILURE ; // should print an error here
-  }
+  return header_checksum( k , sum29 , CRCsum29 , CRC_BQCD ) ;
 }
 
 // clean this up for scope
@@ -25,7 +25,6 @@
 #include "CERN.h"          // CERN gauge field format
 #include "crc.h"           // MILC, SCIDAC and ILDG formats use a crc
 #include "GLU_bswap.h"     // byteswapping
-#include "GLU_memcheck.h"  // can we use the faster/mem expensive code?
 #include "GLU_timer.h"     // timers for the IO
 #include "HIREP.h"         // write out a HIREP config
 #include "plaqs_links.h"   // compute plaquette and links again
@@ -133,7 +132,7 @@ grab_sitedata( GLU_real *__restrict chunk ,
   return ;
 }
 
-// byteswap for output
+// byteswap a site for output, always called from inside a parallel region
 static void
 swap_for_output( GLU_real *uout , 
 		 const size_t SIZE )
@@ -142,17 +141,17 @@ swap_for_output( GLU_real *uout ,
 #ifdef OUT_BIG
   if( !WORDS_BIGENDIAN ) { 
     #ifdef SINGLE_PREC
-    bswap_32( SIZE , uout ) ; 
+    bswap_32_serial( SIZE , uout ) ; 
     #else
-    bswap_64( SIZE , uout ) ; 
+    bswap_64_serial( SIZE , uout ) ; 
     #endif
   }
 #else // write a in little endian format
   if( WORDS_BIGENDIAN ) {
     #ifdef SINGLE_PREC
-    bswap_32( SIZE , uout ) ; 
+    bswap_32_serial( SIZE , uout ) ; 
     #else
-    bswap_64( SIZE , uout ) ; 
+    bswap_64_serial( SIZE , uout ) ; 
     #endif
   }
 #endif
@@ -230,92 +229,52 @@ compute_checksum( uint32_t *nersc_cksum ,
   return ;
 }
 
-// can write in big or little endian, overwrites uout!
+// writes the fields as binary data, pipelined slice by slice. One thread
+// writes the previous slice while the others pack and swap the next
 static void
-byteswap_and_write( FILE *__restrict outfile ,
-		    GLU_real *__restrict uout ,
-		    const size_t SIZE )
-{
-  swap_for_output( uout , SIZE ) ; // do the byteswaps if necessary
-  fwrite( uout , sizeof( GLU_real ) , SIZE , outfile ) ; 
-  return ;
-}
-
-// data copying
-static void
-copy_data( GLU_real *uout , 
-	   const struct site *lat ,
-	   const size_t START ,
-	   const size_t END ,
-	   const size_t LOOP_VAR ,
-	   const GLU_output checktype )
-{
-  size_t i ;
-#pragma omp parallel for private(i)
-  for( i = START ; i < END ; i++ ) { 
-    // temporary
-    GLU_real site[ ND * LOOP_VAR ] ;
-
-    // puts the matrix in glu_real temporary called site
-    grab_sitedata( site , lat[i] , LOOP_VAR , checktype ) ;
-
-    // set this up here
-    const size_t val = (size_t)( LOOP_VAR * ( i * ND ) ) ;
-    for( size_t j = 0 ; j < ND*LOOP_VAR ; j++ ) {
-#ifdef OUT_DOUBLE
-      uout[ val + j ] = (double)site[ j ] ;
-#else
-      uout[ val + j ] = (float)site[ j ] ;
-#endif
-
-    }
-  }
-  return ;
-}
-
-// writes the fields as binary data
-static void
-write_binary_data( const struct site *lat ,
+write_binary_data( const struct site *__restrict lat ,
 		   FILE *__restrict outfile ,
 		   const GLU_output checktype ,
-		   const size_t LATT_LOOP ,
 		   const size_t LOOP_VAR )
 { 
-  // write out in working precision
-  GLU_real *uout = ( GLU_real* ) malloc( LATT_LOOP  * sizeof( GLU_real ) ) ; 
-
-  // copy lattice data into uout 
-  copy_data( uout , lat , 0 , LVOLUME , LOOP_VAR , checktype ) ;
-
-  // and write it out
-  byteswap_and_write( outfile , uout , LATT_LOOP ) ;
-
-  free( uout ) ;
-  return ;
-}
-
-// writes the fields as binary data -> SLICE by SLICE version
-static void
-write_binary_data_cheap( const struct site *__restrict lat ,
-			 FILE *__restrict outfile ,
-			 const GLU_output checktype ,
-			 const size_t LOOP_VAR )
-{ 
-  // write out in working precision
-  GLU_real *uout = ( GLU_real* ) malloc( LCU * LOOP_VAR * 
-					 ND * sizeof( GLU_real ) ) ; 
-
-  size_t t ;
-  for( t = 0 ; t < Latt.dims[ ND - 1 ] ; t++ ) {
-    
-    // copy lattice data into uout 
-    copy_data( uout , lat , LCU*t , LCU*(t+1) , LOOP_VAR , checktype ) ;
-    
-    // and write it out
-    byteswap_and_write( outfile , uout , LCU * LOOP_VAR * ND ) ;
+  const size_t site_len = ND * LOOP_VAR ;
+  const size_t slice_len = LCU * site_len ;
+
+  // double buffer in working precision
+  GLU_real *uout[ 2 ] ;
+  if( GLU_malloc( (void**)&uout[0] , ALIGNMENT , 
+		  2 * slice_len * sizeof( GLU_real ) ) != 0 ) {
+    fprintf( stderr , "[IO] Slice buffer allocation failure\n" ) ;
+    return ;
+  }
+  uout[1] = uout[0] + slice_len ;
+
+  #pragma omp parallel
+  {
+    size_t t ;
+    for( t = 0 ; t <= Latt.dims[ ND - 1 ] ; t++ ) {
+      #pragma omp single nowait
+      {
+	if( t > 0 ) {
+	  fwrite( uout[ ( t - 1 ) & 1 ] , sizeof( GLU_real ) , 
+		  slice_len , outfile ) ;
+	}
+      }
+      if( t < Latt.dims[ ND - 1 ] ) {
+	GLU_real *curr = uout[ t & 1 ] ;
+	size_t i ;
+        #pragma omp for schedule(dynamic,64) nowait
+	for( i = 0 ; i < LCU ; i++ ) {
+	  grab_sitedata( curr + i * site_len , lat[ LCU * t + i ] , 
+			 LOOP_VAR , checktype ) ;
+	  swap_for_output( curr + i * site_len , site_len ) ;
+	}
+      }
+      #pragma omp barrier
+    }
   }
 
-  free( uout ) ;
+  free( uout[0] ) ;
   return ;
 }
 
@@ -381,14 +340,7 @@ write_lat( struct site *lat ,
   }
 
   // binary output is all the same for these types ...
-  const int SAFETY = have_memory_readers_writers( checktype ) ;
-  if( SAFETY != FAST ) {
-    fprintf( stdout , "[IO] Using the slower/memory cheaper code \n" ) ;
-    write_binary_data_cheap( lat , out , checktype , LOOP_VAR ) ;
-  } else {
-    fprintf( stdout , "[IO] Using the faster/memory expensive code \n" ) ;
-    write_binary_data( lat , out , checktype , LATT_LOOP , LOOP_VAR ) ;
-  }
+  write_binary_data( lat , out , checktype , LOOP_VAR ) ;
 
   // need to write out the scidac checksums here
   switch( type ) {
@@ -26,6 +26,11 @@
 
 #ifndef multab_suNC
 
+// under run-time dispatch this is the generic entry of the kernel table
+#ifdef GLU_DISPATCH
+  #define multab_suNC multab_suNC_generic
+#endif
+
 #include <immintrin.h>
 #include "SSE2_OPS.h"
 
@@ -29,6 +29,11 @@
 
 #ifndef multab_dag_suNC
 
+// under run-time dispatch this is the generic entry of the kernel table
+#ifdef GLU_DISPATCH
+  #define multab_dag_suNC multab_dag_suNC_generic
+#endif
+
 void //__attribute__((hot))
 multab_dag_suNC( GLU_complex a[ NCNC ] , 
 		 const GLU_complex b[ NCNC ] , 
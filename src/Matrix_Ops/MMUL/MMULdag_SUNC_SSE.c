@@ -29,6 +29,11 @@
 
 #ifndef multabdag_suNC
 
+// under run-time dispatch this is the generic entry of the kernel table
+#ifdef GLU_DISPATCH
+  #define multabdag_suNC multabdag_suNC_generic
+#endif
+
 void
 multabdag_suNC( GLU_complex a[ NCNC ] , 
 		const GLU_complex b[ NCNC ] , 
@@ -0,0 +1,443 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (SU3_AVX2.c) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file SU3_AVX2.c
+   @brief AVX2/FMA versions of the dispatched SU(3) kernels
+
+   A row of an SU(3) matrix is a __m256d holding its first two elements
+   and a __m128d holding the third. Products are accumulated a row at a
+   time as b_ik c_k = Re(b_ik) c_k + Im(b_ik) (-Im c_k, Re c_k) with
+   broadcasts of b, so there are no horizontal operations in the
+   multiplies. Only compiled in with run-time dispatch
+ */
+#include "Mainfile.h"
+
+#ifdef GLU_DISPATCH
+
+#include <immintrin.h>
+
+#include "cpu_dispatch.h"
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+// after the pragma so that we get the FMA versions of the macros
+#include "SSE2_OPS.h"
+
+// a row of three complex numbers
+typedef struct {
+  __m256d lo ;
+  __m128d hi ;
+} row3 ;
+
+// (re,im) -> (-im,re) i.e. multiplication by I
+static inline __m256d
+imul256( const __m256d a )
+{
+  return _mm256_xor_pd( _mm256_permute_pd( a , 5 ) ,
+			_mm256_setr_pd( -0.0 , 0.0 , -0.0 , 0.0 ) ) ;
+}
+static inline __m128d
+imul128( const __m128d a )
+{
+  return _mm_xor_pd( _mm_permute_pd( a , 1 ) , _mm_setr_pd( -0.0 , 0.0 ) ) ;
+}
+
+// complex conjugate
+static inline __m256d
+conj256( const __m256d a )
+{
+  return _mm256_xor_pd( a , _mm256_setr_pd( 0.0 , -0.0 , 0.0 , -0.0 ) ) ;
+}
+
+// load the row k of a matrix and that row times I
+static inline void
+load_row( row3 *r ,
+	  row3 *ir ,
+	  const GLU_complex *a )
+{
+  r -> lo = _mm256_loadu_pd( (const double*)a ) ;
+  r -> hi = _mm_loadu_pd( (const double*)( a + 2 ) ) ;
+  ir -> lo = imul256( r -> lo ) ;
+  ir -> hi = imul128( r -> hi ) ;
+}
+
+// column k of a, conjugated if "dag", and that times I
+static inline void
+load_col( row3 *r ,
+	  row3 *ir ,
+	  const GLU_complex *a ,
+	  const GLU_bool dag )
+{
+  r -> lo = _mm256_loadu2_m128d( (const double*)( a + 3 ) ,
+				 (const double*)( a ) ) ;
+  r -> hi = _mm_loadu_pd( (const double*)( a + 6 ) ) ;
+  if( dag == GLU_TRUE ) {
+    r -> lo = conj256( r -> lo ) ;
+    r -> hi = SSE2_CONJ( r -> hi ) ;
+  }
+  ir -> lo = imul256( r -> lo ) ;
+  ir -> hi = imul128( r -> hi ) ;
+}
+
+// sum_k b[k*stride] x[k], conjugating b if "dag"
+static inline row3
+row_times( const GLU_complex *b ,
+	   const size_t stride ,
+	   const row3 x[ 3 ] ,
+	   const row3 ix[ 3 ] ,
+	   const GLU_bool dag )
+{
+  const double *pb = (const double*)b ;
+  row3 r ;
+  __m256d re = _mm256_broadcast_sd( pb ) ;
+  __m256d im = _mm256_broadcast_sd( pb + 1 ) ;
+  if( dag == GLU_TRUE ) im = -im ;
+  r.lo = _mm256_fmadd_pd( im , ix[0].lo , _mm256_mul_pd( re , x[0].lo ) ) ;
+  r.hi = _mm_fmadd_pd( _mm256_castpd256_pd128( im ) , ix[0].hi ,
+		       _mm_mul_pd( _mm256_castpd256_pd128( re ) , x[0].hi ) ) ;
+  size_t k ;
+  for( k = 1 ; k < 3 ; k++ ) {
+    pb += 2 * stride ;
+    re = _mm256_broadcast_sd( pb ) ;
+    im = _mm256_broadcast_sd( pb + 1 ) ;
+    if( dag == GLU_TRUE ) im = -im ;
+    r.lo = _mm256_fmadd_pd( re , x[k].lo , r.lo ) ;
+    r.lo = _mm256_fmadd_pd( im , ix[k].lo , r.lo ) ;
+    r.hi = _mm_fmadd_pd( _mm256_castpd256_pd128( re ) , x[k].hi , r.hi ) ;
+    r.hi = _mm_fmadd_pd( _mm256_castpd256_pd128( im ) , ix[k].hi , r.hi ) ;
+  }
+  return r ;
+}
+
+// bottom row of an SU(3) matrix is the conjugate cross product of the top two
+static inline row3
+complete_row( const row3 r0 ,
+	      const row3 r1 )
+{
+  const __m128d a0 = _mm256_castpd256_pd128( r0.lo ) ;
+  const __m128d a1 = _mm256_extractf128_pd( r0.lo , 1 ) ;
+  const __m128d a3 = _mm256_castpd256_pd128( r1.lo ) ;
+  const __m128d a4 = _mm256_extractf128_pd( r1.lo , 1 ) ;
+  const __m128d a2 = r0.hi , a5 = r1.hi ;
+  // ( a1 , a2 ) * ( a5 , a3 ) - ( a2 , a0 ) * ( a4 , a5 )
+  const __m256d x = _mm256_set_m128d( a2 , a1 ) ;
+  const __m256d y = _mm256_set_m128d( a3 , a5 ) ;
+  const __m256d z = _mm256_set_m128d( a0 , a2 ) ;
+  const __m256d w = _mm256_set_m128d( a5 , a4 ) ;
+  const __m256d xy = _mm256_fmaddsub_pd( _mm256_movedup_pd( x ) , y ,
+					 _mm256_mul_pd( _mm256_permute_pd( x , 15 ) ,
+							_mm256_permute_pd( y , 5 ) ) ) ;
+  const __m256d zw = _mm256_fmaddsub_pd( _mm256_movedup_pd( z ) , w ,
+					 _mm256_mul_pd( _mm256_permute_pd( z , 15 ) ,
+							_mm256_permute_pd( w , 5 ) ) ) ;
+  row3 r ;
+  r.lo = conj256( _mm256_sub_pd( xy , zw ) ) ;
+  r.hi = SSE2_CONJ( _mm_sub_pd( SSE2_MUL( a0 , a4 ) , SSE2_MUL( a1 , a3 ) ) ) ;
+  return r ;
+}
+
+static inline void
+store_row( GLU_complex *a ,
+	   const row3 r )
+{
+  _mm256_storeu_pd( (double*)a , r.lo ) ;
+  _mm_storeu_pd( (double*)( a + 2 ) , r.hi ) ;
+}
+
+// horizontal sum of the three complex numbers in a row
+static inline __m128d
+hsum_row( const row3 r )
+{
+  return _mm_add_pd( _mm_add_pd( _mm256_castpd256_pd128( r.lo ) ,
+				 _mm256_extractf128_pd( r.lo , 1 ) ) , r.hi ) ;
+}
+
+// a = b.c
+void
+multab_suNC_AVX2( GLU_complex a[ NCNC ] ,
+		  const GLU_complex b[ NCNC ] ,
+		  const GLU_complex c[ NCNC ] )
+{
+  row3 C[ 3 ] , iC[ 3 ] ;
+  load_row( &C[0] , &iC[0] , c ) ;
+  load_row( &C[1] , &iC[1] , c + 3 ) ;
+  load_row( &C[2] , &iC[2] , c + 6 ) ;
+  const row3 r0 = row_times( b , 1 , C , iC , GLU_FALSE ) ;
+  const row3 r1 = row_times( b + 3 , 1 , C , iC , GLU_FALSE ) ;
+  store_row( a , r0 ) ;
+  store_row( a + 3 , r1 ) ;
+  store_row( a + 6 , complete_row( r0 , r1 ) ) ;
+  return ;
+}
+
+// a = b.c^{\dagger}, the rows of c^{\dagger} are its conjugated columns
+void
+multab_dag_suNC_AVX2( GLU_complex a[ NCNC ] ,
+		      const GLU_complex b[ NCNC ] ,
+		      const GLU_complex c[ NCNC ] )
+{
+  row3 C[ 3 ] , iC[ 3 ] ;
+  load_col( &C[0] , &iC[0] , c , GLU_TRUE ) ;
+  load_col( &C[1] , &iC[1] , c + 1 , GLU_TRUE ) ;
+  load_col( &C[2] , &iC[2] , c + 2 , GLU_TRUE ) ;
+  const row3 r0 = row_times( b , 1 , C , iC , GLU_FALSE ) ;
+  const row3 r1 = row_times( b + 3 , 1 , C , iC , GLU_FALSE ) ;
+  store_row( a , r0 ) ;
+  store_row( a + 3 , r1 ) ;
+  store_row( a + 6 , complete_row( r0 , r1 ) ) ;
+  return ;
+}
+
+// a = b^{\dagger}.c, row i of a is sum_k conj( b_ki ) c_k
+void
+multabdag_suNC_AVX2( GLU_complex a[ NCNC ] ,
+		     const GLU_complex b[ NCNC ] ,
+		     const GLU_complex c[ NCNC ] )
+{
+  row3 C[ 3 ] , iC[ 3 ] ;
+  load_row( &C[0] , &iC[0] , c ) ;
+  load_row( &C[1] , &iC[1] , c + 3 ) ;
+  load_row( &C[2] , &iC[2] , c + 6 ) ;
+  const row3 r0 = row_times( b , 3 , C , iC , GLU_TRUE ) ;
+  const row3 r1 = row_times( b + 1 , 3 , C , iC , GLU_TRUE ) ;
+  store_row( a , r0 ) ;
+  store_row( a + 3 , r1 ) ;
+  store_row( a + 6 , complete_row( r0 , r1 ) ) ;
+  return ;
+}
+
+// Re tr( a.b.c^{\dagger} ) with a,b in SU(3)
+double
+Re_trace_abc_dag_suNC_AVX2( const GLU_complex a[ NCNC ] ,
+			    const GLU_complex b[ NCNC ] ,
+			    const GLU_complex c[ NCNC ] )
+{
+  row3 B[ 3 ] , iB[ 3 ] ;
+  load_row( &B[0] , &iB[0] , b ) ;
+  load_row( &B[1] , &iB[1] , b + 3 ) ;
+  load_row( &B[2] , &iB[2] , b + 6 ) ;
+  const row3 r0 = row_times( a , 1 , B , iB , GLU_FALSE ) ;
+  const row3 r1 = row_times( a + 3 , 1 , B , iB , GLU_FALSE ) ;
+  const row3 last = complete_row( r0 , r1 ) ;
+  // Re( x conj( y ) ) is just the dot product of the doubles
+  __m256d lo = _mm256_mul_pd( r0.lo , _mm256_loadu_pd( (const double*)c ) ) ;
+  __m128d hi = _mm_mul_pd( r0.hi , _mm_loadu_pd( (const double*)( c + 2 ) ) ) ;
+  lo = _mm256_fmadd_pd( r1.lo , _mm256_loadu_pd( (const double*)( c + 3 ) ) , lo ) ;
+  hi = _mm_fmadd_pd( r1.hi , _mm_loadu_pd( (const double*)( c + 5 ) ) , hi ) ;
+  lo = _mm256_fmadd_pd( last.lo , _mm256_loadu_pd( (const double*)( c + 6 ) ) , lo ) ;
+  hi = _mm_fmadd_pd( last.hi , _mm_loadu_pd( (const double*)( c + 8 ) ) , hi ) ;
+  const row3 sum = { lo , hi } ;
+  const __m128d s = hsum_row( sum ) ;
+  return _mm_cvtsd_f64( _mm_add_sd( s , _mm_unpackhi_pd( s , s ) ) ) ;
+}
+
+// tr( a.b.c ) = sum_i ( a.b )_i . ( column i of c )
+void
+trace_abc_AVX2( GLU_complex *__restrict tr ,
+		const GLU_complex a[ NCNC ] ,
+		const GLU_complex b[ NCNC ] ,
+		const GLU_complex c[ NCNC ] )
+{
+  row3 B[ 3 ] , iB[ 3 ] , Ci , iCi ;
+  load_row( &B[0] , &iB[0] , b ) ;
+  load_row( &B[1] , &iB[1] , b + 3 ) ;
+  load_row( &B[2] , &iB[2] , b + 6 ) ;
+  // accumulate ( x_r y_r , x_i y_i ) and ( x_r y_i , x_i y_r )
+  __m256d rlo = _mm256_setzero_pd( ) , ilo = _mm256_setzero_pd( ) ;
+  __m128d rhi = _mm_setzero_pd( ) , ihi = _mm_setzero_pd( ) ;
+  size_t i ;
+  for( i = 0 ; i < 3 ; i++ ) {
+    const row3 r = row_times( a + 3*i , 1 , B , iB , GLU_FALSE ) ;
+    load_col( &Ci , &iCi , c + i , GLU_FALSE ) ;
+    rlo = _mm256_fmadd_pd( r.lo , Ci.lo , rlo ) ;
+    rhi = _mm_fmadd_pd( r.hi , Ci.hi , rhi ) ;
+    ilo = _mm256_fmadd_pd( r.lo , _mm256_permute_pd( Ci.lo , 5 ) , ilo ) ;
+    ihi = _mm_fmadd_pd( r.hi , _mm_permute_pd( Ci.hi , 1 ) , ihi ) ;
+  }
+  const row3 rs = { rlo , rhi } , is = { ilo , ihi } ;
+  const __m128d re = hsum_row( rs ) , im = hsum_row( is ) ;
+  // ( re0 - re1 , im0 + im1 )
+  _mm_storeu_pd( (double*)tr , _mm_addsub_pd( _mm_unpacklo_pd( re , im ) ,
+					      _mm_unpackhi_pd( re , im ) ) ) ;
+  return ;
+}
+
+// tr( a.b.c^{\dagger} ) = sum_ij ( a.b )_ij conj( c_ij )
+void
+trace_abc_dag_AVX2( GLU_complex *__restrict tr ,
+		    const GLU_complex a[ NCNC ] ,
+		    const GLU_complex b[ NCNC ] ,
+		    const GLU_complex c[ NCNC ] )
+{
+  row3 B[ 3 ] , iB[ 3 ] ;
+  load_row( &B[0] , &iB[0] , b ) ;
+  load_row( &B[1] , &iB[1] , b + 3 ) ;
+  load_row( &B[2] , &iB[2] , b + 6 ) ;
+  __m256d rlo = _mm256_setzero_pd( ) , ilo = _mm256_setzero_pd( ) ;
+  __m128d rhi = _mm_setzero_pd( ) , ihi = _mm_setzero_pd( ) ;
+  size_t i ;
+  for( i = 0 ; i < 3 ; i++ ) {
+    const row3 r = row_times( a + 3*i , 1 , B , iB , GLU_FALSE ) ;
+    const __m256d clo = _mm256_loadu_pd( (const double*)( c + 3*i ) ) ;
+    const __m128d chi = _mm_loadu_pd( (const double*)( c + 3*i + 2 ) ) ;
+    rlo = _mm256_fmadd_pd( r.lo , clo , rlo ) ;
+    rhi = _mm_fmadd_pd( r.hi , chi , rhi ) ;
+    ilo = _mm256_fmadd_pd( r.lo , _mm256_permute_pd( clo , 5 ) , ilo ) ;
+    ihi = _mm_fmadd_pd( r.hi , _mm_permute_pd( chi , 1 ) , ihi ) ;
+  }
+  const row3 rs = { rlo , rhi } , is = { ilo , ihi } ;
+  const __m128d re = hsum_row( rs ) , im = hsum_row( is ) ;
+  // ( re0 + re1 , im1 - im0 )
+  const __m128d s = _mm_hadd_pd( re , re ) ;
+  const __m128d d = _mm_hsub_pd( _mm_permute_pd( im , 1 ) , im ) ;
+  _mm_storeu_pd( (double*)tr , _mm_unpacklo_pd( s , d ) ) ;
+  return ;
+}
+
+// real part of tr( a.b.c^{\dagger} )
+void
+trace_abc_dag_Re_AVX2( GLU_real *__restrict tr ,
+		       const GLU_complex a[ NCNC ] ,
+		       const GLU_complex b[ NCNC ] ,
+		       const GLU_complex c[ NCNC ] )
+{
+  GLU_complex Ctr ;
+  trace_abc_dag_AVX2( &Ctr , a , b , c ) ;
+  *tr = creal( Ctr ) ;
+  return ;
+}
+
+// column-wise gram-schmidt as in the SSE2 version, columns are row3's
+void
+gram_reunit_AVX2( GLU_complex *__restrict U )
+{
+  row3 c0 , c1 , ic ;
+  load_col( &c0 , &ic , U , GLU_FALSE ) ;
+  load_col( &c1 , &ic , U + 1 , GLU_FALSE ) ;
+
+  // normalise the first column
+  __m256d lo = _mm256_mul_pd( c0.lo , c0.lo ) ;
+  __m128d hi = _mm_mul_pd( c0.hi , c0.hi ) ;
+  row3 sq = { lo , hi } ;
+  __m128d n = hsum_row( sq ) ;
+  n = _mm_div_pd( _mm_set1_pd( 1.0 ) , _mm_sqrt_pd( _mm_hadd_pd( n , n ) ) ) ;
+  c0.lo = _mm256_mul_pd( c0.lo , _mm256_set_m128d( n , n ) ) ;
+  c0.hi = _mm_mul_pd( c0.hi , n ) ;
+
+  // remove the projection onto the first, sum_i c1_i conj( c0_i )
+  // is the sum of ( re , im ) re( c1 ) + ( im , -re ) im( c1 )
+  const __m256d c0s = _mm256_permute_pd( c0.lo , 5 ) ;
+  lo = _mm256_mul_pd( _mm256_movedup_pd( c1.lo ) , c0.lo ) ;
+  lo = _mm256_fmsubadd_pd( _mm256_permute_pd( c1.lo , 15 ) , c0s , lo ) ;
+  hi = SSE2_MUL_CONJ( c1.hi , c0.hi ) ;
+  const row3 pr = { lo , hi } ;
+  const __m128d p = hsum_row( pr ) ;
+  // c1 -= p c0
+  const __m256d pp = _mm256_set_m128d( p , p ) ;
+  c1.lo = _mm256_sub_pd( c1.lo ,
+			 _mm256_fmaddsub_pd( _mm256_movedup_pd( pp ) , c0.lo ,
+					     _mm256_mul_pd( _mm256_permute_pd( pp , 15 ) ,
+							    c0s ) ) ) ;
+  c1.hi = _mm_sub_pd( c1.hi , SSE2_MUL( p , c0.hi ) ) ;
+
+  // normalise the second column
+  sq.lo = _mm256_mul_pd( c1.lo , c1.lo ) ;
+  sq.hi = _mm_mul_pd( c1.hi , c1.hi ) ;
+  n = hsum_row( sq ) ;
+  n = _mm_div_pd( _mm_set1_pd( 1.0 ) , _mm_sqrt_pd( _mm_hadd_pd( n , n ) ) ) ;
+  c1.lo = _mm256_mul_pd( c1.lo , _mm256_set_m128d( n , n ) ) ;
+  c1.hi = _mm_mul_pd( c1.hi , n ) ;
+
+  // write out and complete the third column by the conjugate cross product
+  const __m128d u0 = _mm256_castpd256_pd128( c0.lo ) ;
+  const __m128d u3 = _mm256_extractf128_pd( c0.lo , 1 ) ;
+  const __m128d u1 = _mm256_castpd256_pd128( c1.lo ) ;
+  const __m128d u4 = _mm256_extractf128_pd( c1.lo , 1 ) ;
+  const __m128d u6 = c0.hi , u7 = c1.hi ;
+  __m128d *u = (__m128d*)U ;
+  _mm_storeu_pd( (double*)( u + 0 ) , u0 ) ;
+  _mm_storeu_pd( (double*)( u + 1 ) , u1 ) ;
+  _mm_storeu_pd( (double*)( u + 3 ) , u3 ) ;
+  _mm_storeu_pd( (double*)( u + 4 ) , u4 ) ;
+  _mm_storeu_pd( (double*)( u + 6 ) , u6 ) ;
+  _mm_storeu_pd( (double*)( u + 7 ) , u7 ) ;
+  _mm_storeu_pd( (double*)( u + 2 ) ,
+		 SSE2_CONJ( _mm_sub_pd( SSE2_MUL( u3 , u7 ) , SSE2_MUL( u4 , u6 ) ) ) ) ;
+  _mm_storeu_pd( (double*)( u + 5 ) ,
+		 SSE2_CONJ( _mm_sub_pd( SSE2_MUL( u1 , u6 ) , SSE2_MUL( u0 , u7 ) ) ) ) ;
+  _mm_storeu_pd( (double*)( u + 8 ) ,
+		 SSE2_CONJ( _mm_sub_pd( SSE2_MUL( u0 , u4 ) , SSE2_MUL( u1 , u3 ) ) ) ) ;
+  return ;
+}
+
+// U = f0 + f1 Q + f2 Q^2 with the f's from SU3_exp_effs()
+void
+exponentiate_AVX2( GLU_complex U[ NCNC ] ,
+		   const GLU_complex Q[ NCNC ] )
+{
+  double complex f[ 3 ] ;
+  if( SU3_exp_effs( f , Q ) == GLU_FALSE ) {
+    size_t i ;
+    for( i = 0 ; i < NCNC ; i++ ) { U[ i ] = 0.0 ; }
+    U[ 0 ] = U[ 4 ] = U[ 8 ] = 1.0 ;
+    return ;
+  }
+  row3 q[ 3 ] , iq[ 3 ] ;
+  load_row( &q[0] , &iq[0] , Q ) ;
+  load_row( &q[1] , &iq[1] , Q + 3 ) ;
+  load_row( &q[2] , &iq[2] , Q + 6 ) ;
+  const double *pf = (const double*)f ;
+  const __m256d f1r = _mm256_broadcast_sd( pf + 2 ) ;
+  const __m256d f1i = _mm256_broadcast_sd( pf + 3 ) ;
+  const __m256d f2r = _mm256_broadcast_sd( pf + 4 ) ;
+  const __m256d f2i = _mm256_broadcast_sd( pf + 5 ) ;
+  // all of U is computed before we write any of it in case U is Q
+  row3 u[ 3 ] ;
+  size_t i ;
+  for( i = 0 ; i < 3 ; i++ ) {
+    const row3 qq = row_times( Q + 3*i , 1 , q , iq , GLU_FALSE ) ;
+    u[i].lo = _mm256_mul_pd( f1r , q[i].lo ) ;
+    u[i].lo = _mm256_fmadd_pd( f1i , iq[i].lo , u[i].lo ) ;
+    u[i].lo = _mm256_fmadd_pd( f2r , qq.lo , u[i].lo ) ;
+    u[i].lo = _mm256_fmadd_pd( f2i , imul256( qq.lo ) , u[i].lo ) ;
+    u[i].hi = _mm_mul_pd( _mm256_castpd256_pd128( f1r ) , q[i].hi ) ;
+    u[i].hi = _mm_fmadd_pd( _mm256_castpd256_pd128( f1i ) , iq[i].hi , u[i].hi ) ;
+    u[i].hi = _mm_fmadd_pd( _mm256_castpd256_pd128( f2r ) , qq.hi , u[i].hi ) ;
+    u[i].hi = _mm_fmadd_pd( _mm256_castpd256_pd128( f2i ) , imul128( qq.hi ) , u[i].hi ) ;
+  }
+  // and f0 on the diagonal
+  const __m128d f0 = _mm_loadu_pd( pf ) ;
+  u[0].lo = _mm256_add_pd( u[0].lo , _mm256_set_m128d( _mm_setzero_pd( ) , f0 ) ) ;
+  u[1].lo = _mm256_add_pd( u[1].lo , _mm256_set_m128d( f0 , _mm_setzero_pd( ) ) ) ;
+  u[2].hi = _mm_add_pd( u[2].hi , f0 ) ;
+  store_row( U , u[0] ) ;
+  store_row( U + 3 , u[1] ) ;
+  store_row( U + 6 , u[2] ) ;
+  return ;
+}
+
+// and the site-batched kernels of lanes.h
+#include "lanes.h"
+#define LANES_FN( name ) name##_AVX2
+#include "lanes_body.h"
+
+#pragma GCC pop_options
+
+#endif
@@ -0,0 +1,356 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (SU3_AVX512.c) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file SU3_AVX512.c
+   @brief AVX-512 versions of the dispatched SU(3) kernels
+
+   A whole row (or column) of an SU(3) matrix lives in the low six lanes
+   of a __m512d, the top two are kept zero by the masked loads. Products
+   are accumulated a row at a time with broadcasts as in SU3_AVX2.c and
+   the completion of the bottom row is a lane-rotated cross product.
+   Only needs AVX512F, only compiled in with run-time dispatch
+ */
+#include "Mainfile.h"
+
+#ifdef GLU_DISPATCH
+
+#include <immintrin.h>
+
+#include "cpu_dispatch.h"
+
+#pragma GCC push_options
+#pragma GCC target("avx512f,avx2,fma")
+
+// lanes of the three complex numbers in a row
+#define ROW (0x3F)
+
+// xor on the bits, _mm512_xor_pd needs AVX512DQ
+static inline __m512d
+xor512( const __m512d a ,
+	const __m512d b )
+{
+  return _mm512_castsi512_pd( _mm512_xor_si512( _mm512_castpd_si512( a ) ,
+						_mm512_castpd_si512( b ) ) ) ;
+}
+
+// (re,im) -> (-im,re) i.e. multiplication by I
+static inline __m512d
+imul512( const __m512d a )
+{
+  return xor512( _mm512_permute_pd( a , 0x55 ) ,
+		 _mm512_setr_pd( -0.0 , 0.0 , -0.0 , 0.0 , -0.0 , 0.0 , -0.0 , 0.0 ) ) ;
+}
+
+// complex conjugate
+static inline __m512d
+conj512( const __m512d a )
+{
+  return xor512( a , _mm512_setr_pd( 0.0 , -0.0 , 0.0 , -0.0 , 0.0 , -0.0 , 0.0 , -0.0 ) ) ;
+}
+
+// complex multiply lane-wise
+static inline __m512d
+cmul512( const __m512d a ,
+	 const __m512d b )
+{
+  return _mm512_fmaddsub_pd( _mm512_movedup_pd( a ) , b ,
+			     _mm512_mul_pd( _mm512_permute_pd( a , 0xFF ) ,
+					    _mm512_permute_pd( b , 0x55 ) ) ) ;
+}
+
+static inline __m512d
+load_row( const GLU_complex *a )
+{
+  return _mm512_maskz_loadu_pd( ROW , (const double*)a ) ;
+}
+
+// exact-sized stores, a masked 512-bit store reaching into the next
+// matrix stops the next load being forwarded from the store buffer
+static inline void
+store_row( GLU_complex *a ,
+	   const __m512d r )
+{
+  _mm256_storeu_pd( (double*)a , _mm512_castpd512_pd256( r ) ) ;
+  _mm_storeu_pd( (double*)( a + 2 ) ,
+		 _mm256_castpd256_pd128( _mm512_extractf64x4_pd( r , 1 ) ) ) ;
+}
+
+// column of a, the masked loads do not touch anything outside the matrix
+static inline __m512d
+load_col( const GLU_complex *a )
+{
+  const double *pa = (const double*)a ;
+  __m512d c = _mm512_maskz_loadu_pd( 0x03 , pa ) ;
+  c = _mm512_mask_loadu_pd( c , 0x0C , pa + 4 ) ;
+  return _mm512_mask_loadu_pd( c , 0x30 , pa + 8 ) ;
+}
+
+// rotate a row by one and two complex numbers
+static inline __m512d
+rot1( const __m512d a )
+{
+  return _mm512_permutexvar_pd( _mm512_setr_epi64( 2 , 3 , 4 , 5 , 0 , 1 , 6 , 7 ) , a ) ;
+}
+static inline __m512d
+rot2( const __m512d a )
+{
+  return _mm512_permutexvar_pd( _mm512_setr_epi64( 4 , 5 , 0 , 1 , 2 , 3 , 6 , 7 ) , a ) ;
+}
+
+// sum_k b[k*stride] x[k], conjugating b if "dag"
+static inline __m512d
+row_times( const GLU_complex *b ,
+	   const size_t stride ,
+	   const __m512d x[ 3 ] ,
+	   const __m512d ix[ 3 ] ,
+	   const GLU_bool dag )
+{
+  const double *pb = (const double*)b ;
+  const double sgn = ( dag == GLU_TRUE ) ? -1.0 : 1.0 ;
+  __m512d r = _mm512_mul_pd( _mm512_set1_pd( pb[0] ) , x[0] ) ;
+  r = _mm512_fmadd_pd( _mm512_set1_pd( sgn * pb[1] ) , ix[0] , r ) ;
+  pb += 2 * stride ;
+  r = _mm512_fmadd_pd( _mm512_set1_pd( pb[0] ) , x[1] , r ) ;
+  r = _mm512_fmadd_pd( _mm512_set1_pd( sgn * pb[1] ) , ix[1] , r ) ;
+  pb += 2 * stride ;
+  r = _mm512_fmadd_pd( _mm512_set1_pd( pb[0] ) , x[2] , r ) ;
+  r = _mm512_fmadd_pd( _mm512_set1_pd( sgn * pb[1] ) , ix[2] , r ) ;
+  return r ;
+}
+
+// conjugate cross product of two rows, gives the bottom row of SU(3)
+static inline __m512d
+complete_row( const __m512d r0 ,
+	      const __m512d r1 )
+{
+  return conj512( _mm512_sub_pd( cmul512( rot1( r0 ) , rot2( r1 ) ) ,
+				 cmul512( rot2( r0 ) , rot1( r1 ) ) ) ) ;
+}
+
+// a = b.c
+void
+multab_suNC_AVX512( GLU_complex a[ NCNC ] ,
+		    const GLU_complex b[ NCNC ] ,
+		    const GLU_complex c[ NCNC ] )
+{
+  const __m512d C[ 3 ] = { load_row( c ) , load_row( c + 3 ) , load_row( c + 6 ) } ;
+  const __m512d iC[ 3 ] = { imul512( C[0] ) , imul512( C[1] ) , imul512( C[2] ) } ;
+  const __m512d r0 = row_times( b , 1 , C , iC , GLU_FALSE ) ;
+  const __m512d r1 = row_times( b + 3 , 1 , C , iC , GLU_FALSE ) ;
+  store_row( a , r0 ) ;
+  store_row( a + 3 , r1 ) ;
+  store_row( a + 6 , complete_row( r0 , r1 ) ) ;
+  return ;
+}
+
+// a = b.c^{\dagger}, the rows of c^{\dagger} are its conjugated columns
+void
+multab_dag_suNC_AVX512( GLU_complex a[ NCNC ] ,
+			const GLU_complex b[ NCNC ] ,
+			const GLU_complex c[ NCNC ] )
+{
+  const __m512d C[ 3 ] = { conj512( load_col( c ) ) ,
+			   conj512( load_col( c + 1 ) ) ,
+			   conj512( load_col( c + 2 ) ) } ;
+  const __m512d iC[ 3 ] = { imul512( C[0] ) , imul512( C[1] ) , imul512( C[2] ) } ;
+  const __m512d r0 = row_times( b , 1 , C , iC , GLU_FALSE ) ;
+  const __m512d r1 = row_times( b + 3 , 1 , C , iC , GLU_FALSE ) ;
+  store_row( a , r0 ) ;
+  store_row( a + 3 , r1 ) ;
+  store_row( a + 6 , complete_row( r0 , r1 ) ) ;
+  return ;
+}
+
+// a = b^{\dagger}.c, row i of a is sum_k conj( b_ki ) c_k
+void
+multabdag_suNC_AVX512( GLU_complex a[ NCNC ] ,
+		       const GLU_complex b[ NCNC ] ,
+		       const GLU_complex c[ NCNC ] )
+{
+  const __m512d C[ 3 ] = { load_row( c ) , load_row( c + 3 ) , load_row( c + 6 ) } ;
+  const __m512d iC[ 3 ] = { imul512( C[0] ) , imul512( C[1] ) , imul512( C[2] ) } ;
+  const __m512d r0 = row_times( b , 3 , C , iC , GLU_TRUE ) ;
+  const __m512d r1 = row_times( b + 1 , 3 , C , iC , GLU_TRUE ) ;
+  store_row( a , r0 ) ;
+  store_row( a + 3 , r1 ) ;
+  store_row( a + 6 , complete_row( r0 , r1 ) ) ;
+  return ;
+}
+
+// Re tr( a.b.c^{\dagger} ) with a,b in SU(3), the dot product of the doubles
+double
+Re_trace_abc_dag_suNC_AVX512( const GLU_complex a[ NCNC ] ,
+			      const GLU_complex b[ NCNC ] ,
+			      const GLU_complex c[ NCNC ] )
+{
+  const __m512d B[ 3 ] = { load_row( b ) , load_row( b + 3 ) , load_row( b + 6 ) } ;
+  const __m512d iB[ 3 ] = { imul512( B[0] ) , imul512( B[1] ) , imul512( B[2] ) } ;
+  const __m512d r0 = row_times( a , 1 , B , iB , GLU_FALSE ) ;
+  const __m512d r1 = row_times( a + 3 , 1 , B , iB , GLU_FALSE ) ;
+  __m512d sum = _mm512_mul_pd( r0 , load_row( c ) ) ;
+  sum = _mm512_fmadd_pd( r1 , load_row( c + 3 ) , sum ) ;
+  sum = _mm512_fmadd_pd( complete_row( r0 , r1 ) , load_row( c + 6 ) , sum ) ;
+  return _mm512_reduce_add_pd( sum ) ;
+}
+
+// tr( a.b.c ) = sum_i ( a.b )_i . ( column i of c )
+void
+trace_abc_AVX512( GLU_complex *__restrict tr ,
+		  const GLU_complex a[ NCNC ] ,
+		  const GLU_complex b[ NCNC ] ,
+		  const GLU_complex c[ NCNC ] )
+{
+  const __m512d B[ 3 ] = { load_row( b ) , load_row( b + 3 ) , load_row( b + 6 ) } ;
+  const __m512d iB[ 3 ] = { imul512( B[0] ) , imul512( B[1] ) , imul512( B[2] ) } ;
+  // accumulate ( x_r y_r , x_i y_i ) and ( x_r y_i , x_i y_r )
+  __m512d re = _mm512_setzero_pd( ) , im = _mm512_setzero_pd( ) ;
+  size_t i ;
+  for( i = 0 ; i < 3 ; i++ ) {
+    const __m512d r = row_times( a + 3*i , 1 , B , iB , GLU_FALSE ) ;
+    const __m512d col = load_col( c + i ) ;
+    re = _mm512_fmadd_pd( r , col , re ) ;
+    im = _mm512_fmadd_pd( r , _mm512_permute_pd( col , 0x55 ) , im ) ;
+  }
+  re = xor512( re , _mm512_setr_pd( 0.0 , -0.0 , 0.0 , -0.0 , 0.0 , -0.0 , 0.0 , -0.0 ) ) ;
+  *tr = _mm512_reduce_add_pd( re ) + I * _mm512_reduce_add_pd( im ) ;
+  return ;
+}
+
+// tr( a.b.c^{\dagger} ) = sum_ij ( a.b )_ij conj( c_ij )
+void
+trace_abc_dag_AVX512( GLU_complex *__restrict tr ,
+		      const GLU_complex a[ NCNC ] ,
+		      const GLU_complex b[ NCNC ] ,
+		      const GLU_complex c[ NCNC ] )
+{
+  const __m512d B[ 3 ] = { load_row( b ) , load_row( b + 3 ) , load_row( b + 6 ) } ;
+  const __m512d iB[ 3 ] = { imul512( B[0] ) , imul512( B[1] ) , imul512( B[2] ) } ;
+  __m512d re = _mm512_setzero_pd( ) , im = _mm512_setzero_pd( ) ;
+  size_t i ;
+  for( i = 0 ; i < 3 ; i++ ) {
+    const __m512d r = row_times( a + 3*i , 1 , B , iB , GLU_FALSE ) ;
+    const __m512d row = load_row( c + 3*i ) ;
+    re = _mm512_fmadd_pd( r , row , re ) ;
+    im = _mm512_fmadd_pd( r , _mm512_permute_pd( row , 0x55 ) , im ) ;
+  }
+  // imaginary part is x_i y_r - x_r y_i
+  im = xor512( im , _mm512_setr_pd( -0.0 , 0.0 , -0.0 , 0.0 , -0.0 , 0.0 , -0.0 , 0.0 ) ) ;
+  *tr = _mm512_reduce_add_pd( re ) + I * _mm512_reduce_add_pd( im ) ;
+  return ;
+}
+
+// real part of tr( a.b.c^{\dagger} )
+void
+trace_abc_dag_Re_AVX512( GLU_real *__restrict tr ,
+			 const GLU_complex a[ NCNC ] ,
+			 const GLU_complex b[ NCNC ] ,
+			 const GLU_complex c[ NCNC ] )
+{
+  GLU_complex Ctr ;
+  trace_abc_dag_AVX512( &Ctr , a , b , c ) ;
+  *tr = creal( Ctr ) ;
+  return ;
+}
+
+// column-wise gram-schmidt as in the SSE2 version on whole columns
+void
+gram_reunit_AVX512( GLU_complex *__restrict U )
+{
+  __m512d c0 = load_col( U ) , c1 = load_col( U + 1 ) ;
+
+  // normalise the first column
+  c0 = _mm512_mul_pd( c0 , _mm512_set1_pd( 1.0 / sqrt( _mm512_reduce_add_pd( _mm512_mul_pd( c0 , c0 ) ) ) ) ) ;
+
+  // remove the projection sum_i c1_i conj( c0_i ) onto the first
+  const __m512d ic0 = imul512( c0 ) ;
+  const double pr = _mm512_reduce_add_pd( _mm512_mul_pd( c1 , c0 ) ) ;
+  const double pi = _mm512_reduce_add_pd( _mm512_mul_pd( c1 , ic0 ) ) ;
+  c1 = _mm512_fnmadd_pd( _mm512_set1_pd( pr ) , c0 , c1 ) ;
+  c1 = _mm512_fnmadd_pd( _mm512_set1_pd( pi ) , ic0 , c1 ) ;
+
+  // normalise the second
+  c1 = _mm512_mul_pd( c1 , _mm512_set1_pd( 1.0 / sqrt( _mm512_reduce_add_pd( _mm512_mul_pd( c1 , c1 ) ) ) ) ) ;
+
+  // the third column completes the first two
+  const __m512d c2 = complete_row( c0 , c1 ) ;
+
+  // transpose back into rows
+  const __m512i lo = _mm512_setr_epi64( 0 , 1 , 8 , 9 , 0 , 0 , 0 , 0 ) ;
+  const __m512i mid = _mm512_setr_epi64( 2 , 3 , 10 , 11 , 0 , 0 , 0 , 0 ) ;
+  const __m512i top = _mm512_setr_epi64( 4 , 5 , 12 , 13 , 0 , 0 , 0 , 0 ) ;
+  __m512d t0 = _mm512_permutex2var_pd( c0 , lo , c1 ) ;
+  __m512d t1 = _mm512_permutex2var_pd( c0 , mid , c1 ) ;
+  __m512d t2 = _mm512_permutex2var_pd( c0 , top , c1 ) ;
+  const __m512i third = _mm512_setr_epi64( 0 , 1 , 2 , 3 , 8 , 9 , 0 , 0 ) ;
+  t0 = _mm512_permutex2var_pd( t0 , third , c2 ) ;
+  t1 = _mm512_permutex2var_pd( t1 , third , rot1( c2 ) ) ;
+  t2 = _mm512_permutex2var_pd( t2 , third , rot2( c2 ) ) ;
+  store_row( U , t0 ) ;
+  store_row( U + 3 , t1 ) ;
+  store_row( U + 6 , t2 ) ;
+  return ;
+}
+
+// U = f0 + f1 Q + f2 Q^2 with the f's from SU3_exp_effs()
+void
+exponentiate_AVX512( GLU_complex U[ NCNC ] ,
+		     const GLU_complex Q[ NCNC ] )
+{
+  double complex f[ 3 ] ;
+  if( SU3_exp_effs( f , Q ) == GLU_FALSE ) {
+    size_t i ;
+    for( i = 0 ; i < NCNC ; i++ ) { U[ i ] = 0.0 ; }
+    U[ 0 ] = U[ 4 ] = U[ 8 ] = 1.0 ;
+    return ;
+  }
+  const __m512d q[ 3 ] = { load_row( Q ) , load_row( Q + 3 ) , load_row( Q + 6 ) } ;
+  const __m512d iq[ 3 ] = { imul512( q[0] ) , imul512( q[1] ) , imul512( q[2] ) } ;
+  const __m512d f0 = _mm512_setr_pd( creal( f[0] ) , cimag( f[0] ) ,
+				     creal( f[0] ) , cimag( f[0] ) ,
+				     creal( f[0] ) , cimag( f[0] ) , 0.0 , 0.0 ) ;
+  const __m512d f1r = _mm512_set1_pd( creal( f[1] ) ) ;
+  const __m512d f1i = _mm512_set1_pd( cimag( f[1] ) ) ;
+  const __m512d f2r = _mm512_set1_pd( creal( f[2] ) ) ;
+  const __m512d f2i = _mm512_set1_pd( cimag( f[2] ) ) ;
+  // all of U is computed before we write any of it in case U is Q
+  __m512d u[ 3 ] ;
+  size_t i ;
+  for( i = 0 ; i < 3 ; i++ ) {
+    const __m512d qq = row_times( Q + 3*i , 1 , q , iq , GLU_FALSE ) ;
+    u[i] = _mm512_mul_pd( f1r , q[i] ) ;
+    u[i] = _mm512_fmadd_pd( f1i , iq[i] , u[i] ) ;
+    u[i] = _mm512_fmadd_pd( f2r , qq , u[i] ) ;
+    u[i] = _mm512_fmadd_pd( f2i , imul512( qq ) , u[i] ) ;
+    // f0 on the diagonal
+    u[i] = _mm512_mask_add_pd( u[i] , (__mmask8)( 3 << ( 2*i ) ) , u[i] , f0 ) ;
+  }
+  store_row( U , u[0] ) ;
+  store_row( U + 3 , u[1] ) ;
+  store_row( U + 6 , u[2] ) ;
+  return ;
+}
+
+// and the site-batched kernels of lanes.h
+#include "lanes.h"
+#define LANES_FN( name ) name##_AVX512
+#include "lanes_body.h"
+
+#pragma GCC pop_options
+
+#endif
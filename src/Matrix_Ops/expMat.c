@@ -151,12 +151,13 @@ horners_exp( GLU_complex a[ NCNC ] ,
 
 #endif
 
-// exponentiate exactly a hermitian matrix "Q" into SU(NC) matrix "U"
-void
-exponentiate( GLU_complex U[ NCNC ] , 
+#if NC == 3
+// Cayley-Hamilton coefficients of exp( i Q ) = f0 + f1 Q + f2 Q^2, for
+// Q numerically zero the exponential is the identity and we say so
+GLU_bool
+SU3_exp_effs( double complex f[ 3 ] ,
 	      const GLU_complex Q[ NCNC ] )
 {
-#if NC == 3
   GLU_real *qq = ( GLU_real* )Q ;
   const double REQ0 = *( qq + 0 ) ;
   const double REQ1 = *( qq + 2 ) ;
@@ -177,16 +178,7 @@ exponentiate( GLU_complex U[ NCNC ] ,
   //Iff c0_max < ( smallest representable double) the matrix Q is zero and its
   //exponential is the identity matrix ..
   if( c1 < DBL_MIN ) {
-    *( U + 0 ) = 1. ; 
-    *( U + 1 ) = 0. ; 
-    *( U + 2 ) = 0. ; 
-    *( U + 3 ) = 0. ; 
-    *( U + 4 ) = 1. ; 
-    *( U + 5 ) = 0. ; 
-    *( U + 6 ) = 0. ; 
-    *( U + 7 ) = 0. ; 
-    *( U + 8 ) = 1. ; 
-    return ;
+    return GLU_FALSE ;
   }
 
   // will write this out as it can be done cheaper
@@ -232,9 +224,50 @@ exponentiate( GLU_complex U[ NCNC ] ,
   double complex f1 = 2. * u * two - one * ( 2. * u * c - I * ( 3. * uu - ww ) * E0 ) ; 
   double complex f2 = two - one * ( c + 3. * I * u * E0 ) ; 
 
-  f0 = denom * ( creal( f0 ) + I * cimag( f0 ) * flag ) ;
-  f1 = denom * ( flag * creal( f1 ) + I * cimag( f1 ) ) ;
-  f2 = denom * ( creal( f2 ) + I * cimag( f2 ) * flag ) ;
+  f[0] = denom * ( creal( f0 ) + I * cimag( f0 ) * flag ) ;
+  f[1] = denom * ( flag * creal( f1 ) + I * cimag( f1 ) ) ;
+  f[2] = denom * ( creal( f2 ) + I * cimag( f2 ) * flag ) ;
+  return GLU_TRUE ;
+}
+#endif
+
+// under run-time dispatch this is the generic entry of the kernel table
+#ifdef GLU_DISPATCH
+  #define exponentiate exponentiate_generic
+#endif
+
+// exponentiate exactly a hermitian matrix "Q" into SU(NC) matrix "U"
+void
+exponentiate( GLU_complex U[ NCNC ] , 
+	      const GLU_complex Q[ NCNC ] )
+{
+#if NC == 3
+  GLU_real *qq = ( GLU_real* )Q ;
+  const double REQ0 = *( qq + 0 ) ;
+  const double REQ1 = *( qq + 2 ) ;
+  const double IMQ1 = *( qq + 3 ) ;
+  const double REQ2 = *( qq + 4 ) ;
+  const double IMQ2 = *( qq + 5 ) ;
+  const double REQ4 = *( qq + 8 ) ;
+  const double REQ5 = *( qq + 10 ) ;
+  const double IMQ5 = *( qq + 11 ) ;
+  const double REQ8 = *( qq + 16 ) ;
+
+  // Q = 0 exponentiates to the identity
+  double complex f[ 3 ] ;
+  if( SU3_exp_effs( f , Q ) == GLU_FALSE ) {
+    *( U + 0 ) = 1. ; 
+    *( U + 1 ) = 0. ; 
+    *( U + 2 ) = 0. ; 
+    *( U + 3 ) = 0. ; 
+    *( U + 4 ) = 1. ; 
+    *( U + 5 ) = 0. ; 
+    *( U + 6 ) = 0. ; 
+    *( U + 7 ) = 0. ; 
+    *( U + 8 ) = 1. ; 
+    return ;
+  }
+  const double complex f0 = f[0] , f1 = f[1] , f2 = f[2] ;
 
   // QQ[0].
   const double temp0 = REQ0 * REQ0 + REQ1 * REQ1 +	\
@@ -366,6 +399,10 @@ exponentiate( GLU_complex U[ NCNC ] ,
   return ;
 }
 
+#ifdef GLU_DISPATCH
+  #undef exponentiate
+#endif
+
 // exactly the same as above ,  just calculates the f-functions in-step instead of requiring them
 // takes a shortened, Hermitian Q and gives back the SU(NC) matrix U
 void
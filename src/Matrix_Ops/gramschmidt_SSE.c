@@ -22,6 +22,7 @@
  */
 #include "Mainfile.h"
 
+#include "gramschmidt.h" // gram_reunit()
 #include "par_rng.h"    // par_generate_NCxNC() is called
 
 #if (defined HAVE_IMMINTRIN_H ) && !( defined SINGLE_PREC)
@@ -33,6 +34,11 @@
   #include "LU.h"         // LU_det()
 #endif
 
+// under run-time dispatch this is the generic entry of the kernel table
+#ifdef GLU_DISPATCH
+  #define gram_reunit gram_reunit_generic
+#endif
+
 //reunitarise an SU(3) matrix sped up for our requirements
 void 
 gram_reunit( GLU_complex *__restrict U )
@@ -170,6 +176,10 @@ gram_reunit( GLU_complex *__restrict U )
   return ;
 }
 
+#ifdef GLU_DISPATCH
+  #undef gram_reunit
+#endif
+
 // generate a random SU(N) matrix
 void 
 Sunitary_gen( GLU_complex Z[ NCNC ] ,
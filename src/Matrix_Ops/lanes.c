@@ -0,0 +1,34 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (lanes.c) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file lanes.c
+   @brief generic build of the site-batched staple, plaquette and clover kernels
+ */
+#include "Mainfile.h"
+
+#include "lanes.h"
+
+#ifdef GLU_DISPATCH
+  #include "cpu_dispatch.h"
+  #define LANES_FN( name ) name##_generic
+#else
+  #define LANES_FN( name ) name
+#endif
+
+#include "lanes_body.h"
@@ -27,6 +27,14 @@
 #include <immintrin.h>
 #include "SSE2_OPS.h"
 
+// under run-time dispatch these are the generic entries of the kernel table
+#ifdef GLU_DISPATCH
+  #define Re_trace_abc_dag_suNC Re_trace_abc_dag_suNC_generic
+  #define trace_abc trace_abc_generic
+  #define trace_abc_dag trace_abc_dag_generic
+  #define trace_abc_dag_Re trace_abc_dag_Re_generic
+#endif
+
 #define TEST
 
 // compute the real part of the product of 3 su(3) matrices
@@ -59,6 +59,15 @@ main( const int argc ,
   // and make the input data constant
   const struct infile_data INFILE = infile_struct ;
 
+  // -b instead of -c runs over a list or glob of configurations
+  if( strcmp( argv[ READ - 1 ] , "-b" ) == 0 ) {
+    const int FLAG = batch_wrap( argv[ READ ] , 
+				 ( argc-1 ) == WRITE ? argv[ WRITE ] : NULL ,
+				 INFILE ) ;
+    unstick_GLU( ) ;
+    return FLAG ;
+  }
+
   // and the options
   switch( INFILE.mode ) {
   case MODE_GF :
@@ -22,19 +22,44 @@
 
    HEX smearing alphas are related to HYP's
    via HYP::HYP (a1,a2,a3) = (3a1,2a2,a3)
+
+   The level-1 and level-2 decorated links are only kept for a window
+   of time-slices around the one being smeared, see HYPSLsmear4D()
    
    @warning only implemented for ND=4
  */
 #include "Mainfile.h"
+#include "ND_generic_HYP.h" // HYsmearND() for very short lattices
 #include "plaqs_links.h"
 #include "projectors.h"
 
 #if ND == 4
-// precompute the level 1 dressed links ....
 
+// decorated link l at site j of slice s, whichever buffer holds that slice
+#define WIN( lev , j , s , l ) ( lev[ s ][ (j) - (s)*LCU ].O[ l ] )
+
+// slice of the neighbour in direction dir of a site on slice s
+static inline size_t
+slice_up( const size_t s , 
+	  const size_t dir )
+{
+  if( dir != ND - 1 ) return s ;
+  return ( s + 1 == Latt.dims[ ND - 1 ] ) ? 0 : s + 1 ;
+}
+
+static inline size_t
+slice_dn( const size_t s , 
+	  const size_t dir )
+{
+  if( dir != ND - 1 ) return s ;
+  return ( s == 0 ? Latt.dims[ ND - 1 ] : s ) - 1 ;
+}
+
+// the level 1 dressed links of time-slice s
 static void 
 get_lv1( struct s_site *__restrict lev1 ,
 	 const struct site *__restrict lat ,
+	 const size_t s ,
 	 const int type ,
 	 void (*project) ( GLU_complex smeared_link[ NCNC ] , 
 			   GLU_complex staple[ NCNC ] , 
@@ -42,36 +67,37 @@ get_lv1( struct s_site *__restrict lev1 ,
 			   const double smear_alpha , 	     
 			   const double al ) )
 {
-  size_t i ; 
-  //do the whole lattice
-#pragma omp for private(i) SCHED
-  for( i = 0 ; i < LVOLUME ; i++ ) {
+  size_t k ; 
+  //do the whole slice
+#pragma omp for private(k) SCHED
+  for( k = 0 ; k < LCU ; k++ ) {
     GLU_complex a[ NCNC ] GLUalign , b[ NCNC ] GLUalign ;
     GLU_complex c[ NCNC ] GLUalign ;
+    const size_t i = LCU * s + k ;
     size_t j = 0 , mu , nu ;
     //calculate the level1 staples
     for( mu = 0  ;  mu < ND  ;  mu++  ) {
       for( nu = 0  ;  nu < ND  ;  nu++ ) {
 	if( nu == mu ) continue ;	
-	size_t temp = lat[i].neighbor[nu] ; 
+	size_t temp = site_fwd( i , nu ) ; 
 	multab_suNC( a , lat[i].O[nu] , lat[temp].O[mu] ) ; 
-	temp = lat[i].neighbor[mu] ; 
+	temp = site_fwd( i , mu ) ; 
 	multab_dag_suNC( b , a , lat[temp].O[nu] ) ;	
 	if( type == SM_LOG ) {
 	  multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
 	  exact_log_slow( b , a ) ; 
 	}
 	//bottom staple
-	temp = lat[i].back[nu] ; 
+	temp = site_bck( i , nu ) ; 
 	multabdag_suNC( a , lat[temp].O[nu] , lat[temp].O[mu] ) ; 
-	temp = lat[temp].neighbor[mu] ; 
+	temp = site_fwd( temp , mu ) ; 
 	multab_suNC( c , a , lat[temp].O[nu] ) ; 
 	if( type == SM_LOG ) {
 	  multab_dag_suNC( a , c , lat[i].O[mu] ) ; 
 	  exact_log_slow( c , a ) ; 
 	}
 	a_plus_b( b , c ) ; 
-	project( lev1[i].O[j] , b , lat[i].O[mu] , 
+	project( lev1[k].O[j] , b , lat[i].O[mu] , 
 		 alpha3 , one_min_a3 ) ; 
 	// j is our staple counter
 	j++ ; 
@@ -81,11 +107,12 @@ get_lv1( struct s_site *__restrict lev1 ,
   return ;
 }
 
-//calculate the 4D level2 staples 
+//calculate the 4D level2 staples of time-slice s
 static void 
 get_lv2( struct s_site *__restrict lev2 ,
-	 const struct s_site *__restrict lev1 ,
+	 struct s_site *const *lev1 ,
 	 const struct site *__restrict lat ,
+	 const size_t s ,
 	 const int type ,
 	 void (*project) ( GLU_complex smeared_link[ NCNC ] , 
 			   GLU_complex staple[ NCNC ] , 
@@ -93,9 +120,10 @@ get_lv2( struct s_site *__restrict lev2 ,
 			   const double smear_alpha , 	     
 			   const double al ) )
 {
-  size_t i ;
-#pragma omp for private(i) SCHED
-  for( i = 0  ;  i < LVOLUME  ;  i++ ) {
+  size_t k ;
+#pragma omp for private(k) SCHED
+  for( k = 0  ;  k < LCU  ;  k++ ) {
+    const size_t i = LCU * s + k ;
     size_t rho = 0 , sigma = 0 ;
     size_t ii = 0 , mu , nu ;
     GLU_complex b[ NCNC ] GLUalign , a[ NCNC ] GLUalign ;
@@ -125,10 +153,11 @@ get_lv2( struct s_site *__restrict lev2 ,
 	  if( sigma > rho ) { kk-- ; } 
 		
 	  //kk , jj , kk are the correct steps for the staples rho-mu plane	
-	  size_t temp = lat[i].neighbor[rho] ; 
-	  multab_suNC( a , lev1[i].O[kk] , lev1[temp].O[jj] ) ; 
-	  temp = lat[i].neighbor[mu] ; 
-	  multab_dag_suNC( b , a , lev1[temp].O[kk] ) ; 
+	  size_t temp = site_fwd( i , rho ) ; 
+	  multab_suNC( a , lev1[s][k].O[kk] , 
+		       WIN( lev1 , temp , slice_up( s , rho ) , jj ) ) ; 
+	  temp = site_fwd( i , mu ) ; 
+	  multab_dag_suNC( b , a , WIN( lev1 , temp , slice_up( s , mu ) , kk ) ) ; 
 		
 	  if( type == SM_LOG ) {
 	    multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
@@ -137,10 +166,12 @@ get_lv2( struct s_site *__restrict lev2 ,
 	  a_plus_b( stap , b ) ; 
 
 	  //bottom staple
-	  temp = lat[i].back[rho] ; 
-	  multabdag_suNC( a , lev1[temp].O[kk] , lev1[temp].O[jj]  ) ; 
-	  temp = lat[temp].neighbor[mu] ;  
-	  multab_suNC( b , a , lev1[temp].O[kk] ) ; 
+	  temp = site_bck( i , rho ) ; 
+	  const size_t sb = slice_dn( s , rho ) ;
+	  multabdag_suNC( a , WIN( lev1 , temp , sb , kk ) , 
+			  WIN( lev1 , temp , sb , jj ) ) ; 
+	  temp = site_fwd( temp , mu ) ;  
+	  multab_suNC( b , a , WIN( lev1 , temp , slice_up( sb , mu ) , kk ) ) ; 
 		
 	  if( type == SM_LOG ) {
 	    multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
@@ -149,7 +180,7 @@ get_lv2( struct s_site *__restrict lev2 ,
 	  a_plus_b( stap , b ) ; 
 	}
 	// here are the projections; SM_APE, SM_STOUT and SM_LOG
-	project( lev2[i].O[ii] , stap , lat[i].O[mu] , 
+	project( lev2[k].O[ii] , stap , lat[i].O[mu] , 
 		 alpha2 , one_min_a2 ) ; 
 	// end of projections
 	ii++ ; 
@@ -159,12 +190,13 @@ get_lv2( struct s_site *__restrict lev2 ,
   return ;
 }
 
-// complete the staples ....
+// complete the staples of site i on slice s ....
 static void 
 gen_staples_4D( GLU_complex *__restrict stap , 
-		const struct s_site *__restrict lev2 ,
+		struct s_site *const *lev2 ,
 		const struct site *__restrict lat ,
 		const size_t i , 
+		const size_t s ,
 		const size_t mu , 
 		const int type )
 {
@@ -180,10 +212,11 @@ gen_staples_4D( GLU_complex *__restrict stap ,
     if( mu > nu  ) { kk-- ; } 
     
     //kk , jj , kk are the correct steps for the staples nu-mu plane
-    size_t temp = lat[i].neighbor[nu] ; 
-    multab_suNC( a , lev2[i].O[kk] , lev2[temp].O[jj]  ) ; 
-    temp = lat[i].neighbor[mu] ; 
-    multab_dag_suNC( b , a , lev2[temp].O[kk] ) ; 
+    size_t temp = site_fwd( i , nu ) ; 
+    multab_suNC( a , WIN( lev2 , i , s , kk ) , 
+		 WIN( lev2 , temp , slice_up( s , nu ) , jj ) ) ; 
+    temp = site_fwd( i , mu ) ; 
+    multab_dag_suNC( b , a , WIN( lev2 , temp , slice_up( s , mu ) , kk ) ) ; 
     
     if( type == SM_LOG ) {
       multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
@@ -191,10 +224,12 @@ gen_staples_4D( GLU_complex *__restrict stap ,
     }
     a_plus_b( stap , b ) ; 
     
-    temp = lat[i].back[nu] ; 
-    multabdag_suNC( a , lev2[temp].O[kk] , lev2[temp].O[jj] ) ; 
-    temp = lat[temp].neighbor[mu] ; 
-    multab_suNC( b , a , lev2[temp].O[kk] ) ; 
+    temp = site_bck( i , nu ) ; 
+    const size_t sb = slice_dn( s , nu ) ;
+    multabdag_suNC( a , WIN( lev2 , temp , sb , kk ) , 
+		    WIN( lev2 , temp , sb , jj ) ) ; 
+    temp = site_fwd( temp , mu ) ; 
+    multab_suNC( b , a , WIN( lev2 , temp , slice_up( sb , mu ) , kk ) ) ; 
     
     if( type == SM_LOG ) {
       multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
@@ -204,15 +239,17 @@ gen_staples_4D( GLU_complex *__restrict stap ,
   }
   return ;
 }
+
+#undef WIN
 #endif
 
 ////////////////////////////////////////////////////
 
 // this code performs the smearing ...
 int
-HYPSLsmear4D_expensive( struct site *__restrict lat , 
-			const size_t smiters , 
-			const int type )
+HYPSLsmear4D( struct site *__restrict lat , 
+	      const size_t smiters , 
+	      const int type )
 {
 #if ND != 4
   return GLU_FAILURE ;
@@ -227,7 +264,14 @@ HYPSLsmear4D_expensive( struct site *__restrict lat ,
     return GLU_FAILURE ; 
   }
 
-  struct s_site *lat2 = NULL , *lat3 = NULL , *lat4 = NULL ;
+  // the window below needs four distinct slices
+  const size_t T = Latt.dims[ ND - 1 ] ;
+  if( T < 4 ) {
+    return HYsmearND( lat , smiters , type , ALL_DIRECTIONS ) ;
+  }
+
+  // lev1 holds a ring of three slices and slice T-1, lev2 a ring of
+  // three and slices T-1 and 0
   struct s_site *lev1 = NULL , *lev2 = NULL ;
   double *red = NULL ;
   int FLAG = GLU_SUCCESS ;
@@ -258,17 +302,9 @@ HYPSLsmear4D_expensive( struct site *__restrict lat ,
     FLAG = GLU_FAILURE ; goto memfree ;
   }
 
-  // allocate temporary lattices ...
-  if( ( lat2 = allocate_s_site( LCU , ND , NCNC ) ) == NULL ||
-      ( lat3 = allocate_s_site( LCU , ND , NCNC ) ) == NULL ||
-      ( lat4 = allocate_s_site( LCU , ND , NCNC ) ) == NULL ) {
-    fprintf( stderr , "[SMEARING] field allocation failure\n" ) ;
-    FLAG = GLU_FAILURE ; goto memfree ;
-  }
-
   // allocate levels
-  if( ( lev1 = allocate_s_site( LVOLUME , ND*(ND-1) , NCNC ) ) == NULL ||
-      ( lev2 = allocate_s_site( LVOLUME , ND*(ND-1) , NCNC ) ) == NULL ) {
+  if( ( lev1 = allocate_s_site( 4*LCU , ND*(ND-1) , NCNC ) ) == NULL ||
+      ( lev2 = allocate_s_site( 5*LCU , ND*(ND-1) , NCNC ) ) == NULL ) {
     fprintf( stderr , "[SMEARING] field allocation failure\n" ) ;
     FLAG = GLU_FAILURE ; goto memfree ;
   }
@@ -280,70 +316,62 @@ HYPSLsmear4D_expensive( struct site *__restrict lat ,
     #ifdef TOP_VALUE
     double qtop_new , qtop_old = 0.0 ;
     #endif
+    // which buffer each slice's levels are in, the same on every thread
+    struct s_site *m1[ T ] , *m2[ T ] ;
     size_t count = 0 ; 
     for( count = 1 ; count <= smiters && top_found != GLU_TRUE ; count++ ) {
 
       {
          #pragma omp barrier
       }
-      
-      size_t i ;
-      get_lv1( lev1 , lat , type , project ) ; 
-      get_lv2( lev2 , lev1 , lat , type , project ) ;
-      const size_t bck = lat[0].back[ ND - 1 ] ; 
-      #pragma omp for private(i) SCHED
-      for( i = 0 ; i < LCU ; i++ ) {
-	const size_t back = bck + i ;
-	size_t mu ;
-	GLU_complex stap[ NCNC ] GLUalign ;
-	for( mu = 0 ; mu < ND ; mu++ ) {
-	  zero_mat( stap ) ;
-	  gen_staples_4D( stap , lev2 , lat , back , mu , type ) ; 
-	  project( lat4[i].O[mu] , stap , lat[back].O[mu] , alpha1 , 
-		   one_min_a1 ) ; 
-	}
-      }
+
+      // slices 0 and T-1 are overwritten before the last slices are
+      // smeared so everything that needs them unsmeared is done first
+      m1[ 0 ] = lev1 ; 
+      m1[ 1 ] = lev1 + LCU ; 
+      m1[ T-2 ] = lev1 + 2*LCU ; 
+      m1[ T-1 ] = lev1 + 3*LCU ;
+      m2[ T-1 ] = lev2 + 3*LCU ;
+      m2[ 0 ] = lev2 + 4*LCU ;
+      get_lv1( m1[ T-2 ] , lat , T-2 , type , project ) ;
+      get_lv1( m1[ T-1 ] , lat , T-1 , type , project ) ;
+      get_lv1( m1[ 0 ] , lat , 0 , type , project ) ;
+      get_lv1( m1[ 1 ] , lat , 1 , type , project ) ;
+      get_lv2( m2[ T-1 ] , m1 , lat , T-1 , type , project ) ;
+      get_lv2( m2[ 0 ] , m1 , lat , 0 , type , project ) ;
+
       ///////////////////
       //loop time slices
       ///////////////////
-      size_t t ;
-      for( t = 0 ; t < Latt.dims[ ND - 1 ] - 1 ; t++ ) {
+      size_t t , i ;
+      for( t = 0 ; t < T ; t++ ) {
+	// slide the window on, the levels of slice t+1 only need links
+	// up to slice t+3 which are still unsmeared
+	if( t + 1 < T - 1 ) {
+	  if( t + 2 < T - 1 ) {
+	    m1[ t+2 ] = lev1 + ( ( t + 2 ) % 3 ) * LCU ;
+	    get_lv1( m1[ t+2 ] , lat , t+2 , type , project ) ;
+	  }
+	  m2[ t+1 ] = lev2 + ( ( t + 1 ) % 3 ) * LCU ;
+	  get_lv2( m2[ t+1 ] , m1 , lat , t+1 , type , project ) ;
+	}
+	// smear slice t in place, nothing left to do needs it
 	const size_t slice = LCU * t ; 
-	const size_t bck = lat[ slice ].back[ ND - 1 ] ;
         #pragma omp for private(i) SCHED
 	for( i = 0 ; i < LCU ; i++ )  {
 	  const size_t it = slice + i ; 
 	  GLU_complex stap[ NCNC ] GLUalign ;
+	  GLU_complex smeared[ ND ][ NCNC ] GLUalign ;
 	  size_t mu ;
 	  for( mu = 0 ; mu < ND ; mu++ ) {
 	    zero_mat( stap ) ;
-	    gen_staples_4D( stap , lev2 , lat , it , mu , type ) ; 
-	    project( lat2[i].O[mu] , stap , lat[it].O[mu] , alpha1 , 
+	    gen_staples_4D( stap , m2 , lat , it , t , mu , type ) ; 
+	    project( smeared[ mu ] , stap , lat[it].O[mu] , alpha1 , 
 		     one_min_a1 ) ; 
 	  }
-	  // this is only a legal maneuver for this method
-	  //put temp into the previous time-slice
-	  register const size_t back = bck + i ;
 	  for( mu = 0 ; mu < ND ; mu++ ) {
-	    if( t != 0 ) { 
-	      equiv( lat[back].O[mu] , lat3[i].O[mu] ) ;
-	    }
-	    equiv( lat3[i].O[mu] , lat2[i].O[mu] ) ;
+	    equiv( lat[it].O[mu] , smeared[ mu ] ) ;
 	  }
-	  //
-	}
-      }
-      //put last and last but one time slice in
-      ////////////////////////////////////////////
-      const size_t slice = LCU * t ;
-      const size_t behind = lat[ slice ].back[ ND - 1 ] ;
-      #pragma omp for private(i) 
-      for( i = 0 ; i < LCU ; i++ ) {
-	register const size_t back = behind + i , it = slice + i ;
-	register size_t mu ;
-	for( mu = 0 ; mu < ND ; mu++ ) {
-	  equiv( lat[back].O[mu] , lat3[i].O[mu] ) ;
-	  equiv( lat[it].O[mu]   , lat4[i].O[mu] ) ;
 	}
       }
 
@@ -380,13 +408,9 @@ HYPSLsmear4D_expensive( struct site *__restrict lat ,
   }
   
   // free that memory //
-  free_s_site( lat2 , LCU , ND , NCNC ) ;
-  free_s_site( lat3 , LCU , ND , NCNC ) ;
-  free_s_site( lat4 , LCU , ND , NCNC ) ;
-  free_s_site( lev1 , LVOLUME , ND*(ND-1) , NCNC ) ;
-  free_s_site( lev2 , LVOLUME , ND*(ND-1) , NCNC ) ;
+  free_s_site( lev1 , 4*LCU , ND*(ND-1) , NCNC ) ;
+  free_s_site( lev2 , 5*LCU , ND*(ND-1) , NCNC ) ;
 
   return FLAG ;
 #endif
 }
-
@@ -60,9 +60,9 @@ get_spatial_lv1( struct s_site *__restrict lev1 ,
 	if( nu == mu ) continue ;
 	// b is our staple
 	// j is our staple counter	    
-	size_t temp = lat[i].neighbor[nu] ; 
+	size_t temp = site_fwd( i , nu ) ; 
 	multab_suNC( a , lat[i].O[nu] , lat[temp].O[mu] ) ; 
-	temp = lat[i].neighbor[mu] ; 
+	temp = site_fwd( i , mu ) ; 
 	multab_dag_suNC( b , a , lat[temp].O[nu] ) ; 
 	if( type == SM_LOG ) {
 	  multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
@@ -70,9 +70,9 @@ get_spatial_lv1( struct s_site *__restrict lev1 ,
 	}
 	// put the bottom staple in "c"
 	//bottom staple
-	temp = lat[i].back[nu] ; 
+	temp = site_bck( i , nu ) ; 
 	multabdag_suNC( a , lat[temp].O[nu] , lat[temp].O[mu] ) ; 
-	temp = lat[temp].neighbor[mu] ; 
+	temp = site_fwd( temp , mu ) ; 
 	multab_suNC( c , a , lat[temp].O[nu] ) ; 
 	if( type == SM_LOG ) {
 	  multab_dag_suNC( a , c , lat[i].O[mu] ) ; 
@@ -117,9 +117,9 @@ staples3D( GLU_complex stap[ NCNC ] ,
     size_t kk = ( ND - 2 ) * nu + rho ; 
     if( rho > nu  ) { kk-- ; }
     //kk , jj , kk are the correct steps for the staples
-    size_t temp = lat[i].neighbor[nu] ; 
+    size_t temp = site_fwd( i , nu ) ; 
     multab_suNC( a , lev1[i].O[kk] , lev1[temp].O[jj] ) ; 
-    temp = lat[i].neighbor[mu] ; 
+    temp = site_fwd( i , mu ) ; 
     multab_dag_suNC( b , a , lev1[temp].O[kk] ) ; 
     if( type == SM_LOG ) {
       multab_dag_suNC( a , b , lat[it].O[mu] ) ; 
@@ -127,9 +127,9 @@ staples3D( GLU_complex stap[ NCNC ] ,
     }
     a_plus_b( stap , b ) ;
     //bottom staple
-    temp = lat[i].back[nu] ; 
+    temp = site_bck( i , nu ) ; 
     multabdag_suNC( a , lev1[temp].O[kk] , lev1[temp].O[jj] ) ;
-    temp = lat[temp].neighbor[mu] ; 
+    temp = site_fwd( temp , mu ) ; 
     multab_suNC( b , a , lev1[temp].O[kk] ) ; 
     if( type == SM_LOG ) {
       multab_dag_suNC( a , b , lat[it].O[mu] ) ; 
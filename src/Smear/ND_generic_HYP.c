@@ -99,9 +99,9 @@ recurse_staples( GLU_complex *__restrict link ,
     for( jj = 0 ; jj < MAXDIR ; jj++ ) {
       if( is_orthogonal( jj , MAXDIR-lev , list_dirs ) == ORTHOGONAL ) { 
 	//jj is our orthogonal direction
-	size_t temp = lat[i].neighbor[jj] ; 
+	size_t temp = site_fwd( i , jj ) ; 
 	multab_suNC( a , lat[i].O[jj] , lat[temp].O[rho] ) ; 
-	temp = lat[i].neighbor[rho] ; 
+	temp = site_fwd( i , rho ) ; 
 	multab_dag_suNC( b , a , lat[temp].O[jj] ) ; 
 
 	if( type == SM_LOG ) {
@@ -111,9 +111,9 @@ recurse_staples( GLU_complex *__restrict link ,
 	a_plus_b( stap , b ) ; 
       
 	//bottom staple
-	temp = lat[i].back[jj] ; 
+	temp = site_bck( i , jj ) ; 
 	multabdag_suNC( a , lat[temp].O[jj] , lat[temp].O[rho] ) ; 
-	temp = lat[temp].neighbor[rho] ; 
+	temp = site_fwd( temp , rho ) ; 
 	multab_suNC( b , a , lat[temp].O[jj] ) ; 
 
 	if( type == SM_LOG ) {
@@ -143,13 +143,13 @@ recurse_staples( GLU_complex *__restrict link ,
 	orthogonal_dirs[nu] = rho ; 
 	new_list_dirs[nu] = jj ;
 
-	size_t dir = lat[i].neighbor[jj] ; 
+	size_t dir = site_fwd( i , jj ) ; 
 	// first element of the staple is in the jj - rho direction
 	recurse_staples( temp , lat , i , lev-1 , MAXDIR , new_list_dirs , type , project ) ; 
 	recurse_staples( temp2 , lat , dir , lev-1 , MAXDIR , orthogonal_dirs , type , project ) ; 
 	multab_suNC( a , temp , temp2 ) ; 
 
-	dir = lat[i].neighbor[rho] ;
+	dir = site_fwd( i , rho ) ;
 	recurse_staples( temp , lat , dir , lev-1 , MAXDIR ,new_list_dirs , type , project ) ; 
 	multab_dag_suNC( b , a , temp ) ; 
 
@@ -160,12 +160,12 @@ recurse_staples( GLU_complex *__restrict link ,
 	a_plus_b( stap , b ) ; 
 	// end of top staple ...
 
-	dir = lat[i].back[jj] ; 
+	dir = site_bck( i , jj ) ; 
 	recurse_staples( temp , lat , dir , lev-1 , MAXDIR , new_list_dirs , type , project ) ; 
 	recurse_staples( temp2 , lat , dir , lev-1 , MAXDIR , orthogonal_dirs , type , project ) ;
 	multabdag_suNC( a , temp , temp2 ) ; 
 
-	dir = lat[dir].neighbor[rho] ; 
+	dir = site_fwd( dir , rho ) ; 
 	recurse_staples( temp , lat , dir , lev-1 , MAXDIR , new_list_dirs , type , project ) ;
 	multab_suNC( b , a , temp ) ; 
 
@@ -247,7 +247,7 @@ HYsmearND( struct site *__restrict lat ,
     size_t i , t ;
     GLU_bool found_top = GLU_FALSE ;
     for( count = 1 ; count <= smiters && found_top != GLU_TRUE ; count++ ) {
-      const size_t back = lat[ 0 ].back[ ND - 1 ] ;
+      const size_t back = site_bck( 0 , ND - 1 ) ;
       #pragma omp for private(i)
       for( i = 0 ; i < LCU ; i++ ) {
 	const size_t bck = back + i ;
@@ -274,7 +274,7 @@ HYsmearND( struct site *__restrict lat ,
 	}
       }
 	  
-      const size_t bck = lat[slice].back[ ND - 1 ] ;
+      const size_t bck = site_bck( slice , ND - 1 ) ;
       #pragma omp for private(i)
       for( i = 0 ; i < LCU ; i++ ) {
 	size_t mu ;
@@ -294,7 +294,7 @@ HYsmearND( struct site *__restrict lat ,
     //put last and last but one time slice in
     ////////////////////////////////////////////
     const size_t slice = LCU * t ;    
-    const size_t behind = lat[ slice ].back[ ND - 1 ] ;
+    const size_t behind = site_bck( slice , ND - 1 ) ;
     #pragma omp for private(i) 
     for( i = 0 ; i < LCU ; i++ ) {
       register size_t mu ;
@@ -22,9 +22,13 @@
 
    Slows down, performing fine measurements at ~t_0 and ~w_0
    W0_STOP and T0_STOP are defined in wflowfuncs.h
+
+   The embedded version takes the error from a second order solution
+   built out of the first two RK3 stages rather than stepping twice
  */
 #include "Mainfile.h"
 
+#include "GLU_malloc.h"   // allocate_s_site()
 #include "init.h"         // init_navig is called for the temporary
 #include "plaqs_links.h"  // av_plaquette()
 #include "projectors.h"   // smearing projections
@@ -68,6 +72,12 @@ static const double ADAPTIVE_EPS = 1E-6 ;
 // define adaptive safe
 #define ADAPTIVE_SAFE (0.9)
 
+// largest t^2 weighted link distance allowed between the embedded pair
+static const double EMBEDDED_EPS = 3E-4 ;
+// the estimate is the local error of the second order solution ~ dt^3
+#define EMBEDDED_SHRINK (-0.5)
+#define EMBEDDED_GROWTH (-0.33333333333333333333)
+
 // two step adaptive routine
 static int
 twostep_adaptive( struct site *lat ,
@@ -172,29 +182,99 @@ twostep_adaptive( struct site *lat ,
   return GLU_SUCCESS ;
 }
 
-// Adaptive stepsize version 
-int 
-flow_adaptive_RK3( struct site *__restrict lat , 
-		   const size_t smiters ,
-		   const int SIGN ,
-		   const smearing_types SM_TYPE )
+// embedded adaptive routine, lat is flowed in place and lat_two keeps
+// the starting links in case we have to reject the step
+static int
+embedded_adaptive( struct site *lat ,
+		   struct wflow_temps WF ,
+		   double *dt ,
+		   double *errmax ,
+		   const double t ,
+		   const smearing_types SM_TYPE  , 
+		   void (*project)( GLU_complex log[ NCNC ] , 
+				    GLU_complex *__restrict staple , 
+				    const GLU_complex link[ NCNC ] , 
+				    const double smear_alpha )  )
+{
+  size_t counter = 0 , i ;
+
+#pragma omp for private(i)
+  for( i = 0 ; i < LVOLUME ; i++ ) {
+    register size_t mu ;
+    for( mu = 0 ; mu < ND ; mu++ ) {
+      equiv( WF.lat_two[i].O[mu] , lat[i].O[mu] ) ;
+    }
+  }
+
+  // adaptive loop, shrinking the stepsize until the pair agree
+ top :
+  
+  {
+    #pragma omp barrier
+  }
+
+  // weighted by t^2 like the two step version, early errors get smoothed away
+  *errmax = step_distance_embedded( lat , WF , *dt , SM_TYPE , project ) ;
+  *errmax *= ( t + *dt ) * ( t + *dt ) / EMBEDDED_EPS ;
+
+  if( *errmax > 1.0 && counter < ADAPTIVE_BIG_NUMBER ) {
+    // reject, put the links back
+    #pragma omp for private(i)
+    for( i = 0 ; i < LVOLUME ; i++ ) {
+      register size_t mu ;
+      for( mu = 0 ; mu < ND ; mu++ ) {
+	equiv( lat[i].O[mu] , WF.lat_two[i].O[mu] ) ;
+      }
+    }
+    const double del_temp = ADAPTIVE_SAFE * (*dt) * pow( *errmax , EMBEDDED_SHRINK ) ; 
+    const double tol = 0.1 * ( *dt );
+    
+    *dt = ( 0. < del_temp ?				\
+	    adaptfmax( del_temp , tol ) :		\
+	    adaptfmin( del_temp , tol ) ) ;
+
+    counter ++ ;
+      
+    goto top ;
+  }
+
+  if( counter >= ADAPTIVE_BIG_NUMBER ) return GLU_FAILURE ;
+
+  return GLU_SUCCESS ;
+}
+
+// Adaptive stepsize driver, either step doubling or the embedded pair
+static int 
+flow_adaptive( struct site *__restrict lat , 
+	       const size_t smiters ,
+	       const int SIGN ,
+	       const smearing_types SM_TYPE ,
+	       const GLU_bool embedded )
 {  
   ////// USUAL STARTUP INFORMATION /////////
   print_GG_info( ) ;
 
+  // error tolerance and step size controls
+  const double eps    = embedded ? EMBEDDED_EPS : ADAPTIVE_EPS ;
+  const double shrink = embedded ? EMBEDDED_SHRINK : ADAPTIVE_SHRINK ;
+  const double growth = embedded ? EMBEDDED_GROWTH : ADAPTIVE_GROWTH ;
+
   // adaptive error conserving
-  const double ADAPTIVE_ERRCON = powl( 5./ADAPTIVE_SAFE , 1./ADAPTIVE_GROWTH ) ;
+  const double ADAPTIVE_ERRCON = powl( 5./ADAPTIVE_SAFE , 1./growth ) ;
   // percentage to value we want for performing fine measurements
   const double FINETWIDDLE = 0.08 ;
   // fine measurement step
   const double FINESTEP = 0.02 ;
 
   // adaptive factors for RK4, we are RK3 could be more lenient?
-  fprintf( stdout , "[WFLOW] Adaptive Error :: %e \n" , ADAPTIVE_EPS ) ;
+  if( embedded == GLU_TRUE ) {
+    fprintf( stdout , "[WFLOW] Embedded RK3(2) error estimate\n" ) ;
+  }
+  fprintf( stdout , "[WFLOW] Adaptive Error :: %e \n" , eps ) ;
   fprintf( stdout , "[WFLOW] Adaptive ErrCon :: %f \n" , ADAPTIVE_ERRCON ) ;
   fprintf( stdout , "[WFLOW] Safety Factor :: %g \n" , ADAPTIVE_SAFE ) ;
-  fprintf( stdout , "[WFLOW] Growth factor :: %g \n" , ADAPTIVE_GROWTH ) ;
-  fprintf( stdout , "[WFLOW] Shrink factor :: %g \n\n" , ADAPTIVE_SHRINK ) ; 
+  fprintf( stdout , "[WFLOW] Growth factor :: %g \n" , growth ) ;
+  fprintf( stdout , "[WFLOW] Shrink factor :: %g \n\n" , shrink ) ; 
   fprintf( stdout , "[WFLOW] Fine measurement %% :: %g \n" , FINETWIDDLE ) ;
   fprintf( stdout , "[WFLOW] Fine step :: %g \n\n" , FINESTEP ) ;
 
@@ -218,28 +298,37 @@ flow_adaptive_RK3( struct site *__restrict lat ,
   
   // allocate temps
   struct wflow_temps WF ;
+  int FLAG = GLU_FAILURE ;
   if( allocate_WF( &WF , GLU_TRUE , GLU_TRUE ) == GLU_FAILURE ) {
     goto memfree ;
   }
+  if( embedded == GLU_TRUE ) {
+    if( ( WF.Zfirst = allocate_s_site( LVOLUME , ND , TRUE_HERM ) ) == NULL ) {
+      fprintf( stderr , "[WFLOW] embedded allocation failure \n" ) ;
+      goto memfree ;
+    }
+  }
 
+  // seeds the scale of the two-step error, which is a difference of nearly
+  // equal plaquettes, so it keeps the summation order of av_plaquette()
   const double inplaq = av_plaquette( lat ) ;
-  int FLAG = GLU_SUCCESS ;
+  FLAG = GLU_SUCCESS ;
   
 #pragma omp parallel
   {
     struct wfmeas *head = NULL , *curr ;
 
-    double new_plaq = inplaq ;
+    double new_plaq = 0.0 ;
     double t = 0.0 ;
     size_t i ;
     double delta_t = SIGN * Latt.sm_alpha[0] ;
 
     curr = (struct wfmeas*)malloc( sizeof( struct wfmeas ) ) ;
     update_meas_list( head , curr , WF.red ,
-		      new_plaq , t , delta_t , 0.0 , lat ) ;
+		      t , delta_t , 0.0 , lat ) ;
     head = curr ;
     double flow = 0.0 , flow_next = curr -> Gt ;
-    double yscal = curr -> avplaq , wapprox = 0.0 ;
+    double yscal = inplaq , wapprox = 0.0 ;
     double errmax = 10. ;
     size_t count = 0 , meas_count = 0 ;
     
@@ -252,23 +341,32 @@ flow_adaptive_RK3( struct site *__restrict lat ,
     
     errmax = 10. ;
     
-    // perform two-step adaptive
-    if( twostep_adaptive( lat , WF , &delta_t , &errmax , &new_plaq ,
-			  t , yscal , SM_TYPE , project ) == GLU_FAILURE ) {
-      FLAG = GLU_FAILURE ;
-      count = smiters ;
-    }
+    if( embedded == GLU_TRUE ) {
+      // the embedded step leaves the flowed links in lat
+      if( embedded_adaptive( lat , WF , &delta_t , &errmax ,
+			     t , SM_TYPE , project ) == GLU_FAILURE ) {
+	FLAG = GLU_FAILURE ;
+	count = smiters ;
+      }
+    } else {
+      // perform two-step adaptive
+      if( twostep_adaptive( lat , WF , &delta_t , &errmax , &new_plaq ,
+			    t , yscal , SM_TYPE , project ) == GLU_FAILURE ) {
+	FLAG = GLU_FAILURE ;
+	count = smiters ;
+      }
     
-    // set up a scaling parameter to control the adaptation uses a first order finite difference def ...
-    const double yscal_new = new_plaq ;
-    yscal = 2.0 * yscal_new - yscal ;
+      // set up a scaling parameter to control the adaptation uses a first order finite difference def ...
+      const double yscal_new = new_plaq ;
+      yscal = 2.0 * yscal_new - yscal ;
     
-    // overwrite lat .. 
-    #pragma omp for private(i)
-    for( i = 0 ; i < LVOLUME ; i++ ) {
-      size_t mu ;
-      for( mu = 0 ; mu < ND ; mu++ ) {
-	equiv( lat[i].O[mu] , WF.lat_two[i].O[mu] ) ;
+      // overwrite lat .. 
+      #pragma omp for private(i)
+      for( i = 0 ; i < LVOLUME ; i++ ) {
+	size_t mu ;
+	for( mu = 0 ; mu < ND ; mu++ ) {
+	  equiv( lat[i].O[mu] , WF.lat_two[i].O[mu] ) ;
+	}
       }
     }
 
@@ -287,8 +385,8 @@ flow_adaptive_RK3( struct site *__restrict lat ,
     if( t > WFLOW_MEAS_START ) {
       curr = (struct wfmeas*)malloc( sizeof( struct wfmeas ) ) ;
       update_meas_list( head , curr , WF.red ,
-			new_plaq , t , delta_t ,
-			errmax*ADAPTIVE_EPS , lat ) ;
+			t , delta_t ,
+			errmax*eps , lat ) ;
       flow_next = curr -> Gt ;
       head = curr ;
       #ifndef WFLOW_TIME_ONLY
@@ -312,8 +410,8 @@ flow_adaptive_RK3( struct site *__restrict lat ,
 
       curr = (struct wfmeas*)malloc( sizeof( struct wfmeas ) ) ;
       update_meas_list( head , curr , WF.red ,
-			new_plaq , t = t+delta_t , delta_t ,
-			errmax*ADAPTIVE_EPS , lat ) ;
+			t = t+delta_t , delta_t ,
+			errmax*eps , lat ) ;
 
       flow_next = curr -> Gt ;
       wapprox = ( flow_next - flow ) * curr -> time / delta_t ;
@@ -337,8 +435,8 @@ flow_adaptive_RK3( struct site *__restrict lat ,
 
       curr = (struct wfmeas*)malloc( sizeof( struct wfmeas ) ) ;
       update_meas_list( head , curr , WF.red ,
-			new_plaq , t += delta_t , delta_t ,
-			errmax*ADAPTIVE_EPS , lat ) ;
+			t += delta_t , delta_t ,
+			errmax*eps , lat ) ;
       flow_next = curr -> Gt ;
       wapprox = ( flow_next - flow ) * curr -> time / delta_t ;
       flow = flow_next ;
@@ -352,7 +450,7 @@ flow_adaptive_RK3( struct site *__restrict lat ,
     
     // Increase the step size ...
     if( errmax > ADAPTIVE_ERRCON ) {
-      delta_t = ADAPTIVE_SAFE * delta_t * pow( errmax , ADAPTIVE_GROWTH ) ;
+      delta_t = ADAPTIVE_SAFE * delta_t * pow( errmax , growth ) ;
     } else {
       delta_t = ADAPTIVE_SAFE * 5.0 * delta_t ;
     }
@@ -373,8 +471,8 @@ flow_adaptive_RK3( struct site *__restrict lat ,
       
       curr = (struct wfmeas*)malloc( sizeof( struct wfmeas ) ) ;
       update_meas_list( head , curr , WF.red ,
-			new_plaq , t += delta_t , delta_t ,
-			errmax*ADAPTIVE_EPS , lat ) ;
+			t += delta_t , delta_t ,
+			errmax*eps , lat ) ;
       count++ ;
       meas_count++ ;
       curr -> next = head ;
@@ -402,7 +500,30 @@ flow_adaptive_RK3( struct site *__restrict lat ,
   
  memfree :
 
+  if( WF.Zfirst != NULL ) {
+    free_s_site( WF.Zfirst , LVOLUME , ND , TRUE_HERM ) ;
+  }
   free_WF( &WF , GLU_TRUE , GLU_TRUE ) ;
 
   return FLAG ;
 }
+
+// Adaptive stepsize version 
+int 
+flow_adaptive_RK3( struct site *__restrict lat , 
+		   const size_t smiters ,
+		   const int SIGN ,
+		   const smearing_types SM_TYPE )
+{
+  return flow_adaptive( lat , smiters , SIGN , SM_TYPE , GLU_FALSE ) ;
+}
+
+// Adaptive stepsize version with the embedded error estimate
+int 
+flow_adaptive_embedded( struct site *__restrict lat , 
+			const size_t smiters ,
+			const int SIGN ,
+			const smearing_types SM_TYPE )
+{
+  return flow_adaptive( lat , smiters , SIGN , SM_TYPE , GLU_TRUE ) ;
+}
@@ -34,12 +34,14 @@ print_smearing_obs( const struct site *__restrict lat ,
 {
   #pragma omp master
   {
+    // links and plaquettes in a single sweep
+    struct gauge_obs obs ;
+    gauge_obs( &obs , lat , GLU_FALSE ) ;
     fprintf( stdout , "[SMEAR] {Iteration} %zu {Link trace} %1.15f \n" , 
-	     count , links( lat ) ) ; 
-    // print out the info ::
-    double splaq , tplaq , plaq = all_plaquettes( lat , &splaq , &tplaq ) ;
+	     count , obs.link ) ; 
     fprintf( stdout , "[SMEAR] {Plaquette} %1.15f {Spatial} %1.15f "
-	     "{Temporal} %1.15f \n\n" , plaq , splaq , tplaq ) ; 
+	     "{Temporal} %1.15f \n\n" , 0.5 * ( obs.splaq + obs.tplaq ) ,
+	     obs.splaq , obs.tplaq ) ;
   }
   return ;
 }
@@ -111,19 +111,23 @@ smear3D( struct site *__restrict lat ,
       for( t = 0 ; t < Latt.dims[ ND -1 ] ; t++ ) {
 	const size_t slice = LCU * t ;
         #pragma omp for private(i)
-	for( i = 0 ; i < LCU ; i++ ) {
-	  const size_t it = slice + i ; 
-	  size_t mu ;
+	for( i = 0 ; i < LCU ; i += STAPLE_LANES ) {
+	  // a batch of STAPLE_LANES sites of the slice at a time
+	  const size_t n = ( LCU - i ) < STAPLE_LANES ? ( LCU - i ) : STAPLE_LANES ;
+	  size_t site[ STAPLE_LANES ] , mu , l ;
+	  for( l = 0 ; l < n ; l++ ) {
+	    site[ l ] = slice + i + l ;
+	  }
 	  for( mu = 0 ; mu < ND - 1 ; mu++ ) {
-	    GLU_complex stap[ NCNC ] GLUalign ;
-	    zero_mat( stap ) ;
-            #ifdef IMPROVED_SMEARING
-	    all_staples_improve( stap , lat , it , mu , ND - 1 , type ) ; 
-            #else
-	    all_staples( stap , lat , it , mu , ND - 1 , type ) ; 
-            #endif
-	    project( lat2[ i ].O[ mu ] , stap , lat[ it ].O[ mu ] , alpha1 , 
-		     one_min_a1 ) ;
+	    GLU_complex stap[ STAPLE_LANES ][ NCNC ] GLUalign ;
+	    for( l = 0 ; l < n ; l++ ) {
+	      zero_mat( stap[ l ] ) ;
+	    }
+	    all_staples_lanes( stap , lat , site , n , mu , ND - 1 , type ) ;
+	    for( l = 0 ; l < n ; l++ ) {
+	      project( lat2[ i + l ].O[ mu ] , stap[ l ] , 
+		       lat[ site[ l ] ].O[ mu ] , alpha1 , one_min_a1 ) ;
+	    }
 	  }
 	}
         #pragma omp for private(i) 
@@ -256,30 +260,34 @@ smear4D( struct site *__restrict lat ,
 
       //this bit initialises the calculation by working out the staples for the last time slice first
       #ifdef IMPROVED_SMEARING
-      const size_t back = lat[ lat[0].back[ ND-1 ] ].back[ ND-1 ] ;
+      const size_t back = site_bck( site_bck( 0 , ND-1 ) , ND-1 ) ;
       #else
-      const size_t back = lat[ 0 ].back[ ND - 1 ] ;
+      const size_t back = site_bck( 0 , ND - 1 ) ;
       #endif
 
       size_t i , t ;
       #pragma omp for private(i) SCHED
       #ifdef IMPROVED_SMEARING
-      for( i = 0 ; i < 2*LCU ; i++ ) {
+      for( i = 0 ; i < 2*LCU ; i += STAPLE_LANES ) {
+	const size_t n = ( 2*LCU - i ) < STAPLE_LANES ? ( 2*LCU - i ) : STAPLE_LANES ;
       #else
-      for( i = 0 ; i < LCU ; i++ ) {
+      for( i = 0 ; i < LCU ; i += STAPLE_LANES ) {
+	const size_t n = ( LCU - i ) < STAPLE_LANES ? ( LCU - i ) : STAPLE_LANES ;
       #endif
-	const size_t bck = back + i ;
-	register size_t mu ;
+	size_t site[ STAPLE_LANES ] , mu , l ;
+	for( l = 0 ; l < n ; l++ ) {
+	  site[ l ] = back + i + l ;
+	}
 	for( mu = 0 ; mu < ND ; mu++ ) { 
-	  GLU_complex stap[ NCNC ] GLUalign ;
-	  zero_mat( stap ) ;
-          #ifdef IMPROVED_SMEARING
-	  all_staples_improve( stap , lat , bck , mu , ND , type ) ;
-          #else
-	  all_staples( stap , lat , bck , mu , ND , type ) ;
-          #endif
-	  project( lat4[ i ].O[ mu ] , stap , lat[ bck ].O[ mu ] , alpha1 ,
-		   one_min_a1 ) ; 
+	  GLU_complex stap[ STAPLE_LANES ][ NCNC ] GLUalign ;
+	  for( l = 0 ; l < n ; l++ ) {
+	    zero_mat( stap[ l ] ) ;
+	  }
+	  all_staples_lanes( stap , lat , site , n , mu , ND , type ) ;
+	  for( l = 0 ; l < n ; l++ ) {
+	    project( lat4[ i + l ].O[ mu ] , stap[ l ] , 
+		     lat[ site[ l ] ].O[ mu ] , alpha1 , one_min_a1 ) ; 
+	  }
 	}
       }
       #ifdef IMPROVED_SMEARING
@@ -289,26 +297,29 @@ smear4D( struct site *__restrict lat ,
       #endif
 	const size_t slice = LCU * t ; 
         #pragma omp for private(i) SCHED
-	for( i = 0 ; i < LCU ; i++ ) {
-	  const size_t it = slice + i ;
-	  size_t mu ;
+	for( i = 0 ; i < LCU ; i += STAPLE_LANES ) {
+	  const size_t n = ( LCU - i ) < STAPLE_LANES ? ( LCU - i ) : STAPLE_LANES ;
+	  size_t site[ STAPLE_LANES ] , mu , l ;
+	  for( l = 0 ; l < n ; l++ ) {
+	    site[ l ] = slice + i + l ;
+	  }
 	  for( mu = 0 ; mu < ND ; mu++ ) {
-	    GLU_complex stap[ NCNC ] ;
-	    zero_mat( stap ) ;
-            #ifdef IMPROVED_SMEARING
-	    all_staples_improve( stap , lat , it , mu , ND , type ) ;
-            #else
-	    all_staples( stap , lat , it , mu , ND , type ) ;
-            #endif
-	    project( lat2[ i ].O[ mu ] , stap , lat[ it ].O[ mu ] , alpha1 ,
-		     one_min_a1 ) ; 
+	    GLU_complex stap[ STAPLE_LANES ][ NCNC ] GLUalign ;
+	    for( l = 0 ; l < n ; l++ ) {
+	      zero_mat( stap[ l ] ) ;
+	    }
+	    all_staples_lanes( stap , lat , site , n , mu , ND , type ) ;
+	    for( l = 0 ; l < n ; l++ ) {
+	      project( lat2[ i + l ].O[ mu ] , stap[ l ] , 
+		       lat[ site[ l ] ].O[ mu ] , alpha1 , one_min_a1 ) ; 
+	    }
 	  }
 	}
 
         #ifdef IMPROVED_SMEARING
-	const size_t bck = lat[ lat[ slice ].back[ ND-1 ] ].back[ ND-1 ] ;
+	const size_t bck = site_bck( site_bck( slice , ND-1 ) , ND-1 ) ;
         #else
-	const size_t bck = lat[ slice ].back[ ND -1 ] ;
+	const size_t bck = site_bck( slice , ND -1 ) ;
         #endif
 
         #pragma omp for private(i)
@@ -335,9 +346,9 @@ smear4D( struct site *__restrict lat ,
  
       // put the last couple back in ....
       const size_t slice = LCU * t ;
-      const size_t behind = lat[ slice ].back[ ND - 1 ] ;
+      const size_t behind = site_bck( slice , ND - 1 ) ;
       #ifdef IMPROVED_SMEARING
-      const size_t behind2 = lat[ behind ].back[ ND-1 ] ;
+      const size_t behind2 = site_bck( behind , ND-1 ) ;
       #endif
 
       #pragma omp parallel for private(i)
@@ -22,6 +22,8 @@
  */
 #include "Mainfile.h"
 
+#include "lanes.h"
+
 // staple routine the positive \nu one goes like
 //
 //         --->---
@@ -43,10 +45,10 @@ all_staples( GLU_complex stap[ NCNC ] ,
     for( j = 0 ; j < dir-1 ; j++ ) {
       nu = j < mu ? j : j + 1 ;
       // directions
-      t1 = lat[ i ].neighbor[nu] ; 
-      t2 = lat[ i ].neighbor[mu] ; 
-      b1 = lat[ i ].back[nu] ; 
-      b2 = lat[ b1 ].neighbor[mu] ; 
+      t1 = site_fwd( i , nu ) ; 
+      t2 = site_fwd( i , mu ) ; 
+      b1 = site_bck( i , nu ) ; 
+      b2 = site_fwd( b1 , mu ) ; 
       // top staple
       multab_suNC( a , lat[ i ].O[nu] , lat[ t1 ].O[mu] ) ; 
       multab_dag_suNC( b , a , lat[ t2 ].O[nu] ) ; 
@@ -64,10 +66,10 @@ all_staples( GLU_complex stap[ NCNC ] ,
     for( j = 0 ; j < dir-1 ; j++ ) {
       nu = j < mu ? j : j + 1 ;
       // directions
-      t1 = lat[ i ].neighbor[nu] ; 
-      t2 = lat[ i ].neighbor[mu] ; 
-      b1 = lat[ i ].back[nu] ; 
-      b2 = lat[ b1 ].neighbor[mu] ; 
+      t1 = site_fwd( i , nu ) ; 
+      t2 = site_fwd( i , mu ) ; 
+      b1 = site_bck( i , nu ) ; 
+      b2 = site_fwd( b1 , mu ) ; 
       // top staple
       multab_suNC( a , lat[ i ].O[nu] , lat[ t1 ].O[mu] ) ; 
       multab_dag_suNC( b , a , lat[ t2 ].O[nu] ) ; 
@@ -81,6 +83,39 @@ all_staples( GLU_complex stap[ NCNC ] ,
   return ;
 }
 
+// STAPLE_LANES sites at a time, the log and improved staples have no
+// batched kernel and fall back to the per-site routines
+void
+all_staples_lanes( GLU_complex stap[ STAPLE_LANES ][ NCNC ] ,
+		   const struct site *__restrict lat ,
+		   const size_t site[ STAPLE_LANES ] ,
+		   const size_t n ,
+		   const size_t mu ,
+		   const size_t dir ,
+		   const smearing_types type )
+{
+  size_t l ;
+#ifdef IMPROVED_SMEARING
+  for( l = 0 ; l < n ; l++ ) {
+    all_staples_improve( stap[l] , lat , site[l] , mu , dir , type ) ;
+  }
+#else
+  if( type == SM_LOG ) {
+    for( l = 0 ; l < n ; l++ ) {
+      all_staples( stap[l] , lat , site[l] , mu , dir , type ) ;
+    }
+    return ;
+  }
+  // pad a short batch with the first site
+  size_t pad[ STAPLE_LANES ] ;
+  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+    pad[l] = l < n ? site[l] : site[0] ;
+  }
+  staples_lanes( stap , lat , pad , n , mu , dir ) ;
+#endif
+  return ;
+}
+
 // (OVER)IMPROVED STAPLES ROUTINE
 #ifdef IMPROVED_SMEARING
 
@@ -108,9 +143,9 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
   for( nu = 0 ; nu < dir ; nu++ ) {
     if( nu == mu ) continue ;
     //top staple
-    register const size_t t1 = lat[i].neighbor[nu] ; 
+    register const size_t t1 = site_fwd( i , nu ) ; 
     multab_suNC( a , lat[i].O[nu] , lat[ t1 ].O[mu] ) ; 
-    register const size_t t2 = lat[i].neighbor[mu] ; 
+    register const size_t t2 = site_fwd( i , mu ) ; 
     multab_dag_suNC( b , a , lat[ t2 ].O[nu] ) ; 
     if( type == SM_LOG ) {
       multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
@@ -119,9 +154,9 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
     a_plus_b( c0_stap , b ) ;
     
     //bottom staple
-    const size_t b1 = lat[i].back[nu] ; 
+    const size_t b1 = site_bck( i , nu ) ; 
     multabdag_suNC( a , lat[ b1 ].O[nu] , lat[ b1 ].O[mu] ) ; 
-    const size_t b2 = lat[ b1 ].neighbor[mu] ; 
+    const size_t b2 = site_fwd( b1 , mu ) ; 
     multab_suNC( b , a , lat[ b2 ].O[nu] ) ; 
     if( type == SM_LOG )  {
       multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
@@ -143,13 +178,13 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
     // ^     v          v     ^
     // |     |          |     |
     // x==<==x          x-->--x
-    register const size_t tv1 = lat[ i ].neighbor[nu] ; 
+    register const size_t tv1 = site_fwd( i , nu ) ; 
     multab_suNC( a , lat[ i ].O[nu] , lat[ tv1 ].O[nu] ) ; 
-    register const size_t tv2 = lat[ tv1 ].neighbor[nu] ; 
+    register const size_t tv2 = site_fwd( tv1 , nu ) ; 
     multab_suNC( b , a , lat[ tv2 ].O[mu] ) ; 
     // halfway there ...
-    register const size_t tv3 = lat[ i ].neighbor[ mu ] ; 
-    register const size_t tv4 = lat[ tv3 ].neighbor[ nu ] ; 
+    register const size_t tv3 = site_fwd( i , mu ) ; 
+    register const size_t tv4 = site_fwd( tv3 , nu ) ; 
     multab_dag_suNC( a , b , lat[ tv4 ].O[ nu ] ) ; 
     multab_dag_suNC( b , a , lat[ tv3 ].O[ nu ] ) ; 
     if( type == SM_LOG ) {
@@ -159,13 +194,13 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
     a_plus_b( c1_stap , b ) ;
     
     // include the lower half contributions .....
-    register const size_t bv1 = lat[ i ].back[nu] ; 
-    register const size_t bv2 = lat[ bv1 ].back[nu] ; 
+    register const size_t bv1 = site_bck( i , nu ) ; 
+    register const size_t bv2 = site_bck( bv1 , nu ) ; 
     multab_dagdag_suNC( a , lat[ bv1 ].O[nu] , lat[ bv2 ].O[nu] ) ; 
     multab_suNC( b , a , lat[ bv2 ].O[mu] ) ; 
-    register const size_t bv3 = lat[ bv2 ].neighbor[mu] ; 
+    register const size_t bv3 = site_fwd( bv2 , mu ) ; 
     multab_suNC( a , b , lat[ bv3 ].O[nu] ) ; 
-    register const size_t bv4 = lat[ bv3 ].neighbor[nu] ; 
+    register const size_t bv4 = site_fwd( bv3 , nu ) ; 
     multab_suNC( b , a , lat[ bv4 ].O[nu] ) ; 
     if( type == SM_LOG ) {
       multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
@@ -180,12 +215,12 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
     //  |           |        |           |
     //  x==<==x--<--<        x-->--x-->--x
     // The log is a pain as we usually can eliminate 1 matrix multiply
-    register const size_t tf1 = lat[ i ].neighbor[nu] ; 
+    register const size_t tf1 = site_fwd( i , nu ) ; 
     multab_suNC( a , lat[ i ].O[nu] , lat[ tf1 ].O[mu] ) ; 
-    register const size_t tf2 = lat[ tf1 ].neighbor[mu] ; 
+    register const size_t tf2 = site_fwd( tf1 , mu ) ; 
     multab_suNC( b , a , lat[ tf2 ].O[mu] ) ; 
-    register const size_t tf3 = lat[ i ].neighbor[ mu ] ; 
-    register const size_t tf4 = lat[ tf3 ].neighbor[ mu ] ; 
+    register const size_t tf3 = site_fwd( i , mu ) ; 
+    register const size_t tf4 = site_fwd( tf3 , mu ) ; 
     multab_dag_suNC( a , b , lat[ tf4 ].O[ nu ] ) ; 
     if( type == SM_LOG ) {
       multab_dag_suNC( b , a , lat[ tf3 ].O[ mu ] ) ; 
@@ -197,11 +232,11 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
     }
     
     // bottom rectangle
-    register const size_t bf1 = lat[ i ].back[nu] ; 
+    register const size_t bf1 = site_bck( i , nu ) ; 
     multabdag_suNC( a , lat[ bf1 ].O[nu] , lat[ bf1 ].O[mu] ) ; 
-    register const size_t bf2 = lat[ bf1 ].neighbor[mu] ; 
+    register const size_t bf2 = site_fwd( bf1 , mu ) ; 
     multab_suNC( b , a , lat[ bf2 ].O[mu] ) ; 
-    register const size_t bf3 = lat[ bf2 ].neighbor[mu] ; 
+    register const size_t bf3 = site_fwd( bf2 , mu ) ; 
     multab_suNC( a , b , lat[ bf3 ].O[nu] ) ; 
     if( type == SM_LOG ) {
       multab_dag_suNC( b , a , lat[ tf3 ].O[ mu ] ) ; 
@@ -223,46 +258,46 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
     // this one is split
     if( type == SM_LOG ) {
       // do the top staple
-      register const size_t tb1 = lat[ i ].back[mu] ; 
+      register const size_t tb1 = site_bck( i , mu ) ; 
       multabdag_suNC( a , lat[ tb1 ].O[mu] , lat[ tb1 ].O[nu] ) ; 
-      register const size_t tb2 = lat[ tb1 ].neighbor[nu] ; 
+      register const size_t tb2 = site_fwd( tb1 , nu ) ; 
       multab_suNC( b , a , lat[ tb2 ].O[mu] ) ; 
       // halfway there ...
-      register const size_t tb3 = lat[ tb2 ].neighbor[mu] ; 
+      register const size_t tb3 = site_fwd( tb2 , mu ) ; 
       multab_suNC( a , b , lat[ tb3 ].O[ mu ] ) ; 
-      register const size_t tb4 = lat[ i ].neighbor[ mu ] ; 
+      register const size_t tb4 = site_fwd( i , mu ) ; 
       multab_dag_suNC( b , a , lat[ tb4 ].O[ nu ] ) ; 
       multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
       exact_log_slow( b , a ) ; 
       a_plus_b( c1_stap , b ) ;
       
       // and the bottom staple ...
-      register const size_t bb1 = lat[ i ].back[mu] ; 
-      register const size_t bb2 = lat[ bb1 ].back[nu] ; 
+      register const size_t bb1 = site_bck( i , mu ) ; 
+      register const size_t bb2 = site_bck( bb1 , nu ) ; 
       multab_dagdag_suNC( a , lat[ bb1 ].O[mu] , lat[ bb2 ].O[nu] ) ; 
       multab_suNC( b , a , lat[ bb2 ].O[mu] ) ; 
-      const register size_t bb3 = lat[ bb2 ].neighbor[mu] ; 
+      const register size_t bb3 = site_fwd( bb2 , mu ) ; 
       multab_suNC( a , b , lat[ bb3 ].O[mu] ) ; 
-      const register size_t bb4 = lat[ bb3 ].neighbor[mu] ; 
+      const register size_t bb4 = site_fwd( bb3 , mu ) ; 
       multab_suNC( b , a , lat[ bb4 ].O[nu] ) ; 
       multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
       exact_log_slow( b , a ) ; 
     } else {
-      register const size_t tb1 = lat[i].back[mu] ; 
-      register const size_t tb2 = lat[ tb1 ].neighbor[nu] ; 
+      register const size_t tb1 = site_bck( i , mu ) ; 
+      register const size_t tb2 = site_fwd( tb1 , nu ) ; 
       multab_suNC( b , lat[ tb1 ].O[nu] , lat[ tb2 ].O[mu] ) ; 
-      register const size_t tb3 = lat[ tb2 ].neighbor[mu] ; 
+      register const size_t tb3 = site_fwd( tb2 , mu ) ; 
       multab_suNC( a , b , lat[ tb3 ].O[ mu ] ) ; 
-      register const size_t tb4 = lat[ i ].neighbor[ mu ] ; 
+      register const size_t tb4 = site_fwd( i , mu ) ; 
       multab_dag_suNC( b , a , lat[ tb4 ].O[ nu ] ) ; 
       equiv( tempstap , b ) ;
 
       // bottom rectangle
-      register const size_t bb2 = lat[ tb1 ].back[nu] ; 
+      register const size_t bb2 = site_bck( tb1 , nu ) ; 
       multabdag_suNC( b , lat[ bb2 ].O[nu] , lat[ bb2 ].O[mu] ) ; 
-      register const size_t bb3 = lat[ bb2 ].neighbor[mu] ; 
+      register const size_t bb3 = site_fwd( bb2 , mu ) ; 
       multab_suNC( a , b , lat[ bb3 ].O[mu] ) ; 
-      register const size_t bb4 = lat[ bb3 ].neighbor[mu] ; 
+      register const size_t bb4 = site_fwd( bb3 , mu ) ; 
       multab_suNC( b , a , lat[ bb4 ].O[nu] ) ; 
       a_plus_b( tempstap , b ) ; 
       multabdag( b , lat[ tb1 ].O[mu] , tempstap ) ;
@@ -288,13 +323,13 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
       if( rho != mu && rho != nu ) {
 	// include the term (nu,rho,mu,-\rho,-\nu)
 	//top staple
-	size_t temp = lat[i].neighbor[nu] ; 
+	size_t temp = site_fwd( i , nu ) ; 
 	multab_suNC( a , lat[i].O[nu] , lat[temp].O[rho] ) ; 
-	temp = lat[temp].neighbor[rho] ; 
+	temp = site_fwd( temp , rho ) ; 
 	multab_suNC( b , a , lat[temp].O[mu] ) ; 
 	// halfway there ...
-	size_t temp2 = lat[ i ].neighbor[ mu ] ; 
-	temp = lat[ temp2 ].neighbor[ rho ] ; 
+	size_t temp2 = site_fwd( i , mu ) ; 
+	temp = site_fwd( temp2 , rho ) ; 
 	multab_dag_suNC( a , b , lat[ temp ].O[ nu ] ) ; 
 	multab_dag_suNC( b , a , lat[ temp2 ].O[ rho ] ) ; 
 	
@@ -305,14 +340,14 @@ all_staples_improve( GLU_complex stap[ NCNC ] ,
 	a_plus_b( c2_stap , b ) ; 
 	
 	//include the bottom staple
-	temp = lat[i].back[nu] ; 
-	temp2 = lat[temp].back[rho] ; 
+	temp = site_bck( i , nu ) ; 
+	temp2 = site_bck( temp , rho ) ; 
 	multab_dagdag_suNC( a , lat[temp].O[nu] , lat[temp2].O[rho] ) ; 
 	multab_suNC( b , a , lat[temp2].O[mu] ) ; 
 	// agree
-	temp = lat[temp2].neighbor[mu] ; 
+	temp = site_fwd( temp2 , mu ) ; 
 	multab_suNC( a , b , lat[temp].O[nu] ) ; 
-	temp2 = lat[temp].neighbor[nu] ; 
+	temp2 = site_fwd( temp , nu ) ; 
 	multab_suNC( b , a , lat[temp2].O[rho] ) ; 
 	if( type == SM_LOG ) {
 	  multab_dag_suNC( a , b , lat[i].O[mu] ) ; 
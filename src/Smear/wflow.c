@@ -84,18 +84,16 @@ flow_RK3( struct site *__restrict lat ,
     return GLU_FAILURE ;
   }
 
-  const double inplaq = av_plaquette( lat ) ;
-
 #pragma omp parallel
   {
     // counters for the derivative ...
-    double flow = 0. , flow_next = 0. , t = 0.0 , wapprox = 0.0 , new_plaq = inplaq ;
+    double flow = 0. , flow_next = 0. , t = 0.0 , wapprox = 0.0 ;
     size_t count = 0 , meas_count = 0 ;
     
     struct wfmeas *head = NULL , *curr ;
     curr = (struct wfmeas*)malloc( sizeof( struct wfmeas ) ) ;
     update_meas_list( head , curr , WF.red ,
-		      new_plaq , t , delta_t ,
+		      t , delta_t ,
 		      err_est , lat ) ;
     flow_next = curr -> Gt ;
     head = curr ;
@@ -117,16 +115,8 @@ flow_RK3( struct site *__restrict lat ,
     // update the linked list
     if( t >= WFLOW_MEAS_START ) {
       curr = (struct wfmeas*)malloc( sizeof( struct wfmeas ) ) ;
-      // compute plaquette
-      av_plaquette_th( WF.red , lat ) ;
-      size_t k ;
-      new_plaq = 0.0 ;
-      for( k = 0 ; k < Latt.Nthreads ; k++ ) {
-	new_plaq += WF.red[ 3 + CLINE*k ] ;
-      }
-      new_plaq /= ( NC * ( ND-1 ) * ( ND - 2 ) * LVOLUME ) ;
       update_meas_list( head , curr , WF.red ,
-			new_plaq , t , delta_t ,
+			t , delta_t ,
 			err_est , lat ) ;
       flow_next = curr -> Gt ;
       #ifndef WFLOW_TIME_ONLY
@@ -149,7 +139,7 @@ flow_RK3( struct site *__restrict lat ,
       // update the linked list
       curr = (struct wfmeas*)malloc( sizeof( struct wfmeas ) ) ;
       update_meas_list( head , curr , WF.red ,
-			new_plaq , t , delta_t ,
+			t , delta_t ,
 			err_est , lat ) ;
       head = curr ;
       count++ ;
@@ -22,9 +22,8 @@
  */
 #include "Mainfile.h"
 
-#include "clover.h"      // compute_Gmumu_th
 #include "GLU_splines.h" // spline evaluations
-#include "plaqs_links.h" // clover discretisation
+#include "plaqs_links.h" // gauge_obs_th()
 #include "projectors.h"  // stout projection
 #include "staples.h"     // computes staples
 
@@ -84,11 +83,12 @@ set_zmatrix( struct s_site *__restrict Z ,
 #endif
 }
 
-// wilson flow in all ND directions ...
+// wilson flow of link mu at it given its staple
 static void
 flow_directions( struct s_site *__restrict lat2 ,
 		 struct s_site *__restrict Z ,
 		 const struct site *__restrict lat ,
+		 const GLU_complex staple[ NCNC ] ,
 		 const double multiplier ,
 		 const double delta_t ,
 		 const size_t i ,
@@ -100,15 +100,8 @@ flow_directions( struct s_site *__restrict lat2 ,
 				  const GLU_complex link[ NCNC ] , 
 				  const double smear_alpha ) )
 {
-  GLU_complex staple[ NCNC ] GLUalign , temp[ NCNC ] GLUalign ;
+  GLU_complex temp[ NCNC ] GLUalign ;
   GLU_complex short_staple[ HERMSIZE ] GLUalign ; // does not need to be inited
-  zero_mat( staple ) ;
-  // first element
-  #ifdef IMPROVED_SMEARING
-  all_staples_improve( staple , lat , it , mu , ND , SM_TYPE ) ;
-  #else
-  all_staples( staple , lat , it , mu , ND , SM_TYPE ) ;
-  #endif
   // default to STOUT ...
   switch( SM_TYPE ) {
   case SM_LOG :
@@ -126,6 +119,91 @@ flow_directions( struct s_site *__restrict lat2 ,
   return ;
 }
 
+// flow a link in the final stage and measure its distance to the
+// embedded second order solution exp( dt( 2Z_1 - 5/4 Z_0 ) ) W_1. At
+// this point Z holds 8/9 Z_1 - 17/36 Z_0 and Zfirst holds -17/36 Z_0, so
+// the exponent is 9/4 Z + 27/68 Zfirst and W_1 = exp( -dt Z ) W_2
+static double
+embedded_directions( struct s_site *__restrict lat2 ,
+		     const struct wflow_temps WF ,
+		     const struct site *__restrict lat ,
+		     const GLU_complex staple[ NCNC ] ,
+		     const double multiplier ,
+		     const double delta_t ,
+		     const size_t i ,
+		     const size_t it ,
+		     const size_t mu ,
+		     const smearing_types SM_TYPE ,
+		     void (*project)( GLU_complex log[ NCNC ] , 
+				      GLU_complex *__restrict staple , 
+				      const GLU_complex link[ NCNC ] , 
+				      const double smear_alpha ) )
+{
+  GLU_complex W1[ NCNC ] GLUalign , W2[ NCNC ] GLUalign ;
+  GLU_complex Zlow[ TRUE_HERM ] GLUalign ;
+  size_t j ;
+  for( j = 0 ; j < TRUE_HERM ; j++ ) {
+    Zlow[ j ] = 2.25 * WF.Z[it].O[mu][j] + 
+      0.39705882352941176471 * WF.Zfirst[it].O[mu][j] ;
+  }
+  // the third stage's step is -dt
+  project( W1 , WF.Z[it].O[mu] , lat[it].O[mu] , delta_t ) ;
+  project( W2 , Zlow , W1 , -delta_t ) ;
+  // the usual third stage
+  flow_directions( lat2 , WF.Z , lat , staple , multiplier , 
+		   delta_t , i , it , mu , SM_TYPE , project ) ;
+  double dist = 0.0 ;
+  for( j = 0 ; j < NCNC ; j++ ) {
+    const GLU_complex d = lat2[i].O[mu][j] - W2[j] ;
+    dist += creal( d ) * creal( d ) + cimag( d ) * cimag( d ) ;
+  }
+  return dist ;
+}
+
+// flows all the links of the n sites from it, the staples of the batch
+// are computed together by all_staples_lanes(). If dist is not NULL this
+// is the last stage of the embedded step
+static void
+flow_batch( struct s_site *__restrict lat2 ,
+	    const struct wflow_temps WF ,
+	    const struct site *__restrict lat ,
+	    const double multiplier ,
+	    const double delta_t ,
+	    double *dist ,
+	    const size_t i ,
+	    const size_t it ,
+	    const size_t n ,
+	    const smearing_types SM_TYPE ,
+	    void (*project)( GLU_complex log[ NCNC ] , 
+			     GLU_complex *__restrict staple , 
+			     const GLU_complex link[ NCNC ] , 
+			     const double smear_alpha ) )
+{
+  size_t site[ STAPLE_LANES ] , mu , l ;
+  for( l = 0 ; l < n ; l++ ) {
+    site[ l ] = it + l ;
+  }
+  for( mu = 0 ; mu < ND ; mu++ ) {
+    GLU_complex staple[ STAPLE_LANES ][ NCNC ] GLUalign ;
+    for( l = 0 ; l < n ; l++ ) {
+      zero_mat( staple[ l ] ) ;
+    }
+    all_staples_lanes( staple , lat , site , n , mu , ND , SM_TYPE ) ;
+    for( l = 0 ; l < n ; l++ ) {
+      if( dist != NULL ) {
+	const double d = embedded_directions( lat2 , WF , lat , staple[ l ] ,
+					      multiplier , delta_t , i + l , 
+					      it + l , mu , SM_TYPE , project ) ;
+	if( d > *dist ) *dist = d ;
+      } else {
+	flow_directions( lat2 , WF.Z , lat , staple[ l ] , multiplier , 
+			 delta_t , i + l , it + l , mu , SM_TYPE , project ) ;
+      }
+    }
+  }
+  return ;
+}
+
 // memory-expensive runge-kutta step
 static void
 RK3step( struct wflow_temps WF ,
@@ -140,42 +218,11 @@ RK3step( struct wflow_temps WF ,
 {
   size_t i ;
 #pragma omp for private(i) SCHED
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    GLU_complex staple[ NCNC ] GLUalign , temp[ NCNC ] GLUalign ;
-    GLU_complex short_staple[ HERMSIZE ] GLUalign ;
-    size_t mu ;
-    switch( SM_TYPE ) {
-    case SM_LOG :
-      for( mu = 0 ; mu < ND ; mu++ ) {
-	zero_mat( staple ) ;
-	// first element
-        #ifdef IMPROVED_SMEARING
-	all_staples_improve( staple , lat , i , mu , ND , SM_TYPE ) ;
-        #else
-	all_staples( staple , lat , i , mu , ND , SM_TYPE ) ;
-        #endif
-	// log smearing just requires an set the log
-	make_short_log( short_staple , staple ) ;
-	set_zmatrix( WF.Z , short_staple , multiplier , i , mu ) ;
-	project( WF.lat2[i].O[mu] , WF.Z[i].O[mu] , lat[i].O[mu] , delta_t ) ; 
-      } break ;
-    default :
-      for( mu = 0 ; mu < ND ; mu++ ) {
-	zero_mat( staple ) ;
-	// first element
-        #ifdef IMPROVED_SMEARING
-	all_staples_improve( staple , lat , i , mu , ND , SM_TYPE ) ;
-        #else
-	all_staples( staple , lat , i , mu , ND , SM_TYPE ) ;
-        #endif
-	// log smearing just requires an set the log
-	// hermitian projection
-	multab_dag( temp , staple , lat[i].O[mu] ) ; 
-	Hermitian_proj_short( short_staple , temp ) ;
-	set_zmatrix( WF.Z , short_staple , multiplier , i , mu ) ;
-	project( WF.lat2[i].O[mu] , WF.Z[i].O[mu] , lat[i].O[mu] , delta_t ) ;
-      } break ;
-    }
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
+    const size_t n = ( LVOLUME - i ) < STAPLE_LANES ?
+      ( LVOLUME - i ) : STAPLE_LANES ;
+    flow_batch( WF.lat2 , WF , lat , multiplier , delta_t , NULL ,
+		i , i , n , SM_TYPE , project ) ;
   }
   // copy into lat
 #pragma omp for private(i)
@@ -188,12 +235,15 @@ RK3step( struct wflow_temps WF ,
   return ;
 }
 
-// computes one of the RK steps, doesn't matter which one
+// computes one of the RK steps, doesn't matter which one. If dist is
+// not NULL this is the last stage of the embedded step and the largest
+// squared link distance to the second order solution is put in it
 static void
 RK3step_memcheap( struct wflow_temps WF ,
 		  struct site *__restrict lat ,
 		  const double multiplier ,
 		  const double step ,
+		  double *dist ,
 		  const smearing_types SM_TYPE ,
 		  void (*project)( GLU_complex log[ NCNC ] , 
 				   GLU_complex *__restrict staple , 
@@ -202,23 +252,23 @@ RK3step_memcheap( struct wflow_temps WF ,
 {
   size_t i ;
 #ifdef IMPROVED_SMEARING
-  const size_t back = lat[ lat[0].back[ ND-1 ] ].back[ ND-1 ] ;
+  const size_t back = site_bck( site_bck( 0 , ND-1 ) , ND-1 ) ;
 #else
-  const size_t back = lat[0].back[ ND - 1 ] ;
+  const size_t back = site_bck( 0 , ND - 1 ) ;
 #endif
   // split volume - wise
   #pragma omp for private(i) SCHED
   #ifdef IMPROVED_SMEARING
-  for( i = 0 ; i < 2*LCU ; i++ ) {
+  for( i = 0 ; i < 2*LCU ; i += STAPLE_LANES ) {
+    const size_t n = ( 2*LCU - i ) < STAPLE_LANES ?
+      ( 2*LCU - i ) : STAPLE_LANES ;
   #else
-  for( i = 0 ; i < LCU ; i++ ) {
+  for( i = 0 ; i < LCU ; i += STAPLE_LANES ) {
+    const size_t n = ( LCU - i ) < STAPLE_LANES ?
+      ( LCU - i ) : STAPLE_LANES ;
   #endif
-    const size_t bck = back + i ;
-    size_t mu ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      flow_directions( WF.lat4 , WF.Z , lat , multiplier , 
-		       step , i , bck , mu , SM_TYPE , project ) ; 
-    }
+    flow_batch( WF.lat4 , WF , lat , multiplier , step , dist ,
+		i , back + i , n , SM_TYPE , project ) ;
   }
   size_t t ;
   #ifdef IMPROVED_SMEARING
@@ -229,19 +279,17 @@ RK3step_memcheap( struct wflow_temps WF ,
     const size_t slice = LCU * t ;
     // perform the wilson flow for a point on the slice
     #pragma omp for private(i) SCHED
-    for( i = 0 ; i < LCU ; i++ ) {
-      const size_t it = slice + i ;
-      size_t mu ;
-      for( mu = 0 ; mu < ND ; mu++ ) {
-	flow_directions( WF.lat2 , WF.Z , lat , multiplier , 
-			 step , i , it , mu , SM_TYPE , project ) ;
-      }
+    for( i = 0 ; i < LCU ; i += STAPLE_LANES ) {
+      const size_t n = ( LCU - i ) < STAPLE_LANES ?
+	( LCU - i ) : STAPLE_LANES ;
+      flow_batch( WF.lat2 , WF , lat , multiplier , step , dist ,
+		  i , slice + i , n , SM_TYPE , project ) ;
     }
     // swap over the temporary lattice fields
 #ifdef IMPROVED_SMEARING
-    const size_t bck = lat[ lat[ slice ].back[ ND-1 ] ].back[ ND-1 ] ;
+    const size_t bck = site_bck( site_bck( slice , ND-1 ) , ND-1 ) ;
 #else
-    const size_t bck = lat[ slice ].back[ ND -1 ] ;
+    const size_t bck = site_bck( slice , ND -1 ) ;
 #endif
 #pragma omp for private(i)
     for( i = 0 ; i < LCU ; i++ ) {
@@ -271,9 +319,9 @@ RK3step_memcheap( struct wflow_temps WF ,
   }
   // put the last couple back in ....
   const size_t slice = LCU * t ;
-  const size_t behind = lat[ slice ].back[ ND - 1 ] ;
+  const size_t behind = site_bck( slice , ND - 1 ) ;
 #ifdef IMPROVED_SMEARING
-  const size_t behind2 = lat[ behind ].back[ ND-1 ] ;
+  const size_t behind2 = site_bck( behind , ND-1 ) ;
 #endif
 #pragma omp for private(i)
   for( i = 0 ; i < LCU ; i++ ) {
@@ -337,7 +385,7 @@ allocate_WF( struct wflow_temps *WF ,
 	     const GLU_bool adaptive )
 {
   WF->lat2 = NULL ; WF->lat3 = NULL ; WF->lat4 = NULL ; WF->Z = NULL ;
-  WF->lat_two = NULL ; WF->red = NULL ;
+  WF->lat_two = NULL ; WF->red = NULL ; WF->Zfirst = NULL ;
   int FLAG = GLU_SUCCESS ;
   if( adaptive == GLU_TRUE ) {
     if( ( WF->lat_two = allocate_lat( ) ) == NULL ) {
@@ -561,38 +609,85 @@ step_distance_memcheap( struct site *__restrict lat ,
     }
   }
   // flow forwards one timestep
-  RK3step_memcheap( WF , lat , mseventeenOthsix , rk1 , SM_TYPE , project ) ;
-  RK3step_memcheap( WF , lat , eightOnine , rk2 , SM_TYPE , project ) ;
-  RK3step_memcheap( WF , lat , mthreeOfour , rk3 , SM_TYPE , project ) ;
+  RK3step_memcheap( WF , lat , mseventeenOthsix , rk1 , NULL , SM_TYPE , project ) ;
+  RK3step_memcheap( WF , lat , eightOnine , rk2 , NULL , SM_TYPE , project ) ;
+  RK3step_memcheap( WF , lat , mthreeOfour , rk3 , NULL , SM_TYPE , project ) ;
   return ;
 }
 
+// the usual step along with the distance to its embedded second order
+// solution, the largest link distance is returned to every thread
+double
+step_distance_embedded( struct site *__restrict lat ,
+			struct wflow_temps WF ,
+			const double delta_t ,
+			const smearing_types SM_TYPE ,
+			void (*project)( GLU_complex log[ NCNC ] , 
+					 GLU_complex *__restrict staple , 
+					 const GLU_complex link[ NCNC ] , 
+					 const double smear_alpha ) )
+{
+  // RK3 parameters
+  const double rk1 = -0.52941176470588235294 * delta_t ;
+  const double rk2 =  delta_t ;
+  const double rk3 = -delta_t ;
+  const double mthreeOfour = -3.0/4.0 ;
+  const double mseventeenOthsix = -17.0/36.0 ;
+  const double eightOnine = 8.0/9.0 ;
+  // set z to zero
+  size_t i ;
+#pragma omp for private(i)
+  for( i = 0 ; i < LVOLUME ; i++ ) {
+    register size_t mu ;
+    for( mu = 0 ; mu < ND ; mu++ ) {
+      memset( WF.Z[i].O[mu] , 0.0 , TRUE_HERM*sizeof( GLU_complex ) ) ;
+    }
+  }
+  RK3step_memcheap( WF , lat , mseventeenOthsix , rk1 , NULL , SM_TYPE , project ) ;
+  // keep the first stage's Z for the second order solution
+#pragma omp for private(i)
+  for( i = 0 ; i < LVOLUME ; i++ ) {
+    register size_t mu ;
+    for( mu = 0 ; mu < ND ; mu++ ) {
+      memcpy( WF.Zfirst[i].O[mu] , WF.Z[i].O[mu] , 
+	      TRUE_HERM*sizeof( GLU_complex ) ) ;
+    }
+  }
+  RK3step_memcheap( WF , lat , eightOnine , rk2 , NULL , SM_TYPE , project ) ;
+  double dist = 0.0 ;
+  RK3step_memcheap( WF , lat , mthreeOfour , rk3 , &dist , SM_TYPE , project ) ;
+  // reduce the maximum over the threads
+  WF.red[ CLINE*get_GLU_thread() ] = dist ;
+  {
+    #pragma omp barrier
+  }
+  for( i = 0 ; i < Latt.Nthreads ; i++ ) {
+    if( WF.red[ CLINE*i ] > dist ) dist = WF.red[ CLINE*i ] ;
+  }
+  {
+    #pragma omp barrier
+  }
+  return sqrt( dist ) / NC ;
+}
+
 // updates the measurement linked list
 void
 update_meas_list( struct wfmeas *head ,
 		  struct wfmeas *curr ,
 		  double *red ,
-		  const double new_plaq ,
 		  const double t ,
 		  const double delta_t ,
 		  const double errmax ,
 		  const struct site *lat )
 {
-  // compute field strength tensor
-  compute_Gmunu_th( red , lat ) ;
-  double GT = 0.0 , Q = 0.0 ;
-  size_t i ;
-  for( i = 0 ; i < Latt.Nthreads ; i++ ) {
-    GT += red[ 0 + CLINE*i ] ;
-    Q  += red[ 1 + CLINE*i ] ;
-  }
-  GT /= 16*LVOLUME ;
-  Q *= -0.001583143494411527678811 ;
+  // plaquette, field strength tensor and charge in one sweep
+  struct gauge_obs obs ;
+  gauge_obs_th( &obs , red , lat , GLU_TRUE ) ;
   
   curr -> time   = t ;
-  curr -> Gt     = curr -> time * curr -> time * GT ;
-  curr -> qtop   = Q ;
-  curr -> avplaq = new_plaq ; 
+  curr -> Gt     = curr -> time * curr -> time * obs.GG ;
+  curr -> qtop   = obs.qtop ;
+  curr -> avplaq = obs.plaq ; 
 #pragma omp master
   {
     print_flow( curr , errmax , delta_t ) ;
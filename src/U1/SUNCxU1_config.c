@@ -38,6 +38,9 @@
 // just to make it clear what we are doing
 enum{ CONJUGATE_NOT_IN_LIST , CONJUGATE_IN_LIST } ;
 
+// sites whose gaussians are drawn together
+#define U1_SITES (16)
+
 // little inline for the ( 0 , 0 , .. , 0 ) point in the -Pi -> Pi BZ
 static size_t
 compute_zeropoint( void )
@@ -78,21 +81,25 @@ conjugate_site( const size_t i )
 static void 
 periodic_dft( struct fftw_stuff *FFTW )
 {
-  // slower version just randomly assigns fields first
+  // slower version just randomly assigns fields first, U1_SITES sites
+  // worth of gaussians at a time
+  const size_t Nblocks = ( LVOLUME + U1_SITES - 1 ) / U1_SITES ;
   size_t i ;
+  par_rng_pass( ) ;
   #pragma omp parallel for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) {
+  for( i = 0 ; i < Nblocks ; i++ ) {
     const uint32_t thread = get_GLU_thread( ) ;
-    #if ND == 4
-    FFTW -> in[0][i] = FFTW -> psq[i] * par_polar_box( thread ) ;
-    FFTW -> in[1][i] = FFTW -> psq[i] * par_polar_box( thread ) ;
-    FFTW -> in[2][i] = FFTW -> psq[i] * par_polar_box( thread ) ;
-    FFTW -> in[3][i] = FFTW -> psq[i] * par_polar_box( thread ) ;
-    #else
-    for( size_t mu = 0 ; mu < ND ; mu++ ) {
-      FFTW -> in[mu][i] = FFTW -> psq[i] * par_polar_box( thread ) ;
+    const size_t s0 = i * U1_SITES ;
+    const size_t Ns = ( LVOLUME - s0 ) < U1_SITES ? ( LVOLUME - s0 ) : U1_SITES ;
+    GLU_complex z[ U1_SITES ][ ND ] ;
+    size_t j , mu ;
+    par_rng_seek( thread , s0 , 0 ) ;
+    par_gaussian_array( (GLU_complex*)z , Ns * ND , thread ) ;
+    for( j = 0 ; j < Ns ; j++ ) {
+      for( mu = 0 ; mu < ND ; mu++ ) {
+	FFTW -> in[mu][ s0 + j ] = FFTW -> psq[ s0 + j ] * z[j][mu] ;
+      }
     }
-    #endif
   }  
   const size_t SYMM_POINT = compute_zeropoint( ) + 1 ;
   for( i = 0 ; i < SYMM_POINT ; i++ ) {
@@ -189,6 +196,9 @@ create_u1( struct site *lat ,
 #endif
   return GLU_SUCCESS ;
 }
+
+#undef U1_SITES
+
 #endif // HAVE_FFTW3_H
 
 // Possibly a check that the plaquette has changed ..
@@ -39,9 +39,9 @@ non_plaquette( double *plaq ,
     register double loc_sum = 0.0 , loc_plaq = 0.0 ;
     size_t mu , nu , s , t ;
     for( mu = 1 ; mu < ND ; mu++ ) {
-      s = lat[i].neighbor[mu] ;
+      s = site_fwd( i , mu ) ;
       for( nu = 0 ; nu < mu ; nu++ ) {
-	t = lat[i].neighbor[nu] ;
+	t = site_fwd( i , nu ) ;
 	register const double temp =				\
 	  creal( (double)O[mu][i] + (double)O[nu][s] -		\
 		 (double)O[mu][t] - (double)O[nu][i] ) ;
@@ -70,11 +70,11 @@ U1_rectangle( double *U1REC ,
     double loc_rec = 0. , loc_ncrec = 0. ;
     size_t mu , nu , s , t , t2 , u , v ;
     for( mu = 1 ; mu < ND ; mu++ ) {
-      s = lat[i].neighbor[mu] ;
-      t = lat[s].neighbor[mu] ;
+      s = site_fwd( i , mu ) ;
+      t = site_fwd( s , mu ) ;
       for( nu = 0 ; nu < mu ; nu++ ) {
-	v = lat[i].neighbor[nu] ;
-	u = lat[v].neighbor[mu] ;
+	v = site_fwd( i , nu ) ;
+	u = site_fwd( v , mu ) ;
 	// first one is the (2x1) rectangle
 	register double cache =						\
 	  creal( (double)O[mu][i] + (double)O[mu][s] + (double)O[nu][t] -
@@ -82,8 +82,8 @@ U1_rectangle( double *U1REC ,
 	loc_rec += cos( cache ) ;
 	loc_ncrec += cache * cache ;
 	// second one is the (1x2) rectangle
-	t2 = lat[s].neighbor[nu] ;
-	u  = lat[v].neighbor[nu] ;
+	t2 = site_fwd( s , nu ) ;
+	u  = site_fwd( v , nu ) ;
         cache =								\
 	  creal( (double)O[mu][i] + (double)O[nu][s] + (double)O[nu][t2] -
 		 (double)O[mu][u] - (double)O[nu][v] - (double)O[nu][i] ) ;
@@ -22,13 +22,13 @@
  */
 #include "Mainfile.h"
 
+#include "checkpoint.h"    // write out a configuration
 #include "draughtboard.h"  // draughtboarding
-#include "GLUlib_wrap.h"   // write out a configuration
 #include "GLU_timer.h"     // print_time()
 #include "gramschmidt.h"   // gram_reunit()
 #include "hb.h"            // heat-bath
 #include "par_rng.h"       // parallel rngs
-#include "plaqs_links.h"   // av_plaquette()
+#include "plaqs_links.h"   // gauge_obs_th()
 #include "POLY.h"          // poly()
 #include "random_config.h" // reunit_latt()
 #include "relax.h"         // overrelaxation
@@ -41,25 +41,18 @@ perform_measurements( double *PLAQred ,
 		      const struct site *lat ,
 		      const size_t conf_idx )
 {
-  double pl = 0.0 , re , im ;
+  double re , im ;
   size_t mu , k ;
-  
-#pragma omp for private(k)
-  for( k = 0 ; k < Latt.Nthreads*CLINE ; k++ ) {
-    PLAQred[ k ] = 0.0 ;
-  }
-  
-  av_plaquette_th( PLAQred , lat ) ;
-  
-  for( k = 0 ; k < Latt.Nthreads ; k++ ) {
-    pl += PLAQred[ 3 + CLINE*k ] ;
-  }
+
+  // the local observables come out of one sweep
+  struct gauge_obs obs ;
+  gauge_obs_th( &obs , PLAQred , lat , GLU_FALSE ) ;
   
 #pragma omp master
   {
     // write out the plaquette
     fprintf( stdout , "[UPDATE] %zu :: {P} %1.12f \n" , 
-	     conf_idx , pl/( NC*(ND-1)*(ND-2)*LVOLUME ) ) ;
+	     conf_idx , obs.plaq ) ;
   }
   
 #pragma omp for private(k)
@@ -121,6 +114,7 @@ hb_update( struct site *lat ,
   // strip the number in the infile if it has one
   char *pch = strtok( (char*)traj_name , "." ) ;
   char str[ strlen(pch)+6+sizeof(size_t) ] ;
+  char rng_str[ strlen(pch)+6+sizeof(size_t) ] ;
   sprintf( str , "%s.%zu.rand" , pch , Latt.flow ) ;
   
   if( HBINFO.continuation == GLU_FALSE ) {
@@ -142,7 +136,11 @@ hb_update( struct site *lat ,
     return GLU_FAILURE ;
   }
 #else
-  if( init_cb( &db , LVOLUME , ND ) == GLU_FAILURE ) {
+  // with the checkerboard layout each colour's links are contiguous
+  // in the slab so we visit them in that order
+  const int cb_flag = ( Latt.layout == LAYOUT_CHECKERBOARD ) ?
+    init_blocked_cb( &db , ND ) : init_cb( &db , LVOLUME , ND ) ;
+  if( cb_flag == GLU_FAILURE ) {
     return GLU_FAILURE ;
   }
 #endif
@@ -162,6 +160,14 @@ hb_update( struct site *lat ,
 	   HBINFO.Nsave ) ;
   fprintf( stdout , "[UPDATE] Using beta = %1.12f \n" , HBINFO.beta ) ;
 
+  // set up the (possibly asynchronous) checkpointing
+  if( init_checkpoints( HBINFO.Nstage , storage , 
+			output_details ) == GLU_FAILURE ) {
+    free_cb( &db ) ;
+    free_par_rng( ) ;
+    return GLU_FAILURE ;
+  }
+
   double *PLAQred = calloc( CLINE*Latt.Nthreads , sizeof( double ) ) ;
   double *POLYred = calloc( CLINE*Latt.Nthreads , sizeof( double ) ) ;
   
@@ -203,27 +209,24 @@ hb_update( struct site *lat ,
       if( i%HBINFO.Nsave == 0 && i != start ) {
 	#pragma omp single
 	{
-	  // write a configuration
 	  sprintf( str , "%s.%zu" , pch , i ) ;
-	  if( write_configuration( lat , str , storage , output_details )
-	      != GLU_FAILURE ) {
-	    // write out the rng state
-	    sprintf( str , "%s.%zu.rand" , pch , i ) ;
-	    write_par_rng_state( str ) ;
-	  }
+	  sprintf( rng_str , "%s.%zu.rand" , pch , i ) ;
 	}
+	checkpoint_configuration( lat , i , str , rng_str ) ;
       }
 
       // perform a hb-OR step
       update_lattice( lat , inverse_beta , db , HBINFO.Nor ) ;
-
-      #pragma omp master
-      {
-	Latt.flow = i + 1 ; 
-      }
     }
   }
 
+  // make sure everything we queued is on disk, the writer sets the
+  // sequence number of each configuration so we only update it here
+  flush_checkpoints( ) ;
+  if( HBINFO.iterations > Latt.flow ) {
+    Latt.flow = HBINFO.iterations ;
+  }
+
   // free the reduction array
   free( PLAQred ) ;
   free( POLYred ) ;
@@ -24,6 +24,10 @@ a    GLU is distributed in the hope that it will be useful,
             due to the funny nature of links we have to loop over directions and 
 	    then volume, this is a bit out of order for our AoS setup but fuck it
 
+            With HB_LANES > 1 HB_LANES links of the same colour are updated
+	    together, the KP accept/reject is masked per lane so the maths
+	    vectorises while the random numbers are still drawn per lane
+
    Credit :: Lots of credit to T deGrand whose code (in MILC) I used as the basis 
              for this work and whose code I tested this against.
  */
@@ -32,13 +36,14 @@ a    GLU is distributed in the hope that it will be useful,
 #include "Mainfile.h"
 
 #include "par_rng.h"    // parallel rng
-#include "staples.h"    // all_staples()
+#include "staples.h"    // all_staples_lanes()
 #include "SU2_rotate.h" // rotation
 #include "relax.h"      // OR
 
 #include "gramschmidt.h"
 #include "GLU_malloc.h"
 #include "geometry.h"
+#include "lane_math.h"  // lane_log(), lane_sincos2pi()
 
 static struct site *lat2 = NULL ;
 
@@ -48,6 +53,17 @@ static struct site *lat2 = NULL ;
 // Tony and Brian's algorithm is better - sorry LatticeGuy!
 #define USE_KP
 
+// update HB_LANES links of a colour at a time
+#if (HB_LANES > 1) && (defined USE_KP) && !(defined IMPROVED_SMEARING)
+  #define HB_BATCHED
+  // the staples of a batch come from all_staples_lanes()
+  #if HB_LANES > STAPLE_LANES
+    #error "HB_LANES must not be larger than STAPLE_LANES"
+  #endif
+#endif
+
+#ifndef HB_BATCHED
+
 #ifdef USE_KP
 // Kennedy-Pendleton heatbath algorithm
 static int
@@ -156,6 +172,128 @@ hb( GLU_complex U[ NCNC ] ,
   return ;
 }
 
+#else
+
+// masked Kennedy-Pendleton, lanes that accept stop drawing and keep their d
+static void
+KP_lanes( double d[ HB_LANES ] ,
+	  const double NORM[ HB_LANES ] ,
+	  const size_t n ,
+	  const uint32_t thread )
+{
+  double x4[ HB_LANES ] , x3[ HB_LANES ] ;
+  double l1[ HB_LANES ] , l2[ HB_LANES ] ;
+  int active[ HB_LANES ] ;
+  size_t l , iters , Nactive = n ;
+  for( l = 0 ; l < HB_LANES ; l++ ) {
+    active[l] = ( l < n ) ;
+    d[l] = 0.0 ;
+  }
+  for( iters = 0 ; iters < NHBMAX && Nactive > 0 ; iters++ ) {
+    // draws in the order of KP() for the lanes still going
+    for( l = 0 ; l < HB_LANES ; l++ ) {
+      if( active[l] ) {
+	x4[l] = par_rng_dbl( thread ) ;
+	x3[l] = par_rng_dbl( thread ) ;
+	l1[l] = par_rng_dbl( thread ) ;
+	l2[l] = par_rng_dbl( thread ) ;
+      } else {
+	x4[l] = x3[l] = l1[l] = l2[l] = 0.5 ;
+      }
+    }
+    #pragma omp simd
+    for( l = 0 ; l < HB_LANES ; l++ ) {
+      double sn , cs ;
+      lane_sincos2pi( x3[l] , &sn , &cs ) ;
+      const double dl = -( lane_log( l1[l] ) + 
+			   lane_log( l2[l] ) * cs * cs ) * NORM[l] ;
+      const int reject = ( 1. - 0.5*dl ) < x4[l]*x4[l] ;
+      d[l] = active[l] ? dl : d[l] ;
+      active[l] = active[l] & reject ;
+    }
+    for( Nactive = l = 0 ; l < HB_LANES ; l++ ) {
+      Nactive += active[l] ;
+    }
+  }
+  return ;
+}
+
+// generate_SU2() for a batch of links, s0 and s1 are split into re/im
+static void
+generate_SU2_lanes( double rS0[ HB_LANES ] ,
+		    double iS0[ HB_LANES ] ,
+		    double rS1[ HB_LANES ] ,
+		    double iS1[ HB_LANES ] ,
+		    const double NORM[ HB_LANES ] ,
+		    const size_t n ,
+		    const uint32_t thread )
+{
+  double d[ HB_LANES ] , a3[ HB_LANES ] , rho[ HB_LANES ] , x2[ HB_LANES ] ;
+  size_t l ;
+  KP_lanes( d , NORM , n , thread ) ;
+  // sqrt stays scalar, with errno set it cannot be vectorised
+  for( l = 0 ; l < HB_LANES ; l++ ) {
+    const double ar2 = fabs( 1.0 - ( 1.0 - d[l] )*( 1.0 - d[l] ) ) ;
+    a3[l] = sqrt( ar2 ) * ( 2.0 * ( l < n ? par_rng_dbl( thread ) : 0.5 ) - 1.0 ) ;
+    rho[l] = sqrt( fabs( ar2 - a3[l]*a3[l] ) ) ;
+    x2[l] = l < n ? par_rng_dbl( thread ) : 0.5 ;
+  }
+  #pragma omp simd
+  for( l = 0 ; l < HB_LANES ; l++ ) {
+    const double a0 = 1.0 - d[l] ;
+    double a1 , a2 ;
+    lane_sincos2pi( x2[l] , &a2 , &a1 ) ;
+    a1 *= rho[l] ;
+    a2 *= rho[l] ;
+    const double r0 = rS0[l] , i0 = iS0[l] , r1 = rS1[l] , i1 = iS1[l] ;
+    rS0[l] =  a0 * r0 + a3[l] * i0 + a2 * r1 + a1 * i1 ;
+    iS0[l] = -a0 * i0 + r0 * a3[l] - a2 * i1 + r1 * a1 ;
+    rS1[l] = -a0 * r1 + a3[l] * i1 + a2 * r0 - a1 * i0 ;
+    iS1[l] = -a0 * i1 - a3[l] * r1 + a2 * i0 + a1 * r0 ;
+  }
+  return ;
+}
+
+// hb() for n <= HB_LANES links of the same colour at once
+static void
+hb_lanes( GLU_complex *U[ HB_LANES ] ,
+	  GLU_complex stap[ HB_LANES ][ NCNC ] ,
+	  const size_t n ,
+	  const double invbeta ,
+	  const uint32_t thread )
+{
+  double rS0[ HB_LANES ] , iS0[ HB_LANES ] , rS1[ HB_LANES ] , iS1[ HB_LANES ] ;
+  double NORM[ HB_LANES ] ;
+  size_t stoch[ HB_LANES ] , i , l ;
+  for( i = 0 ; i < NSTOCH ; i++ ) {
+    for( l = 0 ; l < HB_LANES ; l++ ) {
+      if( l < n ) {
+        #if (NSTOCH != NSU2SUBGROUPS)
+	stoch[l] = (size_t)( par_rng_dbl( thread ) * NSU2SUBGROUPS ) ;
+        #else
+	stoch[l] = i ;
+        #endif
+	GLU_complex s0 , s1 ;
+	double scale ;
+	only_subgroup( &s0 , &s1 , &scale , U[l] , stap[l] , stoch[l] ) ;
+	rS0[l] = creal( s0 ) ; iS0[l] = cimag( s0 ) ;
+	rS1[l] = creal( s1 ) ; iS1[l] = cimag( s1 ) ;
+	NORM[l] = invbeta*scale ;
+      } else {
+	rS0[l] = 1.0 ; iS0[l] = rS1[l] = iS1[l] = 0.0 ;
+	NORM[l] = invbeta ;
+      }
+    }
+    generate_SU2_lanes( rS0 , iS0 , rS1 , iS1 , NORM , n , thread ) ;
+    for( l = 0 ; l < n ; l++ ) {
+      su2_rotate( U[l] , rS0[l] + I * iS0[l] , rS1[l] + I * iS1[l] , stoch[l] ) ;
+    }
+  }
+  return ;
+}
+
+#endif
+
 // perform a heat-bath over the whole lattice
 int
 hb_lattice( struct site *lat ,
@@ -163,6 +301,11 @@ hb_lattice( struct site *lat ,
 	    const struct draughtboard db )
 {
   // single node until I figure out the coloring -- could this just be a simple copy? i.e. a temporary gauge field being set and then pointer-swapped?
+  // every thread of the team gets here, one of them starts the pass
+  #pragma omp single
+  {
+    par_rng_pass( ) ;
+  }
 #ifdef IMPROVED_SMEARING
   size_t cmu , i ;
   for( cmu = 0 ; cmu < db.Ncolors ; cmu++ ) {
@@ -174,28 +317,71 @@ hb_lattice( struct site *lat ,
       GLU_complex stap[ NCNC ] GLUalign ;
       zero_mat( stap ) ;
       all_staples_improve( stap , lat , it , mu , ND , SM_APE ) ;
+      par_rng_seek( get_GLU_thread() , it , mu ) ;
       hb( lat[ it ].O[mu] , stap , invbeta , get_GLU_thread() ) ;
       gram_reunit( lat[it].O[mu] ) ;
     }
   }
+#elif (defined HB_BATCHED)
+  size_t cmu , i ;
+  for( cmu = 0 ; cmu < ND*db.Ncolors ; cmu++ ) {
+    const size_t mu = cmu/db.Ncolors ;
+    const size_t c  = cmu%db.Ncolors ;
+    const size_t Nbatch = ( db.Nsquare[c] + HB_LANES - 1 ) / HB_LANES ;
+    // parallel loop over batches of HB_LANES sites with this coloring
+    #pragma omp for private(i)
+    for( i = 0 ; i < Nbatch ; i++ ) {
+      GLU_complex stap[ STAPLE_LANES ][ NCNC ] GLUalign , *U[ HB_LANES ] ;
+      const size_t n = ( i+1 )*HB_LANES > db.Nsquare[c] ? 
+	db.Nsquare[c] - i*HB_LANES : HB_LANES ;
+      size_t l ;
+      for( l = 0 ; l < n ; l++ ) {
+	const size_t it = db.square[c][ l + i*HB_LANES ] ;
+	zero_mat( stap[l] ) ;
+	U[l] = lat[ it ].O[mu] ;
+      }
+      all_staples_lanes( stap , lat , db.square[c] + i*HB_LANES , n ,
+			 mu , ND , SM_APE ) ;
+      // the batch draws from the stream of its first link
+      par_rng_seek( get_GLU_thread() , db.square[c][ i*HB_LANES ] , mu ) ;
+      hb_lanes( U , stap , n , invbeta , get_GLU_thread() ) ;
+      for( l = 0 ; l < n ; l++ ) {
+	gram_reunit( U[l] ) ;
+      }
+    }
+  }
 #else
   size_t cmu , i ;
   for( cmu = 0 ; cmu < ND*db.Ncolors ; cmu++ ) {
     const size_t mu = cmu/db.Ncolors ;
     const size_t c  = cmu%db.Ncolors ;
-    // parallel loop over all sites with this coloring
+    // parallel loop over all sites with this coloring, the staples
+    // of a batch of them are computed together
     #pragma omp for private(i) 
-    for( i = 0 ; i < db.Nsquare[c] ; i++ ) {
-      const size_t it = db.square[c][i] ;
-      GLU_complex stap[ NCNC ] GLUalign ;
-      zero_mat( stap ) ;
-      all_staples( stap , lat , it , mu , ND , SM_APE ) ;
-      hb( lat[ it ].O[mu] , stap , invbeta , get_GLU_thread() ) ;
-      gram_reunit( lat[it].O[mu] ) ;
+    for( i = 0 ; i < db.Nsquare[c] ; i += STAPLE_LANES ) {
+      GLU_complex stap[ STAPLE_LANES ][ NCNC ] GLUalign ;
+      const size_t n = ( db.Nsquare[c] - i ) < STAPLE_LANES ?
+	( db.Nsquare[c] - i ) : STAPLE_LANES ;
+      size_t l ;
+      for( l = 0 ; l < n ; l++ ) {
+	zero_mat( stap[l] ) ;
+      }
+      all_staples_lanes( stap , lat , db.square[c] + i , n ,
+			 mu , ND , SM_APE ) ;
+      for( l = 0 ; l < n ; l++ ) {
+	const size_t it = db.square[c][ i + l ] ;
+	par_rng_seek( get_GLU_thread() , it , mu ) ;
+	hb( lat[ it ].O[mu] , stap[l] , invbeta , get_GLU_thread() ) ;
+	gram_reunit( lat[it].O[mu] ) ;
+      }
     }
   }
 #endif
   return GLU_SUCCESS ;
 }
 
+#ifdef HB_BATCHED
+  #undef HB_BATCHED
+#endif
+
 #undef NHBMAX
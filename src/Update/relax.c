@@ -78,6 +78,11 @@ OR_lattice( struct site *lat ,
 	    const struct draughtboard db )
 {
     // single node until I get the coloring correct
+  // every thread of the team gets here, one of them starts the pass
+  #pragma omp single
+  {
+    par_rng_pass( ) ;
+  }
 #ifdef IMPROVED_SMEARING
   size_t cmu , i ;
   for( cmu = 0 ; cmu < db.Ncolors ; cmu++ ) {
@@ -89,6 +94,7 @@ OR_lattice( struct site *lat ,
       GLU_complex stap[ NCNC ] GLUalign ;
       zero_mat( stap ) ;
       all_staples_improve( stap , lat , it , mu , ND , SM_APE ) ;
+      par_rng_seek( get_GLU_thread() , it , mu ) ;
       overrelax( lat[ it ].O[mu] , stap , get_GLU_thread() ) ;
     }
   }
@@ -104,6 +110,7 @@ OR_lattice( struct site *lat ,
       GLU_complex stap[ NCNC ] GLUalign ;
       zero_mat( stap ) ;
       all_staples( stap , lat , it , mu , ND , SM_APE ) ;
+      par_rng_seek( get_GLU_thread() , it , mu ) ;
       overrelax( lat[ it ].O[mu] , stap , get_GLU_thread() ) ;
     }
     // and that is it
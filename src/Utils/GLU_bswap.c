@@ -110,3 +110,27 @@ bswap_64( const size_t n , void *u )
   }
   return ;
 }
+
+// serial 32 bit swap, for small arrays already inside a parallel region
+void
+bswap_32_serial( const size_t n , void *u ) 
+{
+  uint32_t *T = u ;
+  size_t i ;
+  for( i = 0 ; i < n ; i++ ) {
+    *( T + i ) = SwapByteOrder_32( *( T + i ) ) ;
+  }
+  return ;
+} 
+
+// serial 64 bit swap, for small arrays already inside a parallel region
+void
+bswap_64_serial( const size_t n , void *u ) 
+{
+  uint64_t *T = u ;
+  size_t i ;
+  for( i = 0 ; i < n ; i++ ) {
+    *( T + i ) = SwapByteOrder_64( *( T + i ) ) ;
+  }
+  return ;
+}
@@ -28,7 +28,8 @@
 #include <immintrin.h>
 #endif
 
-#include "init.h" // init_navig()
+#include "draughtboard.h" // init_blocked_cb()
+#include "init.h"         // init_navig()
 
 // memalign wrapper
 int 
@@ -44,80 +45,142 @@ GLU_malloc( void **memptr ,
 #endif
 }
 
-// allocate the gauge fields
-struct site *
-allocate_lat( void )
+// position of each site in the concatenated tiled colour lists
+static size_t *
+checkerboard_order( void )
 {
-  struct site *lat = NULL ;
-  size_t i , flag = 0 ;
-  if( GLU_malloc( (void**)&lat , ALIGNMENT , LVOLUME * sizeof( struct site ) ) != 0 ) {
+  struct draughtboard db ;
+  size_t *pos = malloc( LVOLUME * sizeof( size_t ) ) ;
+  if( pos == NULL || init_blocked_cb( &db , ND ) == GLU_FAILURE ) {
+    fprintf( stderr , "[MALLOC] checkerboard ordering failure\n" ) ;
+    free( pos ) ;
     return NULL ;
   }
+  size_t c , i , offset = 0 ;
+  for( c = 0 ; c < db.Ncolors ; c++ ) {
+    for( i = 0 ; i < db.Nsquare[c] ; i++ ) {
+      pos[ db.square[c][i] ] = offset + i ;
+    }
+    offset += db.Nsquare[c] ;
+  }
+  free_cb( &db ) ;
+  return pos ;
+}
+
+// set the views lat[i].O[mu] into the link slab in the order "layout"
+static int
+set_lat_views( struct site *lat ,
+	       GLU_complex **ptrs ,
+	       GLU_complex *links ,
+	       const field_layout layout )
+{
+  size_t *pos = NULL ;
+  if( layout == LAYOUT_CHECKERBOARD && 
+      ( pos = checkerboard_order( ) ) == NULL ) {
+    return GLU_FAILURE ;
+  }
+  size_t i ;
   #pragma omp parallel for private(i)
   for( i = 0 ; i < LVOLUME ; i++ ) {
-    if( GLU_malloc( (void**)&lat[i].O , ALIGNMENT , ND * sizeof( GLU_complex* ) ) != 0 ) {
-      flag = 1 ;
-    }
+    lat[i].O = ptrs + i * ND ;
     size_t mu ;
     for( mu = 0 ; mu < ND ; mu++ ) {
-      if( GLU_malloc( (void**)&lat[i].O[mu] , ALIGNMENT , NCNC * sizeof( GLU_complex ) ) != 0 ) {
-	flag = 1 ;
+      switch( layout ) {
+      case LAYOUT_CHECKERBOARD :
+	lat[i].O[mu] = links + ( mu * LVOLUME + pos[i] ) * NCNC ;
+	break ;
+      case LAYOUT_LINK_MAJOR :
+	lat[i].O[mu] = links + ( mu * LVOLUME + i ) * NCNC ;
+	break ;
+      case LAYOUT_SITE_MAJOR :
+      default :
+	lat[i].O[mu] = links + ( i * ND + mu ) * NCNC ;
+	break ;
       }
     }
   }
-  if( flag == 1 ) return NULL ;
-  init_navig( lat ) ;
+  free( pos ) ;
+  return GLU_SUCCESS ;
+}
+
+// allocate the gauge fields as one slab of links and one of pointers
+struct site *
+allocate_lat( void )
+{
+  struct site *lat = NULL ;
+  GLU_complex **ptrs = NULL , *links = NULL ;
+  if( GLU_malloc( (void**)&lat , ALIGNMENT , LVOLUME * sizeof( struct site ) ) != 0 ||
+      GLU_malloc( (void**)&ptrs , ALIGNMENT , LVOLUME * ND * sizeof( GLU_complex* ) ) != 0 ||
+      GLU_malloc( (void**)&links , ALIGNMENT , LVOLUME * ND * NCNC * sizeof( GLU_complex ) ) != 0 ) {
+    fprintf( stderr , "[MALLOC] gauge field slab allocation failure\n" ) ;
+    free( links ) ; free( ptrs ) ; free( lat ) ;
+    return NULL ;
+  }
+  if( set_lat_views( lat , ptrs , links , Latt.layout ) == GLU_FAILURE ) {
+    free( links ) ; free( ptrs ) ; free( lat ) ;
+    return NULL ;
+  }
+  init_navig( ) ;
   return lat ;
 }
 
-// free the lattice gauge field
+// copy all the links of "src" into "dest", both from allocate_lat()
 void
-free_lat( struct site *lat )
+copy_lat( struct site *dest ,
+	  const struct site *src )
 {
+  const size_t Nlinks = LVOLUME * ND ;
+  GLU_complex *pd = lat_slab( dest ) ;
+  const GLU_complex *ps = lat_slab( src ) ;
   size_t i ;
   #pragma omp parallel for private(i)
-  for( i = 0 ; i < LVOLUME ; i++ ) {
-    size_t mu ;
-    for( mu = 0 ; mu < ND ; mu++ ) {
-      if( lat[i].O[mu] != NULL ) {
-	free( lat[i].O[mu] ) ;
-      }
-    }
-    if( lat[i].O != NULL ) {
-      free( lat[i].O ) ;
-    }
-  }
-  if( lat != NULL ) {
-    free( lat ) ;
+  for( i = 0 ; i < Nlinks ; i++ ) {
+    memcpy( pd + i * NCNC , ps + i * NCNC , NCNC * sizeof( GLU_complex ) ) ;
   }
   return ;
 }
 
-// allocate an spt_size
+// free the lattice gauge field
+void
+free_lat( struct site *lat )
+{
+  if( lat == NULL ) return ;
+  free( lat_slab( lat ) ) ;
+  free( lat[0].O ) ;
+  free( lat ) ;
+  return ;
+}
+
+// the first link of the slab is always O[0] of site 0
+GLU_complex *
+lat_slab( const struct site *lat )
+{
+  return lat[0].O[0] ;
+}
+
+// allocate an s_site lat[LENGTH1].O[LENGTH2][LENGTH3] in two slabs
 struct s_site *
 allocate_s_site( const size_t LENGTH1 ,
 		 const size_t LENGTH2 ,
 		 const size_t LENGTH3 )
 {
-  size_t i , flag = 0 ;
   struct s_site *lat = NULL ;
-  if( GLU_malloc( (void**)&lat , ALIGNMENT , LENGTH1 * sizeof( struct s_site ) ) != 0 ) {
+  GLU_complex **ptrs = NULL , *links = NULL ;
+  if( GLU_malloc( (void**)&lat , ALIGNMENT , LENGTH1 * sizeof( struct s_site ) ) != 0 ||
+      GLU_malloc( (void**)&ptrs , ALIGNMENT , LENGTH1 * LENGTH2 * sizeof( GLU_complex* ) ) != 0 ||
+      GLU_malloc( (void**)&links , ALIGNMENT , LENGTH1 * LENGTH2 * LENGTH3 * sizeof( GLU_complex ) ) != 0 ) {
+    free( links ) ; free( ptrs ) ; free( lat ) ;
     return NULL ;
   }
+  size_t i ;
   #pragma omp parallel for private(i)
   for( i = 0 ; i < LENGTH1 ; i++ ) {
-    if( GLU_malloc( (void**)&lat[i].O , ALIGNMENT , LENGTH2 * sizeof( GLU_complex* ) ) != 0 ) {
-      flag = 1 ;
-    }
-    //
+    lat[i].O = ptrs + i * LENGTH2 ;
     size_t mu ;
     for( mu = 0 ; mu < LENGTH2 ; mu++ ) {
-      if( GLU_malloc( (void**)&lat[i].O[mu] , ALIGNMENT , LENGTH3 * sizeof( GLU_complex ) ) != 0 ) {
-	flag = 1 ;
-      }
+      lat[i].O[mu] = links + ( i * LENGTH2 + mu ) * LENGTH3 ;
     }
   }
-  if( flag == 1 ) return NULL ;
   return lat ;
 }
 
@@ -128,22 +191,9 @@ free_s_site( struct s_site *lat ,
 	     const size_t LENGTH2 ,
 	     const size_t LENGTH3 )
 {
-
-  size_t i ;
-#pragma omp parallel for private(i)
-  for( i = 0 ; i < LENGTH1 ; i++ ) {
-    size_t mu ;
-    for( mu = 0 ; mu < LENGTH2 ; mu++ ) {
-      if( lat[i].O[mu] != NULL ) {
-	free( lat[i].O[mu] ) ;
-      }
-    }
-    if( lat[i].O != NULL ) {
-      free( lat[i].O ) ;
-    }
-  }
-  if( lat != NULL ) {
-    free( lat ) ;
-  }
+  if( lat == NULL ) return ;
+  free( lat[0].O[0] ) ;
+  free( lat[0].O ) ;
+  free( lat ) ;
   return ;
 }
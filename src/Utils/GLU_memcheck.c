@@ -34,7 +34,7 @@
   #endif
 static double page_size , MemTotal , MemFree , gauge_fields , gtrans_mats , 
               lat_element , sublat_element ;
-static int HYP = -1 , WF = -1 , LGF = -1 , IO = -1 , GFIELDS = -1 , CGF = -1 ;
+static int HYP = -1 , WF = -1 , LGF = -1 , GFIELDS = -1 , CGF = -1 ;
 
 // call to the OS to request what memory size we have
 static void
@@ -44,8 +44,8 @@ check_mem( void )
   page_size = (double)sysconf( _SC_PAGESIZE ) ; 
   MemTotal = sysconf(_SC_PHYS_PAGES) * page_size ; 
   MemFree = (double)sysconf( _SC_AVPHYS_PAGES ) * page_size ; 
-  gauge_fields = GLU_size * (double)LVOLUME * ( NCNC * ND ) * GB + 
-    (double)sizeof( int ) * (double)LVOLUME * ( 2 * ND ) * GB ; // integer neighbours
+  // the neighbour table is shared between all fields so is not counted
+  gauge_fields = GLU_size * (double)LVOLUME * ( NCNC * ND ) * GB ;
   gtrans_mats = (double)LVOLUME * GLU_size * ( NCNC ) * GB ;
   // lattice sites in GB
   lat_element = GLU_size * (double)LVOLUME * GB ;
@@ -124,8 +124,9 @@ have_memory_hyp( const struct sm_info SMINFO )
     //calculate what our most expensive HYP 4D is :: SOMETHING close to this
     const double expensive_less =  (double)NCNC * ND * sizeof( GLU_complex ) * 
       ( LVOLUME * 7./3. + 7. * LCU ) * GB ;
+    // the gauge field and nine slices of ND*(ND-1) decorated links
     const double expensive_more =  (double)NCNC * ND * sizeof( GLU_complex ) * 
-      ( LVOLUME * 7. + 3. * LCU ) * GB ;
+      ( LVOLUME + 9. * ( ND - 1 ) * LCU ) * GB ;
     
     #ifdef DANGEROUS 
     const double free_memory = MemTotal * GB ;
@@ -207,69 +208,72 @@ have_memory_Lgf( void )
   return GF ;
 } 
 
-// checks which Landau gauge fixing routine is called
-short int 
-have_memory_readers_writers( const GLU_output config_type )
+// can we keep a copy of the links around for the Landau restarts
+short int
+have_memory_snapshot( const GF_snapshot snapshot )
 {
-  int CONFIG = FAST ;
+  int SNAP = GLU_SUCCESS ;
 #ifdef HAVE_UNISTD_H
-  if( IO == -1 ) {
-    check_mem( ) ;
-    
-    double expensive_more , expensive_less ;
-    
-    #ifdef DANGEROUS
-    const double free_memory = MemTotal * GB ;
-    #else
-    const double free_memory = MemFree * GB ;
-    #endif
+  check_mem( ) ;
+  #ifdef DANGEROUS
+  const double free_memory = MemTotal * GB ;
+  #else
+  const double free_memory = MemFree * GB ;
+  #endif
+  // the snapshot sits on top of the most expensive Landau fixer
+  const double expensive_less = gauge_fields + gtrans_mats +
+    TRUE_HERM * lat_element * 2.0 ;
+  double expensive_more = expensive_less ;
+  switch( snapshot ) {
+  case GF_SNAPSHOT_NONE :
+    return GLU_SUCCESS ;
+  case GF_SNAPSHOT_FULL :
+    expensive_more += gauge_fields ;
+    break ;
+  case GF_SNAPSHOT_SMALL :
+    expensive_more += (double)sizeof( GLU_real ) *
+      ( (double)LVOLUME * ( ND * ( NCNC - 1 ) ) ) * GB ;
+    break ;
+  }
+  print_info( "GF" , free_memory , expensive_more , expensive_less ) ;
+  if( expensive_more > free_memory ) {
+    fprintf( stdout , "[GF] Not enough memory for the restart snapshot, "
+	     "restarts will reread the file\n" ) ;
+    SNAP = GLU_FAILURE ;
+  }
+#endif
+  return SNAP ;
+}
 
-    // check to make sure we can fit gauge field and the malloc
-    IO = FAST ;
-    switch( config_type ) 
-      {
-      case OUTPUT_SMALL :
-	expensive_more = gauge_fields + (double)sizeof( double ) * ( (double)LVOLUME * ( ND * ( NCNC - 1 ) ) ) * GB ;
-	expensive_less = gauge_fields + (double)sizeof( double ) * ( (double)( ND * ( NCNC - 1 ) ) ) * GB ;
-	print_info( "IO" , free_memory , expensive_more , expensive_less ) ;
-	if( expensive_more < free_memory ) {
-	  return FAST ;
-	} else { 
-	  IO = SLOW ;
-	  return SLOW ;
-	}
-      case OUTPUT_GAUGE :
-	expensive_more = gauge_fields + (double)sizeof( double complex ) * ( (double)LVOLUME * ( ND * NC * ( NC - 1 ) ) ) * GB ;
-	expensive_less = gauge_fields + (double)sizeof( double complex ) * ( (double)( ND * NC * ( NC - 1 ) ) ) * GB ;
-	print_info( "IO" , free_memory , expensive_more , expensive_less ) ;
-	if( expensive_more < free_memory ) {
-	  return FAST ;
-	} else { 
-	  IO = SLOW ;
-	  return SLOW ;
-	}
-      case OUTPUT_MILC :
-      case OUTPUT_SCIDAC :
-      case OUTPUT_ILDG :
-      case OUTPUT_NCxNC :
-	expensive_more = 2.0 * gauge_fields ; 
-	expensive_less = gauge_fields + (double) sizeof( double complex ) * ( (double)( ND * NCNC ) ) * GB ;
-	print_info( "IO" , free_memory , expensive_more , expensive_less ) ;
-	if( expensive_more < free_memory ) {
-	  return FAST ;
-	} else { 
-	  IO = SLOW ;
-	  return SLOW ;
-	}
-      case OUTPUT_HIREP :
-	return FAST ;
-      default :
-	return SLOW ;
-      } 
-  } else { CONFIG = IO ; }
+// how many Gribov copies we can fix at once
+size_t
+have_memory_luxury( const size_t max_teams )
+{
+  size_t Nteams = max_teams ;
+#ifdef HAVE_UNISTD_H
+  check_mem( ) ;
+  #ifdef DANGEROUS
+  const double free_memory = MemTotal * GB ;
+  #else
+  const double free_memory = MemFree * GB ;
+  #endif
+  // the field, the best copy and the random transform are shared
+  const double shared = 2 * gauge_fields + gtrans_mats ;
+  // each team has a copy, its FFT arrays, psq and the CG directions
+  const double per_team = gauge_fields + ( 4 * TRUE_HERM + 1 ) * lat_element ;
+
+  print_info( "GF" , free_memory , shared + max_teams * per_team ,
+	      shared + per_team ) ;
+  while( Nteams > 1 && shared + Nteams * per_team > free_memory ) {
+    Nteams-- ;
+  }
+  if( Nteams < max_teams ) {
+    fprintf( stdout , "[GF] Memory limits us to %zu Gribov copy team(s)\n" ,
+	     Nteams ) ;
+  }
 #endif
-  return CONFIG ;
-} 
+  return Nteams ;
+}
 
 // checks which wilson flow routine is called
 short int 
@@ -293,6 +297,11 @@ have_memory_wf( const struct sm_info SMINFO )
       expensive_less += gauge_fields ;
       expensive_more += gauge_fields ;
     }
+    // the embedded one also keeps the first stage's Z
+    if( SMINFO.type == SM_EMBEDWFLOW_LOG || SMINFO.type == SM_EMBEDWFLOW_STOUT ) {
+      expensive_less += gauge_fields + TRUEHERM * lat_element * ND ;
+      expensive_more += gauge_fields + TRUEHERM * lat_element * ND ;
+    }
 
     #ifdef DANGEROUS
     const double free_memory = MemTotal * GB ;
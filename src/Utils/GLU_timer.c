@@ -40,8 +40,14 @@
    @var t1
    @brief the time in microseconds in double precision
  */
+#if (defined __STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+// per thread so the checkpoint writer does not reset our timings
+static _Thread_local struct timeval GLUtimer ;
+static _Thread_local double t1 ;
+#else
 static struct timeval GLUtimer ;
 static double t1 ;
+#endif
 
 // print to stdout the time elapsed in seconds
 double
@@ -61,6 +67,15 @@ start_timer( void )
   t1 = GLUtimer.tv_sec + ( GLUtimer.tv_usec / 1E6 ) ;
   return ;
 }
+
+// wall-clock time in seconds, leaves the timer above alone
+double
+wall_time( void )
+{
+  struct timeval now ;
+  gettimeofday( &now , NULL ) ;
+  return now.tv_sec + ( now.tv_usec / 1E6 ) ;
+}
 #else // do nothing
 
 double
@@ -69,6 +84,9 @@ print_time( void ) { return 0.0 ; }
 void
 start_timer( void ) { return ; }
 
+double
+wall_time( void ) { return 0.0 ; }
+
 #endif
 
 // functions for the date
@@ -0,0 +1,198 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (cpu_dispatch.c) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file cpu_dispatch.c
+   @brief run-time selection of the SU(3) matrix kernels
+ */
+#include "Mainfile.h"
+
+#include "cpu_dispatch.h"
+#include "gramschmidt.h"  // gram_reunit()
+#include "lanes.h"        // staples_lanes() and friends
+#include "str_stuff.h"    // are_equal()
+
+// backend the table currently points to
+static GLU_simd current = SIMD_GENERIC ;
+
+#ifdef GLU_DISPATCH
+
+// the kernel table, starts off generic so anything called before
+// init_cpu_dispatch() still works
+void (*multab_suNC)( GLU_complex a[ NCNC ] ,
+		     const GLU_complex b[ NCNC ] ,
+		     const GLU_complex c[ NCNC ] ) = multab_suNC_generic ;
+void (*multab_dag_suNC)( GLU_complex a[ NCNC ] ,
+			 const GLU_complex b[ NCNC ] ,
+			 const GLU_complex c[ NCNC ] ) = multab_dag_suNC_generic ;
+void (*multabdag_suNC)( GLU_complex a[ NCNC ] ,
+			const GLU_complex b[ NCNC ] ,
+			const GLU_complex c[ NCNC ] ) = multabdag_suNC_generic ;
+double (*Re_trace_abc_dag_suNC)( const GLU_complex a[ NCNC ] ,
+				 const GLU_complex b[ NCNC ] ,
+				 const GLU_complex c[ NCNC ] ) =
+  Re_trace_abc_dag_suNC_generic ;
+void (*trace_abc)( GLU_complex *__restrict tr ,
+		   const GLU_complex a[ NCNC ] ,
+		   const GLU_complex b[ NCNC ] ,
+		   const GLU_complex c[ NCNC ] ) = trace_abc_generic ;
+void (*trace_abc_dag)( GLU_complex *__restrict tr ,
+		       const GLU_complex a[ NCNC ] ,
+		       const GLU_complex b[ NCNC ] ,
+		       const GLU_complex c[ NCNC ] ) = trace_abc_dag_generic ;
+void (*trace_abc_dag_Re)( GLU_real *__restrict tr ,
+			  const GLU_complex a[ NCNC ] ,
+			  const GLU_complex b[ NCNC ] ,
+			  const GLU_complex c[ NCNC ] ) = trace_abc_dag_Re_generic ;
+void (*gram_reunit)( GLU_complex *__restrict U ) = gram_reunit_generic ;
+void (*exponentiate)( GLU_complex U[ NCNC ] ,
+		      const GLU_complex Q[ NCNC ] ) = exponentiate_generic ;
+void (*staples_lanes)( GLU_complex stap[ STAPLE_LANES ][ NCNC ] ,
+		       const struct site *__restrict lat ,
+		       const size_t site[ STAPLE_LANES ] ,
+		       const size_t n ,
+		       const size_t mu ,
+		       const size_t dir ) = staples_lanes_generic ;
+void (*plaquettes_lanes)( double plaq[ STAPLE_LANES ][ 2 ] ,
+			  const struct site *__restrict lat ,
+			  const size_t site[ STAPLE_LANES ] ) =
+  plaquettes_lanes_generic ;
+void (*clover_lanes)( GLU_complex sum[ STAPLE_LANES ][ NCNC ] ,
+		      double plaq[ STAPLE_LANES ] ,
+		      const struct site *__restrict lat ,
+		      const size_t site[ STAPLE_LANES ] ,
+		      const size_t mu ,
+		      const size_t nu ) = clover_lanes_generic ;
+
+// point every entry at one backend's versions
+#define SET_KERNELS( ISA )				\
+  multab_suNC = multab_suNC_##ISA ;			\
+  multab_dag_suNC = multab_dag_suNC_##ISA ;		\
+  multabdag_suNC = multabdag_suNC_##ISA ;		\
+  Re_trace_abc_dag_suNC = Re_trace_abc_dag_suNC_##ISA ;	\
+  trace_abc = trace_abc_##ISA ;				\
+  trace_abc_dag = trace_abc_dag_##ISA ;			\
+  trace_abc_dag_Re = trace_abc_dag_Re_##ISA ;		\
+  gram_reunit = gram_reunit_##ISA ;			\
+  exponentiate = exponentiate_##ISA ;			\
+  staples_lanes = staples_lanes_##ISA ;			\
+  plaquettes_lanes = plaquettes_lanes_##ISA ;		\
+  clover_lanes = clover_lanes_##ISA ;
+
+#endif
+
+// is this backend compiled in and supported by the CPU?
+GLU_bool
+simd_available( const GLU_simd backend )
+{
+  switch( backend ) {
+  case SIMD_GENERIC : return GLU_TRUE ;
+#ifdef GLU_DISPATCH
+  case SIMD_AVX2 :
+    __builtin_cpu_init( ) ;
+    return __builtin_cpu_supports( "avx2" ) &&
+      __builtin_cpu_supports( "fma" ) ? GLU_TRUE : GLU_FALSE ;
+  case SIMD_AVX512 :
+    __builtin_cpu_init( ) ;
+    return __builtin_cpu_supports( "avx512f" ) &&
+      __builtin_cpu_supports( "avx2" ) &&
+      __builtin_cpu_supports( "fma" ) ? GLU_TRUE : GLU_FALSE ;
+#endif
+  default : return GLU_FALSE ;
+  }
+}
+
+// backend the kernels point to
+GLU_simd
+simd_backend( void )
+{
+  return current ;
+}
+
+// printable name
+const char *
+simd_name( const GLU_simd backend )
+{
+  switch( backend ) {
+  case SIMD_AVX2 : return "AVX2" ;
+  case SIMD_AVX512 : return "AVX-512" ;
+  case SIMD_GENERIC :
+  default :
+#if (defined HAVE_IMMINTRIN_H) && !(defined SINGLE_PREC)
+    return "generic (SSE2)" ;
+#else
+    return "generic (C)" ;
+#endif
+  }
+}
+
+// point the kernel table at "backend"
+int
+set_simd_backend( const GLU_simd backend )
+{
+  if( simd_available( backend ) == GLU_FALSE ) {
+    fprintf( stderr , "[SIMD] %s kernels are not available on this node\n" ,
+	     simd_name( backend ) ) ;
+    return GLU_FAILURE ;
+  }
+#ifdef GLU_DISPATCH
+  switch( backend ) {
+  case SIMD_AVX512 : SET_KERNELS( AVX512 ) ; break ;
+  case SIMD_AVX2 : SET_KERNELS( AVX2 ) ; break ;
+  case SIMD_GENERIC : SET_KERNELS( generic ) ; break ;
+  }
+#endif
+  current = backend ;
+  return GLU_SUCCESS ;
+}
+
+// widest available backend unless GLU_SIMD says otherwise
+void
+init_cpu_dispatch( void )
+{
+  GLU_simd backend = SIMD_GENERIC ;
+  if( simd_available( SIMD_AVX512 ) == GLU_TRUE ) {
+    backend = SIMD_AVX512 ;
+  } else if( simd_available( SIMD_AVX2 ) == GLU_TRUE ) {
+    backend = SIMD_AVX2 ;
+  }
+  const char *env = getenv( "GLU_SIMD" ) ;
+  if( env != NULL ) {
+    GLU_simd request = backend ;
+    if( are_equal( env , "generic" ) ) {
+      request = SIMD_GENERIC ;
+    } else if( are_equal( env , "avx2" ) ) {
+      request = SIMD_AVX2 ;
+    } else if( are_equal( env , "avx512" ) ) {
+      request = SIMD_AVX512 ;
+    } else {
+      fprintf( stderr , "[SIMD] unrecognised GLU_SIMD=%s, ignoring it\n" ,
+	       env ) ;
+    }
+    if( simd_available( request ) == GLU_TRUE ) {
+      backend = request ;
+    } else {
+      fprintf( stderr , "[SIMD] %s kernels are not available on this node\n" ,
+	       simd_name( request ) ) ;
+    }
+  }
+  set_simd_backend( backend ) ;
+  fprintf( stdout , "[INIT] using %s SU(%d) kernels\n" ,
+	   simd_name( backend ) , NC ) ;
+  return ;
+}
@@ -0,0 +1,239 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (par_THREEFRY.c) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file par_THREEFRY.c
+   @brief counter-based Threefry2x64-13 rng of Salmon et al, SC11
+
+   The number we get is a function of the key ( seed ) and a counter
+   ( draw , pass , site , mu ) only. Updates that seek to the site and
+   direction they are working on get the same numbers whatever thread
+   does the work, so the result does not depend on the number of threads.
+   Draws that never seek use a per-thread counter with ~thread in place
+   of the site and direction
+
+   We generate THREEFRY_BLOCKS consecutive blocks at a time so that the
+   rounds of independent blocks overlap and hand them out 32 bits at a
+   time, the same as the other generators
+ */
+#include "Mainfile.h"
+
+#include "GLU_bswap.h"    // bswap_32
+#include "GLU_malloc.h"   // GLU_malloc()
+#include "par_THREEFRY.h" // alphabetising
+
+// number of 2-word blocks generated at once
+#define THREEFRY_BLOCKS (2)
+
+// 32-bit numbers we get out of them
+#define THREEFRY_NOUT (4*THREEFRY_BLOCKS)
+
+// per-thread stream, padded to a cache line
+struct threefry_stream {
+  uint32_t out[ THREEFRY_NOUT ] ;
+  uint64_t ctr[2] ;
+  uint32_t idx ;
+  uint32_t pad[ 11 - THREEFRY_NOUT ] ;
+} ;
+
+static struct threefry_stream *streams = NULL ;
+static uint32_t key[2] ;
+static uint32_t pass ;
+
+// one mix of every block, r is the rotation of this round
+#define ROUND(r)						\
+  for( b = 0 ; b < THREEFRY_BLOCKS ; b++ ) {			\
+    x0[b] += x1[b] ;						\
+    x1[b] = ( ( x1[b] << (r) ) | ( x1[b] >> ( 64 - (r) ) ) ) ^ x0[b] ;	\
+  }
+
+// key injection after every fourth round
+#define INJECT(s)						\
+  for( b = 0 ; b < THREEFRY_BLOCKS ; b++ ) {			\
+    x0[b] += ks[ (s) % 3 ] ;					\
+    x1[b] += ks[ ( (s) + 1 ) % 3 ] + (s) ;			\
+  }
+
+// thirteen rounds of threefry on counters ( c[0]+b , c[1] )
+static void
+threefry2x64( uint32_t out[ THREEFRY_NOUT ] ,
+	      const uint64_t c[2] )
+{
+  const uint64_t ks[3] = { key[0] , key[1] ,
+			   0x1BD11BDAA9FC1A22ULL ^ key[0] ^ key[1] } ;
+  uint64_t x0[ THREEFRY_BLOCKS ] , x1[ THREEFRY_BLOCKS ] ;
+  size_t b ;
+  for( b = 0 ; b < THREEFRY_BLOCKS ; b++ ) {
+    x0[b] = c[0] + b + ks[0] ; x1[b] = c[1] + ks[1] ;
+  }
+  ROUND(16) ROUND(42) ROUND(12) ROUND(31) INJECT(1)
+  ROUND(16) ROUND(32) ROUND(24) ROUND(21) INJECT(2)
+  ROUND(16) ROUND(42) ROUND(12) ROUND(31) INJECT(3)
+  ROUND(16)
+  for( b = 0 ; b < THREEFRY_BLOCKS ; b++ ) {
+    out[ 4*b ]     = (uint32_t)x0[b] ; out[ 4*b + 1 ] = (uint32_t)( x0[b] >> 32 ) ;
+    out[ 4*b + 2 ] = (uint32_t)x1[b] ; out[ 4*b + 3 ] = (uint32_t)( x1[b] >> 32 ) ;
+  }
+  return ;
+}
+
+#undef ROUND
+#undef INJECT
+
+// generate the next blocks and move the counter on
+static void
+refill( struct threefry_stream *s )
+{
+  threefry2x64( s -> out , s -> ctr ) ;
+  s -> ctr[0] += THREEFRY_BLOCKS ;
+  s -> idx = 0 ;
+  return ;
+}
+
+// next 32 bits of the stream
+static inline uint32_t
+par_THREEFRY( struct threefry_stream *s )
+{
+  if( s -> idx == THREEFRY_NOUT ) {
+    refill( s ) ;
+  }
+  return s -> out[ s -> idx++ ] ;
+}
+
+// set the per-thread streams to their unseeked counters
+static void
+reset_streams( void )
+{
+  size_t i ;
+  for( i = 0 ; i < Latt.Nthreads ; i++ ) {
+    streams[i].ctr[0] = (uint64_t)pass << 32 ;
+    streams[i].ctr[1] = ~(uint64_t)i ;
+    streams[i].idx = THREEFRY_NOUT ;
+  }
+  return ;
+}
+
+// allocate the streams
+static int
+allocate_streams( void )
+{
+  if( GLU_malloc( (void**)&streams , 64 , Latt.Nthreads *
+		  sizeof( struct threefry_stream ) ) != 0 ) {
+    fprintf( stderr , "[PAR_RNG] Threefry stream allocation failure\n" ) ;
+    return GLU_FAILURE ;
+  }
+  return GLU_SUCCESS ;
+}
+
+void
+free_par_THREEFRY( void )
+{
+  if( streams != NULL ) {
+    free( streams ) ;
+  }
+  streams = NULL ;
+  return ;
+}
+
+void
+GLU_set_par_THREEFRY_table( const uint32_t seed[ Latt.Nthreads ] )
+{
+  // the other seeds are seed[0]+thread, we only need the one
+  key[0] = seed[0] ;
+  key[1] = 0x474C55U ;
+  pass = 0 ;
+  if( allocate_streams( ) == GLU_FAILURE ) {
+    return ;
+  }
+  reset_streams( ) ;
+  return ;
+}
+
+double
+par_THREEFRY_dbl( const uint32_t thread )
+{
+  struct threefry_stream *s = &streams[ thread ] ;
+#ifdef FULL_DOUBLE
+  // same packing as the other generators
+  const uint64_t hi = par_THREEFRY( s ) , lo = par_THREEFRY( s ) ;
+  const uint64_t bits = ( ( ( hi << 32 ) | lo ) >> 12 ) | 0x3FF0000000000000ULL ;
+  double x ;
+  memcpy( &x , &bits , sizeof( double ) ) ;
+  return x - 1.0 ;
+#else
+  return (double)( par_THREEFRY( s ) * 2.3283064365386963e-10 ) ;
+#endif
+}
+
+void
+par_THREEFRY_pass( void )
+{
+  #pragma omp atomic
+  pass++ ;
+  return ;
+}
+
+void
+par_THREEFRY_seek( const uint32_t thread ,
+		 const size_t site ,
+		 const size_t mu )
+{
+  struct threefry_stream *s = &streams[ thread ] ;
+  // 2^32 blocks per ( site , mu ) a pass, 2^48 sites and 2^16 directions
+  s -> ctr[0] = (uint64_t)pass << 32 ;
+  s -> ctr[1] = (uint64_t)site | ( (uint64_t)mu << 48 ) ;
+  s -> idx = THREEFRY_NOUT ;
+  return ;
+}
+
+// read the key and the pass
+int
+read_par_THREEFRY_table( FILE *rng_file )
+{
+  uint32_t state[3] ;
+  if( fread( state , sizeof( uint32_t ) , 3 , rng_file ) != 3 ) {
+    fprintf( stderr , "[PAR_RNG] file read failure\n" ) ;
+    return GLU_FAILURE ;
+  }
+  if( !WORDS_BIGENDIAN ) {
+    bswap_32( 3 , state ) ;
+  }
+  key[0] = state[0] ;
+  key[1] = state[1] ;
+  pass   = state[2] ;
+  if( allocate_streams( ) == GLU_FAILURE ) {
+    return GLU_FAILURE ;
+  }
+  reset_streams( ) ;
+  return GLU_SUCCESS ;
+}
+
+// write the key and the pass, that is all the state there is
+void
+write_par_THREEFRY_table( FILE *rng_file )
+{
+  uint32_t state[3] = { key[0] , key[1] , pass } ;
+  if( !WORDS_BIGENDIAN ) {
+    bswap_32( 3 , state ) ;
+  }
+  fwrite( state , sizeof( uint32_t ) , 3 , rng_file ) ;
+  return ;
+}
+
+#undef THREEFRY_BLOCKS
+#undef THREEFRY_NOUT
@@ -29,9 +29,11 @@
 #include "chklat_stuff.h" // reading a NERSC header
 #include "GLU_bswap.h"    // for byte swapping
 #include "par_rng.h"      // alphabetising
+#include "lane_math.h"    // lane_log() and lane_sincos2pi()
 #include "par_KISS.h"     // parallel KISS generator
 #include "par_MWC_1038.h" // parallel MWC generator
 #include "par_MWC_4096.h" // parallel MWC generator
+#include "par_THREEFRY.h" // counter-based Threefry generator
 #include "par_XOR_1024.h" // parallel XOR generator
 #include "par_WELL_512.h" // parallel well rng
 
@@ -55,6 +57,8 @@ initialise_par_rng( const char *rng_file )
     fprintf( stdout , "[PAR_RNG] XOR_1024\n" ) ;
 #elif (defined WELL_512_RNG)
     fprintf( stdout , "[PAR_RNG] WELL_512\n" ) ;
+#elif (defined THREEFRY_RNG)
+    fprintf( stdout , "[PAR_RNG] THREEFRY\n" ) ;
 #else
     fprintf( stdout , "[PAR_RNG] MWC_4096\n" ) ;
 #endif
@@ -105,11 +109,14 @@ initialise_par_rng( const char *rng_file )
       GLU_set_par_XOR_1024_table( Seeds ) ;
       #elif (defined WELL_512_RNG)
       GLU_set_par_WELL_512_table( Seeds ) ;
+      #elif (defined THREEFRY_RNG)
+      GLU_set_par_THREEFRY_table( Seeds ) ;
       #else
       GLU_set_par_MWC_4096_table( Seeds ) ;
       #endif
 
-      // warm up the rng
+      // warm up the rng, a counter-based one does not need it
+      #ifndef THREEFRY_RNG
       #pragma omp parallel for private(i)
       for( i = 0 ; i < Latt.Nthreads ; i++ ) {
 	size_t j ;
@@ -119,6 +126,7 @@ initialise_par_rng( const char *rng_file )
 	}
       }
       fprintf( stdout , "[PAR_RNG] warmed up\n" ) ;
+      #endif
 
       // free the seeds
       free( Seeds ) ;
@@ -146,6 +154,8 @@ free_par_rng( void )
     free_par_MWC_1038( ) ;
 #elif (defined WELL_512_RNG)
     free_par_WELL_512( ) ;
+#elif (defined THREEFRY_RNG)
+    free_par_THREEFRY( ) ;
 #else
     free_par_MWC_4096( ) ;
 #endif
@@ -154,15 +164,43 @@ free_par_rng( void )
   return ;
 }
 
-// generate a random NCxNC matrix ... Use gaussian numbers?
+// generate a random NCxNC matrix of gaussian numbers
 void 
 par_generate_NCxNC( GLU_complex U[ NCNC ] , 
 		    const uint32_t thread )
 {
-  int i ;
-  for( i = 0 ; i < NCNC ; i++ ) {
-    // gaussians
-    U[i] = par_polar_box( thread ) ;
+  par_gaussian_array( U , NCNC , thread ) ;
+  return ;
+}
+
+// fill z with complex gaussians, box-muller on blocks of uniforms
+void
+par_gaussian_array( GLU_complex *z ,
+		    const size_t n ,
+		    const uint32_t thread )
+{
+  double u[ 2*PAR_RNG_BLOCK ] , r[ PAR_RNG_BLOCK ] ;
+  size_t i , j ;
+  for( i = 0 ; i < n ; i += PAR_RNG_BLOCK ) {
+    const size_t m = ( n - i ) < PAR_RNG_BLOCK ? ( n - i ) : PAR_RNG_BLOCK ;
+    GLU_real *pz = (GLU_real*)( z + i ) ;
+    par_rng_dbl_array( u , 2*m , thread ) ;
+    // 1 - u is in (0,1] so the log is finite
+    #pragma omp simd
+    for( j = 0 ; j < m ; j++ ) {
+      r[j] = -lane_log( 1.0 - u[j] ) ;
+    }
+    // sqrt sets errno, which stops the loop above vectorising
+    for( j = 0 ; j < m ; j++ ) {
+      r[j] = sqrt( r[j] ) ;
+    }
+    #pragma omp simd
+    for( j = 0 ; j < m ; j++ ) {
+      double s , c ;
+      lane_sincos2pi( u[ m + j ] , &s , &c ) ;
+      pz[ 2*j ]     = (GLU_real)( r[j] * c ) ;
+      pz[ 2*j + 1 ] = (GLU_real)( r[j] * s ) ;
+    }
   }
   return ;
 }
@@ -199,11 +237,49 @@ par_rng_dbl( const uint32_t thread )
   return par_MWC_1038_dbl( thread ) ;
 #elif (defined WELL_512_RNG)
   return par_Well_512_dbl( thread ) ;
+#elif (defined THREEFRY_RNG)
+  return par_THREEFRY_dbl( thread ) ;
 #else
   return par_MWC_4096_dbl( thread ) ;
 #endif
 }
 
+// fill r with uniform doubles
+void
+par_rng_dbl_array( double *r ,
+		   const size_t n ,
+		   const uint32_t thread )
+{
+  size_t i ;
+  for( i = 0 ; i < n ; i++ ) {
+    r[i] = par_rng_dbl( thread ) ;
+  }
+  return ;
+}
+
+// move the counter-based rng on to a new pass over the lattice, no
+// worksharing here as we can be called by one thread of a team
+void
+par_rng_pass( void )
+{
+#ifdef THREEFRY_RNG
+  par_THREEFRY_pass( ) ;
+#endif
+  return ;
+}
+
+// point thread's draws at the ones for ( site , mu ) in this pass
+void
+par_rng_seek( const uint32_t thread ,
+	      const size_t site ,
+	      const size_t mu )
+{
+#ifdef THREEFRY_RNG
+  par_THREEFRY_seek( thread , site , mu ) ;
+#endif
+  return ;
+}
+
 // accessor for ints
 uint32_t
 par_rng_int( const uint32_t thread )
@@ -237,17 +313,19 @@ read_par_rng_state( const char *infile )
     return init_new_rng_sequence( ) ;
   }
 
-  // check Nthreads
+  // check Nthreads, the counter-based state does not care
   size_t Nthreads ;
   if( get_size_t( "NTHREADS" , hdr , &Nthreads ) == GLU_FAILURE ) {
     fprintf( stderr , "[PAR_RNG] NTHREADS not found in header\n" ) ;
     return init_new_rng_sequence( ) ;
   }
+#ifndef THREEFRY_RNG
   if( Nthreads != (size_t)Latt.Nthreads ) {
     fprintf( stderr , "[PAR_RNG] RNG Nthreads (%zu) not the same as "
 	     "Latt.Nthreads (%u)\n" , Nthreads , Latt.Nthreads ) ;
     return init_new_rng_sequence( ) ;
   }
+#endif
 
   // figure out what RNG we are using and make sure it is consistent
   if( get_string( "RNG" , hdr , &str ) == GLU_FAILURE ) {
@@ -295,6 +373,14 @@ read_par_rng_state( const char *infile )
   if( read_par_WELL_512_table( in ) == GLU_FAILURE ) {
     return GLU_FAILURE ;
   }
+#elif (defined THREEFRY_RNG)
+  if( strcmp(  " PAR_THREEFRY" , str ) ) {
+    fprintf( stderr , "[PAR_RNG] state RNG differs from compiled (THREEFRY) RNG\n" ) ;
+    return init_new_rng_sequence( ) ;
+  }
+  if( read_par_THREEFRY_table( in ) == GLU_FAILURE ) {
+    return GLU_FAILURE ;
+  }
 #else
   if( strcmp(  " PAR_MWC_4096" , str ) ) {
     fprintf( stderr , "[PAR_RNG] state RNG differs from compiled (MWC_4096) RNG\n" ) ;
@@ -310,12 +396,10 @@ read_par_rng_state( const char *infile )
   return GLU_SUCCESS ;
 }
 
-// write out the parallel rng
+// write out the parallel rng to an open stream
 void
-write_par_rng_state( const char *outfile )
+write_par_rng_stream( FILE *out )
 {
-  FILE *out = fopen( outfile , "wb" ) ;
-
   // write out in a NERSC-like header so I can reuse that code
   fprintf( out , "BEGIN_HEADER\n" ) ;
   // write out number of threads
@@ -329,6 +413,8 @@ write_par_rng_state( const char *outfile )
   fprintf( out , "RNG = PAR_XOR_1024\n" ) ;
 #elif (defined MWC_1038_RNG)
   fprintf( out , "RNG = PAR_MWC_1038\n" ) ;
+#elif (defined THREEFRY_RNG)
+  fprintf( out , "RNG = PAR_THREEFRY\n" ) ;
 #else
   fprintf( out , "RNG = PAR_MWC_4096\n" ) ;
 #endif
@@ -344,11 +430,21 @@ write_par_rng_state( const char *outfile )
   write_par_XOR_1024_table( out ) ;
 #elif (defined MWC_1038_RNG)
   write_par_MWC_1038_table( out ) ;
+#elif (defined THREEFRY_RNG)
+  write_par_THREEFRY_table( out ) ;
 #else
   write_par_MWC_4096_table( out ) ;
 #endif
 
-  fclose( out ) ;
+  return ;
+}
 
+// write out the parallel rng
+void
+write_par_rng_state( const char *outfile )
+{
+  FILE *out = fopen( outfile , "wb" ) ;
+  write_par_rng_stream( out ) ;
+  fclose( out ) ;
   return ;
 }
@@ -52,7 +52,7 @@ GF_wrap_coulomb( struct site *lat ,
 	     GFINFO.accuracy , Latt.gf_alpha ) ;
 #else
   // we could check iters if we wanted, actually we do want to
-  Coulomb( lat , GFINFO.accuracy , GFINFO.max_iters ) ; 
+  Coulomb( lat , GFINFO.accuracy , GFINFO.max_iters , GFINFO.Nteams ) ; 
 #endif
 
   print_time() ;
@@ -75,7 +75,8 @@ GF_wrap_landau( struct site *lat ,
 		    GFINFO.accuracy , Latt.gf_alpha ) ;
 #else
   // the memory cheap one wasn't much of a saving so we just use the fast
-  iters = Landau( lat , GFINFO.accuracy , GFINFO.max_iters , infile ) ;
+  iters = Landau( lat , GFINFO.accuracy , GFINFO.max_iters , infile ,
+		  GFINFO.snapshot ) ;
 #endif
   print_time( ) ;
   return iters ;
@@ -168,9 +169,11 @@ print_fixing_info( const struct gf_info GFINFO )
 static void
 output_information( struct site *lat )
 {
+  struct gauge_obs obs ;
+  gauge_obs( &obs , lat , GLU_FALSE ) ;
   fprintf( stdout , "[GF] Tlink %1.15f || Slink %1.15f ||"
 	   " Link %1.15f || Plaq %1.15f \n" , 
-	   t_links(lat) , s_links(lat) , links(lat) , av_plaquette(lat) ) ;
+	   obs.tlink , obs.slink , obs.link , obs.plaq ) ;
   return ;
 }
 
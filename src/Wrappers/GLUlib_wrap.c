@@ -23,6 +23,7 @@
 #include "Mainfile.h"
 
 #include "CUT_wrap.h"       // wrap the cutting operations
+#include "cut_routines.h"   // keep_veclists()
 #include "GLU_memcheck.h"   // basic memory checking
 #include "GF_wrap.h"        // wrap the gauge fixing
 #include "givens.h"         // allocating the su2 submatrices
@@ -30,6 +31,7 @@
 #include "init.h"           // init_latt()
 #include "KPHB.h"           // pseudo-heatbath updates
 #include "OBS_wrap.h"       // standard observable calculations (default)
+#include "plan_ffts.h"      // keep_fftw_plans()
 #include "random_config.h"  // random transform
 #include "read_headers.h"   // read the header data
 #include "read_config.h"    // read the binary configuration and check
@@ -39,6 +41,16 @@
 #include "taylor_logs.h"    // Taylor series brute force logarithm
 #include "writers.h"        // write out a configuration
 
+#ifdef HAVE_GLOB_H
+#include <glob.h>
+#endif
+
+#if (defined HAVE_FCNTL_H) && (defined HAVE_POSIX_FADVISE) && \
+  (defined HAVE_UNISTD_H)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 // allow for some very necessary precomputations ...
 #if NC > 3 
   #include "taylor_logs.h"  // precomputes Taylor series coefficients
@@ -58,9 +70,11 @@ attach_GLU( void )
   return ;
 }
 
-// read a file, has to be out of order because it is called by the others
-struct site*
-read_file( struct head_data *HEAD_DATA , 
+// read a configuration into *lat, allocating it if it is NULL or if
+// the geometry has changed since the last read. On failure *lat is NULL
+static int
+read_into( struct site **lat ,
+	   struct head_data *HEAD_DATA , 
 	   const char *config_in )
 {
   // some additional information
@@ -82,46 +96,65 @@ read_file( struct head_data *HEAD_DATA ,
       fprintf( stdout , "[IO] %s is empty but that is ok \n" , config_in ) ;
     } else {
       fprintf( stderr , "[IO] error opening file :: %s\n" , config_in ) ;
-      return NULL ;
+      free_lat( *lat ) ;
+      *lat = NULL ;
+      return GLU_FAILURE ;
     }
   }
   fprintf( stdout , "[IO] reading file %s\n" , config_in ) ;
+
+  // remember the geometry of a resident field
+  size_t dims[ ND ] , mu ;
+  memcpy( dims , Latt.dims , ND * sizeof( size_t ) ) ;
  
   // initialise the configuration number to zero
   struct head_data tmp ;
   if( read_header( infile , &tmp , GLU_TRUE ) == GLU_FAILURE ) {
     fprintf( stderr , "[IO] Header reading failure\n" ) ;
     fclose( infile ) ;
-    return NULL ;
+    free_lat( *lat ) ;
+    *lat = NULL ;
+    return GLU_FAILURE ;
   } 
 
+  // a different geometry needs a new field and neighbour table
+  for( mu = 0 ; mu < ND && *lat != NULL ; mu++ ) {
+    if( dims[ mu ] != Latt.dims[ mu ] ) {
+      free_lat( *lat ) ;
+      *lat = NULL ;
+      free( Latt.navig ) ;
+      Latt.navig = NULL ;
+    }
+  }
+
   // initialise geometry so that we can use LVOLUME and stuff
   init_latt( ) ;
 
-  // check for having enough memory for the gauge field
-  if( have_memory_gauge( ) == GLU_FAILURE ) {
-    fclose( infile ) ;
-    return NULL ;
-  }
-
-  // malloc our gauge field and initialise our lattice geometry
-  struct site *lat = NULL ;
-  if( ( lat = allocate_lat( ) ) == NULL ) {
-    fprintf( stderr , "[IO] Gauge field allocation failure\n" ) ;
-    return NULL ;
+  if( *lat == NULL ) {
+    // check for having enough memory for the gauge field
+    if( have_memory_gauge( ) == GLU_FAILURE ) {
+      fclose( infile ) ;
+      return GLU_FAILURE ;
+    }
+    // malloc our gauge field and initialise our lattice geometry
+    if( ( *lat = allocate_lat( ) ) == NULL ) {
+      fprintf( stderr , "[IO] Gauge field allocation failure\n" ) ;
+      return GLU_FAILURE ;
+    }
   }
 
 #ifdef SINGLE_PREC
   fprintf( stdout , "[PREC] Single-precision storage for the gauge fields\n" ) ;
 #endif
 
-  const int check = get_config_SUNC( infile , lat , tmp ) ;
+  const int check = get_config_SUNC( infile , *lat , tmp ) ;
   // read in the configuration ...  
   if( check == GLU_FAILURE ) {
     fprintf( stderr , "[IO] File read error ... Leaving \n" ) ;
     fclose( infile ) ;
-    free( lat ) ;
-    return NULL ;
+    free_lat( *lat ) ;
+    *lat = NULL ;
+    return GLU_FAILURE ;
   }
 
   // look at scidac header again to get the checksums
@@ -132,10 +165,11 @@ read_file( struct head_data *HEAD_DATA ,
   }
 
   // have a look at some available checks
-  if( checks( lat , check , tmp ) == GLU_FAILURE ) { 
+  if( checks( *lat , check , tmp ) == GLU_FAILURE ) { 
     fclose( infile ) ;
-    free( lat ) ;
-    return NULL ; 
+    free_lat( *lat ) ;
+    *lat = NULL ;
+    return GLU_FAILURE ; 
   }
 
   // set the header info
@@ -146,7 +180,16 @@ read_file( struct head_data *HEAD_DATA ,
     fclose( infile ) ;
   }
 
-  // and finally set the header data into a constant struct
+  return GLU_SUCCESS ;
+}
+
+// read a file, has to be out of order because it is called by the others
+struct site*
+read_file( struct head_data *HEAD_DATA , 
+	   const char *config_in )
+{
+  struct site *lat = NULL ;
+  read_into( &lat , HEAD_DATA , config_in ) ;
   return lat ;
 }
 
@@ -340,6 +383,171 @@ read_and_U1( const char *infile ,
   return FLAG ;
 }
 
+// ask the kernel to start reading the next configuration into the page cache
+static void
+prefetch_config( const char *config )
+{
+#if (defined HAVE_FCNTL_H) && (defined HAVE_POSIX_FADVISE) && \
+  (defined HAVE_UNISTD_H)
+  const int fd = open( config , O_RDONLY ) ;
+  if( fd == -1 ) return ;
+  posix_fadvise( fd , 0 , 0 , POSIX_FADV_WILLNEED ) ;
+  close( fd ) ;
+#endif
+  return ;
+}
+
+// a glob of configurations or a file listing them one per line
+static char **
+config_list( size_t *Nconfigs ,
+	     const char *configs )
+{
+  char **list = NULL ;
+  *Nconfigs = 0 ;
+#ifdef HAVE_GLOB_H
+  if( strpbrk( configs , "*?[" ) != NULL ) {
+    glob_t g ;
+    if( glob( configs , 0 , NULL , &g ) != 0 ) {
+      fprintf( stderr , "[BATCH] no configurations match %s\n" , configs ) ;
+      return NULL ;
+    }
+    list = malloc( g.gl_pathc * sizeof( char* ) ) ;
+    for( *Nconfigs = 0 ; *Nconfigs < g.gl_pathc ; (*Nconfigs)++ ) {
+      list[ *Nconfigs ] = malloc( strlen( g.gl_pathv[ *Nconfigs ] ) + 1 ) ;
+      strcpy( list[ *Nconfigs ] , g.gl_pathv[ *Nconfigs ] ) ;
+    }
+    globfree( &g ) ;
+    return list ;
+  }
+#endif
+  FILE *file = fopen( configs , "r" ) ;
+  if( file == NULL ) {
+    fprintf( stderr , "[BATCH] cannot open configuration list %s\n" , 
+	     configs ) ;
+    return NULL ;
+  }
+  char line[ 1024 ] ;
+  while( fgets( line , 1024 , file ) != NULL ) {
+    line[ strcspn( line , "\r\n" ) ] = '\0' ;
+    if( line[0] == '\0' || line[0] == '#' ) continue ;
+    list = realloc( list , ( *Nconfigs + 1 ) * sizeof( char* ) ) ;
+    list[ *Nconfigs ] = malloc( strlen( line ) + 1 ) ;
+    strcpy( list[ *Nconfigs ] , line ) ;
+    (*Nconfigs)++ ;
+  }
+  fclose( file ) ;
+  return list ;
+}
+
+// output name, "%s" in the pattern becomes the input's file name,
+// without one the file name is appended after a '.'
+static char *
+output_name( const char *pattern ,
+	     const char *config )
+{
+  const char *base = strrchr( config , '/' ) ;
+  base = ( base == NULL ) ? config : base + 1 ;
+  const char *sub = strstr( pattern , "%s" ) ;
+  char *name = malloc( strlen( pattern ) + strlen( base ) + 2 ) ;
+  if( sub == NULL ) {
+    sprintf( name , "%s.%s" , pattern , base ) ;
+  } else {
+    memcpy( name , pattern , sub - pattern ) ;
+    sprintf( name + ( sub - pattern ) , "%s%s" , base , sub + 2 ) ;
+  }
+  return name ;
+}
+
+// runs INFILE over many configurations keeping the field resident
+int
+batch_wrap( const char *configs ,
+	    const char *out_pattern ,
+	    const struct infile_data INFILE )
+{
+  if( INFILE.mode == MODE_HEATBATH ) {
+    fprintf( stderr , "[BATCH] the heatbath does not run in batch mode\n" ) ;
+    return GLU_FAILURE ;
+  }
+  size_t Nconfigs , n , Nfailed = 0 ;
+  char **list = config_list( &Nconfigs , configs ) ;
+  if( list == NULL ) return GLU_FAILURE ;
+  fprintf( stdout , "[BATCH] %zu configuration(s)\n" , Nconfigs ) ;
+
+  // plans and momentum lists survive between configurations
+#ifdef HAVE_FFTW3_H
+  keep_fftw_plans( ) ;
+#endif
+  keep_veclists( ) ;
+
+  struct site *lat = NULL ;
+  for( n = 0 ; n < Nconfigs ; n++ ) {
+    fprintf( stdout , "\n[BATCH] configuration %zu of %zu :: %s\n" , 
+	     n + 1 , Nconfigs , list[n] ) ;
+    struct head_data HEAD_DATA ;
+    const int read = read_into( &lat , &HEAD_DATA , list[n] ) ;
+
+    // the disk can get on with the next one while we work
+    if( n + 1 < Nconfigs ) {
+      prefetch_config( list[ n + 1 ] ) ;
+    }
+    if( read == GLU_FAILURE ) {
+      Nfailed++ ;
+      continue ;
+    }
+
+    // reseed so each configuration gets what a lone run would give it
+    free_par_rng( ) ;
+
+    if( INFILE.rtrans == GLU_TRUE && INFILE.mode != MODE_CUTS ) {
+      random_gtrans( lat ) ;
+    }
+
+    switch( INFILE.mode ) {
+    case MODE_GF :
+      GF_wrap( list[n] , lat , INFILE.GFINFO , HEAD_DATA ) ;
+      break ;
+    case MODE_CUTS :
+      cuts_wrap_struct( lat , INFILE.CUTINFO , INFILE.SMINFO ) ;
+      break ;
+    case MODE_SMEARING :
+      SM_wrap_struct( lat , INFILE.SMINFO ) ;
+      break ;
+    case MODE_CROSS_U1 :
+      suNC_cross_u1( lat , INFILE.U1INFO ) ;
+      break ;
+    default :
+      gauge( lat ) ;
+      break ;
+    }
+
+    if( out_pattern != NULL && INFILE.mode != MODE_CUTS ) {
+      char *outfile = output_name( out_pattern , list[n] ) ;
+      if( write_configuration( lat , outfile , INFILE.storage , 
+			       INFILE.output_details ) == GLU_FAILURE ) {
+	Nfailed++ ;
+      }
+      free( outfile ) ;
+    }
+  }
+
+  free_lat( lat ) ;
+#ifdef HAVE_FFTW3_H
+  release_fftw_plans( ) ;
+#endif
+  release_veclists( ) ;
+  for( n = 0 ; n < Nconfigs ; n++ ) {
+    free( list[n] ) ;
+  }
+  free( list ) ;
+
+  if( Nfailed != 0 ) {
+    fprintf( stderr , "[BATCH] %zu of %zu configuration(s) failed\n" , 
+	     Nfailed , Nconfigs ) ;
+    return GLU_FAILURE ;
+  }
+  return GLU_SUCCESS ;
+}
+
 // free whatever memory we have allocated
 void
 unstick_GLU( void )
@@ -20,7 +20,7 @@
    @file OBS_wrap.c
    @brief wraps many observable calculations into one
 
-   calls av_plaquette() is_unitary() poly() s_plaq() t_plaq() links() s_links() t_links()
+   calls gauge_obs() is_unitary() poly()
  */
 #include "Mainfile.h"
 
@@ -131,9 +131,9 @@ print_invariant_loops( const struct site *__restrict lat )
   for( i = 0 ; i < LVOLUME ; i++ ) {
     size_t mu , nu , t , s ;
     for( mu = 1 ; mu < ND ; mu++ ) {
-      t = lat[i].neighbor[mu] ; 
+      t = site_fwd( i , mu ) ; 
       for( nu = 0 ; nu < mu ; nu++ ) {
-	s = lat[i].neighbor[nu] ;
+	s = site_fwd( i , nu ) ;
 	const double face = complete_plaquette( lat[ i ].O[mu] , 
 						lat[ t ].O[nu] , 
 						lat[ s ].O[mu] , 
@@ -198,15 +198,17 @@ gauge( const struct site *__restrict lat )
   start_timer( ) ;
 
   fprintf( stdout , "\n" ) ;
-  double splaq , tplaq , plaq = all_plaquettes( lat , &splaq , &tplaq ) ;
-  fprintf( stdout , "[PLAQS SU(%d)]          :: %1.15f \n" , NC , plaq ) ;
-  fprintf( stdout , "[PLAQS SU(%d) spatial]  :: %1.15f \n" , NC , splaq ) ;
-  fprintf( stdout , "[PLAQS SU(%d) temporal] :: %1.15f \n" , NC , tplaq ) ;
+  // plaquettes and links in one sweep
+  struct gauge_obs obs ;
+  gauge_obs( &obs , lat , GLU_FALSE ) ;
+  fprintf( stdout , "[PLAQS SU(%d)]          :: %1.15f \n" , NC , 
+	   0.5 * ( obs.splaq + obs.tplaq ) ) ;
+  fprintf( stdout , "[PLAQS SU(%d) spatial]  :: %1.15f \n" , NC , obs.splaq ) ;
+  fprintf( stdout , "[PLAQS SU(%d) temporal] :: %1.15f \n" , NC , obs.tplaq ) ;
   fprintf( stdout , "\n" ) ;
-  double slink , tlink , link = all_links( lat , &slink , &tlink ) ;
-  fprintf( stdout , "[LINKS SU(%d)]          :: %1.15f \n" , NC , link ) ;
-  fprintf( stdout , "[LINKS SU(%d) spatial]  :: %1.15f \n" , NC , slink ) ;
-  fprintf( stdout , "[LINKS SU(%d) temporal] :: %1.15f \n" , NC , tlink ) ;
+  fprintf( stdout , "[LINKS SU(%d)]          :: %1.15f \n" , NC , obs.link ) ;
+  fprintf( stdout , "[LINKS SU(%d) spatial]  :: %1.15f \n" , NC , obs.slink ) ;
+  fprintf( stdout , "[LINKS SU(%d) temporal] :: %1.15f \n" , NC , obs.tlink ) ;
   fprintf( stdout , "\n") ;
 
   // gauge invariance checks and what have you
@@ -28,7 +28,7 @@
  */
 #include "Mainfile.h"
 
-#include "4D_fast.h"        // excessively uses temporaries for precomuputation
+#include "4D_fast.h"        // fastest 4D hypercubic blocking
 #include "adaptive_flow.h"  // adaptive wilson flow routine
 #include "GLU_memcheck.h"   // memory checking
 #include "GLU_timer.h"      // timing functions
@@ -54,6 +54,17 @@ hyp_chooser( struct site *__restrict lat ,
 		      GLU_FORWARD , GENTYPE ) ;
     return ;
   }
+  // ADAPTIVE RK3 with the embedded second order error estimate
+  if( SMINFO.type == SM_EMBEDWFLOW_LOG || 
+      SMINFO.type == SM_EMBEDWFLOW_STOUT ) {
+    smearing_types GENTYPE = SM_STOUT ;
+    if( SMINFO.type == SM_EMBEDWFLOW_LOG ) {
+      GENTYPE = SM_LOG ;
+    }
+    flow_adaptive_embedded( lat , SMINFO.smiters , 
+			    GLU_FORWARD , GENTYPE ) ;
+    return ;
+  }
   // RK4 method of integrating the flow equation
   if( SMINFO.type == SM_WFLOW_LOG || 
       SMINFO.type == SM_WFLOW_STOUT ) {
@@ -92,7 +103,7 @@ hyp_chooser( struct site *__restrict lat ,
     } else {
       switch( meminfo ) {
       case FAST :
-	HYPSLsmear4D_expensive( lat , SMINFO.smiters , GENTYPE ) ;
+	HYPSLsmear4D( lat , SMINFO.smiters , GENTYPE ) ;
 	return ;
       case MODERATE :
       case SLOW :
@@ -112,7 +123,9 @@ smear_or_wflow( const smearing_types type )
   if( type == SM_WFLOW_LOG || 
       type == SM_ADAPTWFLOW_LOG ||
       type == SM_WFLOW_STOUT || 
-      type == SM_ADAPTWFLOW_STOUT )  {
+      type == SM_ADAPTWFLOW_STOUT ||
+      type == SM_EMBEDWFLOW_LOG ||
+      type == SM_EMBEDWFLOW_STOUT )  {
     fprintf( stdout , "[WFLOW] " ) ;
     return GLU_FALSE ;
   } else { 
@@ -157,6 +170,10 @@ print_smearinfo( const struct sm_info SMINFO )
     fprintf( stdout , "Adaptive RK3-Wilson flow Log\n" ) ; break ;
   case SM_ADAPTWFLOW_STOUT : 
     fprintf( stdout , "Adaptive RK3-Wilson flow STOUT\n" ) ; break ;
+  case SM_EMBEDWFLOW_LOG : 
+    fprintf( stdout , "Embedded adaptive RK3-Wilson flow Log\n" ) ; break ;
+  case SM_EMBEDWFLOW_STOUT : 
+    fprintf( stdout , "Embedded adaptive RK3-Wilson flow STOUT\n" ) ; break ;
   default : fprintf( stdout , "No smearing\n" ) ;
   }
   // wilson flow information about the clover terms and what have you
@@ -248,7 +265,9 @@ SM_wrap_struct( struct site *__restrict lat ,
   } else if( SMINFO.type == SM_WFLOW_LOG || 
 	     SMINFO.type == SM_ADAPTWFLOW_LOG ||
 	     SMINFO.type == SM_WFLOW_STOUT || 
-	     SMINFO.type == SM_ADAPTWFLOW_STOUT )  {
+	     SMINFO.type == SM_ADAPTWFLOW_STOUT ||
+	     SMINFO.type == SM_EMBEDWFLOW_LOG ||
+	     SMINFO.type == SM_EMBEDWFLOW_STOUT )  {
     const int meminfo = have_memory_wf( SMINFO ) ;
     if( meminfo == GLU_FAILURE ) { return GLU_FAILURE ; }
     hyp_chooser( lat , SMINFO , meminfo ) ;
@@ -0,0 +1,269 @@
+/*
+    Copyright 2013-2018 Renwick James Hudspith
+
+    This file (MMULs_bench.c) is part of GLU.
+
+    GLU is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    GLU is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with GLU.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/**
+   @file MMULs_bench.c
+   @brief microbenchmark of the dispatched SU(3) kernels
+
+   Runs each kernel over a small array of random SU(3) matrices that
+   sits in L1/L2 for every backend available on this node and prints
+   the time per call. GFLOP/s uses the flop count of the plain algorithm
+   (174 for the SU(3) multiply completing the bottom row) so it compares
+   backends rather than counting the flops each one really does.
+
+   Then the staples and plaquettes of a random 8^ND lattice, a site at
+   a time and #STAPLE_LANES sites at a time with lanes.h, as staples
+   (the sum over the 2(ND-1) of one link) per second on one core
+ */
+#include "Mainfile.h"
+
+#include "cpu_dispatch.h"
+#include "expMat.h"
+#include "GLU_timer.h"
+#include "GLUlib_wrap.h"
+#include "gramschmidt.h"
+#include "init.h"
+#include "lanes.h"
+#include "par_rng.h"
+#include "plaqs_links.h"
+#include "random_config.h"
+#include "staples.h"
+#include "trace_abc.h"
+
+struct latt_info Latt ; // dimensions and stuff
+GLU_bool INIT_RNG ;
+
+#if NC == 3
+
+// number of matrices we loop over
+#define NMAT (256)
+
+// minimum time in seconds for each measurement
+#define TMIN (0.25)
+
+static GLU_complex A[ NMAT ][ NCNC ] GLUalign ;
+static GLU_complex B[ NMAT ][ NCNC ] GLUalign ;
+static GLU_complex C[ NMAT ][ NCNC ] GLUalign ;
+static GLU_complex Q[ NMAT ][ NCNC ] GLUalign ;
+
+// stops the traces being thrown away
+static volatile double sink ;
+
+// random gauge field for the staples
+static struct site *lat = NULL ;
+
+static void mul( void ) {
+  size_t i ; for( i = 0 ; i < NMAT ; i++ ) multab_suNC( C[i] , A[i] , B[i] ) ;
+}
+static void mul_dag( void ) {
+  size_t i ; for( i = 0 ; i < NMAT ; i++ ) multab_dag_suNC( C[i] , A[i] , B[i] ) ;
+}
+static void muldag( void ) {
+  size_t i ; for( i = 0 ; i < NMAT ; i++ ) multabdag_suNC( C[i] , A[i] , B[i] ) ;
+}
+static void Retrdag( void ) {
+  double s = 0.0 ; size_t i ;
+  for( i = 0 ; i < NMAT ; i++ ) s += Re_trace_abc_dag_suNC( A[i] , B[i] , C[i] ) ;
+  sink = s ;
+}
+static void tr( void ) {
+  GLU_complex s = 0.0 , t ; size_t i ;
+  for( i = 0 ; i < NMAT ; i++ ) { trace_abc( &t , A[i] , B[i] , C[i] ) ; s += t ; }
+  sink = creal( s ) ;
+}
+static void trdag( void ) {
+  GLU_complex s = 0.0 , t ; size_t i ;
+  for( i = 0 ; i < NMAT ; i++ ) { trace_abc_dag( &t , A[i] , B[i] , C[i] ) ; s += t ; }
+  sink = creal( s ) ;
+}
+static void trdagRe( void ) {
+  GLU_real s = 0.0 , t ; size_t i ;
+  for( i = 0 ; i < NMAT ; i++ ) { trace_abc_dag_Re( &t , A[i] , B[i] , C[i] ) ; s += t ; }
+  sink = s ;
+}
+// C is already unitary so this measures the steady state
+static void reunit( void ) {
+  size_t i ; for( i = 0 ; i < NMAT ; i++ ) gram_reunit( C[i] ) ;
+}
+static void expo( void ) {
+  size_t i ; for( i = 0 ; i < NMAT ; i++ ) exponentiate( C[i] , Q[i] ) ;
+}
+
+// the kernels and the flops of the plain algorithm, 0 if not meaningful
+// the traces are the 174 of the SU(3) a.b plus 70 (complex) or 35 (real)
+static const struct {
+  const char *name ;
+  void (*loop)( void ) ;
+  const double flops ;
+} kernels[ ] = {
+  { "multab_suNC" , mul , 174 } ,
+  { "multab_dag_suNC" , mul_dag , 174 } ,
+  { "multabdag_suNC" , muldag , 174 } ,
+  { "Re_trace_abc_dag_suNC" , Retrdag , 209 } ,
+  { "trace_abc" , tr , 244 } ,
+  { "trace_abc_dag" , trdag , 244 } ,
+  { "trace_abc_dag_Re" , trdagRe , 209 } ,
+  { "gram_reunit" , reunit , 0 } ,
+  { "exponentiate" , expo , 0 } ,
+} ;
+
+// all the staples of the lattice a site at a time
+static void stap_site( void ) {
+  size_t i , mu ;
+  for( i = 0 ; i < LVOLUME ; i++ ) {
+    for( mu = 0 ; mu < ND ; mu++ ) {
+      GLU_complex stap[ NCNC ] GLUalign ;
+      zero_mat( stap ) ;
+      all_staples( stap , lat , i , mu , ND , SM_APE ) ;
+      sink = creal( stap[0] ) ;
+    }
+  }
+}
+static void stap_lanes( void ) {
+  size_t i , mu , l ;
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
+    size_t site[ STAPLE_LANES ] ;
+    for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+      site[l] = i + l ;
+    }
+    for( mu = 0 ; mu < ND ; mu++ ) {
+      GLU_complex stap[ STAPLE_LANES ][ NCNC ] GLUalign ;
+      for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	zero_mat( stap[l] ) ;
+      }
+      all_staples_lanes( stap , lat , site , STAPLE_LANES , mu , ND , SM_APE ) ;
+      sink = creal( stap[0][0] ) ;
+    }
+  }
+}
+// the plaquettes, counted as staples as there are as many of them,
+// s_plaq() and t_plaq() still work a site at a time
+static void plaq_site( void ) {
+  sink = s_plaq( lat ) + t_plaq( lat ) ;
+}
+static void plaq_lanes( void ) {
+  double p = 0.0 ;
+  size_t i , l ;
+  for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES ) {
+    size_t site[ STAPLE_LANES ] ;
+    double plaq[ STAPLE_LANES ][ 2 ] ;
+    for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+      site[l] = i + l ;
+    }
+    plaquettes_lanes( plaq , lat , site ) ;
+    for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+      p += plaq[l][0] + plaq[l][1] ;
+    }
+  }
+  sink = p ;
+}
+
+static const struct {
+  const char *name ;
+  void (*loop)( void ) ;
+} lattice[ ] = {
+  { "all_staples" , stap_site } ,
+  { "all_staples_lanes" , stap_lanes } ,
+  { "s_plaq+t_plaq" , plaq_site } ,
+  { "plaquettes_lanes" , plaq_lanes } ,
+} ;
+
+// seconds per call of loop, which does n things
+static double
+time_loop( void (*loop)( void ) , const size_t n )
+{
+  size_t reps = 1 , r ;
+  loop( ) ; // warm up
+  for( ;; ) {
+    const double t0 = wall_time( ) ;
+    for( r = 0 ; r < reps ; r++ ) {
+      loop( ) ;
+    }
+    const double t = wall_time( ) - t0 ;
+    if( t > TMIN ) {
+      return t / (double)( reps * n ) ;
+    }
+    reps *= 2 ;
+  }
+}
+
+#endif
+
+int main( void )
+{
+  attach_GLU( ) ;
+
+  // init_latt() also picks the kernels
+  size_t mu ;
+  for( mu = 0 ; mu < ND ; mu++ ) {
+    Latt.dims[ mu ] = 8 ;
+  }
+  init_latt( ) ;
+  Latt.Seed[0] = 1 ;
+  initialise_par_rng( NULL ) ;
+
+#if NC == 3
+  size_t i , j , k ;
+  for( i = 0 ; i < NMAT ; i++ ) {
+    Sunitary_gen( A[i] , 0 ) ;
+    Sunitary_gen( B[i] , 0 ) ;
+    Sunitary_gen( C[i] , 0 ) ;
+    // small hermitian traceless matrices to exponentiate
+    for( j = 0 ; j < NCNC ; j++ ) {
+      Q[i][j] = 0.05 * I * ( A[i][j] - conj( A[i][ ( j%NC )*NC + j/NC ] ) ) ;
+    }
+    const GLU_complex trQ = ( Q[i][0] + Q[i][4] + Q[i][8] ) / 3. ;
+    Q[i][0] -= trQ ; Q[i][4] -= trQ ; Q[i][8] -= trQ ;
+  }
+  if( ( lat = allocate_lat( ) ) == NULL ) {
+    fprintf( stderr , "[BENCH] gauge field allocation failure\n" ) ;
+    return GLU_FAILURE ;
+  }
+  random_suNC( lat ) ;
+
+  const GLU_simd keep = simd_backend( ) ;
+  GLU_simd backend ;
+  for( backend = SIMD_GENERIC ; backend <= SIMD_AVX512 ; backend++ ) {
+    if( simd_available( backend ) == GLU_FALSE ) continue ;
+    set_simd_backend( backend ) ;
+    for( k = 0 ; k < sizeof( kernels ) / sizeof( kernels[0] ) ; k++ ) {
+      const double t = time_loop( kernels[k].loop , NMAT ) ;
+      if( kernels[k].flops > 0 ) {
+	fprintf( stdout , "[BENCH] %-16s %-22s %8.2f ns/call %7.3f GFLOP/s\n" ,
+		 simd_name( backend ) , kernels[k].name , t * 1E9 ,
+		 kernels[k].flops / t * 1E-9 ) ;
+      } else {
+	fprintf( stdout , "[BENCH] %-16s %-22s %8.2f ns/call\n" ,
+		 simd_name( backend ) , kernels[k].name , t * 1E9 ) ;
+      }
+    }
+    for( k = 0 ; k < sizeof( lattice ) / sizeof( lattice[0] ) ; k++ ) {
+      const double t = time_loop( lattice[k].loop , LVOLUME * ND ) ;
+      fprintf( stdout , "[BENCH] %-16s %-22s %8.2f ns/staple %7.3f Mstaples/s\n" ,
+	       simd_name( backend ) , lattice[k].name , t * 1E9 , 1E-6 / t ) ;
+    }
+  }
+  set_simd_backend( keep ) ;
+  free_lat( lat ) ;
+#else
+  fprintf( stdout , "[BENCH] the dispatched kernels are SU(3) only\n" ) ;
+#endif
+
+  unstick_GLU( ) ;
+  return GLU_SUCCESS ;
+}
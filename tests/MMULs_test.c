@@ -4,9 +4,12 @@
  */
 #include "Mainfile.h"
 
+#include "cpu_dispatch.h"
+#include "expMat.h"
 #include "par_rng.h"
 #include "gramschmidt.h"
 #include "minunit.h"
+#include "trace_abc.h"
 
 // temporary mats
 static GLU_complex Ua[ NCNC ] GLUalign , Ub[ NCNC ] GLUalign ;
@@ -124,6 +127,72 @@ static char *multab_dag_test( void )
   return NULL ;
 }
 
+#if NC == 3
+// every kernel of the run-time dispatch against the generic one
+static char *backends_test( void )
+{
+  const GLU_simd keep = simd_backend( ) ;
+  GLU_complex Q[ NCNC ] , M[ NCNC ] ;
+  GLU_complex ref[ 6 ][ NCNC ] , out[ 6 ][ NCNC ] ;
+  GLU_complex tr[ 2 ][ 3 ] ;
+  GLU_real trRe[ 2 ] ;
+  double Retr[ 2 ] ;
+  size_t i , j ;
+  // hermitian, traceless Q and a non-unitary M
+  for( i = 0 ; i < NC ; i++ ) {
+    for( j = 0 ; j < NC ; j++ ) {
+      Q[ j + i*NC ] = I * ( Ua[ j + i*NC ] - conj( Ua[ i + j*NC ] ) ) / 2. ;
+      M[ j + i*NC ] = Ua[ j + i*NC ] + 0.1 * Ub[ j + i*NC ] ;
+    }
+  }
+  const GLU_complex trQ = ( Q[0] + Q[4] + Q[8] ) / 3. ;
+  Q[0] -= trQ ; Q[4] -= trQ ; Q[8] -= trQ ;
+
+  GLU_simd backend ;
+  for( backend = SIMD_GENERIC ; backend <= SIMD_AVX512 ; backend++ ) {
+    if( simd_available( backend ) == GLU_FALSE ) continue ;
+    set_simd_backend( backend ) ;
+    const size_t k = ( backend == SIMD_GENERIC ) ? 0 : 1 ;
+    GLU_complex (*r)[ NCNC ] = ( k == 0 ) ? ref : out ;
+    multab_suNC( r[0] , Ua , Ub ) ;
+    multab_dag_suNC( r[1] , Ua , Ub ) ;
+    multabdag_suNC( r[2] , Ua , Ub ) ;
+    equiv( r[3] , M ) ;
+    gram_reunit( r[3] ) ;
+    exponentiate( r[4] , Q ) ;
+    // in place, U is Q
+    equiv( r[5] , Q ) ;
+    exponentiate( r[5] , r[5] ) ;
+    Retr[ k ] = Re_trace_abc_dag_suNC( Ua , Ub , M ) ;
+    trace_abc( &tr[ k ][0] , Ua , Ub , M ) ;
+    trace_abc_dag( &tr[ k ][1] , Ua , Ub , M ) ;
+    trace_abc_dag_Re( &trRe[ k ] , Ua , Ub , M ) ;
+    tr[ k ][2] = trRe[ k ] ;
+    if( k == 0 ) continue ;
+    for( i = 0 ; i < 6 ; i++ ) {
+      if( are_equal( ref[i] , out[i] ) == GLU_FALSE ) {
+	write_matrix( ref[i] ) ;
+	write_matrix( out[i] ) ;
+	set_simd_backend( keep ) ;
+	mu_assert( "[GLUnit] error : dispatched matrix kernel differs" , 0 ) ;
+      }
+    }
+    for( i = 0 ; i < 3 ; i++ ) {
+      if( cabs( tr[0][i] - tr[1][i] ) > PREC_TOL ) {
+	set_simd_backend( keep ) ;
+	mu_assert( "[GLUnit] error : dispatched trace_abc differs" , 0 ) ;
+      }
+    }
+    if( fabs( Retr[0] - Retr[1] ) > PREC_TOL ) {
+      set_simd_backend( keep ) ;
+      mu_assert( "[GLUnit] error : dispatched Re_trace_abc_dag differs" , 0 ) ;
+    }
+  }
+  set_simd_backend( keep ) ;
+  return NULL ;
+}
+#endif
+
 // little runner for the tests
 static char *
 mmul_test( void )
@@ -135,6 +204,9 @@ mmul_test( void )
   mu_run_test( multabdag_test ) ;
   mu_run_test( multab_dagdag_test ) ;
   mu_run_test( multab_dag_test ) ;
+#if NC == 3
+  mu_run_test( backends_test ) ;
+#endif
   return NULL ;
 }
 
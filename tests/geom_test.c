@@ -4,6 +4,7 @@
  */
 #include "Mainfile.h"
 
+#include "draughtboard.h"
 #include "geometry.h"
 #include "minunit.h"
 
@@ -226,6 +227,33 @@ gen_shift_test( void )
   return NULL ;
 }
 
+// tiled draughtboard has the same colours as the lexicographical one
+static char*
+init_blocked_cb_test( void )
+{
+  struct draughtboard db , bdb ;
+  size_t *colour = malloc( LVOLUME * sizeof( size_t ) ) , c , i ;
+  init_cb( &db , LVOLUME , ND ) ;
+  init_blocked_cb( &bdb , ND ) ;
+  for( c = 0 ; c < db.Ncolors ; c++ ) {
+    for( i = 0 ; i < db.Nsquare[c] ; i++ ) {
+      colour[ db.square[c][i] ] = c ;
+    }
+  }
+  size_t nbad = ( db.Ncolors != bdb.Ncolors ) ;
+  for( c = 0 ; c < db.Ncolors && nbad == 0 ; c++ ) {
+    nbad += ( db.Nsquare[c] != bdb.Nsquare[c] ) ;
+    for( i = 0 ; i < bdb.Nsquare[c] && nbad == 0 ; i++ ) {
+      nbad += ( colour[ bdb.square[c][i] ] != c ) ;
+    }
+  }
+  free( colour ) ;
+  free_cb( &db ) ;
+  free_cb( &bdb ) ;
+  mu_assert( "[GEOM] init_blocked_cb broken" , nbad == 0 ) ;
+  return NULL ;
+}
+
 // geometry tests
 static char *
 geom_test( void )
@@ -245,6 +273,7 @@ geom_test( void )
   mu_run_test( compute_rsq_test ) ;
   mu_run_test( compute_spacing_test ) ;
   mu_run_test( gen_shift_test ) ;
+  mu_run_test( init_blocked_cb_test ) ;
 
   return NULL ;
 }
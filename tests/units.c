@@ -22,6 +22,7 @@
  */
 #include "Mainfile.h"
 
+#include "cpu_dispatch.h"
 #include "exactQ.h"
 #include "expMat.h"
 #include "init.h"
@@ -29,11 +30,13 @@
 #include "GLUlib_wrap.h"
 #include "gramschmidt.h"
 #include "invert.h"
+#include "lanes.h"
 #include "LU.h"
 #include "minunit.h"
 #include "plaqs_links.h"
 #include "POLY.h"
 #include "random_config.h"
+#include "staples.h"
 
 #include "geom_test.h"
 #include "MMULs_test.h"
@@ -68,9 +71,32 @@ static char *rng_test( void ) {
   return 0;
 }
 
+// bulk gaussians should have the moments of par_polar_box's
+static char *gaussian_array_test( void ) {
+  const size_t N = 1 << 16 ;
+  GLU_complex *z = malloc( N * sizeof( GLU_complex ) ) ;
+  par_gaussian_array( z , N , 0 ) ;
+  double m1 = 0.0 , m2 = 0.0 ;
+  size_t i ;
+  for( i = 0 ; i < N ; i++ ) {
+    m1 += creal( z[i] ) + cimag( z[i] ) ;
+    m2 += creal( z[i] ) * creal( z[i] ) + cimag( z[i] ) * cimag( z[i] ) ;
+  }
+  free( z ) ;
+  m1 /= 2 * N ; m2 /= 2 * N ;
+  // both have a variance of 1/2 per number, allow five sigma
+  const double tol = 5.0 * sqrt( 0.5 / ( 2 * N ) ) ;
+  mu_assert( "[GLUnit] error : par_gaussian_array mean is off" , 
+	     !( fabs( m1 ) > tol ) ) ;
+  mu_assert( "[GLUnit] error : par_gaussian_array variance is off" , 
+	     !( fabs( m2 - 0.5 ) > tol ) ) ;
+  return 0 ;
+}
+
 // test our random numbers
 static char *rng_tests( void ) {
   mu_run_test( rng_test ) ;
+  mu_run_test( gaussian_array_test ) ;
   return 0 ;
 }
 
@@ -223,6 +249,191 @@ static char *av_plaquette_test( void ) {
   return 0 ;
 }
 
+// two teams transforming their own copies one at a time, like the
+// luxury gauge fixing does, must finish and stay gauge invariant
+static char *team_transform_test( void ) {
+  GLU_bool is_ok = GLU_TRUE ;
+  struct site *copy[ 2 ] = { NULL , NULL } ;
+  GLU_complex **gauge = malloc( 2 * LVOLUME * sizeof( GLU_complex* ) ) ;
+  size_t n , i ;
+  for( i = 0 ; i < 2 * LVOLUME ; i++ ) {
+    gauge[i] = malloc( NCNC * sizeof( GLU_complex ) ) ;
+  }
+  for( n = 0 ; n < 2 ; n++ ) {
+    copy[n] = allocate_lat( ) ;
+    copy_lat( copy[n] , lat ) ;
+  }
+  #pragma omp parallel for num_threads(2) private(n)
+  for( n = 0 ; n < 2 ; n++ ) {
+    #pragma omp critical (unit_rng)
+    {
+      random_transform( copy[n] , gauge + n * LVOLUME ) ;
+    }
+  }
+  double sp_plaq , t_plaq , csp_plaq , ct_plaq ;
+  all_plaquettes( lat , &sp_plaq , &t_plaq ) ;
+  for( n = 0 ; n < 2 ; n++ ) {
+    all_plaquettes( copy[n] , &csp_plaq , &ct_plaq ) ;
+    if( fabs( sp_plaq - csp_plaq ) > PREC_TOL ||
+	fabs( t_plaq - ct_plaq ) > PREC_TOL ) is_ok = GLU_FALSE ;
+    free_lat( copy[n] ) ;
+  }
+  for( i = 0 ; i < 2 * LVOLUME ; i++ ) {
+    free( gauge[i] ) ;
+  }
+  free( gauge ) ;
+  mu_assert( "[GLUnit] error : team gauge transforms are broken" , is_ok ) ;
+  return 0 ;
+}
+
+// Re tr( a b ( c d )^dagger )
+static double
+Re_tr_abcddag( const GLU_complex a[ NCNC ] , const GLU_complex b[ NCNC ] ,
+	       const GLU_complex c[ NCNC ] , const GLU_complex d[ NCNC ] )
+{
+  GLU_complex x[ NCNC ] , y[ NCNC ] ;
+  multab( x , a , b ) ;
+  multab( y , c , d ) ;
+  double tr = 0.0 ;
+  size_t j ;
+  for( j = 0 ; j < NCNC ; j++ ) {
+    tr += creal( x[j] * conj( y[j] ) ) ;
+  }
+  return tr ;
+}
+
+// the four leaves of the mu-nu clover, in the order of clover.c
+static void
+clover_ref( GLU_complex sum[ NCNC ] , double *plaq ,
+	    const size_t i , const size_t mu , const size_t nu )
+{
+  GLU_complex a[ NCNC ] , b[ NCNC ] , c[ NCNC ] ;
+  const size_t pm = site_fwd( i , mu ) , pn = site_fwd( i , nu ) ;
+  const size_t mm = site_bck( i , mu ) , mn = site_bck( i , nu ) ;
+  const size_t mn_pm = site_fwd( mn , mu ) , mm_mn = site_bck( mm , nu ) ;
+  const size_t mm_pn = site_fwd( mm , nu ) ;
+  multab( a , lat[i].O[mu] , lat[pm].O[nu] ) ;
+  multab_dag( b , a , lat[pn].O[mu] ) ;
+  multab_dag( sum , b , lat[i].O[nu] ) ;
+  *plaq = creal( trace( sum ) ) ;
+  multabdag( a , lat[mn].O[nu] , lat[mn].O[mu] ) ;
+  multab( b , a , lat[mn_pm].O[nu] ) ;
+  multab_dag( c , b , lat[i].O[mu] ) ;
+  a_plus_b( sum , c ) ;
+  multab_dagdag( a , lat[mm].O[mu] , lat[mm_mn].O[nu] ) ;
+  multab( b , a , lat[mm_mn].O[mu] ) ;
+  multab( c , b , lat[mn].O[nu] ) ;
+  a_plus_b( sum , c ) ;
+  multab_dag( a , lat[i].O[nu] , lat[mm_pn].O[mu] ) ;
+  multab_dag( b , a , lat[mm].O[nu] ) ;
+  multab( c , b , lat[mm].O[mu] ) ;
+  a_plus_b( sum , c ) ;
+  return ;
+}
+
+// the site-batched kernels against the per-site routines, for every
+// backend and with a short batch at the end
+static char *lanes_test( void ) {
+  GLU_bool is_ok = GLU_TRUE ;
+#ifdef GLU_DISPATCH
+  const GLU_simd keep = simd_backend( ) ;
+  GLU_simd backend ;
+  for( backend = SIMD_GENERIC ; backend <= SIMD_AVX512 ; backend++ ) {
+    if( simd_available( backend ) == GLU_FALSE ) continue ;
+    set_simd_backend( backend ) ;
+#endif
+    size_t i ;
+    for( i = 0 ; i < LVOLUME ; i += STAPLE_LANES - 3 ) {
+      const size_t n = i + STAPLE_LANES - 3 < LVOLUME ?
+	STAPLE_LANES - 3 : LVOLUME - i ;
+      GLU_complex stap[ STAPLE_LANES ][ NCNC ] , ref[ NCNC ] ;
+      double plaq[ STAPLE_LANES ][ 2 ] , lp[ STAPLE_LANES ] ;
+      size_t site[ STAPLE_LANES ] , mu , nu , l , j ;
+      for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	site[l] = i + ( l < n ? l : 0 ) ;
+      }
+      for( mu = 0 ; mu < ND ; mu++ ) {
+	for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	  zero_mat( stap[l] ) ;
+	}
+	staples_lanes( stap , lat , site , n , mu , ND ) ;
+	for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	  zero_mat( ref ) ;
+	  if( l < n ) {
+	    all_staples( ref , lat , site[l] , mu , ND , SM_APE ) ;
+	  }
+	  for( j = 0 ; j < NCNC ; j++ ) {
+	    if( cabs( stap[l][j] - ref[j] ) > PREC_TOL ) is_ok = GLU_FALSE ;
+	  }
+	}
+      }
+      plaquettes_lanes( plaq , lat , site ) ;
+      for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	double p[ 2 ] = { 0.0 , 0.0 } ;
+	for( mu = 0 ; mu < ND ; mu++ ) {
+	  for( nu = 0 ; nu < mu ; nu++ ) {
+	    p[ mu < ND-1 ] += Re_tr_abcddag( lat[ site[l] ].O[mu] ,
+					     lat[ site_fwd( site[l] , mu ) ].O[nu] ,
+					     lat[ site[l] ].O[nu] ,
+					     lat[ site_fwd( site[l] , nu ) ].O[mu] ) ;
+	  }
+	}
+	if( fabs( p[0] - plaq[l][0] ) > PREC_TOL ||
+	    fabs( p[1] - plaq[l][1] ) > PREC_TOL ) is_ok = GLU_FALSE ;
+      }
+      for( mu = 0 ; mu < ND ; mu++ ) {
+	for( nu = 0 ; nu < ND ; nu++ ) {
+	  if( mu == nu ) continue ;
+	  clover_lanes( stap , lp , lat , site , mu , nu ) ;
+	  for( l = 0 ; l < STAPLE_LANES ; l++ ) {
+	    double rp ;
+	    clover_ref( ref , &rp , site[l] , mu , nu ) ;
+	    if( fabs( rp - lp[l] ) > PREC_TOL ) is_ok = GLU_FALSE ;
+	    for( j = 0 ; j < NCNC ; j++ ) {
+	      if( cabs( stap[l][j] - ref[j] ) > PREC_TOL ) is_ok = GLU_FALSE ;
+	    }
+	  }
+	}
+      }
+    }
+#ifdef GLU_DISPATCH
+  }
+  set_simd_backend( keep ) ;
+#endif
+  mu_assert( "[GLUnit] error : site-batched kernels are broken" , is_ok ) ;
+  return 0 ;
+}
+
+// the fused sweep should agree with the separate measurements and its
+// clover observables should be gauge invariant
+static char *gauge_obs_test( void ) {
+  GLU_bool is_ok = GLU_TRUE ;
+
+  struct gauge_obs obs , gobs ;
+  gauge_obs( &obs , lat , GLU_TRUE ) ;
+  gauge_obs( &gobs , glat , GLU_TRUE ) ;
+
+  double sp_plaq , t_plaq , sp_link , t_link ;
+  all_plaquettes( lat , &sp_plaq , &t_plaq ) ;
+  const double link = all_links( lat , &sp_link , &t_link ) ;
+
+  if( fabs( obs.splaq - sp_plaq ) > PREC_TOL ||
+      fabs( obs.tplaq - t_plaq ) > PREC_TOL ||
+      fabs( obs.plaq - av_plaquette( lat ) ) > PREC_TOL ) is_ok = GLU_FALSE ;
+  mu_assert( "[GLUnit] error : fused plaquettes are broken" , is_ok ) ;
+
+  if( fabs( obs.link - link ) > PREC_TOL ||
+      fabs( obs.slink - sp_link ) > PREC_TOL ||
+      fabs( obs.tlink - t_link ) > PREC_TOL ) is_ok = GLU_FALSE ;
+  mu_assert( "[GLUnit] error : fused link traces are broken" , is_ok ) ;
+
+  if( fabs( obs.GG - gobs.GG ) > PREC_TOL ||
+      fabs( obs.qtop - gobs.qtop ) > PREC_TOL ) is_ok = GLU_FALSE ;
+  mu_assert( "[GLUnit] error : fused clover is not gauge invariant" , is_ok ) ;
+
+  return 0 ;
+}
+
 // test the gauge invariance of the polyakov loops in each direction
 // after a gauge transformation
 static char *polyakov_test( void ) {
@@ -247,7 +458,6 @@ static char *config_tests( void )
     fprintf( stderr , "[CONFIG-UNIT] Gauge field allocation failure\n" ) ;
     return NULL ;
   }
-  init_navig( lat ) ;
 
   // randomly generate an SU(NC) field
   random_suNC( lat ) ;
@@ -258,7 +468,6 @@ static char *config_tests( void )
     fprintf( stderr , "[CONFIG-UNIT] Gauge field 2 allocation failure\n" ) ;
     return NULL ;
   }
-  init_navig( glat ) ;
 
   size_t i , mu ;
   for( i = 0 ; i < LVOLUME ; i++ ) {
@@ -272,6 +481,9 @@ static char *config_tests( void )
 
   // test gauge invariant stuff
   mu_run_test( av_plaquette_test ) ;
+  mu_run_test( team_transform_test ) ;
+  mu_run_test( lanes_test ) ;
+  mu_run_test( gauge_obs_test ) ;
   mu_run_test( polyakov_test ) ;
 
   free( lat ) ;